@@ -0,0 +1,30 @@
+/**
+ * bench_main.cpp
+ *
+ * The main function for the benchmarks, runs the benchmarks between initialising and finalising
+ * MPI. The benchmarks are intended to be run on a single rank.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <mpi.h>
+
+int main(int argc, char* argv[])
+{
+  MPI_Init(&argc, &argv);
+
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+  {
+    MPI_Finalize();
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+
+  MPI_Finalize();
+
+  return 0;
+}
@@ -0,0 +1,304 @@
+/**
+ * bench_partition.cpp
+ *
+ * Benchmarks testing node membership of each partition implementation, and comparing the quality
+ * and cost of the graph partitioner with the geometric partitioners.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <mpi.h>
+
+#include <_node_parser.h>
+#include <dual_graph.h>
+#include <element_parser.h>
+#include <geometric_partition.h>
+#include <graph_partition.h>
+#include <mapped_stream.h>
+#include <mpi_utils.h>
+#include <section_reader.h>
+#include <sfc_partition.h>
+#include <utils.h>
+
+#include "bench_utils.h"
+
+namespace
+{
+  /**
+   * Reads this rank's nodes from a binary synthetic mesh.
+   */
+  [[nodiscard]] cfg::parser::NodeSet<3> read_node_set(const cfg::bench::MeshSpec& spec,
+                                                      const cfg::utils::Parallel& parallel)
+  {
+    const cfg::reader::MappedFile mapping{cfg::bench::mesh_file(spec)};
+    cfg::reader::MappedStream stream{mapping};
+    const cfg::reader::SectionReader node_reader("Nodes", stream);
+    const auto node_header = cfg::parser::HeaderParser::parse(node_reader, stream, cfg::parser::Mode::BINARY);
+    return cfg::parser::NodeSetParser::parse(node_reader, stream, cfg::parser::Mode::BINARY, node_header, {parallel});
+  }
+
+  /**
+   * Constructs a partition of the nodes, the simple partitions emulate rank 1 of 4.
+   */
+  template <class P>
+  [[nodiscard]] P make_partition(const cfg::parser::NodeSet<3>& nodes, const size_t n_nodes)
+  {
+    if constexpr (std::is_same_v<P, cfg::utils::NaivePartition>)
+    {
+      return P{cfg::utils::Parallel{1, 4}, n_nodes};
+    }
+    else if constexpr (std::is_base_of_v<cfg::utils::GeometricPartition, P>)
+    {
+      return P{nodes, MPI_COMM_WORLD};
+    }
+    else
+    {
+      return P{};
+    }
+  }
+
+  /**
+   * Tests every node of the mesh for membership of the partition, through the `Partition`
+   * interface.
+   */
+  template <class P>
+  void BM_Pick(benchmark::State& state)
+  {
+    const auto n_nodes  = static_cast<size_t>(state.range(0));
+    const auto parallel = cfg::utils::make_parallel(MPI_COMM_WORLD);
+    const auto nodes    = read_node_set(cfg::bench::mesh_spec(state, cfg::parser::Mode::BINARY), parallel);
+
+    // The partition is hidden from the optimiser so that `pick` is called through the vtable, as
+    // by the parsers
+    const auto partition                     = make_partition<P>(nodes, n_nodes);
+    const cfg::utils::Partition* as_partition = &partition;
+    benchmark::DoNotOptimize(as_partition);
+    for (auto _ : state)
+    {
+      size_t picked = 0;
+      for (size_t idx = 0; idx < n_nodes; idx++)
+      {
+        picked += as_partition->pick(idx) ? 1 : 0;
+      }
+      benchmark::DoNotOptimize(picked);
+    }
+    cfg::bench::report_throughput(state, n_nodes, n_nodes * sizeof(size_t));
+  }
+
+  /**
+   * The mesh sizes benchmarked, a single block as the partitions do not depend on the blocks.
+   */
+  void partition_sizes(benchmark::internal::Benchmark* bench)
+  {
+    bench->ArgNames({"nodes", "blocks"});
+    bench->Args({int64_t{1} << 12U, 1});
+    bench->Args({int64_t{1} << 18U, 1});
+  }
+
+  BENCHMARK_TEMPLATE(BM_Pick, cfg::utils::Partition)->Apply(partition_sizes);
+  BENCHMARK_TEMPLATE(BM_Pick, cfg::utils::SerialPartition)->Apply(partition_sizes);
+  BENCHMARK_TEMPLATE(BM_Pick, cfg::utils::NaivePartition)->Apply(partition_sizes);
+  BENCHMARK_TEMPLATE(BM_Pick, cfg::utils::RCBPartition)->Apply(partition_sizes);
+  BENCHMARK_TEMPLATE(BM_Pick, cfg::utils::SFCPartition)->Apply(partition_sizes);
+
+  /**
+   * Identifies how the cells of a mesh are partitioned.
+   */
+  enum class Method
+  {
+    MULTILEVEL,  ///< Multilevel partitioning of the dual graph, `partition_graph`.
+    RCB,         ///< Recursive coordinate bisection of the cell centroids.
+    SFC          ///< Equal ranges of the cell centroids along the Hilbert curve.
+  };
+
+  /**
+   * A synthetic mesh of hexahedra on a structured grid, stored in a shuffled order so that the
+   * order of the cells carries no locality, with its dual graph and the centroids of its cells.
+   */
+  struct GridMesh
+  {
+    cfg::utils::WeightedGraph graph;    // The dual graph of the cells
+    cfg::parser::NodeSet<3> centroids;  // The centroid of each cell
+
+    explicit GridMesh(const size_t n)
+    {
+      constexpr int hexahedron = 5;
+
+      std::vector<size_t> order(n * n * n);
+      std::iota(order.begin(), order.end(), 0);
+      std::shuffle(order.begin(), order.end(), std::mt19937_64{42});  // NOLINT(readability-magic-numbers)
+
+      // Node tags follow the grid of (n + 1)^3 nodes, from 1
+      const auto tag = [n](const size_t i, const size_t j, const size_t k) -> size_t
+      {
+        return ((k * (n + 1)) + j) * (n + 1) + i + 1;
+      };
+      cfg::parser::ElementSet elements;
+      elements.reserve(order.size());
+      centroids = cfg::parser::NodeSet<3>(order.size());
+      for (size_t c = 0; c < order.size(); c++)
+      {
+        const auto i = order[c] % n;
+        const auto j = (order[c] / n) % n;
+        const auto k = order[c] / (n * n);
+
+        const std::vector<size_t> nodes{tag(i, j, k),
+                                        tag(i + 1, j, k),
+                                        tag(i + 1, j + 1, k),
+                                        tag(i, j + 1, k),
+                                        tag(i, j, k + 1),
+                                        tag(i + 1, j, k + 1),
+                                        tag(i + 1, j + 1, k + 1),
+                                        tag(i, j + 1, k + 1)};
+        elements.push_back(c + 1, c, hexahedron, nodes.begin(), nodes.end());
+        centroids.global_idx[c] = c;
+        centroids.x[0][c]       = static_cast<double>(i) + 0.5;  // NOLINT(readability-magic-numbers)
+        centroids.x[1][c]       = static_cast<double>(j) + 0.5;  // NOLINT(readability-magic-numbers)
+        centroids.x[2][c]       = static_cast<double>(k) + 0.5;  // NOLINT(readability-magic-numbers)
+      }
+
+      const auto dual = cfg::utils::build_dual_graph(elements, MPI_COMM_SELF);
+      graph.offsets   = dual.offsets;
+      graph.adjacency = dual.adjacency;
+      graph.edge_weights.assign(dual.adjacency.size(), 1);
+      graph.vertex_weights.assign(dual.size(), 1);
+    }
+  };
+
+  /**
+   * Partitions cells by recursive coordinate bisection of their centroids, as `RCBPartition` over
+   * `n_parts` ranks.
+   */
+  void rcb_cells(const cfg::parser::NodeSet<3>& centroids,
+                 const std::vector<size_t>::iterator first,
+                 const std::vector<size_t>::iterator last,
+                 const int first_part,
+                 const size_t n_parts,
+                 std::vector<int>& parts)
+  {
+    if (n_parts == 1)
+    {
+      std::for_each(first,
+                    last,
+                    [&parts, first_part](const size_t c)
+                    {
+                      parts[c] = first_part;
+                    });
+      return;
+    }
+
+    size_t axis    = 0;
+    double longest = -1.0;
+    for (size_t ax = 0; ax < 3; ax++)
+    {
+      const auto [lo, hi] = std::minmax_element(first,
+                                                last,
+                                                [&centroids, ax](const size_t a, const size_t b) -> bool
+                                                {
+                                                  return centroids.x[ax][a] < centroids.x[ax][b];
+                                                });
+      if ((lo != last) && (centroids.x[ax][*hi] - centroids.x[ax][*lo] > longest))
+      {
+        axis    = ax;
+        longest = centroids.x[ax][*hi] - centroids.x[ax][*lo];
+      }
+    }
+
+    const auto n_first = n_parts / 2;
+    const auto middle  = first + (last - first) * static_cast<std::ptrdiff_t>(n_first) /
+                                    static_cast<std::ptrdiff_t>(n_parts);
+    std::nth_element(first,
+                     middle,
+                     last,
+                     [&centroids, axis](const size_t a, const size_t b) -> bool
+                     {
+                       return centroids.x[axis][a] < centroids.x[axis][b];
+                     });
+    rcb_cells(centroids, first, middle, first_part, n_first, parts);
+    rcb_cells(centroids, middle, last, first_part + static_cast<int>(n_first), n_parts - n_first, parts);
+  }
+
+  /**
+   * Partitions the cells of a synthetic grid mesh, reporting the edge cut of the dual graph and the
+   * imbalance of the partition. The geometric methods partition the cell centroids serially, as the
+   * distributed partitioners would over `parts` ranks.
+   */
+  template <Method method>
+  void BM_PartitionCells(benchmark::State& state)
+  {
+    const GridMesh mesh{static_cast<size_t>(state.range(0))};
+    const auto n_parts   = static_cast<size_t>(state.range(1));
+    const auto n_threads = static_cast<unsigned int>(state.range(2));
+
+    std::vector<int> parts(mesh.graph.size(), 0);
+    for (auto _ : state)
+    {
+      if constexpr (method == Method::MULTILEVEL)
+      {
+        parts = cfg::utils::partition_graph(mesh.graph, n_parts, n_threads);
+      }
+      else if constexpr (method == Method::RCB)
+      {
+        std::vector<size_t> cells(mesh.graph.size());
+        std::iota(cells.begin(), cells.end(), 0);
+        rcb_cells(mesh.centroids, cells.begin(), cells.end(), 0, n_parts, parts);
+      }
+      else
+      {
+        const auto keys = cfg::utils::sfc_keys(
+            mesh.centroids, cfg::utils::global_bounding_box(mesh.centroids, MPI_COMM_SELF), cfg::utils::Curve::HILBERT);
+        std::vector<size_t> cells(keys.size());
+        std::iota(cells.begin(), cells.end(), 0);
+        std::stable_sort(cells.begin(),
+                         cells.end(),
+                         [&keys](const size_t a, const size_t b) -> bool
+                         {
+                           return keys[a] < keys[b];
+                         });
+        for (size_t i = 0; i < cells.size(); i++)
+        {
+          parts[cells[i]] = static_cast<int>(i * n_parts / cells.size());
+        }
+      }
+      benchmark::DoNotOptimize(parts.data());
+    }
+
+    state.counters["edge_cut"]  = static_cast<double>(cfg::utils::partition_cut(mesh.graph, parts));
+    state.counters["imbalance"] = cfg::utils::partition_imbalance(mesh.graph, parts, n_parts);
+    state.counters["cells/s"] =
+        benchmark::Counter(static_cast<double>(mesh.graph.size()), benchmark::Counter::kIsIterationInvariantRate);
+  }
+
+  /**
+   * The grids and numbers of parts benchmarked, the geometric methods use a single thread.
+   */
+  template <Method method>
+  void cell_partition_sizes(benchmark::internal::Benchmark* bench)
+  {
+    bench->ArgNames({"cells/axis", "parts", "threads"});
+    for (const int64_t n : {16, 48})  // NOLINT(readability-magic-numbers)
+    {
+      for (const int64_t n_parts : {4, 32})  // NOLINT(readability-magic-numbers)
+      {
+        bench->Args({n, n_parts, 1});
+        if constexpr (method == Method::MULTILEVEL)
+        {
+          bench->Args({n, n_parts, 4});
+        }
+      }
+    }
+    bench->Unit(benchmark::kMillisecond);
+  }
+
+  BENCHMARK_TEMPLATE(BM_PartitionCells, Method::MULTILEVEL)->Apply(cell_partition_sizes<Method::MULTILEVEL>);
+  BENCHMARK_TEMPLATE(BM_PartitionCells, Method::RCB)->Apply(cell_partition_sizes<Method::RCB>);
+  BENCHMARK_TEMPLATE(BM_PartitionCells, Method::SFC)->Apply(cell_partition_sizes<Method::SFC>);
+}  // namespace
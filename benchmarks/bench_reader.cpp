@@ -0,0 +1,205 @@
+/**
+ * bench_reader.cpp
+ *
+ * Benchmarks locating and parsing the Nodes section of GMSH files.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include <_node_parser.h>
+#include <mapped_stream.h>
+#include <section_index.h>
+#include <section_reader.h>
+
+#include "bench_utils.h"
+
+namespace
+{
+  using cfg::parser::Mode;
+  using cfg::parser::ReadStrategy;
+
+  /**
+   * A memory-mapped synthetic mesh and the location of its sections.
+   */
+  struct MappedMesh
+  {
+    explicit MappedMesh(const cfg::bench::MeshSpec& spec)
+        : mapping(cfg::bench::mesh_file(spec)), stream(mapping), index(stream)
+    {
+    }
+
+    /**
+     * Returns the size of a section in bytes.
+     */
+    [[nodiscard]] size_t section_size(const std::string& name) const
+    {
+      const auto& section = index.find(name);
+      return section.end - section.start;
+    }
+
+    cfg::reader::MappedFile mapping;    // The mesh file
+    cfg::reader::MappedStream stream;   // The stream over the mesh file
+    cfg::reader::SectionIndex index;    // The sections of the mesh file
+  };
+
+  /**
+   * The Nodes section of a mesh, located and with its header parsed.
+   */
+  struct NodeSection
+  {
+    NodeSection(MappedMesh& mesh, const Mode mode)
+        : reader("Nodes", mesh.stream, mesh.index),
+          header(cfg::parser::HeaderParser::parse(reader, mesh.stream, mode)),
+          data_start(mesh.stream.tellg())
+    {
+    }
+
+    cfg::reader::SectionReader reader;               // The reader of the Nodes section
+    cfg::parser::NodeHeader header;                  // The header of the Nodes section
+    cfg::reader::MappedStream::pos_type data_start;  // The start of the node blocks
+  };
+
+  /**
+   * The mesh sizes benchmarked, as the number of nodes and the number of blocks.
+   */
+  void mesh_sizes(benchmark::internal::Benchmark* bench)
+  {
+    bench->ArgNames({"nodes", "blocks"});
+    for (const int64_t n_nodes : {int64_t{1} << 12U, int64_t{1} << 18U})
+    {
+      for (const int64_t n_blocks : {1, 64})
+      {
+        bench->Args({n_nodes, n_blocks});
+      }
+    }
+  }
+
+  /**
+   * Searches for the Elements section by reading the stream word by word.
+   */
+  template <Mode mode>
+  void BM_SectionReaderSearch(benchmark::State& state)
+  {
+    MappedMesh mesh{cfg::bench::mesh_spec(state, mode)};
+    for (auto _ : state)
+    {
+      mesh.stream.clear();
+      mesh.stream.seekg(0);
+      const cfg::reader::SectionReader reader("Elements", mesh.stream);
+      benchmark::DoNotOptimize(&reader);
+    }
+    cfg::bench::report_throughput(state, static_cast<size_t>(state.range(0)), mesh.index.find("Elements").start);
+  }
+  BENCHMARK_TEMPLATE(BM_SectionReaderSearch, Mode::ASCII)->Apply(mesh_sizes);
+  BENCHMARK_TEMPLATE(BM_SectionReaderSearch, Mode::BINARY)->Apply(mesh_sizes);
+
+  /**
+   * Locates every section in a single pass, for comparison with `BM_SectionReaderSearch`.
+   */
+  template <Mode mode>
+  void BM_SectionIndex(benchmark::State& state)
+  {
+    MappedMesh mesh{cfg::bench::mesh_spec(state, mode)};
+    for (auto _ : state)
+    {
+      const cfg::reader::SectionIndex index{mesh.stream};
+      benchmark::DoNotOptimize(&index);
+    }
+    cfg::bench::report_throughput(state, static_cast<size_t>(state.range(0)), mesh.mapping.bytes().size());
+  }
+  BENCHMARK_TEMPLATE(BM_SectionIndex, Mode::ASCII)->Apply(mesh_sizes);
+  BENCHMARK_TEMPLATE(BM_SectionIndex, Mode::BINARY)->Apply(mesh_sizes);
+
+  /**
+   * Reads every value of the Nodes section with `read_one`, specialised for the encoding.
+   */
+  template <Mode mode>
+  void BM_ReadOne(benchmark::State& state)
+  {
+    using E = cfg::parser::Encoding<mode>;
+    MappedMesh mesh{cfg::bench::mesh_spec(state, mode)};
+    const NodeSection nodes{mesh, mode};
+    for (auto _ : state)
+    {
+      mesh.stream.seekg(nodes.data_start);
+
+      double sum = 0.0;
+      for (size_t block = 0; block < nodes.header.n_blocks; block++)
+      {
+        static_cast<void>(cfg::parser::read_one<int, E>(nodes.reader, mesh.stream));
+        static_cast<void>(cfg::parser::read_one<int, E>(nodes.reader, mesh.stream));
+        static_cast<void>(cfg::parser::read_one<int, E>(nodes.reader, mesh.stream));
+        const auto block_nodes = cfg::parser::read_one<size_t, E>(nodes.reader, mesh.stream);
+        for (size_t i = 0; i < block_nodes; i++)
+        {
+          sum += static_cast<double>(cfg::parser::read_one<size_t, E>(nodes.reader, mesh.stream));
+        }
+        for (size_t i = 0; i < 3 * block_nodes; i++)
+        {
+          sum += cfg::parser::read_one<double, E>(nodes.reader, mesh.stream);
+        }
+      }
+      benchmark::DoNotOptimize(sum);
+    }
+    cfg::bench::report_throughput(state, nodes.header.n_nodes, mesh.section_size("Nodes"));
+  }
+  BENCHMARK_TEMPLATE(BM_ReadOne, Mode::ASCII)->Apply(mesh_sizes);
+  BENCHMARK_TEMPLATE(BM_ReadOne, Mode::BINARY)->Apply(mesh_sizes);
+
+  /**
+   * Parses the node blocks with a node data parser, on a single rank and thread.
+   */
+  template <class P, Mode mode, ReadStrategy strategy>
+  void BM_DataParse(benchmark::State& state)
+  {
+    MappedMesh mesh{cfg::bench::mesh_spec(state, mode)};
+    const NodeSection nodes{mesh, mode};
+    const cfg::utils::Parallel parallel{0, 1};
+    const cfg::parser::NodeEnvironment environment{parallel, strategy};
+    for (auto _ : state)
+    {
+      mesh.stream.seekg(nodes.data_start);
+      const auto parsed = P::parse(nodes.reader, mesh.stream, mode, nodes.header, environment);
+      benchmark::DoNotOptimize(parsed.size());
+    }
+    cfg::bench::report_throughput(state, nodes.header.n_nodes, mesh.section_size("Nodes"));
+  }
+  BENCHMARK_TEMPLATE(BM_DataParse, cfg::parser::DataParser, Mode::ASCII, ReadStrategy::FULL)->Apply(mesh_sizes);
+  BENCHMARK_TEMPLATE(BM_DataParse, cfg::parser::DataParser, Mode::BINARY, ReadStrategy::FULL)->Apply(mesh_sizes);
+  BENCHMARK_TEMPLATE(BM_DataParse, cfg::parser::DataParser, Mode::BINARY, ReadStrategy::LOCAL)->Apply(mesh_sizes);
+  BENCHMARK_TEMPLATE(BM_DataParse, cfg::parser::NodeSetParser, Mode::ASCII, ReadStrategy::FULL)->Apply(mesh_sizes);
+  BENCHMARK_TEMPLATE(BM_DataParse, cfg::parser::NodeSetParser, Mode::BINARY, ReadStrategy::LOCAL)->Apply(mesh_sizes);
+
+  /**
+   * Validates the nodes of a mesh, as read by a node data parser.
+   */
+  template <class P, cfg::bench::TagLayout tags>
+  void BM_ValidateNodes(benchmark::State& state)
+  {
+    MappedMesh mesh{cfg::bench::mesh_spec(state, Mode::BINARY, tags)};
+    const NodeSection section{mesh, Mode::BINARY};
+    const cfg::utils::Parallel parallel{0, 1};
+    const auto nodes = P::parse(section.reader, mesh.stream, Mode::BINARY, section.header, {parallel});
+    for (auto _ : state)
+    {
+      cfg::parser::validate_nodes(nodes, section.header, parallel);
+    }
+    cfg::bench::report_throughput(state, nodes.size(), nodes.size() * sizeof(cfg::parser::Node<3>));
+  }
+  BENCHMARK_TEMPLATE(BM_ValidateNodes, cfg::parser::DataParser, cfg::bench::TagLayout::CONTIGUOUS)
+      ->Apply(mesh_sizes);
+  BENCHMARK_TEMPLATE(BM_ValidateNodes, cfg::parser::DataParser, cfg::bench::TagLayout::SHUFFLED)->Apply(mesh_sizes);
+  BENCHMARK_TEMPLATE(BM_ValidateNodes, cfg::parser::DataParser, cfg::bench::TagLayout::SPARSE)->Apply(mesh_sizes);
+  BENCHMARK_TEMPLATE(BM_ValidateNodes, cfg::parser::NodeSetParser, cfg::bench::TagLayout::CONTIGUOUS)
+      ->Apply(mesh_sizes);
+  BENCHMARK_TEMPLATE(BM_ValidateNodes, cfg::parser::NodeSetParser, cfg::bench::TagLayout::SHUFFLED)
+      ->Apply(mesh_sizes);
+  BENCHMARK_TEMPLATE(BM_ValidateNodes, cfg::parser::NodeSetParser, cfg::bench::TagLayout::SPARSE)
+      ->Apply(mesh_sizes);
+}  // namespace
@@ -0,0 +1,90 @@
+/**
+ * bench_utils.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "bench_utils.h"
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <system_error>
+#include <tuple>
+
+#include <unistd.h>
+
+namespace cfg::bench
+{
+  namespace
+  {
+    /**
+     * The mesh files generated by this process, removed on exit.
+     */
+    class MeshCache
+    {
+     public:
+      MeshCache() = default;
+
+      ~MeshCache()
+      {
+        for (const auto& [key, path] : files)
+        {
+          std::error_code ec;
+          std::filesystem::remove(path, ec);
+        }
+      }
+
+      MeshCache(const MeshCache&)            = delete;
+      MeshCache(MeshCache&&)                 = delete;
+      MeshCache& operator=(const MeshCache&) = delete;
+      MeshCache& operator=(MeshCache&&)      = delete;
+
+      const std::filesystem::path& get(const MeshSpec& spec)
+      {
+        const auto key = std::make_tuple(
+            spec.n_nodes, spec.n_elements, spec.n_blocks, static_cast<int>(spec.tags), spec.binary, spec.seed);
+        const auto found = files.find(key);
+        if (found != files.end())
+        {
+          return found->second;
+        }
+
+        // The process id keeps concurrent benchmark runs apart
+        auto path = std::filesystem::temp_directory_path() /
+                    ("cfgrid-bench-" + std::to_string(getpid()) + "-" + std::to_string(files.size()) + ".msh");
+        write_mesh(path, spec);
+        return files.emplace(key, std::move(path)).first->second;
+      }
+
+     private:
+      std::map<std::tuple<size_t, size_t, size_t, int, bool, uint64_t>, std::filesystem::path> files;
+    };
+  }  // namespace
+
+  const std::filesystem::path& mesh_file(const MeshSpec& spec)
+  {
+    static MeshCache cache;
+    return cache.get(spec);
+  }
+
+  MeshSpec mesh_spec(const benchmark::State& state, const cfg::parser::Mode mode, const TagLayout tags)
+  {
+    MeshSpec spec;
+    spec.n_nodes    = static_cast<size_t>(state.range(0));
+    spec.n_elements = spec.n_nodes;
+    spec.n_blocks   = static_cast<size_t>(state.range(1));
+    spec.tags       = tags;
+    spec.binary     = (mode == cfg::parser::Mode::BINARY);
+
+    return spec;
+  }
+
+  void report_throughput(benchmark::State& state, const size_t n_nodes, const size_t n_bytes)
+  {
+    // Rate counters are reported per second, the counter is named by what is counted
+    state.counters["nodes"] =
+        benchmark::Counter(static_cast<double>(n_nodes), benchmark::Counter::kIsIterationInvariantRate);
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(n_bytes));
+  }
+}  // namespace cfg::bench
@@ -0,0 +1,54 @@
+/**
+ * bench_utils.h
+ *
+ * Shared fixtures of the CFGrid benchmarks.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef __CFG_BENCH_UTILS_H_
+#define __CFG_BENCH_UTILS_H_
+
+#include <cstddef>
+#include <filesystem>
+
+#include <benchmark/benchmark.h>
+
+#include <node_parser.h>
+
+#include "mesh_generator.h"
+
+namespace cfg::bench
+{
+  /**
+   * Returns a synthetic mesh file, generated on first use in the temporary directory and removed
+   * when the benchmarks exit.
+   *
+   * @param spec The description of the mesh.
+   * @returns The path of the mesh file.
+   */
+  [[nodiscard]] const std::filesystem::path& mesh_file(const MeshSpec& spec);
+
+  /**
+   * Describes the mesh of a benchmark, whose arguments are the number of nodes and the number of
+   * blocks. The meshes hold one element per node.
+   *
+   * @param state The benchmark state.
+   * @param mode  The mode the mesh is written in.
+   * @param tags  The layout of the node tags.
+   * @returns The description of the mesh.
+   */
+  [[nodiscard]] MeshSpec mesh_spec(const benchmark::State& state,
+                                   const cfg::parser::Mode mode,
+                                   const TagLayout tags = TagLayout::CONTIGUOUS);
+
+  /**
+   * Reports the throughput of each iteration of a benchmark in nodes/s and bytes/s.
+   *
+   * @param state   The benchmark state.
+   * @param n_nodes The number of nodes processed per iteration.
+   * @param n_bytes The number of bytes processed per iteration.
+   */
+  void report_throughput(benchmark::State& state, const size_t n_nodes, const size_t n_bytes);
+}  // namespace cfg::bench
+
+#endif  // __CFG_BENCH_UTILS_H_
@@ -0,0 +1,257 @@
+/**
+ * mesh_generator.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "mesh_generator.h"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <fstream>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace cfg::bench
+{
+  namespace
+  {
+    /**
+     * The GMSH element type of a tetrahedron and its number of nodes.
+     */
+    constexpr int tetrahedron    = 4;
+    constexpr size_t n_tet_nodes = 4;
+
+    /**
+     * The default number of elements per node.
+     */
+    constexpr size_t elements_per_node = 5;
+
+    /**
+     * Writes the values of a mesh to a stream, as text in ASCII mode or as their native
+     * representation in binary mode.
+     */
+    class MeshWriter
+    {
+     public:
+      MeshWriter(std::ostream& os, const bool binary) : os(os), binary(binary) {}
+
+      /**
+       * Writes a line of text, regardless of the mode.
+       */
+      void line(const std::string& text)
+      {
+        os << text << '\n';
+      }
+
+      /**
+       * Writes a value, in ASCII mode values on the same line are separated by a space.
+       */
+      template <class T>
+      void put(const T val)
+      {
+        if (binary)
+        {
+          // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+          os.write(reinterpret_cast<const char*>(&val), sizeof(T));
+          return;
+        }
+
+        if (!line_start)
+        {
+          os.put(' ');
+        }
+        std::array<char, 32> buf{};
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        const auto [end, ec] = std::to_chars(buf.data(), buf.data() + buf.size(), val);
+        os.write(buf.data(), end - buf.data());
+        line_start = false;
+      }
+
+      /**
+       * Ends a line of values in ASCII mode, in binary mode there are no lines.
+       */
+      void end_line()
+      {
+        if (!binary)
+        {
+          os.put('\n');
+          line_start = true;
+        }
+      }
+
+      /**
+       * Writes a section sygil, in binary mode the section data is preceded and followed by a newline.
+       */
+      void sygil(const std::string& name, const bool end)
+      {
+        if (binary && end)
+        {
+          os.put('\n');
+        }
+        os << (end ? "$End" : "$") << name << '\n';
+      }
+
+     private:
+      std::ostream& os;       // The mesh stream
+      bool binary;            // Whether the mesh is written in binary mode
+      bool line_start{true};  // Whether the next ASCII value starts a line
+    };
+
+    /**
+     * The first item of a block, when splitting items as evenly as possible over blocks.
+     */
+    [[nodiscard]] size_t block_start(const size_t block, const size_t n_items, const size_t n_blocks)
+    {
+      return (block * n_items) / n_blocks;
+    }
+
+    /**
+     * Determines the tag of each node, in file order.
+     */
+    [[nodiscard]] std::vector<size_t> node_tags(const MeshSpec& spec, std::mt19937_64& gen)
+    {
+      std::vector<size_t> tags(spec.n_nodes);
+      std::iota(tags.begin(), tags.end(), size_t{1});
+      if (spec.tags == TagLayout::SHUFFLED)
+      {
+        std::shuffle(tags.begin(), tags.end(), gen);
+      }
+      else if (spec.tags == TagLayout::SPARSE)
+      {
+        std::transform(tags.begin(),
+                       tags.end(),
+                       tags.begin(),
+                       [](const size_t tag) -> size_t
+                       {
+                         return 2 * tag - 1;
+                       });
+      }
+
+      return tags;
+    }
+  }  // namespace
+
+  void write_mesh(const std::filesystem::path& mesh_file, const MeshSpec& spec)
+  {
+    if ((spec.n_nodes < n_tet_nodes) || (spec.n_blocks == 0) || (spec.n_blocks > spec.n_nodes))
+    {
+      throw std::runtime_error("A synthetic mesh requires at least four nodes and one node per block");
+    }
+    const auto n_elements = (spec.n_elements == 0) ? elements_per_node * spec.n_nodes : spec.n_elements;
+    if (spec.n_blocks > n_elements)
+    {
+      throw std::runtime_error("A synthetic mesh requires at least one element per block");
+    }
+
+    std::ofstream os{mesh_file, std::ios::out | std::ios::binary | std::ios::trunc};
+    if (!os)
+    {
+      throw std::runtime_error("Couldn't open " + mesh_file.string() + " for writing");
+    }
+    MeshWriter writer{os, spec.binary};
+
+    std::mt19937_64 gen{spec.seed};
+    const auto tags = node_tags(spec, gen);
+
+    // Header, a binary file records the value 1 to detect its byte order
+    writer.sygil("MeshFormat", false);
+    writer.line(spec.binary ? "4.1 1 8" : "4.1 0 8");
+    if (spec.binary)
+    {
+      writer.put<int>(1);
+      os.put('\n');
+    }
+    writer.sygil("MeshFormat", true);
+
+    // Nodes, each block lists its node tags followed by their coordinates
+    writer.sygil("Nodes", false);
+    writer.put<size_t>(spec.n_blocks);
+    writer.put<size_t>(spec.n_nodes);
+    writer.put<size_t>(*std::min_element(tags.begin(), tags.end()));
+    writer.put<size_t>(*std::max_element(tags.begin(), tags.end()));
+    writer.end_line();
+
+    std::uniform_real_distribution<double> coordinate{0.0, 1.0};
+    for (size_t block = 0; block < spec.n_blocks; block++)
+    {
+      const auto first = block_start(block, spec.n_nodes, spec.n_blocks);
+      const auto last  = block_start(block + 1, spec.n_nodes, spec.n_blocks);
+
+      writer.put<int>(3);                            // Entity dimension
+      writer.put<int>(static_cast<int>(block + 1));  // Entity tag
+      writer.put<int>(0);                            // Not parametric
+      writer.put<size_t>(last - first);
+      writer.end_line();
+      for (auto node = first; node < last; node++)
+      {
+        writer.put<size_t>(tags[node]);
+        writer.end_line();
+      }
+      for (auto node = first; node < last; node++)
+      {
+        writer.put<double>(coordinate(gen));
+        writer.put<double>(coordinate(gen));
+        writer.put<double>(coordinate(gen));
+        writer.end_line();
+      }
+    }
+    writer.sygil("Nodes", true);
+
+    // Elements, tetrahedra over consecutive nodes in file order
+    writer.sygil("Elements", false);
+    writer.put<size_t>(spec.n_blocks);
+    writer.put<size_t>(n_elements);
+    writer.put<size_t>(1);
+    writer.put<size_t>(n_elements);
+    writer.end_line();
+
+    for (size_t block = 0; block < spec.n_blocks; block++)
+    {
+      const auto first = block_start(block, n_elements, spec.n_blocks);
+      const auto last  = block_start(block + 1, n_elements, spec.n_blocks);
+
+      writer.put<int>(3);                            // Entity dimension
+      writer.put<int>(static_cast<int>(block + 1));  // Entity tag
+      writer.put<int>(tetrahedron);
+      writer.put<size_t>(last - first);
+      writer.end_line();
+      for (auto element = first; element < last; element++)
+      {
+        writer.put<size_t>(element + 1);
+        for (size_t i = 0; i < n_tet_nodes; i++)
+        {
+          writer.put<size_t>(tags[(element + i) % spec.n_nodes]);
+        }
+        writer.end_line();
+      }
+    }
+    writer.sygil("Elements", true);
+
+    if (!os)
+    {
+      throw std::runtime_error("Failed to write " + mesh_file.string());
+    }
+  }
+
+  TagLayout tag_layout(const std::string& name)
+  {
+    if (name == "contiguous")
+    {
+      return TagLayout::CONTIGUOUS;
+    }
+    if (name == "shuffled")
+    {
+      return TagLayout::SHUFFLED;
+    }
+    if (name == "sparse")
+    {
+      return TagLayout::SPARSE;
+    }
+
+    throw std::runtime_error("Unknown tag layout: " + name);
+  }
+}  // namespace cfg::bench
@@ -0,0 +1,61 @@
+/**
+ * mesh_generator.h
+ *
+ * Writes synthetic GMSH 4.1 meshes for benchmarking, so that meshes of any size can be produced
+ * without the `gmsh` binary.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef __CFG_MESH_GENERATOR_H_
+#define __CFG_MESH_GENERATOR_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+namespace cfg::bench
+{
+  /**
+   * Identifies how the node tags are laid out in the file.
+   */
+  enum class TagLayout
+  {
+    CONTIGUOUS,  ///< Tags `1..n` in file order.
+    SHUFFLED,    ///< A permutation of the tags `1..n`, the tag range is contiguous but unordered.
+    SPARSE       ///< The odd tags `1, 3, ..., 2n - 1` in file order, leaving holes in the tag range.
+  };
+
+  /**
+   * Describes a synthetic mesh.
+   *
+   * The nodes are placed uniformly at random in the unit cube and split as evenly as possible over
+   * the node blocks. Each element is a tetrahedron over four nodes, the elements are split over the
+   * same number of blocks as the nodes.
+   */
+  struct MeshSpec
+  {
+    size_t n_nodes{1000};                   ///< The number of nodes.
+    size_t n_elements{0};                   ///< The number of elements, by default five per node.
+    size_t n_blocks{1};                     ///< The number of node and element blocks.
+    TagLayout tags{TagLayout::CONTIGUOUS};  ///< The layout of the node tags.
+    bool binary{false};                     ///< Whether the mesh is written in binary mode.
+    uint64_t seed{42};                      ///< The seed of the random node coordinates.
+  };
+
+  /**
+   * Writes a synthetic GMSH 4.1 mesh, raising an error if the file cannot be written.
+   *
+   * @param mesh_file The path of the mesh file.
+   * @param spec      The description of the mesh.
+   */
+  void write_mesh(const std::filesystem::path& mesh_file, const MeshSpec& spec);
+
+  /**
+   * Parses a tag layout by name, `contiguous`, `shuffled` or `sparse`, raising an error if the name
+   * is unknown.
+   */
+  [[nodiscard]] TagLayout tag_layout(const std::string& name);
+}  // namespace cfg::bench
+
+#endif  // __CFG_MESH_GENERATOR_H_
@@ -0,0 +1,74 @@
+/**
+ * meshgen.cpp
+ *
+ * Writes a synthetic GMSH 4.1 mesh, e.g. to benchmark `cfgrid` on meshes of a given size:
+ *
+ *     cfgrid_meshgen mesh.msh --nodes=1000000 --blocks=64 --tags=shuffled --binary
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <sysexits.h>
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "mesh_generator.h"
+
+int main(int argc, char* argv[])
+{
+  try
+  {
+    if (argc < 2)
+    {
+      throw std::runtime_error(
+          "Usage: cfgrid_meshgen <mesh> [--nodes=<n>] [--elements=<n>] [--blocks=<n>] "
+          "[--tags=contiguous|shuffled|sparse] [--binary] [--seed=<n>]");
+    }
+
+    cfg::bench::MeshSpec spec;
+    for (int i = 2; i < argc; i++)
+    {
+      const std::string arg{argv[i]};  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      const auto value = arg.substr(arg.find('=') + 1);
+      if (arg.rfind("--nodes=", 0) == 0)
+      {
+        spec.n_nodes = std::stoul(value);
+      }
+      else if (arg.rfind("--elements=", 0) == 0)
+      {
+        spec.n_elements = std::stoul(value);
+      }
+      else if (arg.rfind("--blocks=", 0) == 0)
+      {
+        spec.n_blocks = std::stoul(value);
+      }
+      else if (arg.rfind("--tags=", 0) == 0)
+      {
+        spec.tags = cfg::bench::tag_layout(value);
+      }
+      else if (arg == "--binary")
+      {
+        spec.binary = true;
+      }
+      else if (arg.rfind("--seed=", 0) == 0)
+      {
+        spec.seed = std::stoull(value);
+      }
+      else
+      {
+        throw std::runtime_error("Unknown argument: " + arg);
+      }
+    }
+
+    cfg::bench::write_mesh(argv[1], spec);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+  }
+  catch (const std::exception& e)
+  {
+    std::cerr << e.what() << std::endl;
+    return EX_USAGE;
+  }
+
+  return 0;
+}
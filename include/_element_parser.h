@@ -0,0 +1,474 @@
+/**
+ * _element_parser.h
+ *
+ * Internal components of the element_parser module.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef __CFG__ELEMENT_PARSER_H_
+#define __CFG__ELEMENT_PARSER_H_
+
+#include <algorithm>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <element_parser.h>
+#include <node_parser.h>
+#include <utils.h>
+
+namespace cfg::parser
+{
+  /**
+   * Container for the relevant information from the header of the Elements section in a GMSH file.
+   */
+  struct ElementHeader
+  {
+    size_t n_elements;  ///< The number of elements in the mesh
+    size_t n_blocks;    ///< The number of element blocks in the mesh
+    size_t min_tag;     ///< The minimum element index
+    size_t max_tag;     ///< The maximum element index
+  };
+
+  /**
+   * Parses the data header of the Elements segment in a GMSH file: the number of blocks of elements
+   * to read and the global description of the elements in the mesh.
+   */
+  class ElementHeaderParser
+  {
+   public:
+    /**
+     * Parses the header of the Elements Section of a GMSH file of a given encoding.
+     *
+     * @param element_reader The element reader object for the mesh.
+     * @param mesh_stream    The mesh data stream.
+     * @returns The global element description header.
+     */
+    template <class E, class S>
+    [[nodiscard]] static ElementHeader parse(const cfg::reader::SectionReader& element_reader, S& mesh_stream)
+    {
+      const auto start = mark_position(mesh_stream);
+      if constexpr (E::mode == Mode::BINARY)
+      {
+        mesh_stream.ignore(1);  // Skip spare char
+      }
+
+      ElementHeader element_header{};
+      element_header.n_blocks   = read_one<size_t, E>(element_reader, mesh_stream);
+      element_header.n_elements = read_one<size_t, E>(element_reader, mesh_stream);
+      element_header.min_tag    = read_one<size_t, E>(element_reader, mesh_stream);
+      element_header.max_tag    = read_one<size_t, E>(element_reader, mesh_stream);
+      count_bytes_read(mesh_stream, start);
+
+      return element_header;
+    }
+
+    /**
+     * Parses the header of the Elements Section of a GMSH file.
+     *
+     * @param element_reader The element reader object for the mesh.
+     * @param mesh_stream    The mesh data stream.
+     * @param mode           Indicates the data mode of the mesh stream, currently either ASCII or BINARY.
+     * @returns The global element description header.
+     */
+    template <class S>
+    [[nodiscard]] static ElementHeader parse(const cfg::reader::SectionReader& element_reader,
+                                             S& mesh_stream,
+                                             const Mode mode)
+    {
+      return with_encoding(mode,
+                           [&element_reader, &mesh_stream](auto encoding) -> ElementHeader
+                           {
+                             return parse<decltype(encoding)>(element_reader, mesh_stream);
+                           });
+    }
+  };
+
+  /**
+   * Describes the layout of a block of elements in a GMSH file.
+   */
+  struct ElementBlock
+  {
+    int dim;            ///< The dimension of the entity the block belongs to
+    int tag;            ///< The tag of the entity the block belongs to
+    int type;           ///< The GMSH type of the block's elements
+    size_t n_elements;  ///< The number of elements in the block
+    size_t first;       ///< The global index of the first element in the block
+    size_t offset;      ///< The byte offset of the element records in the mesh file
+  };
+
+  /**
+   * Describes the layout of the element data of a GMSH file, as recorded by a mesh index.
+   */
+  struct ElementLayout
+  {
+    std::vector<ElementBlock> blocks;  ///< The layout of each element block
+    size_t end{};                      ///< The byte offset following the last element block
+  };
+
+  /**
+   * Describes the environment for the element DataParser.
+   */
+  struct ElementEnvironment
+  {
+    const utils::Parallel& parallel;       ///< The parallel environment.
+    const ElementLayout* layout{nullptr};  ///< The element data layout, if known from an index.
+  };
+
+  /**
+   * Scans the block headers of the Elements section of a GMSH file, skipping over the element data.
+   * The stream should be positioned at the first block header.
+   *
+   * In BINARY mode each element of a block has the same size and the data is skipped by seeking, in
+   * ASCII mode each element occupies a line and the data is skipped line by line.
+   *
+   * @tparam E             The encoding of the mesh file.
+   * @param element_reader The element reader object for the mesh.
+   * @param mesh_stream    The mesh data stream.
+   * @param element_header The global element description header.
+   * @returns The layout of the element data.
+   */
+  template <class E, class S>
+  [[nodiscard]] ElementLayout scan_element_layout(const cfg::reader::SectionReader& element_reader,
+                                                  S& mesh_stream,
+                                                  const ElementHeader& element_header)
+  {
+    ElementLayout layout;
+    layout.blocks.resize(element_header.n_blocks);
+
+    size_t first = 0;
+    for (auto& block : layout.blocks)
+    {
+      const auto start = mark_position(mesh_stream);
+      block.dim        = read_one<int, E>(element_reader, mesh_stream);
+      block.tag        = read_one<int, E>(element_reader, mesh_stream);
+      block.type       = read_one<int, E>(element_reader, mesh_stream);
+      block.n_elements = read_one<size_t, E>(element_reader, mesh_stream);
+      block.first      = first;
+
+      if constexpr (E::mode == Mode::BINARY)
+      {
+        // Only the block header is read, the element records are seeked over
+        count_bytes_read(mesh_stream, start);
+        block.offset            = static_cast<size_t>(std::streamoff(mesh_stream.tellg()));
+        const auto record_bytes = (1 + element_type(block.type).n_nodes) * sizeof(typename E::index_type);
+        mesh_stream.seekg(static_cast<std::streamoff>(block.offset + block.n_elements * record_bytes));
+      }
+      else
+      {
+        skip_lines(mesh_stream, 1);  // The remainder of the block header
+        block.offset = static_cast<size_t>(std::streamoff(mesh_stream.tellg()));
+        skip_lines(mesh_stream, block.n_elements);
+        count_bytes_read(mesh_stream, start);
+      }
+
+      first += block.n_elements;
+    }
+    layout.end = static_cast<size_t>(std::streamoff(mesh_stream.tellg()));
+
+    return layout;
+  }
+
+  /**
+   * Scans the block headers of the Elements section of a GMSH file in either mode, skipping over the
+   * element data, see `scan_element_layout` for an encoding.
+   *
+   * @param element_reader The element reader object for the mesh.
+   * @param mesh_stream    The mesh data stream.
+   * @param mode           Indicates the data mode of the mesh stream, currently either ASCII or BINARY.
+   * @param element_header The global element description header.
+   * @returns The layout of the element data.
+   */
+  template <class S>
+  [[nodiscard]] ElementLayout scan_element_layout(const cfg::reader::SectionReader& element_reader,
+                                                  S& mesh_stream,
+                                                  const Mode mode,
+                                                  const ElementHeader& element_header)
+  {
+    return with_encoding(mode,
+                         [&element_reader, &mesh_stream, &element_header](auto encoding) -> ElementLayout
+                         {
+                           return scan_element_layout<decltype(encoding)>(element_reader, mesh_stream, element_header);
+                         });
+  }
+
+  /**
+   * Parses each block of elements, keeping the elements in this rank's partition.
+   */
+  class ElementDataParser
+  {
+   public:
+    /**
+     * Parses the element data blocks.
+     *
+     * The elements are partitioned over their global index, i.e. the order in which they appear in
+     * the file. In BINARY mode each element of a block has the same size, blocks and elements outside
+     * the partition are skipped over rather than read.
+     *
+     * @tparam E             The encoding of the mesh file.
+     * @param element_reader The element reader object for the mesh.
+     * @param mesh_stream    The mesh data stream.
+     * @param element_header The global element description header.
+     * @param environment    Contains the calling environment, in particular passes the Parallel field
+     * @returns The element set.
+     */
+    template <class E, class S>
+    [[nodiscard]] static ElementSet parse(const cfg::reader::SectionReader& element_reader,
+                                          S& mesh_stream,
+                                          const ElementHeader& element_header,
+                                          const ElementEnvironment& environment)
+    {
+      if (environment.layout != nullptr)
+      {
+        return parse_indexed<E>(mesh_stream, element_header, environment);
+      }
+
+      const utils::NaivePartition partition{environment.parallel, element_header.n_elements};
+      const auto local_start = partition.start();
+      const auto local_end   = partition.start() + partition.size();
+
+      ElementSet elements;
+      elements.reserve(partition.size());
+
+      // Each element is stored as its tag followed by its node tags, the buffer is reused across blocks
+      std::vector<size_t> records;
+
+      size_t ctr = 0;  // Global index of the first element of the block
+      for (size_t block = 0; block < element_header.n_blocks; block++)
+      {
+        const auto header_start = mark_position(mesh_stream);
+        const auto [block_dim, block_tag, block_type, block_elements] =
+            parse_element_block_header<E>(element_reader, mesh_stream);
+        const auto [type_dim, n_nodes] = element_type(block_type);
+        if (type_dim != block_dim)
+        {
+          throw std::runtime_error("Element type " + std::to_string(block_type) +
+                                   " does not match the dimension of its block");
+        }
+
+        const auto record_size = 1 + n_nodes;
+        const auto start       = std::max(ctr, local_start);
+        const auto end         = std::min(ctr + block_elements, local_end);
+
+        size_t first = ctr;  // Global index of the first element in the records buffer
+        if constexpr (E::mode == Mode::BINARY)
+        {
+          // Read only the partition's elements, then move to the end of the block
+          count_bytes_read(mesh_stream, header_start);
+          const auto block_pos    = static_cast<std::streamoff>(mesh_stream.tellg());
+          const auto record_bytes = static_cast<std::streamoff>(record_size * sizeof(typename E::index_type));
+          if (start < end)
+          {
+            const auto records_start = block_pos + static_cast<std::streamoff>(start - ctr) * record_bytes;
+            mesh_stream.seekg(records_start);
+            read_block<E>(mesh_stream, (end - start) * record_size, records);
+            count_bytes_read(mesh_stream, records_start);
+            first = start;
+          }
+          mesh_stream.seekg(block_pos + static_cast<std::streamoff>(block_elements) * record_bytes);
+        }
+        else
+        {
+          read_block<E>(mesh_stream, block_elements * record_size, records);
+          count_bytes_read(mesh_stream, header_start);
+        }
+
+        const cfg::utils::ScopedTimer timer{cfg::utils::Phase::PARTITION_FILTER};
+        for (auto global_idx = start; global_idx < end; global_idx++)
+        {
+          const auto record = records.begin() + static_cast<std::ptrdiff_t>((global_idx - first) * record_size);
+          const auto last   = record + static_cast<std::ptrdiff_t>(record_size);
+          elements.push_back(*record, global_idx, block_type, record + 1, last);
+        }
+
+        ctr += block_elements;
+      }
+      cfg::utils::count(cfg::utils::Counter::BLOCKS, element_header.n_blocks);
+
+      return elements;
+    }
+
+    /**
+     * Parses the element data blocks, see `parse` for an encoding.
+     *
+     * @param element_reader The element reader object for the mesh.
+     * @param mesh_stream    The mesh data stream.
+     * @param mode           Indicates the data mode of the mesh stream, currently either ASCII or BINARY.
+     * @param element_header The global element description header.
+     * @param environment    Contains the calling environment, in particular passes the Parallel field
+     * @returns The element set.
+     */
+    template <class S>
+    [[nodiscard]] static ElementSet parse(const cfg::reader::SectionReader& element_reader,
+                                          S& mesh_stream,
+                                          const Mode mode,
+                                          const ElementHeader& element_header,
+                                          const ElementEnvironment& environment)
+    {
+      return with_encoding(mode,
+                           [&](auto encoding) -> ElementSet
+                           {
+                             return parse<decltype(encoding)>(element_reader, mesh_stream, element_header, environment);
+                           });
+    }
+
+   private:
+    /**
+     * Reads only the element blocks belonging to this rank's partition, located by the element data
+     * layout recorded in a mesh index, so that the block headers are not read. In BINARY mode only
+     * the partition's elements are read, in ASCII mode the blocks containing them are read from their start.
+     *
+     * @tparam E             The encoding of the mesh file.
+     * @param mesh_stream    The mesh data stream.
+     * @param element_header The global element description header.
+     * @param environment    Contains the calling environment, in particular the element data layout.
+     * @returns The element set.
+     */
+    template <class E, class S>
+    [[nodiscard]] static ElementSet parse_indexed(S& mesh_stream,
+                                                  const ElementHeader& element_header,
+                                                  const ElementEnvironment& environment)
+    {
+      const utils::NaivePartition partition{environment.parallel, element_header.n_elements};
+      const auto local_start = partition.start();
+      const auto local_end   = partition.start() + partition.size();
+
+      ElementSet elements;
+      elements.reserve(partition.size());
+
+      // Each element is stored as its tag followed by its node tags, the buffer is reused across blocks
+      std::vector<size_t> records;
+
+      for (const auto& block : environment.layout->blocks)
+      {
+        // Blocks are in global index order, skip until we reach the partition and stop after it
+        const auto start = std::max(block.first, local_start);
+        const auto end   = std::min(block.first + block.n_elements, local_end);
+        if (block.first >= local_end)
+        {
+          break;
+        }
+        if (start >= end)
+        {
+          continue;
+        }
+
+        const auto record_size  = 1 + element_type(block.type).n_nodes;
+        const auto record_bytes = record_size * sizeof(typename E::index_type);
+
+        // ASCII blocks can only be read from their start
+        const auto first = (E::mode == Mode::BINARY) ? start : block.first;
+        mesh_stream.clear();
+        const auto records_start = static_cast<std::streamoff>(block.offset + (first - block.first) * record_bytes);
+        mesh_stream.seekg(records_start);
+        read_block<E>(mesh_stream, (end - first) * record_size, records);
+        count_bytes_read(mesh_stream, records_start);
+        cfg::utils::count(cfg::utils::Counter::BLOCKS, 1);
+
+        const cfg::utils::ScopedTimer timer{cfg::utils::Phase::PARTITION_FILTER};
+        for (auto global_idx = start; global_idx < end; global_idx++)
+        {
+          const auto record = records.begin() + static_cast<std::ptrdiff_t>((global_idx - first) * record_size);
+          const auto last   = record + static_cast<std::ptrdiff_t>(record_size);
+          elements.push_back(*record, global_idx, block.type, record + 1, last);
+        }
+      }
+
+      // Leave the stream at the end of the element data
+      mesh_stream.clear();
+      mesh_stream.seekg(static_cast<std::streamoff>(environment.layout->end));
+
+      return elements;
+    }
+
+    /**
+     * Parses the data header of an element block in a GMSH file.
+     *
+     * @tparam E             The encoding of the mesh file.
+     * @param element_reader The element reader object for the mesh.
+     * @param mesh_stream    The mesh data stream.
+     * @returns A tuple of the block dimension, block tag, element type and the number of elements in
+     *          the block.
+     */
+    template <class E, class S>
+    [[nodiscard]] static std::tuple<int, int, int, size_t> parse_element_block_header(
+        const cfg::reader::SectionReader& element_reader, S& mesh_stream)
+    {
+      const auto block_dim      = read_one<int, E>(element_reader, mesh_stream);
+      const auto block_tag      = read_one<int, E>(element_reader, mesh_stream);
+      const auto block_type     = read_one<int, E>(element_reader, mesh_stream);
+      const auto block_elements = read_one<size_t, E>(element_reader, mesh_stream);
+
+      return {block_dim, block_tag, block_type, block_elements};
+    }
+  };
+
+  /**
+   * Performs validation of the element data that was read, raising an error if this fails.
+   *
+   * @param elements       The set of elements.
+   * @param element_header The global description of the elements in the mesh that is used to test
+   *                       the data.
+   * @param parallel       The parallel configuration object.
+   */
+  void validate_elements(const ElementSet& elements,
+                         const ElementHeader& element_header,
+                         const cfg::utils::Parallel& parallel);
+
+  /**
+   * Validates the elements read by `read_X`, see `validate_elements`.
+   */
+  class ElementValidator
+  {
+   public:
+    /**
+     * Constructs an element validator.
+     *
+     * @param parallel The parallel environment, which must outlive the validator.
+     */
+    explicit ElementValidator(const utils::Parallel& parallel) : parallel{parallel} {}
+
+    /**
+     * Validates the elements, raising an error if this fails.
+     */
+    void validate(const ElementSet& elements, const ElementHeader& element_header) const
+    {
+      validate_elements(elements, element_header, parallel);
+    }
+
+   private:
+    const utils::Parallel& parallel;  // The parallel environment
+  };
+
+  /**
+   * Utility to construct an element reader, which dispatches on the mode of the mesh file once per
+   * call and expects its `size_t` values to be of the native width.
+   *
+   * Element readers are available for `std::istream` and `cfg::reader::MappedStream` stream types.
+   *
+   * @param parallel The parallel environment.
+   * @returns A function to read elements from a GMSH file.
+   */
+  template <class S>
+  std::function<ElementSet(const cfg::reader::SectionReader&, S&, const Mode)> make_element_reader(
+      const cfg::utils::Parallel& parallel);
+
+  /**
+   * Utility to construct an element reader from the Elements section header and element data layout
+   * recorded by a mesh index, the header is not parsed and only this rank's element blocks are read.
+   *
+   * Element readers are available for `std::istream` and `cfg::reader::MappedStream` stream types.
+   *
+   * @param parallel       The parallel environment.
+   * @param element_header The global element description header.
+   * @param layout         The element data layout, which must outlive the reader.
+   * @returns A function to read elements from a GMSH file.
+   */
+  template <class S>
+  std::function<ElementSet(const cfg::reader::SectionReader&, S&, const Mode)> make_indexed_element_reader(
+      const cfg::utils::Parallel& parallel, const ElementHeader& element_header, const ElementLayout& layout);
+}  // namespace cfg::parser
+
+#endif  // __CFG__ELEMENT_PARSER_H_
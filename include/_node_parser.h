@@ -8,11 +8,24 @@
 #ifndef __CFG__NODE_PARSER_H_
 #define __CFG__NODE_PARSER_H_
 
+#include <algorithm>
 #include <fstream>
+#include <array>
+#include <cstring>
 #include <functional>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <tuple>
+#include <type_traits>
 #include <vector>
 
 #include <node_parser.h>
+#include <node_set.h>
+#include <number_parser.h>
+#include <thread_utils.h>
 #include <utils.h>
 
 namespace cfg::parser
@@ -36,35 +49,91 @@ namespace cfg::parser
   {
    public:
     /**
-     * Parses the header of the Node Section of a GMSH file.
+     * Parses the header of the Node Section of a GMSH file of a given encoding.
      *
      * @param node_reader The node reader object for the mesh.
      * @param mesh_stream The mesh data stream.
-     * @param mode        Indicates the data mode of the mesh stream, currently either ASCII or BINARY.
      * @returns The global node description header.
      */
-    [[nodiscard]] static auto parse(const cfg::reader::SectionReader& node_reader,
-                                    std::istream& mesh_stream,
-                                    const Mode mode)
+    template <class E, class S>
+    [[nodiscard]] static NodeHeader parse(const cfg::reader::SectionReader& node_reader, S& mesh_stream)
     {
-      if (mode == Mode::BINARY)
+      const auto start = mark_position(mesh_stream);
+      if constexpr (E::mode == Mode::BINARY)
       {
         mesh_stream.ignore(1);  // Skip spare char
       }
-      const auto node_header = [&node_reader, &mesh_stream, mode]() -> NodeHeader
-      {
-        NodeHeader node_header{};
 
-        node_header.n_blocks = read_one<size_t>(node_reader, mesh_stream, mode);
-        node_header.n_nodes  = read_one<size_t>(node_reader, mesh_stream, mode);
-        node_header.min_tag  = read_one<size_t>(node_reader, mesh_stream, mode);
-        node_header.max_tag  = read_one<size_t>(node_reader, mesh_stream, mode);
-
-        return node_header;
-      }();
+      NodeHeader node_header{};
+      node_header.n_blocks = read_one<size_t, E>(node_reader, mesh_stream);
+      node_header.n_nodes  = read_one<size_t, E>(node_reader, mesh_stream);
+      node_header.min_tag  = read_one<size_t, E>(node_reader, mesh_stream);
+      node_header.max_tag  = read_one<size_t, E>(node_reader, mesh_stream);
+      count_bytes_read(mesh_stream, start);
 
       return node_header;
     }
+
+    /**
+     * Parses the header of the Node Section of a GMSH file.
+     *
+     * @param node_reader The node reader object for the mesh.
+     * @param mesh_stream The mesh data stream.
+     * @param mode        Indicates the data mode of the mesh stream, currently either ASCII or BINARY.
+     * @returns The global node description header.
+     */
+    template <class S>
+    [[nodiscard]] static NodeHeader parse(const cfg::reader::SectionReader& node_reader,
+                                          S& mesh_stream,
+                                          const Mode mode)
+    {
+      return with_encoding(mode,
+                           [&node_reader, &mesh_stream](auto encoding) -> NodeHeader
+                           {
+                             return parse<decltype(encoding)>(node_reader, mesh_stream);
+                           });
+    }
+  };
+
+  /**
+   * Identifies how the node DataParser reads the node blocks.
+   */
+  enum class ReadStrategy
+  {
+    FULL,  ///< Every rank parses every node block, keeping the nodes in its partition.
+    LOCAL  ///< Each rank scans the block headers and seeks directly to its nodes (BINARY mode only).
+  };
+
+  /**
+   * Describes the layout of a block of nodes in a GMSH file.
+   */
+  struct NodeBlock
+  {
+    int dim;               ///< The dimension of the entity the block belongs to
+    int tag;               ///< The tag of the entity the block belongs to
+    bool parametric;       ///< Flag indicating whether the block stores parametric coordinates
+    size_t n_nodes;        ///< The number of nodes in the block
+    size_t first;          ///< The global index of the first node in the block
+    size_t tags_offset;    ///< The byte offset of the node tags in the mesh file
+    size_t coords_offset;  ///< The byte offset of the node coordinates in the mesh file
+
+    /**
+     * Returns the number of values stored per node in the coordinate array, parametric blocks store
+     * an additional `dim` values per node following the physical coordinates.
+     */
+    [[nodiscard]] size_t n_components() const
+    {
+      return 3 + (parametric ? static_cast<size_t>(dim) : 0);
+    }
+  };
+
+  /**
+   * Describes the layout of the node data of a GMSH file, as recorded by a mesh index.
+   */
+  struct NodeLayout
+  {
+    std::vector<NodeBlock> blocks;  ///< The layout of each node block
+    size_t end{};                   ///< The byte offset following the last node block
   };
 
   /**
@@ -72,183 +141,980 @@ namespace cfg::parser
    */
   struct NodeEnvironment
   {
-    const utils::Parallel& parallel;  ///< The parallel environment.
+    const utils::Parallel& parallel;              ///< The parallel environment.
+    ReadStrategy strategy{ReadStrategy::LOCAL};  ///< How to read the node blocks.
+    const NodeLayout* layout{nullptr};           ///< The node data layout, if known from an index.
+  };
+
+  /**
+   * Describes a contiguous range of nodes within a node block.
+   */
+  struct NodeRange
+  {
+    size_t block;   ///< The index of the block containing the range
+    size_t offset;  ///< The offset of the first node of the range within the block
+    size_t count;   ///< The number of nodes in the range
   };
 
   /**
-   * Parses each block of nodes.
+   * Scans the block headers of the Nodes section of a binary GMSH file, skipping over the node data.
+   * The stream should be positioned at the first block header, on return it is positioned after the
+   * last node block.
+   *
+   * @tparam E          The encoding of the mesh file, in BINARY mode.
+   * @param node_reader The node reader object for the mesh.
+   * @param mesh_stream The mesh data stream.
+   * @param node_header The global node description header.
+   * @returns The layout of each node block.
    */
-  class DataParser
+  template <class E = BinaryEncoding, class S>
+  [[nodiscard]] std::vector<NodeBlock> scan_node_blocks(const cfg::reader::SectionReader& node_reader,
+                                                        S& mesh_stream,
+                                                        const NodeHeader& node_header)
+  {
+    static_assert(E::mode == Mode::BINARY, "Only binary node blocks can be scanned by seeking");
+    using I = typename E::index_type;
+    using R = typename E::real_type;
+
+    std::vector<NodeBlock> blocks(node_header.n_blocks);
+
+    size_t first = 0;
+    for (auto& block : blocks)
+    {
+      // Only the block header is read, the node data is seeked over
+      const auto start = mark_position(mesh_stream);
+      block.dim        = read_one<int, E>(node_reader, mesh_stream);
+      block.tag        = read_one<int, E>(node_reader, mesh_stream);
+      block.parametric = static_cast<bool>(read_one<int, E>(node_reader, mesh_stream));
+      block.n_nodes    = read_one<size_t, E>(node_reader, mesh_stream);
+      block.first      = first;
+      count_bytes_read(mesh_stream, start);
+
+      block.tags_offset   = static_cast<size_t>(std::streamoff(mesh_stream.tellg()));
+      block.coords_offset = block.tags_offset + block.n_nodes * sizeof(I);
+      const auto next     = block.coords_offset + block.n_nodes * block.n_components() * sizeof(R);
+      mesh_stream.seekg(static_cast<std::streamoff>(next));
+
+      first += block.n_nodes;
+    }
+
+    return blocks;
+  }
+
+  /**
+   * Scans the block headers of the Nodes section of a GMSH file of a given encoding, skipping over
+   * the node data. The stream should be positioned at the first block header.
+   *
+   * In ASCII mode each node tag and each node's coordinates occupy a line, so the node data is
+   * skipped line by line and only whole blocks can be located.
+   *
+   * @tparam E          The encoding of the mesh file.
+   * @param node_reader The node reader object for the mesh.
+   * @param mesh_stream The mesh data stream.
+   * @param node_header The global node description header.
+   * @returns The layout of the node data.
+   */
+  template <class E, class S>
+  [[nodiscard]] NodeLayout scan_node_layout(const cfg::reader::SectionReader& node_reader,
+                                            S& mesh_stream,
+                                            const NodeHeader& node_header)
+  {
+    NodeLayout layout;
+    if constexpr (E::mode == Mode::BINARY)
+    {
+      layout.blocks = scan_node_blocks<E>(node_reader, mesh_stream, node_header);
+    }
+    else
+    {
+      // Every line of the node data is read to skip it
+      const auto start = mark_position(mesh_stream);
+      layout.blocks.resize(node_header.n_blocks);
+
+      size_t first = 0;
+      for (auto& block : layout.blocks)
+      {
+        block.dim        = read_one<int, E>(node_reader, mesh_stream);
+        block.tag        = read_one<int, E>(node_reader, mesh_stream);
+        block.parametric = static_cast<bool>(read_one<int, E>(node_reader, mesh_stream));
+        block.n_nodes    = read_one<size_t, E>(node_reader, mesh_stream);
+        block.first      = first;
+        skip_lines(mesh_stream, 1);  // The remainder of the block header
+
+        block.tags_offset = static_cast<size_t>(std::streamoff(mesh_stream.tellg()));
+        skip_lines(mesh_stream, block.n_nodes);
+        block.coords_offset = static_cast<size_t>(std::streamoff(mesh_stream.tellg()));
+        skip_lines(mesh_stream, block.n_nodes);
+
+        first += block.n_nodes;
+      }
+      count_bytes_read(mesh_stream, start);
+    }
+    layout.end = static_cast<size_t>(std::streamoff(mesh_stream.tellg()));
+
+    return layout;
+  }
+
+  /**
+   * Scans the block headers of the Nodes section of a GMSH file in either mode, skipping over the
+   * node data, see `scan_node_layout` for an encoding.
+   *
+   * @param node_reader The node reader object for the mesh.
+   * @param mesh_stream The mesh data stream.
+   * @param mode        Indicates the data mode of the mesh stream, currently either ASCII or BINARY.
+   * @param node_header The global node description header.
+   * @returns The layout of the node data.
+   */
+  template <class S>
+  [[nodiscard]] NodeLayout scan_node_layout(const cfg::reader::SectionReader& node_reader,
+                                            S& mesh_stream,
+                                            const Mode mode,
+                                            const NodeHeader& node_header)
+  {
+    return with_encoding(mode,
+                         [&node_reader, &mesh_stream, &node_header](auto encoding) -> NodeLayout
+                         {
+                           return scan_node_layout<decltype(encoding)>(node_reader, mesh_stream, node_header);
+                         });
+  }
+
+  /**
+   * Determines the ranges of nodes within each block that belong to a partition, the partition is
+   * over the global node index, i.e. the order in which nodes appear in the file.
+   *
+   * @param blocks    The layout of the node blocks.
+   * @param partition The partition of the nodes.
+   * @returns The node ranges, in file order.
+   */
+  [[nodiscard]] std::vector<NodeRange> local_node_ranges(const std::vector<NodeBlock>& blocks,
+                                                         const utils::NaivePartition& partition);
+
+  /**
+   * Locates the lines of a span of bytes, a line starts at the beginning of the bytes or following a
+   * newline. The bytes are split into chunks whose newlines are counted in parallel, only the count of
+   * each chunk is kept, so a line is located by scanning the chunk holding it.
+   */
+  class LineIndex
   {
    public:
+    static constexpr size_t default_chunk_size = size_t{1} << 16U;  ///< The default chunk size in bytes.
+
     /**
-     * Parses a node data block.
+     * Indexes the lines of a span of bytes.
+     *
+     * @param bytes      The bytes, which must outlive the index.
+     * @param n_threads  The number of threads to use.
+     * @param chunk_size The size of the chunks whose newlines are counted.
+     */
+    LineIndex(const std::string_view bytes, const unsigned int n_threads, const size_t chunk_size = default_chunk_size);
+
+    /**
+     * Returns the number of lines.
+     */
+    [[nodiscard]] size_t size() const
+    {
+      return n_lines;
+    }
+
+    /**
+     * Returns the offset of the start of a line in the bytes.
      *
+     * @param line The line, less than `size()`.
+     * @returns The offset of the line.
+     */
+    [[nodiscard]] size_t line_start(const size_t line) const;
+
+   private:
+    std::string_view bytes;               // The bytes indexed
+    size_t chunk_size;                    // The size of the chunks
+    std::vector<size_t> newlines_before;  // The number of newlines before each chunk, followed by the total
+    size_t n_lines{};                     // The number of lines
+  };
+
+  /**
+   * Returns the remaining data of a section held by a memory-mapped stream, from the current stream
+   * position up to the section's end sygil.
+   *
+   * @param mesh_stream The mesh data stream, positioned within the section.
+   * @param end_sygil   The sygil ending the section, e.g. `$EndNodes`.
+   * @returns The section data, the stream is positioned at the end of the data on return.
+   */
+  [[nodiscard]] inline std::string_view section_data(cfg::reader::MappedStream& mesh_stream,
+                                                     const std::string& end_sygil)
+  {
+    const auto start = std::streamoff(mesh_stream.tellg());
+    auto data        = mesh_stream.view().substr(static_cast<size_t>(start));
+
+    const auto end = data.find(end_sygil);
+    if (end == std::string_view::npos)
+    {
+      throw std::runtime_error("Read to EOF without finding section end");
+    }
+    data = data.substr(0, end);
+
+    mesh_stream.clear();
+    mesh_stream.seekg(start + static_cast<std::streamoff>(data.size()));
+
+    return data;
+  }
+
+  /**
+   * Parses each block of nodes into a node container, either a `std::vector<Node<3>>` or a
+   * `NodeSet<3>`.
+   */
+  template <class N>
+  class BasicDataParser
+  {
+   public:
+    /**
+     * Parses a node data block of a given encoding.
+     *
+     * @tparam E          The encoding of the mesh file.
      * @param node_reader The node reader object for the mesh.
      * @param mesh_stream The mesh data stream.
-     * @param mode        Indicates the data mode of the mesh stream, currently either ASCII or BINARY.
      * @param node_header The global node description header.
      * @param environment Contains the calling environment, in particular passes the Parallel field
-     * @returns The node vector.
+     * @returns The node container.
      */
-    [[nodiscard]] static auto parse(const cfg::reader::SectionReader& node_reader,
-                                    std::istream& mesh_stream,
-                                    const Mode mode,
-                                    const NodeHeader& node_header,
-                                    const NodeEnvironment& environment)
+    template <class E, class S>
+    [[nodiscard]] static N parse(const cfg::reader::SectionReader& node_reader,
+                                 S& mesh_stream,
+                                 const NodeHeader& node_header,
+                                 const NodeEnvironment& environment)
     {
-      std::vector<Node<3>> nodes;
+      if (environment.layout != nullptr)
+      {
+        return parse_indexed<E>(mesh_stream, node_header, environment);
+      }
+      if constexpr (E::mode == Mode::BINARY)
+      {
+        if (environment.strategy == ReadStrategy::LOCAL)
+        {
+          return parse_local<E>(node_reader, mesh_stream, node_header, environment);
+        }
+      }
+      else
+      {
+        if (environment.parallel.n_threads > 1)
+        {
+          return parse_threaded(mesh_stream, node_header, environment);
+        }
+      }
 
+      // The partition's nodes are allocated once and filled in place
       const utils::NaivePartition partition{environment.parallel, node_header.n_nodes};
+      const auto local_start = partition.start();
+      const auto local_end   = partition.start() + partition.size();
+      N nodes(partition.size());
 
-      // Read nodes from each block
-      size_t ctr = 0;
+      // Block buffers are reused across blocks
+      std::vector<size_t> indices;
+      std::vector<double> coords;
+
+      // Read nodes from each block, keeping those in the partition
+      const auto data_start = mark_position(mesh_stream);
+      size_t ctr            = 0;  // Global index of the first node of the block
+      size_t filled         = 0;  // Number of nodes stored
       for (size_t block = 0; block < node_header.n_blocks; block++)
       {
         const auto [block_dim, block_tag, block_param, block_nodes] =
-            parse_node_block_header(node_reader, mesh_stream, mode);
-        const auto indices = parse_node_idx(node_reader, block_nodes, mesh_stream, mode);
-        const auto coords  = parse_node_coords(node_reader, block_nodes, mesh_stream, mode);
-        const auto _nodes  = [&partition](const std::vector<Node<3>>& nodes) -> std::vector<Node<3>>
+            parse_node_block_header<E>(node_reader, mesh_stream);
+        const auto n_components = 3 + (block_param ? static_cast<size_t>(block_dim) : 0);
+        parse_node_idx<E>(block_nodes, mesh_stream, indices);
+        parse_node_coords<E>(block_nodes, n_components, mesh_stream, coords);
+
+        const cfg::utils::ScopedTimer timer{cfg::utils::Phase::PARTITION_FILTER};
+        const auto start = std::max(ctr, local_start);
+        const auto end   = std::min(ctr + block_nodes, local_end);
+        for (auto global_idx = start; global_idx < end; global_idx++)
         {
-          std::vector<Node<3>> _nodes;
-          for (const auto n : nodes)
-          {
-            if (partition.pick(n.global_idx))
-            {
-              _nodes.push_back(n);
-            }
-          }
-          return _nodes;
-        }(assemble_nodes(indices, coords, ctr));
+          const auto i = global_idx - ctr;
+          store_node(nodes, global_idx - local_start, indices[i], global_idx, &coords[i * n_components]);
+          filled++;
+        }
 
-        // Append block's nodes to nodes
-        nodes = cfg::utils::append(nodes, _nodes.begin(), _nodes.end());
+        ctr += block_nodes;
       }
+      count_bytes_read(mesh_stream, data_start);
+      cfg::utils::count(cfg::utils::Counter::BLOCKS, node_header.n_blocks);
+
+      // If the blocks held fewer nodes than expected, only the stored nodes are returned
+      nodes.resize(filled);
 
       return nodes;
     }
 
-   private:
     /**
-     * Parses the data header of a node block in a GMSH file.
+     * Parses a node data block.
      *
      * @param node_reader The node reader object for the mesh.
      * @param mesh_stream The mesh data stream.
      * @param mode        Indicates the data mode of the mesh stream, currently either ASCII or BINARY.
-     * @returns A tuple of the block dimension, block tag, flag indicating whether the block is
-     *          parametric and the number of nodes in the block.
+     * @param node_header The global node description header.
+     * @param environment Contains the calling environment, in particular passes the Parallel field
+     * @returns The node container.
      */
-    [[nodiscard]] static std::tuple<int, int, bool, size_t> parse_node_block_header(
-        const cfg::reader::SectionReader& node_reader,
-        std::istream& mesh_stream,
-        const Mode mode) noexcept
+    template <class S>
+    [[nodiscard]] static N parse(const cfg::reader::SectionReader& node_reader,
+                                 S& mesh_stream,
+                                 const Mode mode,
+                                 const NodeHeader& node_header,
+                                 const NodeEnvironment& environment)
     {
-      const auto block_dim   = read_one<int>(node_reader, mesh_stream, mode);
-      const auto block_tag   = read_one<int>(node_reader, mesh_stream, mode);
-      const auto block_param = read_one<int>(node_reader, mesh_stream, mode);
-      const auto block_nodes = read_one<size_t>(node_reader, mesh_stream, mode);
-
-      return {block_dim, block_tag, bool{static_cast<bool>(block_param)}, block_nodes};
+      return with_encoding(mode,
+                           [&](auto encoding) -> N
+                           {
+                             return parse<decltype(encoding)>(node_reader, mesh_stream, node_header, environment);
+                           });
     }
 
+   private:
     /**
-     * Parses the indices of the nodes in a block in a GMSH file.
+     * Reads only the node blocks belonging to this rank's partition of a binary GMSH file. The block
+     * headers are scanned to locate the partition's nodes, which are then read directly.
      *
      * @param node_reader The node reader object for the mesh.
-     * @param block_nodes The number of nodes in the block.
      * @param mesh_stream The mesh data stream.
-     * @param mode        Indicates the data mode of the mesh stream, currently either ASCII or BINARY.
-     * @returns A vector of node indices.
+     * @param node_header The global node description header.
+     * @param environment Contains the calling environment, in particular passes the Parallel field
+     * @returns The node container.
      */
-    [[nodiscard]] static std::vector<size_t> parse_node_idx(const cfg::reader::SectionReader& node_reader,
-                                                            const size_t block_nodes,
-                                                            std::istream& mesh_stream,
-                                                            const Mode mode) noexcept
+    template <class E, class S>
+    [[nodiscard]] static N parse_local(const cfg::reader::SectionReader& node_reader,
+                                       S& mesh_stream,
+                                       const NodeHeader& node_header,
+                                       const NodeEnvironment& environment)
     {
-      std::vector<size_t> indices(block_nodes);
+      using I = typename E::index_type;
+      using R = typename E::real_type;
 
-      for (size_t node = 0; node < block_nodes; node++)
+      const auto blocks  = scan_node_blocks<E>(node_reader, mesh_stream, node_header);
+      const auto end_pos = mesh_stream.tellg();
+
+      const utils::NaivePartition partition{environment.parallel, node_header.n_nodes};
+
+      // Range buffers are reused across ranges
+      std::vector<size_t> indices;
+      std::vector<double> coords;
+
+      N nodes(partition.size());
+      size_t node = 0;
+      const auto ranges = local_node_ranges(blocks, partition);
+      cfg::utils::count(cfg::utils::Counter::BLOCKS, ranges.size());
+      for (const auto& range : ranges)
       {
-        indices[node] = read_one<size_t>(node_reader, mesh_stream, mode);
+        const auto& block       = blocks[range.block];
+        const auto n_components = block.n_components();
+
+        mesh_stream.seekg(static_cast<std::streamoff>(block.tags_offset + range.offset * sizeof(I)));
+        read_block<E>(mesh_stream, range.count, indices);
+        mesh_stream.seekg(static_cast<std::streamoff>(block.coords_offset + range.offset * n_components * sizeof(R)));
+        read_block<E>(mesh_stream, range.count * n_components, coords);
+        cfg::utils::count(cfg::utils::Counter::BYTES_READ, range.count * (sizeof(I) + n_components * sizeof(R)));
+
+        // Parametric coordinates follow the physical coordinates of each node, these are skipped
+        for (size_t i = 0; i < range.count; i++)
+        {
+          store_node(nodes, node + i, indices[i], block.first + range.offset + i, &coords[i * n_components]);
+        }
+
+        node += range.count;
       }
 
-      return indices;
+      // Leave the stream at the end of the node data
+      mesh_stream.seekg(end_pos);
+
+      return nodes;
     }
 
     /**
-     * Parses the coordinates of the nodes in a block in a GMSH file.
+     * Reads only the node blocks belonging to this rank's partition, located by the node data layout
+     * recorded in a mesh index, so that the block headers are not read. In BINARY mode only the
+     * partition's nodes are read, in ASCII mode the blocks containing them are read from their start.
      *
-     * @param node_reader The node reader object for the mesh.
-     * @param block_nodes The number of nodes in the block.
+     * @tparam E          The encoding of the mesh file.
      * @param mesh_stream The mesh data stream.
-     * @param mode        Indicates the data mode of the mesh stream, currently either ASCII or BINARY.
-     * @returns A vector of node coordinates.
+     * @param node_header The global node description header.
+     * @param environment Contains the calling environment, in particular the node data layout.
+     * @returns The node container.
      */
-    [[nodiscard]] static std::vector<std::array<double, 3>> parse_node_coords(
-        const cfg::reader::SectionReader& node_reader,
-        const size_t block_nodes,
-        std::istream& mesh_stream,
-        const Mode mode) noexcept
+    template <class E, class S>
+    [[nodiscard]] static N parse_indexed(S& mesh_stream,
+                                         const NodeHeader& node_header,
+                                         const NodeEnvironment& environment)
     {
-      std::vector<std::array<double, 3>> coords(block_nodes);
+      using I = typename E::index_type;
+      using R = typename E::real_type;
+
+      const auto& blocks = environment.layout->blocks;
 
-      auto pop_component = [&node_reader, &mesh_stream, mode]() -> double
+      const utils::NaivePartition partition{environment.parallel, node_header.n_nodes};
+
+      // Range buffers are reused across ranges
+      std::vector<size_t> indices;
+      std::vector<double> coords;
+
+      N nodes(partition.size());
+      size_t node = 0;
+      const auto ranges = local_node_ranges(blocks, partition);
+      cfg::utils::count(cfg::utils::Counter::BLOCKS, ranges.size());
+      for (const auto& range : ranges)
       {
-        return read_one<double>(node_reader, mesh_stream, mode);
+        const auto& block       = blocks[range.block];
+        const auto n_components = block.n_components();
+
+        // ASCII blocks can only be read from their start
+        const auto skip = (E::mode == Mode::BINARY) ? range.offset : 0;
+        const auto read = range.offset + range.count - skip;
+        mesh_stream.clear();
+        const auto tags_start = static_cast<std::streamoff>(block.tags_offset + skip * sizeof(I));
+        mesh_stream.seekg(tags_start);
+        read_block<E>(mesh_stream, read, indices);
+        count_bytes_read(mesh_stream, tags_start);
+        const auto coords_start = static_cast<std::streamoff>(block.coords_offset + skip * n_components * sizeof(R));
+        mesh_stream.seekg(coords_start);
+        read_block<E>(mesh_stream, read * n_components, coords);
+        count_bytes_read(mesh_stream, coords_start);
+
+        const auto first = range.offset - skip;  // Offset of the range in the buffers
+        for (size_t i = 0; i < range.count; i++)
+        {
+          const auto j = first + i;
+          store_node(nodes, node + i, indices[j], block.first + range.offset + i, &coords[j * n_components]);
+        }
+
+        node += range.count;
+      }
+
+      // Leave the stream at the end of the node data
+      mesh_stream.clear();
+      mesh_stream.seekg(static_cast<std::streamoff>(environment.layout->end));
+
+      return nodes;
+    }
+
+    /**
+     * Locates the nodes of a partition within a node block: the block's tag and coordinate lines.
+     */
+    struct Span
+    {
+      size_t global;        // The global index of the first node of the span
+      size_t local;         // The index of the first node of the span in the container
+      size_t count;         // The number of nodes in the span
+      size_t tags_line;     // The line of the first node's tag
+      size_t coords_line;   // The line of the first node's coordinates
+      size_t n_components;  // The number of values per coordinate line
+    };
+
+    /**
+     * Parses the node blocks of an ASCII GMSH file using multiple threads, keeping the nodes in this
+     * rank's partition.
+     *
+     * In GMSH 4.1 ASCII files each node block is a header line followed by a line per node tag and a
+     * line per node's coordinates. The block headers are parsed to determine the lines holding the
+     * partition's nodes, which are then split over the threads which parse their tag and coordinate
+     * lines and store them in place.
+     *
+     * A memory-mapped file is viewed directly: the newlines of the node data are counted in parallel
+     * and the lines are located from the count of each chunk. Other streams are read line by line,
+     * only the partition's lines are kept. In both cases the memory used is proportional to the
+     * partition's data.
+     *
+     * @param mesh_stream The mesh data stream, positioned after the Nodes section header.
+     * @param node_header The global node description header.
+     * @param environment Contains the calling environment, in particular passes the Parallel field
+     * @returns The node container.
+     */
+    template <class S>
+    [[nodiscard]] static N parse_threaded(S& mesh_stream,
+                                          const NodeHeader& node_header,
+                                          const NodeEnvironment& environment)
+    {
+      const auto n_threads = environment.parallel.n_threads;
+      const utils::NaivePartition partition{environment.parallel, node_header.n_nodes};
+
+      // The whole of the node data is read, to locate the lines of the partition's nodes
+      const auto start = mark_position(mesh_stream);
+      std::vector<Span> spans;
+      std::string buf;  // The partition's lines, if the stream is not viewed directly
+      std::string_view bytes;
+      if constexpr (std::is_same_v<S, cfg::reader::MappedStream>)
+      {
+        // The node data starts with the first block header
+        bytes            = section_data(mesh_stream, "$EndNodes");
+        const auto first = bytes.find_first_not_of(" \t\r\n");
+        bytes.remove_prefix(std::min(first, bytes.size()));
+      }
+      else
+      {
+        spans = read_spans(mesh_stream, node_header, partition, buf);
+        bytes = buf;
+      }
+      count_bytes_read(mesh_stream, start);
+      const LineIndex lines{bytes, n_threads};
+      if constexpr (std::is_same_v<S, cfg::reader::MappedStream>)
+      {
+        spans = locate_spans(bytes, lines, node_header, partition);
+      }
+      cfg::utils::count(cfg::utils::Counter::BLOCKS, node_header.n_blocks);
+
+      // If the blocks held fewer nodes than expected, only the stored nodes are returned
+      const auto filled = spans.empty() ? 0 : (spans.back().local + spans.back().count);
+      N nodes(filled);
+
+      // Each thread parses a contiguous range of the container's nodes, locating the lines of its
+      // first node in each span and then moving from line to line
+      const auto parse_nodes =
+          [&bytes, &lines, &spans, &nodes](const unsigned int /* thread */, size_t i, const size_t i_end)
+      {
+        if (i == i_end)
+        {
+          return;
+        }
+
+        // The spans are ordered by their position in the container, find the span holding the first node
+        auto span = std::partition_point(spans.begin(),
+                                         spans.end(),
+                                         [i](const Span& candidate) -> bool
+                                         {
+                                           return (candidate.local + candidate.count) <= i;
+                                         });
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        const char* last   = bytes.data() + bytes.size();
+        const char* tags   = bytes.data() + lines.line_start(span->tags_line + (i - span->local));
+        const char* coords = bytes.data() + lines.line_start(span->coords_line + (i - span->local));
+        for (; i < i_end; i++)
+        {
+          if (i >= (span->local + span->count))
+          {
+            span++;
+            tags   = bytes.data() + lines.line_start(span->tags_line);
+            coords = bytes.data() + lines.line_start(span->coords_line);
+          }
+
+          // Parametric coordinates follow the physical coordinates, these are skipped
+          const auto natural_idx = next_number<size_t>(tags, last);
+          const auto x0          = next_number<double>(coords, last);
+          const auto x1          = next_number<double>(coords, last);
+          const auto x2          = next_number<double>(coords, last);
+          tags                   = next_line(tags, last);
+          coords                 = next_line(coords, last);
+
+          const std::array<double, 3> x{x0, x1, x2};
+          store_node(nodes, i, natural_idx, span->global + (i - span->local), x.data());
+        }
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
       };
+      utils::parallel_for(n_threads, filled, parse_nodes);
+      cfg::utils::count(cfg::utils::Counter::TOKENS_PARSED, 4 * filled);
 
-      for (size_t node = 0; node < block_nodes; node++)
+      return nodes;
+    }
+
+    /**
+     * Locates the partition's nodes within the node blocks of a memory-mapped ASCII GMSH file.
+     *
+     * @param bytes       The node data, starting with the first block header.
+     * @param lines       The lines of the node data.
+     * @param node_header The global node description header.
+     * @param partition   The partition of the nodes.
+     * @returns The spans of the partition's nodes, whose lines are lines of the node data.
+     */
+    [[nodiscard]] static std::vector<Span> locate_spans(const std::string_view bytes,
+                                                        const LineIndex& lines,
+                                                        const NodeHeader& node_header,
+                                                        const utils::NaivePartition& partition)
+    {
+      const cfg::utils::ScopedTimer timer{cfg::utils::Phase::PARTITION_FILTER};
+      const auto local_start = partition.start();
+      const auto local_end   = partition.start() + partition.size();
+
+      std::vector<Span> spans;
+      size_t line = 0;  // The line of the block header
+      size_t ctr  = 0;  // Global index of the first node of the block
+      for (size_t block = 0; block < node_header.n_blocks; block++)
       {
-        coords[node] = {pop_component(), pop_component(), pop_component()};
+        if (line >= lines.size())
+        {
+          throw std::runtime_error("The Nodes section ended before all node blocks were read");
+        }
+        // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        const char* ptr = bytes.data() + lines.line_start(line);
+        const auto [block_dim, block_param, block_nodes] = parse_block_header(ptr, bytes.data() + bytes.size());
+        // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+        const auto start = std::max(ctr, local_start);
+        const auto end   = std::min(ctr + block_nodes, local_end);
+        if (start < end)
+        {
+          const auto offset = start - ctr;
+          spans.push_back(Span{start,
+                               start - local_start,
+                               end - start,
+                               line + 1 + offset,
+                               line + 1 + block_nodes + offset,
+                               3 + ((block_param != 0) ? static_cast<size_t>(block_dim) : 0)});
+        }
+
+        line += 1 + 2 * block_nodes;
+        ctr += block_nodes;
       }
+      if (line > lines.size())
+      {
+        throw std::runtime_error("The Nodes section ended before all node blocks were read");
+      }
+
+      return spans;
+    }
+
+    /**
+     * Reads the node blocks of an ASCII GMSH file line by line, keeping the lines of the partition's
+     * nodes.
+     *
+     * @param mesh_stream The mesh data stream, positioned after the Nodes section header.
+     * @param node_header The global node description header.
+     * @param partition   The partition of the nodes.
+     * @param buf         Set to the lines of the partition's nodes, in file order.
+     * @returns The spans of the partition's nodes, whose lines are lines of the buffer.
+     */
+    template <class S>
+    [[nodiscard]] static std::vector<Span> read_spans(S& mesh_stream,
+                                                      const NodeHeader& node_header,
+                                                      const utils::NaivePartition& partition,
+                                                      std::string& buf)
+    {
+      const auto local_start = partition.start();
+      const auto local_end   = partition.start() + partition.size();
+
+      size_t n_kept = 0;  // The number of lines in the buffer
+      std::string text;
+      const auto read_lines = [&mesh_stream, &buf, &n_kept, &text](const size_t count, const bool keep)
+      {
+        for (size_t i = 0; i < count; i++)
+        {
+          if (!keep)
+          {
+            mesh_stream.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+          }
+          else if (std::getline(mesh_stream, text))
+          {
+            buf += text;
+            buf += '\n';
+            n_kept++;
+          }
+          if (!mesh_stream)
+          {
+            throw std::runtime_error("The Nodes section ended before all node blocks were read");
+          }
+        }
+      };
+
+      std::vector<Span> spans;
+      buf.clear();
+      mesh_stream >> std::ws;
+      size_t ctr = 0;  // Global index of the first node of the block
+      for (size_t block = 0; block < node_header.n_blocks; block++)
+      {
+        if (!std::getline(mesh_stream, text))
+        {
+          throw std::runtime_error("The Nodes section ended before all node blocks were read");
+        }
+        const char* ptr = text.data();
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        const auto [block_dim, block_param, block_nodes] = parse_block_header(ptr, text.data() + text.size());
+
+        const auto start = std::max(ctr, local_start);
+        const auto end   = std::min(ctr + block_nodes, local_end);
+        if (start < end)
+        {
+          const auto offset = start - ctr;
+          const auto count  = end - start;
+          const auto n_components = 3 + ((block_param != 0) ? static_cast<size_t>(block_dim) : 0);
+          Span span{start, start - local_start, count, 0, 0, n_components};
+
+          // The tag lines, then the coordinate lines, of the span's nodes are kept
+          read_lines(offset, false);
+          span.tags_line = n_kept;
+          read_lines(count, true);
+          read_lines(block_nodes - count, false);
+          span.coords_line = n_kept;
+          read_lines(count, true);
+          read_lines(block_nodes - offset - count, false);
+          spans.push_back(span);
+        }
+        else
+        {
+          read_lines(2 * block_nodes, false);
+        }
 
-      return coords;
+        ctr += block_nodes;
+      }
+
+      return spans;
     }
 
     /**
-     * Assembles collections of node indices and node coordinates into a collection of nodes.
+     * Parses the header line of an ASCII node block.
      *
-     * @param indices The vector of node indices.
-     * @param coords  The vector of node coordinates.
-     * @returns A vector of nodes.
+     * @param ptr  The start of the header, advanced past it.
+     * @param last The end of the buffer.
+     * @returns The block dimension, whether it has parametric coordinates and its number of nodes.
      */
-    [[nodiscard]] static std::vector<Node<3>> assemble_nodes(const std::vector<size_t>& indices,
-                                                             const std::vector<std::array<double, 3>>& coords,
-                                                             size_t& ctr) noexcept
+    [[nodiscard]] static std::tuple<int, int, size_t> parse_block_header(const char*& ptr, const char* last)
     {
-      std::vector<Node<3>> _nodes(indices.size());
-      std::transform(indices.begin(),
-                     indices.end(),
-                     coords.begin(),
-                     _nodes.begin(),
-                     [&ctr](const size_t idx, const std::array<double, 3> coo) -> Node<3>
-                     {
-                       return Node<3>{idx, ctr++, coo};
-                     });
-      return _nodes;
+      const auto block_dim   = next_number<int>(ptr, last);
+      const auto block_tag   = next_number<int>(ptr, last);
+      const auto block_param = next_number<int>(ptr, last);
+      const auto block_nodes = next_number<size_t>(ptr, last);
+      static_cast<void>(block_tag);
+
+      return {block_dim, block_param, block_nodes};
+    }
+
+    /**
+     * Returns the start of the line following a position in a character buffer.
+     */
+    [[nodiscard]] static const char* next_line(const char* ptr, const char* last)
+    {
+      const auto* eol = static_cast<const char*>(std::memchr(ptr, '\n', static_cast<size_t>(last - ptr)));
+      return (eol == nullptr) ? last : eol + 1;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    /**
+     * Parses the next number from a character buffer, skipping leading whitespace and raising an
+     * error if no number is found.
+     *
+     * @param ptr  The current position in the buffer, advanced past the number.
+     * @param last The end of the buffer.
+     * @returns The number.
+     */
+    template <class C>
+    [[nodiscard]] static C next_number(const char*& ptr, const char* last)
+    {
+      while ((ptr != last) && utils::is_space(*ptr))
+      {
+        ptr++;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      }
+
+      C val{};
+      const auto [end, ec] = utils::parse_number(ptr, last, val);
+      if (ec != std::errc{})
+      {
+        throw std::runtime_error("Failed to parse a number in the Nodes section");
+      }
+      ptr = end;
+
+      return val;
+    }
+
+    /**
+     * Stores a node in the node container.
+     *
+     * @param nodes       The node container.
+     * @param i           The index of the node in the container.
+     * @param natural_idx The natural index of the node.
+     * @param global_idx  The global index of the node.
+     * @param x           The node coordinates.
+     */
+    static void store_node(
+        N& nodes, const size_t i, const size_t natural_idx, const size_t global_idx, const double* x)
+    {
+      // The coordinates are read from a strided buffer.
+      // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      if constexpr (std::is_same_v<N, NodeSet<3>>)
+      {
+        nodes.natural_idx[i] = natural_idx;
+        nodes.global_idx[i]  = global_idx;
+        nodes.x[0][i]        = x[0];
+        nodes.x[1][i]        = x[1];
+        nodes.x[2][i]        = x[2];
+      }
+      else
+      {
+        nodes[i] = Node<3>{natural_idx, global_idx, {x[0], x[1], x[2]}};
+      }
+      // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    /**
+     * Parses the data header of a node block in a GMSH file.
+     *
+     * @tparam E          The encoding of the mesh file.
+     * @param node_reader The node reader object for the mesh.
+     * @param mesh_stream The mesh data stream.
+     * @returns A tuple of the block dimension, block tag, flag indicating whether the block is
+     *          parametric and the number of nodes in the block.
+     */
+    template <class E, class S>
+    [[nodiscard]] static std::tuple<int, int, bool, size_t> parse_node_block_header(
+        const cfg::reader::SectionReader& node_reader,
+        S& mesh_stream) noexcept
+    {
+      const auto block_dim   = read_one<int, E>(node_reader, mesh_stream);
+      const auto block_tag   = read_one<int, E>(node_reader, mesh_stream);
+      const auto block_param = read_one<int, E>(node_reader, mesh_stream);
+      const auto block_nodes = read_one<size_t, E>(node_reader, mesh_stream);
+
+      return {block_dim, block_tag, bool{static_cast<bool>(block_param)}, block_nodes};
+    }
+
+    /**
+     * Parses the indices of the nodes in a block in a GMSH file, the stream must be positioned at the
+     * start of the indices.
+     *
+     * @tparam E          The encoding of the mesh file.
+     * @param block_nodes The number of nodes in the block.
+     * @param mesh_stream The mesh data stream.
+     * @param indices     The buffer the node indices are read into.
+     */
+    template <class E, class S>
+    static void parse_node_idx(const size_t block_nodes, S& mesh_stream, std::vector<size_t>& indices)
+    {
+      read_block<E>(mesh_stream, block_nodes, indices);
+    }
+
+    /**
+     * Parses the coordinates of the nodes in a block in a GMSH file, the stream must be positioned at
+     * the start of the coordinates. The coordinates are stored as read, i.e. each node's physical
+     * coordinates are followed by any parametric coordinates.
+     *
+     * @tparam E           The encoding of the mesh file.
+     * @param block_nodes  The number of nodes in the block.
+     * @param n_components The number of values stored per node.
+     * @param mesh_stream  The mesh data stream.
+     * @param coords       The buffer the node coordinates are read into.
+     */
+    template <class E, class S>
+    static void parse_node_coords(const size_t block_nodes,
+                                  const size_t n_components,
+                                  S& mesh_stream,
+                                  std::vector<double>& coords)
+    {
+      read_block<E>(mesh_stream, block_nodes * n_components, coords);
     }
   };
 
+  /**
+   * Parses each block of nodes into a node vector.
+   */
+  using DataParser = BasicDataParser<std::vector<Node<3>>>;
+
+  /**
+   * Parses each block of nodes into a structure-of-arrays node set.
+   */
+  using NodeSetParser = BasicDataParser<NodeSet<3>>;
+
   /**
    * Performs validation of the node data that was read, raising an error if this fails.
    *
+   * Unless the file is trusted, the node indices are checked against the expected range and for
+   * duplicates in a single parallel pass using `parallel.n_threads` threads. Duplicates are detected
+   * with a bitmap of the index range when it is dense, otherwise with a sorted copy of the indices.
+   *
+   * Global validation is collective over the communicator: the ranks agree on whether the nodes are
+   * valid and the number of nodes and the range of their indices over all ranks are checked. When the
+   * indices are contiguous a fingerprint of the indices held by each rank is reduced to detect
+   * duplicates across ranks, without exchanging the indices.
+   *
    * @param nodes       The vector of nodes.
    * @param node_header The global description of the nodes in the mesh that is used to test the data.
    * @param parallel    The parallel configuration object.
+   * @param validation  How thoroughly the nodes are validated.
+   * @param comm        The communicator corresponding to the parallel configuration, required by
+   *                    global validation on more than one rank.
    */
   void validate_nodes(const std::vector<Node<3>>& nodes,
                       const NodeHeader& node_header,
-                      const cfg::utils::Parallel& parallel);
+                      const cfg::utils::Parallel& parallel,
+                      const Validation validation = Validation::LOCAL,
+                      MPI_Comm comm               = MPI_COMM_NULL);
+
+  /**
+   * Performs validation of the node data that was read, raising an error if this fails, see
+   * `validate_nodes` for node vectors.
+   *
+   * @param nodes       The set of nodes.
+   * @param node_header The global description of the nodes in the mesh that is used to test the data.
+   * @param parallel    The parallel configuration object.
+   * @param validation  How thoroughly the nodes are validated.
+   * @param comm        The communicator corresponding to the parallel configuration, required by
+   *                    global validation on more than one rank.
+   */
+  void validate_nodes(const NodeSet<3>& nodes,
+                      const NodeHeader& node_header,
+                      const cfg::utils::Parallel& parallel,
+                      const Validation validation = Validation::LOCAL,
+                      MPI_Comm comm               = MPI_COMM_NULL);
+
+  /**
+   * Validates the nodes read by `read_X`, see `validate_nodes`.
+   */
+  class NodeValidator
+  {
+   public:
+    /**
+     * Constructs a node validator.
+     *
+     * @param parallel   The parallel environment, which must outlive the validator.
+     * @param validation How thoroughly the nodes are validated.
+     * @param comm       The communicator corresponding to the parallel environment.
+     */
+    NodeValidator(const utils::Parallel& parallel, const Validation validation, MPI_Comm comm)
+        : parallel{parallel}, validation{validation}, comm{comm}
+    {
+    }
+
+    /**
+     * Validates the nodes, raising an error if this fails.
+     */
+    template <class N>
+    void validate(const N& nodes, const NodeHeader& node_header) const
+    {
+      validate_nodes(nodes, node_header, parallel, validation, comm);
+    }
+
+   private:
+    const utils::Parallel& parallel;  // The parallel environment
+    Validation validation;            // How thoroughly the nodes are validated
+    MPI_Comm comm;                    // The communicator corresponding to the parallel environment
+  };
+
+  /**
+   * Utility to construct a node reader, which dispatches on the mode of the mesh file once per call
+   * and expects its `size_t` values to be of the native width.
+   *
+   * Node readers are available for `std::istream` and `cfg::reader::MappedStream` stream types.
+   *
+   * @param parallel   The parallel environment.
+   * @param validation How thoroughly the nodes read are validated.
+   * @param comm       The communicator corresponding to the parallel environment, see `validate_nodes`.
+   * @returns A function to read nodes from a GMSH file.
+   */
+  template <class S>
+  std::function<std::vector<Node<3>>(const cfg::reader::SectionReader&, S&, const Mode)> make_node_reader(
+      const cfg::utils::Parallel& parallel,
+      const Validation validation = Validation::LOCAL,
+      MPI_Comm comm               = MPI_COMM_NULL);
 
   /**
-   * Utility to construct a node reader.
+   * Utility to construct a node reader from the Nodes section header and node data layout recorded
+   * by a mesh index, the header is not parsed and only this rank's node blocks are read.
+   *
+   * Node readers are available for `std::istream` and `cfg::reader::MappedStream` stream types.
    *
-   * @param parallel The parallel environment.
+   * @param parallel    The parallel environment.
+   * @param node_header The global node description header.
+   * @param layout      The node data layout, which must outlive the reader.
+   * @param validation  How thoroughly the nodes read are validated.
+   * @param comm        The communicator corresponding to the parallel environment, see `validate_nodes`.
    * @returns A function to read nodes from a GMSH file.
    */
-  std::function<std::vector<Node<3>>(const cfg::reader::SectionReader&, std::ifstream&, const Mode)> make_node_reader(
-      const cfg::utils::Parallel& parallel);
+  template <class S>
+  std::function<std::vector<Node<3>>(const cfg::reader::SectionReader&, S&, const Mode)> make_indexed_node_reader(
+      const cfg::utils::Parallel& parallel,
+      const NodeHeader& node_header,
+      const NodeLayout& layout,
+      const Validation validation = Validation::LOCAL,
+      MPI_Comm comm               = MPI_COMM_NULL);
 }  // namespace cfg::parser
 
 #endif  // __CFG__NODE_PARSER_H_
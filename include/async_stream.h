@@ -0,0 +1,159 @@
+/**
+ * async_stream.h
+ *
+ * A pipelined alternative to `std::ifstream` for reading mesh files, where the file is read ahead
+ * by a background thread while the data already read is parsed.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef __CFG_ASYNC_STREAM_H_
+#define __CFG_ASYNC_STREAM_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <mutex>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace cfg::reader
+{
+  /**
+   * A read-only stream buffer over a file, whose chunks are read ahead by a reader thread.
+   *
+   * The reader thread reads consecutive chunks of the file with `pread` into a bounded ring of
+   * buffers, while the stream consumes the filled buffers in order. The consumer holds one buffer
+   * at a time, so with the default depth of two the next chunk is read while the current chunk is
+   * parsed (double-buffering), deeper rings absorb variations in I/O latency. When the reader gets
+   * ahead of the parser it waits for a buffer to be released.
+   *
+   * Seeking within the current chunk only moves the get pointer, seeking elsewhere discards the
+   * chunks read ahead and restarts the reader thread at the target.
+   */
+  class AsyncFileBuf : public std::streambuf
+  {
+   public:
+    /**
+     * The default size of the chunks the file is read in.
+     */
+    static constexpr size_t default_chunk_size = size_t{1} << 22U;
+
+    /**
+     * The default number of buffers in the ring.
+     */
+    static constexpr size_t default_depth = 2;
+
+    /**
+     * Opens a file for reading and starts the reader thread, raises an error if the file cannot be
+     * opened.
+     *
+     * @param path       The path to the file.
+     * @param chunk_size The size of the chunks the file is read in.
+     * @param depth      The number of buffers in the ring, at least two.
+     */
+    explicit AsyncFileBuf(const std::filesystem::path& path,
+                          const size_t chunk_size = default_chunk_size,
+                          const size_t depth      = default_depth);
+    ~AsyncFileBuf() override;
+
+    // The reader thread refers to this object, copying or moving it would invalidate this.
+    AsyncFileBuf(const AsyncFileBuf&)            = delete;
+    AsyncFileBuf(AsyncFileBuf&&)                 = delete;
+    AsyncFileBuf& operator=(const AsyncFileBuf&) = delete;
+    AsyncFileBuf& operator=(AsyncFileBuf&&)      = delete;
+
+   protected:
+    /**
+     * Releases the current chunk and waits for the reader thread to provide the next.
+     */
+    int_type underflow() override;
+
+    /**
+     * Seeks a position relative to the beginning, end or current position of the file.
+     */
+    pos_type seekoff(off_type off, std::ios::seekdir dir, std::ios::openmode which) override;
+
+    /**
+     * Seeks an absolute position in the file.
+     */
+    pos_type seekpos(pos_type pos, std::ios::openmode which) override;
+
+   private:
+    /**
+     * A buffer of the ring, holding a chunk of the file.
+     */
+    struct Slot
+    {
+      std::vector<char> data;  // The chunk data
+      size_t offset{};         // The offset of the chunk in the file
+      size_t size{};           // The number of bytes of the chunk
+    };
+
+    int fd{-1};              // The file descriptor
+    size_t file_size{};      // The size of the file
+    size_t chunk_size;       // The size of the chunks the file is read in
+    std::vector<Slot> ring;  // The ring of buffers
+
+    // The state shared with the reader thread, guarded by the mutex
+    std::mutex mutex;
+    std::condition_variable space_cv;  // Signals a buffer was released, or the reader must restart
+    std::condition_variable data_cv;   // Signals a buffer was filled
+    size_t head{};                     // The next buffer to be consumed
+    size_t tail{};                     // The next buffer to be filled
+    size_t filled{};                   // The number of filled buffers, including one held by the consumer
+    bool holding{false};               // Whether the consumer holds the buffer at the head
+    bool in_flight{false};             // Whether the reader thread is reading a chunk
+    size_t read_offset{};              // The offset of the next chunk to read
+    uint64_t generation{};             // Incremented on each restart, reads for earlier generations are discarded
+    bool stop{false};                  // Whether the reader thread should exit
+    std::string error;                 // The error raised by the reader thread, if any
+
+    size_t chunk_offset{};  // The offset in the file of the current get area
+    std::thread reader;     // The reader thread
+
+    /**
+     * The reader thread's loop: reads chunks into free buffers until stopped.
+     */
+    void read_ahead();
+
+    /**
+     * Moves the stream to an absolute position.
+     *
+     * @param target The position in the file.
+     * @returns The new position, or -1 if the position is outside the file.
+     */
+    pos_type seek_to(off_type target);
+  };
+
+  /**
+   * An input stream over a file read through an `AsyncFileBuf`, usable wherever an `std::istream`
+   * is expected.
+   */
+  class AsyncFileStream : public std::istream
+  {
+   public:
+    /**
+     * Opens a file for reading, raises an error if the file cannot be opened.
+     *
+     * @param path       The path to the file.
+     * @param chunk_size The size of the chunks the file is read in.
+     * @param depth      The number of buffers in the ring, at least two.
+     */
+    explicit AsyncFileStream(const std::filesystem::path& path,
+                             const size_t chunk_size = AsyncFileBuf::default_chunk_size,
+                             const size_t depth      = AsyncFileBuf::default_depth)
+        : std::istream(nullptr), buf(path, chunk_size, depth)
+    {
+      rdbuf(&buf);
+    }
+
+   private:
+    AsyncFileBuf buf;  // The stream buffer
+  };
+}  // namespace cfg::reader
+
+#endif  // __CFG_ASYNC_STREAM_H_
@@ -6,10 +6,14 @@
 #ifndef __CFG_DETECT_FORMAT_H_
 #define __CFG_DETECT_FORMAT_H_
 
+#include <array>
 #include <filesystem>
 #include <fstream>
 #include <string>
 
+#include <hpc_format.h>
+#include <instrument.h>
+
 namespace cfg::reader
 {
   /**
@@ -17,7 +21,8 @@ namespace cfg::reader
    */
   enum class MeshFormat
   {
-    GMSH
+    GMSH,
+    PARTITIONED  ///< The CFGrid partitioned mesh format.
   };
 
   /**
@@ -70,6 +75,29 @@ namespace cfg::reader
     }
   };
 
+  /**
+   * A class that determines if a given mesh file is a CFGrid partitioned mesh file.
+   */
+  class PartitionedDetector
+  {
+   public:
+    /**
+     * Given a filepath, determines whether the file it points to is a partitioned mesh file, these
+     * begin with the format's magic string.
+     *
+     * @param meshfile The filepath which may point to a partitioned mesh file.
+     * @returns Whether the file is a partitioned mesh file (`true`) or not (`false`).
+     */
+    [[nodiscard]] static bool is_partitioned_file(const std::filesystem::path& meshfile)
+    {
+      std::ifstream istream(meshfile, std::ios::in | std::ios::binary);
+
+      std::array<char, cfg::hpc::magic.size()> magic{};
+      istream.read(magic.data(), magic.size());
+      return istream.good() && (magic == cfg::hpc::magic);
+    }
+  };
+
   /**
    * A class that determines the format of a given mesh file.
    */
@@ -84,11 +112,13 @@ namespace cfg::reader
      */
     [[nodiscard]] static MeshFormat get_format(const std::filesystem::path& meshfile)
     {
+      const cfg::utils::ScopedTimer timer{cfg::utils::Phase::DETECT_FORMAT};
+
       check_mesh_exists(meshfile);
 
       /*
-       * Currently we only support GMSH files, if the path is a directory then
-       * we can immediately discard it
+       * Mesh files are regular files, if the path is a directory then we can
+       * immediately discard it
        */
       if (!std::filesystem::is_regular_file(meshfile))
       {
@@ -101,6 +131,12 @@ namespace cfg::reader
         return MeshFormat::GMSH;
       }
 
+      /* Are we reading a partitioned mesh? */
+      if (cfg::reader::PartitionedDetector::is_partitioned_file(meshfile))
+      {
+        return MeshFormat::PARTITIONED;
+      }
+
       throw unknown_format{"Could not determine format of " + meshfile.string()};
     }
 
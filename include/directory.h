@@ -0,0 +1,294 @@
+/**
+ * directory.h
+ *
+ * A directory of values recorded for node tags, distributed over the ranks by tag, through which
+ * ranks agree on data about nodes that several of them refer to.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef __CFG_DIRECTORY_H_
+#define __CFG_DIRECTORY_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <mpi.h>
+
+#include <mpi_utils.h>
+
+namespace cfg::utils
+{
+  /**
+   * An entry of a directory distributed over the ranks by node tag.
+   */
+  template <class V>
+  struct DirectoryEntry
+  {
+    size_t tag;  ///< The node tag
+    V value;     ///< The value recorded for the node
+  };
+
+  /**
+   * The values found for a set of tags, in CSR form: the values of tag `i` are `values[offsets[i]]`
+   * to `values[offsets[i + 1] - 1]`.
+   */
+  template <class V>
+  struct DirectoryMatches
+  {
+    std::vector<size_t> offsets{0};  ///< The offset of each tag's values, followed by the total
+    std::vector<V> values;           ///< The values of the tags
+  };
+
+  /**
+   * The rank holding the directory entries of a node tag.
+   */
+  [[nodiscard]] inline int directory_rank(const size_t tag, const size_t n_ranks)
+  {
+    return static_cast<int>(tag % n_ranks);
+  }
+
+  /**
+   * Publishes entries to the directory, each entry is sent to the rank given by its tag. This must
+   * be called collectively.
+   *
+   * @param entries The entries published by this rank.
+   * @param comm    The communicator.
+   * @returns The directory entries held by this rank, sorted by tag. A tag published more than once
+   *          has an entry for each value, in the order of the ranks that published them.
+   */
+  template <class V>
+  [[nodiscard]] std::vector<DirectoryEntry<V>> publish(const std::vector<DirectoryEntry<V>>& entries, MPI_Comm comm)
+  {
+    const auto n_ranks = static_cast<size_t>(make_parallel(comm).size);
+    auto directory     = send_to_ranks(
+        entries,
+        [n_ranks](const DirectoryEntry<V>& entry) -> int
+        {
+          return directory_rank(entry.tag, n_ranks);
+        },
+        comm);
+    std::stable_sort(directory.begin(),
+                     directory.end(),
+                     [](const DirectoryEntry<V>& a, const DirectoryEntry<V>& b) -> bool
+                     {
+                       return a.tag < b.tag;
+                     });
+
+    return directory;
+  }
+
+  /**
+   * Publishes entries to the directory, combining the values of each tag. This must be called
+   * collectively.
+   *
+   * @param entries The entries published by this rank.
+   * @param combine Combines the values of a tag published more than once.
+   * @param comm    The communicator.
+   * @returns The directory entries held by this rank, sorted by tag with unique tags.
+   */
+  template <class V, class C>
+  [[nodiscard]] std::vector<DirectoryEntry<V>> publish(const std::vector<DirectoryEntry<V>>& entries,
+                                                       const C& combine,
+                                                       MPI_Comm comm)
+  {
+    auto directory = publish(entries, comm);
+
+    size_t n_unique = 0;
+    for (size_t i = 0; i < directory.size(); i++)
+    {
+      if ((n_unique > 0) && (directory[n_unique - 1].tag == directory[i].tag))
+      {
+        directory[n_unique - 1].value = combine(directory[n_unique - 1].value, directory[i].value);
+      }
+      else
+      {
+        directory[n_unique++] = directory[i];
+      }
+    }
+    directory.resize(n_unique);
+
+    return directory;
+  }
+
+  /**
+   * Looks up the values of tags in the directory, each query is answered by the rank holding its tag
+   * with the values of the tag selected for the querying rank. This must be called collectively.
+   *
+   * @param directory The directory entries held by this rank, as returned by `publish`.
+   * @param tags      The tags queried by this rank.
+   * @param keep      Whether a value is returned to a querying rank, called with the value and the
+   *                  rank, so that the values a rank does not need are not sent.
+   * @param comm      The communicator.
+   * @returns The values kept of each tag queried, none for tags absent from the directory.
+   */
+  template <class V, class K>
+  [[nodiscard]] DirectoryMatches<V> lookup_all(const std::vector<DirectoryEntry<V>>& directory,
+                                               const std::vector<size_t>& tags,
+                                               const K& keep,
+                                               MPI_Comm comm)
+  {
+    const auto n_ranks = static_cast<size_t>(make_parallel(comm).size);
+
+    std::vector<int> holders(tags.size());
+    std::transform(tags.begin(),
+                   tags.end(),
+                   holders.begin(),
+                   [n_ranks](const size_t tag) -> int
+                   {
+                     return directory_rank(tag, n_ranks);
+                   });
+    const auto queries = route(holders, n_ranks);
+    std::vector<size_t> send(tags.size());
+    for (size_t i = 0; i < tags.size(); i++)
+    {
+      send[i] = tags[queries.order[i]];
+    }
+    std::vector<int> recv_counts;
+    const auto received = exchange(send, queries.counts, comm, recv_counts);
+
+    // Answer each query with the number of values found, followed by the values
+    std::vector<int> n_found(received.size());
+    std::vector<int> value_counts(n_ranks, 0);
+    std::vector<V> found;
+    for (size_t rank = 0, i = 0; rank < n_ranks; rank++)
+    {
+      for (int k = 0; k < recv_counts[rank]; k++, i++)
+      {
+        const auto [first, last] = std::equal_range(directory.begin(),
+                                                    directory.end(),
+                                                    DirectoryEntry<V>{received[i], {}},
+                                                    [](const DirectoryEntry<V>& a, const DirectoryEntry<V>& b) -> bool
+                                                    {
+                                                      return a.tag < b.tag;
+                                                    });
+        std::for_each(first,
+                      last,
+                      [&found, &n_found, &keep, i, rank](const DirectoryEntry<V>& entry)
+                      {
+                        if (keep(entry.value, static_cast<int>(rank)))
+                        {
+                          found.push_back(entry.value);
+                          n_found[i]++;
+                        }
+                      });
+        value_counts[rank] += n_found[i];
+      }
+    }
+    std::vector<int> reply_counts;
+    const auto counts = exchange(n_found, recv_counts, comm, reply_counts);
+    const auto values = exchange(found, value_counts, comm, reply_counts);
+
+    // The replies return in the order the queries were sent
+    DirectoryMatches<V> matches;
+    matches.offsets.assign(tags.size() + 1, 0);
+    for (size_t i = 0; i < tags.size(); i++)
+    {
+      matches.offsets[queries.order[i] + 1] = static_cast<size_t>(counts[i]);
+    }
+    for (size_t i = 0; i < tags.size(); i++)
+    {
+      matches.offsets[i + 1] += matches.offsets[i];
+    }
+    matches.values.resize(values.size());
+    for (size_t i = 0, next = 0; i < tags.size(); i++)
+    {
+      const auto query = queries.order[i];
+      std::copy(values.begin() + static_cast<std::ptrdiff_t>(next),
+                values.begin() + static_cast<std::ptrdiff_t>(next) + counts[i],
+                matches.values.begin() + static_cast<std::ptrdiff_t>(matches.offsets[query]));
+      next += static_cast<size_t>(counts[i]);
+    }
+
+    return matches;
+  }
+
+  /**
+   * Looks up all the values of tags in the directory, each query is answered by the rank holding
+   * its tag. This must be called collectively.
+   *
+   * @param directory The directory entries held by this rank, as returned by `publish`.
+   * @param tags      The tags queried by this rank.
+   * @param comm      The communicator.
+   * @returns The values of each tag queried, none for tags absent from the directory.
+   */
+  template <class V>
+  [[nodiscard]] DirectoryMatches<V> lookup_all(const std::vector<DirectoryEntry<V>>& directory,
+                                               const std::vector<size_t>& tags,
+                                               MPI_Comm comm)
+  {
+    return lookup_all(
+        directory,
+        tags,
+        [](const V& /* value */, const int /* rank */) -> bool
+        {
+          return true;
+        },
+        comm);
+  }
+
+  /**
+   * Looks up tags in the directory, each query is answered by the rank holding its tag with the
+   * first value recorded for it. This must be called collectively.
+   *
+   * @param directory The directory entries held by this rank, as returned by `publish`.
+   * @param tags      The tags queried by this rank.
+   * @param missing   The answer for tags absent from the directory.
+   * @param comm      The communicator.
+   * @returns The value of each tag queried.
+   */
+  template <class V>
+  [[nodiscard]] std::vector<V> lookup(const std::vector<DirectoryEntry<V>>& directory,
+                                      const std::vector<size_t>& tags,
+                                      const V& missing,
+                                      MPI_Comm comm)
+  {
+    const auto n_ranks = static_cast<size_t>(make_parallel(comm).size);
+
+    std::vector<int> holders(tags.size());
+    std::transform(tags.begin(),
+                   tags.end(),
+                   holders.begin(),
+                   [n_ranks](const size_t tag) -> int
+                   {
+                     return directory_rank(tag, n_ranks);
+                   });
+    const auto queries = route(holders, n_ranks);
+    std::vector<size_t> send(tags.size());
+    for (size_t i = 0; i < tags.size(); i++)
+    {
+      send[i] = tags[queries.order[i]];
+    }
+    std::vector<int> recv_counts;
+    const auto received = exchange(send, queries.counts, comm, recv_counts);
+
+    std::vector<V> answers(received.size(), missing);
+    for (size_t i = 0; i < received.size(); i++)
+    {
+      const auto found = std::lower_bound(directory.begin(),
+                                          directory.end(),
+                                          received[i],
+                                          [](const DirectoryEntry<V>& entry, const size_t tag) -> bool
+                                          {
+                                            return entry.tag < tag;
+                                          });
+      if ((found != directory.end()) && (found->tag == received[i]))
+      {
+        answers[i] = found->value;
+      }
+    }
+
+    // The answers return in the order the queries were sent
+    std::vector<int> reply_counts;
+    const auto replies = exchange(answers, recv_counts, comm, reply_counts);
+    std::vector<V> values(tags.size());
+    for (size_t i = 0; i < tags.size(); i++)
+    {
+      values[queries.order[i]] = replies[i];
+    }
+
+    return values;
+  }
+}  // namespace cfg::utils
+
+#endif  // __CFG_DIRECTORY_H_
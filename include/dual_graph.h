@@ -0,0 +1,120 @@
+/**
+ * dual_graph.h
+ *
+ * Distributed graphs of the mesh, in the compressed sparse row (CSR) form taken by graph
+ * partitioners.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef __CFG_DUAL_GRAPH_H_
+#define __CFG_DUAL_GRAPH_H_
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include <mpi.h>
+
+#include <element_parser.h>
+
+namespace cfg::utils
+{
+  /**
+   * A graph whose vertices are distributed over the ranks of a communicator, in the distributed CSR
+   * form used by ParMETIS.
+   *
+   * Each rank holds a contiguous range of the global vertices, rank `r` holds the vertices
+   * `vtxdist[r]` to `vtxdist[r + 1] - 1`. The neighbours of local vertex `i` are
+   * `adjacency[offsets[i]]` to `adjacency[offsets[i + 1] - 1]`, identified by their global index and
+   * sorted in ascending order. The graph is undirected, each edge is held by both of its vertices.
+   */
+  struct DistributedGraph
+  {
+    std::vector<size_t> vtxdist{0};  ///< The first global vertex of each rank, followed by the total
+    std::vector<size_t> offsets{0};  ///< The offset of each local vertex's neighbours, followed by the total
+    std::vector<size_t> adjacency;   ///< The global indices of the neighbours of the local vertices
+
+    /**
+     * Returns the number of vertices held by this rank.
+     */
+    [[nodiscard]] size_t size() const
+    {
+      return offsets.size() - 1;
+    }
+
+    /**
+     * Returns the number of vertices held by all ranks.
+     */
+    [[nodiscard]] size_t global_size() const
+    {
+      return vtxdist.back();
+    }
+
+    /**
+     * Returns the number of neighbours of a vertex.
+     *
+     * @param i The local index of the vertex.
+     * @returns The number of neighbours.
+     */
+    [[nodiscard]] size_t degree(const size_t i) const
+    {
+      return offsets[i + 1] - offsets[i];
+    }
+
+    /**
+     * Returns the range of a vertex's neighbours.
+     *
+     * @param i The local index of the vertex.
+     * @returns Iterators to the first and past the last neighbour of the vertex.
+     */
+    [[nodiscard]] std::pair<std::vector<size_t>::const_iterator, std::vector<size_t>::const_iterator> neighbours(
+        const size_t i) const
+    {
+      const auto first = adjacency.begin() + static_cast<std::ptrdiff_t>(offsets[i]);
+      const auto last  = adjacency.begin() + static_cast<std::ptrdiff_t>(offsets[i + 1]);
+      return {first, last};
+    }
+  };
+
+  /**
+   * The dual graph of a mesh: its vertices are the cells of the mesh, i.e. the elements of the mesh
+   * dimension, and two cells are adjacent if they share a face.
+   *
+   * Elements of lower dimension, such as boundary faces, are not vertices of the graph. The local
+   * vertices are the cells held by this rank, in the order of the element set.
+   */
+  struct DualGraph : public DistributedGraph
+  {
+    int dim{};                  ///< The dimension of the mesh, i.e. of its cells
+    std::vector<size_t> cells;  ///< The index in the element set of the cell of each local vertex
+  };
+
+  /**
+   * Builds the dual graph of the elements held by the ranks of a communicator, this must be called
+   * collectively.
+   *
+   * The faces of each cell are identified by the sorted tags of their nodes, and matched through a
+   * hash of these. The faces are first matched within each rank, then each face left unmatched,
+   * which either lies on a boundary between ranks or on the boundary of the mesh, is sent to the rank
+   * given by its hash in a single all-to-all exchange. These ranks match the faces they receive and
+   * return each adjacency across ranks to the ranks holding its cells in a second exchange.
+   *
+   * An error is raised on all ranks if a face is shared by more than two cells held by one rank, or
+   * by more than two cells of which no two are held by the same rank. A third cell on another rank
+   * sharing a face matched within a rank is only detected when `check_manifold` is set: the hash of
+   * each face matched within a rank is then also sent to the rank given by it, which reports the
+   * face if it receives its hash twice or a face with the same hash. This exchanges one word per
+   * interior face, and a collision of the 64-bit hashes would be reported as well.
+   *
+   * @param elements       The elements held by this rank.
+   * @param comm           The communicator the elements are distributed over.
+   * @param check_manifold Whether the faces matched within a rank are checked against the other
+   *                       ranks, this must be the same on all ranks.
+   * @returns The dual graph, whose global vertices are numbered in rank order.
+   */
+  [[nodiscard]] DualGraph build_dual_graph(const cfg::parser::ElementSet& elements,
+                                           MPI_Comm comm,
+                                           const bool check_manifold = false);
+}  // namespace cfg::utils
+
+#endif  // __CFG_DUAL_GRAPH_H_
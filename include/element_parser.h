@@ -0,0 +1,210 @@
+/**
+ * element_parser.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef __CFG_ELEMENT_PARSER_H_
+#define __CFG_ELEMENT_PARSER_H_
+
+#include <cstddef>
+#include <istream>
+#include <utility>
+#include <vector>
+
+#include <mapped_stream.h>
+#include <node_parser.h>
+#include <utils.h>
+
+namespace cfg::parser
+{
+  /**
+   * Describes a GMSH element type.
+   */
+  struct ElementType
+  {
+    int dim;         ///< The dimension of the element
+    size_t n_nodes;  ///< The number of nodes of the element
+  };
+
+  /**
+   * Looks up the description of a GMSH element type, raising an error if the type is unsupported.
+   *
+   * The supported types are the first order line (1), triangle (2), quadrangle (3), tetrahedron (4),
+   * hexahedron (5), prism (6) and pyramid (7) elements and the point (15) element.
+   *
+   * @param type The GMSH element type number.
+   * @returns The description of the element type.
+   */
+  [[nodiscard]] ElementType element_type(const int type);
+
+  /**
+   * A set of mesh elements, the element connectivity is stored in compressed sparse row (CSR) form:
+   * the nodes of element `i` are `nodes[offsets[i]]` to `nodes[offsets[i + 1] - 1]`.
+   */
+  struct ElementSet
+  {
+    std::vector<size_t> natural_idx;  ///< The natural indices (tags) of the elements
+    std::vector<size_t> global_idx;   ///< The global indices of the elements
+    std::vector<int> type;            ///< The GMSH types of the elements
+    std::vector<size_t> offsets{0};   ///< The offset of each element's nodes, followed by the total
+    std::vector<size_t> nodes;        ///< The natural indices of the element nodes
+
+    /**
+     * Returns the number of elements in the set.
+     */
+    [[nodiscard]] size_t size() const
+    {
+      return natural_idx.size();
+    }
+
+    /**
+     * Returns the number of nodes of an element.
+     *
+     * @param i The index of the element in the set.
+     * @returns The number of nodes.
+     */
+    [[nodiscard]] size_t n_nodes(const size_t i) const
+    {
+      return offsets[i + 1] - offsets[i];
+    }
+
+    /**
+     * Returns the range of an element's nodes.
+     *
+     * @param i The index of the element in the set.
+     * @returns Iterators to the first and past the last node of the element.
+     */
+    [[nodiscard]] std::pair<std::vector<size_t>::const_iterator, std::vector<size_t>::const_iterator> connectivity(
+        const size_t i) const
+    {
+      const auto first = nodes.begin() + static_cast<std::ptrdiff_t>(offsets[i]);
+      return {first, first + static_cast<std::ptrdiff_t>(n_nodes(i))};
+    }
+
+    /**
+     * Reserves storage for `n` elements.
+     *
+     * @param n The number of elements.
+     */
+    void reserve(const size_t n)
+    {
+      natural_idx.reserve(n);
+      global_idx.reserve(n);
+      type.reserve(n);
+      offsets.reserve(n + 1);
+    }
+
+    /**
+     * Appends an element to the set.
+     *
+     * @param elem_natural_idx The natural index of the element.
+     * @param elem_global_idx  The global index of the element.
+     * @param elem_type        The GMSH type of the element.
+     * @param first            Iterator to the first node of the element.
+     * @param last             Iterator past the last node of the element.
+     */
+    template <class I>
+    void push_back(
+        const size_t elem_natural_idx, const size_t elem_global_idx, const int elem_type, I first, I last)
+    {
+      natural_idx.push_back(elem_natural_idx);
+      global_idx.push_back(elem_global_idx);
+      type.push_back(elem_type);
+      nodes.insert(nodes.end(), first, last);
+      offsets.push_back(nodes.size());
+    }
+  };
+
+  /**
+   * Reads the elements from a mesh file of a given encoding.
+   *
+   * Instantiated for each `Encoding` alias and for both a `SectionIndex` and a `MeshIndex`, a mesh
+   * index records the element blocks so that only this rank's element blocks are read.
+   *
+   * @tparam E          The encoding of the mesh file.
+   * @param mesh_stream The data stream associated with the mesh file.
+   * @param parallel    The parallel environment.
+   * @param index       The index of the mesh file, either a `SectionIndex` or a `MeshIndex`.
+   * @returns The elements held by this rank.
+   */
+  template <class E, class I>
+  [[nodiscard]] ElementSet read_elements(std::istream& mesh_stream,
+                                         const cfg::utils::Parallel& parallel,
+                                         const I& index);
+
+  /**
+   * Reads the elements from a memory-mapped mesh file of a given encoding, see `read_elements` for
+   * streams.
+   *
+   * @tparam E          The encoding of the mesh file.
+   * @param mesh_stream The memory-mapped stream associated with the mesh file.
+   * @param parallel    The parallel environment.
+   * @param index       The index of the mesh file, either a `SectionIndex` or a `MeshIndex`.
+   * @returns The elements held by this rank.
+   */
+  template <class E, class I>
+  [[nodiscard]] ElementSet read_elements(cfg::reader::MappedStream& mesh_stream,
+                                         const cfg::utils::Parallel& parallel,
+                                         const I& index);
+
+  /**
+   * Reads the elements from a mesh file, dispatching on its mode. The file's `size_t` values are
+   * expected to be of the native width.
+   *
+   * @param mesh_stream The data stream associated with the mesh file.
+   * @param mode        Flag indicating whether the file was opened in ASCII or binary mode.
+   * @param parallel    The parallel environment.
+   * @param index       The index of the sections of the mesh file.
+   * @returns The elements held by this rank.
+   */
+  [[nodiscard]] ElementSet read_elements(std::istream& mesh_stream,
+                                         const Mode mode,
+                                         const cfg::utils::Parallel& parallel,
+                                         const cfg::reader::SectionIndex& index);
+
+  /**
+   * Reads the elements from a memory-mapped mesh file.
+   *
+   * @param mesh_stream The memory-mapped stream associated with the mesh file.
+   * @param mode        Flag indicating whether the file is in ASCII or binary mode.
+   * @param parallel    The parallel environment.
+   * @param index       The index of the sections of the mesh file.
+   * @returns The elements held by this rank.
+   */
+  [[nodiscard]] ElementSet read_elements(cfg::reader::MappedStream& mesh_stream,
+                                         const Mode mode,
+                                         const cfg::utils::Parallel& parallel,
+                                         const cfg::reader::SectionIndex& index);
+
+  /**
+   * Reads the elements from a mesh file, using the Elements section header and element block layout
+   * recorded in a mesh index to read only this rank's element blocks.
+   *
+   * @param mesh_stream The data stream associated with the mesh file.
+   * @param mode        Flag indicating whether the file was opened in ASCII or binary mode.
+   * @param parallel    The parallel environment.
+   * @param index       The index of the mesh file.
+   * @returns The elements held by this rank.
+   */
+  [[nodiscard]] ElementSet read_elements(std::istream& mesh_stream,
+                                         const Mode mode,
+                                         const cfg::utils::Parallel& parallel,
+                                         const cfg::reader::MeshIndex& index);
+
+  /**
+   * Reads the elements from a memory-mapped mesh file, using the Elements section header and element
+   * block layout recorded in a mesh index to read only this rank's element blocks.
+   *
+   * @param mesh_stream The memory-mapped stream associated with the mesh file.
+   * @param mode        Flag indicating whether the file is in ASCII or binary mode.
+   * @param parallel    The parallel environment.
+   * @param index       The index of the mesh file.
+   * @returns The elements held by this rank.
+   */
+  [[nodiscard]] ElementSet read_elements(cfg::reader::MappedStream& mesh_stream,
+                                         const Mode mode,
+                                         const cfg::utils::Parallel& parallel,
+                                         const cfg::reader::MeshIndex& index);
+}  // namespace cfg::parser
+
+#endif  // __CFG_ELEMENT_PARSER_H_
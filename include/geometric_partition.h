@@ -0,0 +1,124 @@
+/**
+ * geometric_partition.h
+ *
+ * Partitioning of mesh nodes based on their coordinates.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef __CFG_GEOMETRIC_PARTITION_H_
+#define __CFG_GEOMETRIC_PARTITION_H_
+
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+#include <mpi.h>
+
+#include <node_set.h>
+#include <utils.h>
+
+namespace cfg::utils
+{
+  /**
+   * Base class for partitions computed collectively from the node coordinates.
+   *
+   * Each rank holds some of the nodes, as read by the `DataParser`, and the partitioner assigns each
+   * of these a destination rank. The partition then describes the nodes assigned to this rank, which
+   * are identified by their global index.
+   */
+  class GeometricPartition : public Partition
+  {
+   public:
+    /**
+     * Determines whether a node is in this rank's partition.
+     *
+     * @param idx The global index of the node to test.
+     * @returns Whether the node is in the partition or not.
+     */
+    [[nodiscard]] bool pick(const size_t idx) const override;
+
+    /**
+     * Returns the number of nodes in this rank's partition.
+     */
+    [[nodiscard]] size_t size() const
+    {
+      return owned.size();
+    }
+
+    /**
+     * Returns the destination rank of each of the nodes held by this rank, in the order they were
+     * given to the partitioner.
+     */
+    [[nodiscard]] const std::vector<int>& destinations() const
+    {
+      return node_destinations;
+    }
+
+    /**
+     * Returns the load imbalance of the partition, i.e. the ratio of the largest partition size to
+     * the mean partition size. A perfectly balanced partition has an imbalance of 1.
+     */
+    [[nodiscard]] double imbalance() const
+    {
+      return load_imbalance;
+    }
+
+    /**
+     * Returns the bounding box of the nodes in each rank's partition, indexed by rank. The bounding
+     * box of an empty partition is inverted, i.e. its `min` is greater than its `max`.
+     */
+    [[nodiscard]] const std::vector<BoundingBox<3>>& bounding_boxes() const
+    {
+      return boxes;
+    }
+
+    /**
+     * Writes a summary of the partition, its imbalance and the bounding box of each rank's
+     * partition, to a stream.
+     *
+     * @param os The output stream.
+     */
+    void report(std::ostream& os) const;
+
+   protected:
+    /**
+     * Completes the partition once the destination of each node held by this rank has been set,
+     * this must be called collectively.
+     *
+     * @param nodes The nodes held by this rank.
+     * @param comm  The communicator the nodes are partitioned over.
+     */
+    void finalise(const cfg::parser::NodeSet<3>& nodes, MPI_Comm comm);
+
+    std::vector<int> node_destinations;  ///< The destination rank of each node held by this rank.
+
+   private:
+    std::vector<size_t> owned;          // The sorted global indices of the nodes in this partition
+    double load_imbalance{1.0};         // The ratio of the largest to the mean partition size
+    std::vector<BoundingBox<3>> boxes;  // The bounding box of each rank's partition
+  };
+
+  /**
+   * Partitions nodes by recursive coordinate bisection (RCB).
+   *
+   * The ranks are recursively split into two groups, and the nodes of each group are bisected along
+   * the longest axis of their bounding box, in proportion to the number of ranks on either side.
+   * The bisecting coordinate is located by a distributed median search: each step of a bisection
+   * over the ordered bit patterns of the coordinates requires one reduction of the counts of all
+   * groups, so the nodes are not moved until the partition is complete. Nodes with coordinates
+   * equal to the median are assigned in rank order to exactly balance the partition.
+   */
+  class RCBPartition : public GeometricPartition
+  {
+   public:
+    /**
+     * Constructs the RCB partition, this must be called collectively.
+     *
+     * @param nodes The nodes held by this rank.
+     * @param comm  The communicator the nodes are partitioned over.
+     */
+    RCBPartition(const cfg::parser::NodeSet<3>& nodes, MPI_Comm comm);
+  };
+}  // namespace cfg::utils
+
+#endif  // __CFG_GEOMETRIC_PARTITION_H_
@@ -0,0 +1,183 @@
+/**
+ * graph_partition.h
+ *
+ * Partitioning of the mesh cells by multilevel partitioning of their dual graph.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef __CFG_GRAPH_PARTITION_H_
+#define __CFG_GRAPH_PARTITION_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+#include <mpi.h>
+
+#include <dual_graph.h>
+#include <utils.h>
+
+namespace cfg::utils
+{
+  /**
+   * The default load imbalance tolerated by the graph partitioner, the largest part may be 3%
+   * heavier than the mean part.
+   */
+  constexpr double default_tolerance = 0.03;
+
+  /**
+   * A graph held by a single rank in CSR form with weighted vertices and edges: the neighbours of
+   * vertex `i` are `adjacency[offsets[i]]` to `adjacency[offsets[i + 1] - 1]`, and the weight of
+   * the edge to `adjacency[j]` is `edge_weights[j]`. The graph is undirected, each edge is held by
+   * both of its vertices with the same weight, and weights are positive.
+   */
+  struct WeightedGraph
+  {
+    std::vector<size_t> offsets{0};        ///< The offset of each vertex's neighbours, followed by the total
+    std::vector<size_t> adjacency;         ///< The neighbours of the vertices
+    std::vector<uint64_t> edge_weights;    ///< The weight of each edge, in the order of `adjacency`
+    std::vector<uint64_t> vertex_weights;  ///< The weight of each vertex
+
+    /**
+     * Returns the number of vertices of the graph.
+     */
+    [[nodiscard]] size_t size() const
+    {
+      return offsets.size() - 1;
+    }
+  };
+
+  /**
+   * Partitions a graph into parts of (nearly) equal vertex weight, minimising the weight of the
+   * edges cut.
+   *
+   * The graph is partitioned by recursive multilevel bisection: each bisection coarsens the graph
+   * by contracting a heavy-edge matching until it is small, bisects the coarsest graph by growing
+   * one half greedily from a seed vertex, and projects the bisection back through the levels,
+   * refining it on each by Fiduccia-Mattheyses passes that move boundary vertices by decreasing
+   * gain, allowing uphill moves and rolling back to the best partition seen. The best of several
+   * bisections is kept and its halves are partitioned recursively, the imbalance tolerated by each
+   * bisection compounding to `tolerance`. The parts are finally refined against each other by k-way
+   * passes.
+   *
+   * The refinement passes are serial, each move depending on the moves before it. The threads
+   * compute the bisections of a split and partition the two halves concurrently, and contract the
+   * coarse graphs, the result is independent of the number of threads.
+   *
+   * @param graph     The graph.
+   * @param n_parts   The number of parts.
+   * @param n_threads The number of threads.
+   * @param tolerance The load imbalance tolerated, as a fraction of the mean part weight.
+   * @returns The part of each vertex, in `[0, n_parts)`.
+   */
+  [[nodiscard]] std::vector<int> partition_graph(const WeightedGraph& graph,
+                                                 const size_t n_parts,
+                                                 const unsigned int n_threads = 1,
+                                                 const double tolerance       = default_tolerance);
+
+  /**
+   * Computes the edge cut of a partition, i.e. the total weight of the edges between parts.
+   *
+   * @param graph The graph.
+   * @param parts The part of each vertex.
+   * @returns The edge cut, each edge counted once.
+   */
+  [[nodiscard]] uint64_t partition_cut(const WeightedGraph& graph, const std::vector<int>& parts);
+
+  /**
+   * Computes the load imbalance of a partition, i.e. the ratio of the largest part weight to the
+   * mean part weight. A perfectly balanced partition has an imbalance of 1.
+   *
+   * @param graph   The graph.
+   * @param parts   The part of each vertex.
+   * @param n_parts The number of parts.
+   * @returns The load imbalance.
+   */
+  [[nodiscard]] double partition_imbalance(const WeightedGraph& graph,
+                                           const std::vector<int>& parts,
+                                           const size_t n_parts);
+
+  /**
+   * Partitions the vertices of a distributed graph, typically the cells of the mesh through its
+   * `DualGraph`, by multilevel partitioning with one part per rank.
+   *
+   * The graph is gathered on the first rank, which partitions it with `partition_graph` using its
+   * threads, and the destination of each vertex is returned to the rank holding it. The graph must
+   * therefore fit in the memory of a single rank. The partition then describes the vertices assigned
+   * to this rank, which are identified by their global index.
+   */
+  class GraphPartition : public Partition
+  {
+   public:
+    /**
+     * Constructs the graph partition, this must be called collectively.
+     *
+     * @param graph     The graph, distributed over the ranks.
+     * @param comm      The communicator the graph is distributed over.
+     * @param n_threads The number of threads used to partition the graph.
+     * @param tolerance The load imbalance tolerated, as a fraction of the mean part size.
+     */
+    GraphPartition(const DistributedGraph& graph,
+                   MPI_Comm comm,
+                   const unsigned int n_threads = 1,
+                   const double tolerance       = default_tolerance);
+
+    /**
+     * Determines whether a vertex is in this rank's partition.
+     *
+     * @param idx The global index of the vertex to test.
+     * @returns Whether the vertex is in the partition or not.
+     */
+    [[nodiscard]] bool pick(const size_t idx) const override;
+
+    /**
+     * Returns the number of vertices in this rank's partition.
+     */
+    [[nodiscard]] size_t size() const
+    {
+      return owned.size();
+    }
+
+    /**
+     * Returns the destination rank of each of the vertices held by this rank, in the order of the
+     * graph.
+     */
+    [[nodiscard]] const std::vector<int>& destinations() const
+    {
+      return vertex_destinations;
+    }
+
+    /**
+     * Returns the load imbalance of the partition, i.e. the ratio of the largest partition size to
+     * the mean partition size. A perfectly balanced partition has an imbalance of 1.
+     */
+    [[nodiscard]] double imbalance() const
+    {
+      return load_imbalance;
+    }
+
+    /**
+     * Returns the edge cut of the partition, i.e. the number of edges between ranks' partitions.
+     */
+    [[nodiscard]] uint64_t edge_cut() const
+    {
+      return cut;
+    }
+
+    /**
+     * Writes a summary of the partition, its imbalance and edge cut, to a stream.
+     *
+     * @param os The output stream.
+     */
+    void report(std::ostream& os) const;
+
+   private:
+    std::vector<int> vertex_destinations;  // The destination rank of each vertex held by this rank
+    std::vector<size_t> owned;             // The sorted global indices of the vertices in this partition
+    double load_imbalance{1.0};            // The ratio of the largest to the mean partition size
+    uint64_t cut{0};                       // The number of edges between partitions
+  };
+}  // namespace cfg::utils
+
+#endif  // __CFG_GRAPH_PARTITION_H_
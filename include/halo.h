@@ -0,0 +1,168 @@
+/**
+ * halo.h
+ *
+ * Construction of the halo of a partitioned mesh, the layers of ghost cells and nodes held by
+ * neighbouring ranks, and of the communication patterns that update the ghosts.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef __CFG_HALO_H_
+#define __CFG_HALO_H_
+
+#include <climits>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <mpi.h>
+
+#include <element_parser.h>
+#include <mpi_utils.h>
+#include <node_set.h>
+
+namespace cfg::utils
+{
+  /**
+   * The default number of layers of ghost cells.
+   */
+  constexpr unsigned int default_halo_depth = 1;
+
+  /**
+   * The pattern of a halo exchange of one kind of item, nodes or cells, with the neighbours of a
+   * `Halo`. The lists are in CSR form by neighbour: the items sent to `neighbours[k]` are
+   * `send_idx[send_offsets[k]]` to `send_idx[send_offsets[k + 1] - 1]`, and likewise for the items
+   * received. The items exchanged with a neighbour are ordered by their local index on the rank
+   * owning them, so the send list of one rank matches the receive list of its neighbour.
+   */
+  struct HaloPattern
+  {
+    std::vector<size_t> send_offsets{0};  ///< The offset of each neighbour's send list, followed by the total
+    std::vector<size_t> send_idx;         ///< The local indices of the owned items sent
+    std::vector<size_t> recv_offsets{0};  ///< The offset of each neighbour's receive list, followed by the total
+    std::vector<size_t> recv_idx;         ///< The indices in the halo of the ghost items received
+  };
+
+  /**
+   * The halo of a rank's partition of a mesh: the ghost cells within a number of layers of its
+   * cells, the ghost nodes completing its cells and the ghost cells, and the patterns exchanging
+   * them with the neighbouring ranks.
+   *
+   * The ghosts are indexed from zero in the order of their global index, separately from the owned
+   * items. An application storing the ghosts after its owned items offsets their indices by the
+   * number of owned items.
+   */
+  struct Halo
+  {
+    unsigned int depth{};              ///< The number of layers of ghost cells
+    std::vector<int> neighbours;       ///< The ranks sharing items with this rank, sorted
+    cfg::parser::NodeSet<3> nodes;     ///< The ghost nodes, ordered by global index
+    cfg::parser::ElementSet elements;  ///< The ghost cells, ordered by global index
+    HaloPattern node_pattern;          ///< The exchange of the ghost nodes
+    HaloPattern element_pattern;       ///< The exchange of the ghost cells
+  };
+
+  /**
+   * Builds the halo of a partitioned mesh, this must be called collectively.
+   *
+   * The cells are the elements of the highest dimension. The first layer of ghost cells are the
+   * cells of other ranks sharing a node with this rank's cells, and each further layer the cells
+   * sharing a node with the previous layer. The ghost nodes are the nodes of this rank's elements
+   * and of the ghost cells that this rank does not own. The cells containing each node, and the
+   * owner of each node, are found through directories distributed over the ranks by node tag, so
+   * the memory used is proportional to the local mesh and its halo. The directory tells each rank
+   * which of its nodes are shared with other ranks, only these are queried for the first layer, and
+   * the directory replies only with the cells of other ranks.
+   *
+   * @param nodes    The nodes owned by this rank, each node must be owned by exactly one rank.
+   * @param elements The elements owned by this rank, each element must be owned by exactly one rank.
+   * @param depth    The number of layers of ghost cells, with no layers the halo only completes
+   *                 this rank's elements with their nodes.
+   * @param comm     The communicator the mesh is partitioned over.
+   * @returns The halo.
+   */
+  [[nodiscard]] Halo build_halo(const cfg::parser::NodeSet<3>& nodes,
+                                const cfg::parser::ElementSet& elements,
+                                const unsigned int depth,
+                                MPI_Comm comm);
+
+  /**
+   * Creates the neighbourhood communicator of a halo with `MPI_Dist_graph_create_adjacent`, each
+   * rank's sources and destinations being its neighbours weighted by the number of items received
+   * and sent. This must be called collectively, the communicator must be freed by the caller.
+   *
+   * @param halo The halo of this rank.
+   * @param comm The communicator the mesh is partitioned over.
+   * @returns The neighbourhood communicator, with the ranks of `comm`.
+   */
+  [[nodiscard]] MPI_Comm halo_communicator(const Halo& halo, MPI_Comm comm);
+
+  /**
+   * Updates the values of the ghosts of a halo from their owners with `MPI_Neighbor_alltoallv`. This
+   * must be called collectively over the halo's neighbourhood communicator. The values must be
+   * trivially copyable, they are sent as bytes.
+   *
+   * @param owned     The values of the items owned by this rank, indexed by local index.
+   * @param pattern   The pattern of the exchange, the halo's `node_pattern` or `element_pattern`.
+   * @param halo_comm The neighbourhood communicator, see `halo_communicator`.
+   * @returns The values of the ghosts, indexed as in the halo.
+   */
+  template <class A>
+  [[nodiscard]] std::vector<typename A::value_type> exchange_halo(const A& owned,
+                                                                  const HaloPattern& pattern,
+                                                                  MPI_Comm halo_comm)
+  {
+    using T = typename A::value_type;
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be exchanged");
+
+    const auto n_neighbours = pattern.send_offsets.size() - 1;
+    if ((pattern.send_idx.size() > INT_MAX) || (pattern.recv_idx.size() > INT_MAX))
+    {
+      throw std::runtime_error("Too many values to exchange on a single rank");
+    }
+    std::vector<int> send_counts(n_neighbours);
+    std::vector<int> send_displs(n_neighbours);
+    std::vector<int> recv_counts(n_neighbours);
+    std::vector<int> recv_displs(n_neighbours);
+    for (size_t k = 0; k < n_neighbours; k++)
+    {
+      send_counts[k] = static_cast<int>(pattern.send_offsets[k + 1] - pattern.send_offsets[k]);
+      send_displs[k] = static_cast<int>(pattern.send_offsets[k]);
+      recv_counts[k] = static_cast<int>(pattern.recv_offsets[k + 1] - pattern.recv_offsets[k]);
+      recv_displs[k] = static_cast<int>(pattern.recv_offsets[k]);
+    }
+
+    std::vector<T> send(pattern.send_idx.size());
+    for (size_t i = 0; i < send.size(); i++)
+    {
+      send[i] = owned[pattern.send_idx[i]];
+    }
+
+    MPI_Datatype value_type = MPI_DATATYPE_NULL;
+    chkerr(MPI_Type_contiguous(sizeof(T), MPI_BYTE, &value_type), "MPI_Type_contiguous");
+    chkerr(MPI_Type_commit(&value_type), "MPI_Type_commit");
+
+    std::vector<T> recv(pattern.recv_idx.size());
+    chkerr(MPI_Neighbor_alltoallv(send.data(),
+                                  send_counts.data(),
+                                  send_displs.data(),
+                                  value_type,
+                                  recv.data(),
+                                  recv_counts.data(),
+                                  recv_displs.data(),
+                                  value_type,
+                                  halo_comm),
+           "MPI_Neighbor_alltoallv");
+    chkerr(MPI_Type_free(&value_type), "MPI_Type_free");
+
+    std::vector<T> ghosts(recv.size());
+    for (size_t i = 0; i < recv.size(); i++)
+    {
+      ghosts[pattern.recv_idx[i]] = recv[i];
+    }
+
+    return ghosts;
+  }
+}  // namespace cfg::utils
+
+#endif  // __CFG_HALO_H_
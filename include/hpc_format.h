@@ -0,0 +1,225 @@
+/**
+ * hpc_format.h
+ *
+ * Description of the CFGrid partitioned mesh format.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef __CFG_HPC_FORMAT_H_
+#define __CFG_HPC_FORMAT_H_
+
+#include <array>
+#include <cstdint>
+
+namespace cfg::hpc
+{
+  /**
+   * The partitioned mesh format stores a mesh as it was partitioned across ranks, so that a
+   * subsequent run can load it without parsing the original mesh file.
+   *
+   * The file consists of a `FileHeader`, a table of `PartEntry` (one per part, i.e. per rank that
+   * wrote the file) and the data of each part. The data of a part is contiguous, so each part can
+   * be loaded with a single read, and consists of the following arrays, each starting on an 8-byte
+   * boundary:
+   *
+   * - the natural and global indices of the nodes, `uint64_t`
+   * - the x, y and z coordinates of the nodes, `double`
+   * - the natural and global indices of the elements, `uint64_t`
+   * - the GMSH type of the elements, `int32_t`
+   * - the CSR offsets of the element nodes, `uint64_t`, starting from zero with the total last
+   * - the natural indices of the element nodes, `uint64_t`
+   *
+   * The file may also hold the halo of each part, see `cfg::utils::Halo`: a table of `HaloEntry`
+   * (one per part) followed by the halo data of each part, which is contiguous and consists of the
+   * following arrays, each starting on an 8-byte boundary:
+   *
+   * - the ranks of the neighbours, `int32_t`
+   * - the ghost nodes and ghost cells, stored as the nodes and elements of a part
+   * - the node exchange: the CSR offsets and local indices of the nodes sent to each neighbour,
+   *   then of the ghost nodes received, `uint64_t`
+   * - the cell exchange, stored as the node exchange
+   *
+   * Values are stored in the byte order of the writer, which is recorded in the header.
+   */
+  constexpr std::array<char, 8> magic{'C', 'F', 'G', 'M', 'E', 'S', 'H', '\0'};
+
+  /**
+   * The version of the partitioned mesh format. Version 2 added the halo, version 1 files are read
+   * as files without a halo.
+   */
+  constexpr uint32_t format_version = 2;
+
+  /**
+   * The byte order marker, as written by the writer.
+   */
+  constexpr uint32_t byte_order = 0x01020304;
+
+  /**
+   * The header of a partitioned mesh file.
+   */
+  struct FileHeader
+  {
+    std::array<char, 8> magic{};  ///< Identifies the file format.
+    uint32_t version{};           ///< The format version.
+    uint32_t byte_order{};        ///< The byte order marker.
+    uint64_t n_parts{};           ///< The number of parts.
+    uint64_t n_nodes{};           ///< The total number of nodes.
+    uint64_t n_elements{};        ///< The total number of elements.
+    uint64_t table_offset{};      ///< The offset of the part table in the file.
+    uint64_t data_offset{};       ///< The offset of the first part's data in the file.
+    uint64_t halo_offset{};       ///< The offset of the halo table in the file, zero without a halo.
+  };
+  static_assert(sizeof(FileHeader) == 64, "The FileHeader must have a fixed size");
+
+  /**
+   * An entry of the part table, describing one part.
+   */
+  struct PartEntry
+  {
+    uint64_t offset{};          ///< The offset of the part's data in the file.
+    uint64_t n_nodes{};         ///< The number of nodes in the part.
+    uint64_t n_elements{};      ///< The number of elements in the part.
+    uint64_t n_connectivity{};  ///< The total number of element nodes in the part.
+  };
+  static_assert(sizeof(PartEntry) == 32, "The PartEntry must have a fixed size");
+
+  /**
+   * An entry of the halo table, describing the halo of one part.
+   */
+  struct HaloEntry
+  {
+    uint64_t offset{};          ///< The offset of the part's halo data in the file.
+    uint64_t depth{};           ///< The number of layers of ghost cells.
+    uint64_t n_neighbours{};    ///< The number of neighbours of the part.
+    uint64_t n_nodes{};         ///< The number of ghost nodes.
+    uint64_t n_elements{};      ///< The number of ghost cells.
+    uint64_t n_connectivity{};  ///< The total number of ghost cell nodes.
+    uint64_t n_node_send{};     ///< The number of nodes sent to the neighbours.
+    uint64_t n_element_send{};  ///< The number of cells sent to the neighbours.
+  };
+  static_assert(sizeof(HaloEntry) == 64, "The HaloEntry must have a fixed size");
+
+  /**
+   * Places consecutive arrays in a block of data, each array starting on an 8 byte boundary.
+   */
+  struct LayoutBuilder
+  {
+    static constexpr uint64_t word = 8;  ///< The alignment of each array.
+
+    uint64_t offset{};  ///< The offset following the last array placed.
+
+    /**
+     * Places an array after the arrays already placed.
+     *
+     * @param count      The number of values of the array.
+     * @param value_size The size of each value.
+     * @returns The offset of the array.
+     */
+    uint64_t place(const uint64_t count, const uint64_t value_size)
+    {
+      const auto start = offset;
+      offset           = (offset + count * value_size + word - 1) / word * word;
+      return start;
+    }
+  };
+
+  /**
+   * The layout of a part's data, the offset of each array relative to the start of the part.
+   */
+  struct PartLayout
+  {
+    uint64_t node_natural_idx{};       ///< The offset of the node natural indices.
+    uint64_t node_global_idx{};        ///< The offset of the node global indices.
+    std::array<uint64_t, 3> node_x{};  ///< The offsets of the node coordinates.
+    uint64_t element_natural_idx{};    ///< The offset of the element natural indices.
+    uint64_t element_global_idx{};     ///< The offset of the element global indices.
+    uint64_t element_type{};           ///< The offset of the element types.
+    uint64_t element_offsets{};        ///< The offset of the element CSR offsets.
+    uint64_t element_nodes{};          ///< The offset of the element nodes.
+    uint64_t size{};                   ///< The size of the part's data, a multiple of 8 bytes.
+
+    /**
+     * Computes the layout of a part's data.
+     *
+     * @param entry The part's table entry.
+     */
+    explicit PartLayout(const PartEntry& entry)
+    {
+      LayoutBuilder layout;
+
+      node_natural_idx = layout.place(entry.n_nodes, sizeof(uint64_t));
+      node_global_idx  = layout.place(entry.n_nodes, sizeof(uint64_t));
+      for (auto& x : node_x)
+      {
+        x = layout.place(entry.n_nodes, sizeof(double));
+      }
+      element_natural_idx = layout.place(entry.n_elements, sizeof(uint64_t));
+      element_global_idx  = layout.place(entry.n_elements, sizeof(uint64_t));
+      element_type        = layout.place(entry.n_elements, sizeof(int32_t));
+      element_offsets     = layout.place(entry.n_elements + 1, sizeof(uint64_t));
+      element_nodes       = layout.place(entry.n_connectivity, sizeof(uint64_t));
+      size                = layout.offset;
+    }
+  };
+
+  /**
+   * The layout of a part's halo data, the offset of each array relative to the start of the halo
+   * data. The ghosts are received from the neighbours exactly once, so the number of ghosts received
+   * is the number of ghosts.
+   */
+  struct HaloLayout
+  {
+    uint64_t neighbours{};            ///< The offset of the neighbour ranks.
+    PartLayout ghosts;                ///< The layout of the ghost nodes and cells.
+    uint64_t node_send_offsets{};     ///< The offset of the CSR offsets of the nodes sent.
+    uint64_t node_send_idx{};         ///< The offset of the local indices of the nodes sent.
+    uint64_t node_recv_offsets{};     ///< The offset of the CSR offsets of the nodes received.
+    uint64_t node_recv_idx{};         ///< The offset of the halo indices of the nodes received.
+    uint64_t element_send_offsets{};  ///< The offset of the CSR offsets of the cells sent.
+    uint64_t element_send_idx{};      ///< The offset of the local indices of the cells sent.
+    uint64_t element_recv_offsets{};  ///< The offset of the CSR offsets of the cells received.
+    uint64_t element_recv_idx{};      ///< The offset of the halo indices of the cells received.
+    uint64_t size{};                  ///< The size of the part's halo data, a multiple of 8 bytes.
+
+    /**
+     * Computes the layout of a part's halo data.
+     *
+     * @param entry The part's halo table entry.
+     */
+    explicit HaloLayout(const HaloEntry& entry)
+        : ghosts{PartEntry{0, entry.n_nodes, entry.n_elements, entry.n_connectivity}}
+    {
+      LayoutBuilder layout;
+
+      neighbours = layout.place(entry.n_neighbours, sizeof(int32_t));
+
+      // The ghosts are laid out as a part, shifted to follow the neighbours
+      const auto ghosts_start = layout.place(ghosts.size, 1);
+      for (auto* array : {&ghosts.node_natural_idx,
+                          &ghosts.node_global_idx,
+                          &ghosts.node_x[0],
+                          &ghosts.node_x[1],
+                          &ghosts.node_x[2],
+                          &ghosts.element_natural_idx,
+                          &ghosts.element_global_idx,
+                          &ghosts.element_type,
+                          &ghosts.element_offsets,
+                          &ghosts.element_nodes})
+      {
+        *array += ghosts_start;
+      }
+
+      node_send_offsets    = layout.place(entry.n_neighbours + 1, sizeof(uint64_t));
+      node_send_idx        = layout.place(entry.n_node_send, sizeof(uint64_t));
+      node_recv_offsets    = layout.place(entry.n_neighbours + 1, sizeof(uint64_t));
+      node_recv_idx        = layout.place(entry.n_nodes, sizeof(uint64_t));
+      element_send_offsets = layout.place(entry.n_neighbours + 1, sizeof(uint64_t));
+      element_send_idx     = layout.place(entry.n_element_send, sizeof(uint64_t));
+      element_recv_offsets = layout.place(entry.n_neighbours + 1, sizeof(uint64_t));
+      element_recv_idx     = layout.place(entry.n_elements, sizeof(uint64_t));
+      size                 = layout.offset;
+    }
+  };
+}  // namespace cfg::hpc
+
+#endif  // __CFG_HPC_FORMAT_H_
@@ -0,0 +1,88 @@
+/**
+ * hpc_reader.h
+ *
+ * Loading of partitioned meshes written in the CFGrid partitioned mesh format.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef __CFG_HPC_READER_H_
+#define __CFG_HPC_READER_H_
+
+#include <cstdint>
+#include <filesystem>
+
+#include <mpi.h>
+
+#include <element_parser.h>
+#include <halo.h>
+#include <hpc_format.h>
+#include <node_set.h>
+#include <partitioned_mesh.h>
+#include <utils.h>
+
+namespace cfg::hpc
+{
+  /**
+   * Describes which parts of a partitioned mesh file a rank loads.
+   *
+   * When there are at least as many parts as ranks each rank loads a range of neighbouring parts,
+   * which are merged. Otherwise each part is split into pieces over a range of neighbouring ranks,
+   * and each rank loads one piece of a single part.
+   */
+  struct PartAssignment
+  {
+    uint64_t first{};     ///< The first part loaded by this rank.
+    uint64_t count{};     ///< The number of parts loaded by this rank.
+    uint64_t piece{};     ///< The piece of the part loaded by this rank, when a part is split.
+    uint64_t n_pieces{};  ///< The number of pieces the part is split into, 1 if parts are merged.
+  };
+
+  /**
+   * Assigns the parts of a partitioned mesh file to a rank.
+   *
+   * @param n_parts  The number of parts in the file.
+   * @param parallel The parallel environment.
+   * @returns The parts assigned to this rank.
+   */
+  [[nodiscard]] PartAssignment assign_parts(const uint64_t n_parts, const cfg::utils::Parallel& parallel);
+
+  /**
+   * Reads the header of a partitioned mesh file, checking that it is a partitioned mesh file that
+   * can be read.
+   *
+   * @param mesh_file The filepath to a partitioned mesh file.
+   * @returns The file header.
+   */
+  [[nodiscard]] FileHeader read_header(const std::filesystem::path& mesh_file);
+
+  /**
+   * Loads this rank's partition of a partitioned mesh file. This must be called by all ranks in the
+   * communicator.
+   *
+   * Rank 0 reads the header and part table, which are broadcast to the other ranks. If the number
+   * of ranks matches the number of parts, or is smaller, the parts assigned to a rank are contiguous
+   * in the file and all ranks load their data with a single collective read, merging the parts if
+   * required. If there are more ranks than parts, each part is split into contiguous ranges of its
+   * nodes and elements which are read directly from the part's arrays. Nodes and elements retain
+   * the global indices they were written with, the mesh is not repartitioned.
+   *
+   * @param mesh_file The filepath to a partitioned mesh file.
+   * @param comm      The communicator to load the mesh over.
+   * @returns This rank's partition of the mesh.
+   */
+  [[nodiscard]] PartitionedMesh read_mesh(const std::filesystem::path& mesh_file, MPI_Comm comm);
+
+  /**
+   * Loads this rank's halo from a partitioned mesh file written with halos. This must be called by
+   * all ranks in the communicator, which must have as many ranks as the file has parts since the
+   * halo refers to the local indices of each part. An error is raised on every rank if the file has
+   * no halo or the number of ranks differs.
+   *
+   * @param mesh_file The filepath to a partitioned mesh file.
+   * @param comm      The communicator to load the halo over.
+   * @returns This rank's halo.
+   */
+  [[nodiscard]] cfg::utils::Halo read_halo(const std::filesystem::path& mesh_file, MPI_Comm comm);
+}  // namespace cfg::hpc
+
+#endif  // __CFG_HPC_READER_H_
@@ -0,0 +1,58 @@
+/**
+ * hpc_writer.h
+ *
+ * Writing of partitioned meshes in the CFGrid partitioned mesh format.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef __CFG_HPC_WRITER_H_
+#define __CFG_HPC_WRITER_H_
+
+#include <filesystem>
+
+#include <mpi.h>
+
+#include <element_parser.h>
+#include <halo.h>
+#include <hpc_format.h>
+#include <node_set.h>
+
+namespace cfg::hpc
+{
+  /**
+   * Writes a partitioned mesh, each rank's nodes and elements are written as one part. This must be
+   * called by all ranks in the communicator.
+   *
+   * Each rank packs its part into a single buffer and all ranks write their parts in parallel with
+   * one collective MPI-IO operation, rank 0 additionally writes the header and part table. Any
+   * existing file is replaced.
+   *
+   * @param mesh_file The filepath to write.
+   * @param nodes     The nodes held by this rank.
+   * @param elements  The elements held by this rank.
+   * @param comm      The communicator the mesh is partitioned over.
+   */
+  void write_mesh(const std::filesystem::path& mesh_file,
+                  const cfg::parser::NodeSet<3>& nodes,
+                  const cfg::parser::ElementSet& elements,
+                  MPI_Comm comm);
+
+  /**
+   * Writes a partitioned mesh with the halo of each part, see `write_mesh` above. Each rank's halo
+   * is packed into a second buffer written after the parts, so that the mesh can still be loaded
+   * on any number of ranks while the halo is loaded on the number of ranks that wrote it.
+   *
+   * @param mesh_file The filepath to write.
+   * @param nodes     The nodes held by this rank.
+   * @param elements  The elements held by this rank.
+   * @param halo      The halo of this rank, see `cfg::utils::build_halo`.
+   * @param comm      The communicator the mesh is partitioned over.
+   */
+  void write_mesh(const std::filesystem::path& mesh_file,
+                  const cfg::parser::NodeSet<3>& nodes,
+                  const cfg::parser::ElementSet& elements,
+                  const cfg::utils::Halo& halo,
+                  MPI_Comm comm);
+}  // namespace cfg::hpc
+
+#endif  // __CFG_HPC_WRITER_H_
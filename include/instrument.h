@@ -0,0 +1,227 @@
+/**
+ * instrument.h
+ *
+ * Lightweight instrumentation of the mesh reading hot paths: scoped phase timers and event
+ * counters, reduced over the ranks into a per-phase report.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef __CFG_INSTRUMENT_H_
+#define __CFG_INSTRUMENT_H_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+#include <mpi.h>
+
+namespace cfg::utils
+{
+  /**
+   * The phases of reading a mesh that are timed.
+   *
+   * Phases may nest, e.g. `PARTITION_FILTER` is measured within `DATA_PARSE`, so the phase times
+   * do not sum to the total time.
+   */
+  enum class Phase
+  {
+    DETECT_FORMAT,     ///< Determining the format of the mesh file.
+    READ_HEADER,       ///< Reading the mesh file header.
+    SECTION_SEARCH,    ///< Locating the sections of the mesh file, or loading its index.
+    HEADER_PARSE,      ///< Parsing the header of a section.
+    DATA_PARSE,        ///< Parsing the data of a section.
+    PARTITION_FILTER,  ///< Selecting the data held by this rank.
+    VALIDATION,        ///< Validating the data read.
+    N_PHASES           ///< The number of phases, not a phase.
+  };
+
+  /**
+   * The events of reading a mesh that are counted.
+   */
+  enum class Counter
+  {
+    BYTES_SCANNED,  ///< Bytes of the mesh file scanned to locate its sections.
+    BYTES_READ,     ///< Bytes of the node and element sections read by this rank.
+    TOKENS_PARSED,  ///< Values read from the node and element data, numbers in ASCII mode.
+    BLOCKS,         ///< Node and element blocks visited.
+    NODES,          ///< Nodes held by this rank.
+    ELEMENTS,       ///< Elements held by this rank.
+    N_COUNTERS      ///< The number of counters, not a counter.
+  };
+
+  constexpr size_t n_phases   = static_cast<size_t>(Phase::N_PHASES);    ///< The number of phases.
+  constexpr size_t n_counters = static_cast<size_t>(Counter::N_COUNTERS);  ///< The number of counters.
+
+  /**
+   * The name of a phase, as reported.
+   */
+  [[nodiscard]] std::string_view phase_name(const Phase phase);
+
+  /**
+   * The name of a counter, as reported.
+   */
+  [[nodiscard]] std::string_view counter_name(const Counter counter);
+
+  /**
+   * A copy of the instrumentation data of a rank.
+   */
+  struct Profile
+  {
+    std::array<double, n_phases> seconds{};     ///< The time spent in each phase.
+    std::array<uint64_t, n_phases> calls{};     ///< The number of times each phase was entered.
+    std::array<uint64_t, n_counters> counts{};  ///< The value of each counter.
+  };
+
+  /**
+   * The statistics of a value over the ranks.
+   */
+  struct Stats
+  {
+    double min{};   ///< The minimum over the ranks.
+    double max{};   ///< The maximum over the ranks.
+    double mean{};  ///< The mean over the ranks.
+  };
+
+  /**
+   * The instrumentation data of every rank, and its statistics over the ranks.
+   */
+  struct ProfileReport
+  {
+    std::vector<Profile> ranks;              ///< The data of each rank, held only by the root.
+    std::array<Stats, n_phases> seconds{};   ///< The statistics of the time spent in each phase.
+    std::array<Stats, n_counters> counts{};  ///< The statistics of each counter.
+  };
+
+  namespace instrument
+  {
+    // The instrumentation state of this process, shared by its threads. Updates are relaxed atomic
+    // additions, they are only ordered by the synchronisation of the threads themselves.
+    inline std::atomic<bool> enabled{false};
+    inline std::array<std::atomic<uint64_t>, n_phases> nanoseconds{};
+    inline std::array<std::atomic<uint64_t>, n_phases> calls{};
+    inline std::array<std::atomic<uint64_t>, n_counters> counts{};
+  }  // namespace instrument
+
+  /**
+   * Returns whether instrumentation is enabled, disabled by default.
+   */
+  [[nodiscard]] inline bool profiling() noexcept
+  {
+    return instrument::enabled.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Enables or disables instrumentation, the data recorded so far is kept.
+   */
+  inline void set_profiling(const bool enable) noexcept
+  {
+    instrument::enabled.store(enable, std::memory_order_relaxed);
+  }
+
+  /**
+   * Adds to a counter if instrumentation is enabled.
+   *
+   * @param counter The counter.
+   * @param n       The amount to add.
+   */
+  inline void count(const Counter counter, const uint64_t n) noexcept
+  {
+    if (profiling())
+    {
+      instrument::counts[static_cast<size_t>(counter)].fetch_add(n, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * Times a phase from its construction to its destruction, if instrumentation is enabled on
+   * construction. When instrumentation is disabled this costs a load and a branch.
+   */
+  class ScopedTimer
+  {
+   public:
+    /**
+     * Starts timing a phase.
+     *
+     * @param phase The phase.
+     */
+    explicit ScopedTimer(const Phase phase) noexcept : phase(phase), active(profiling())
+    {
+      if (active)
+      {
+        start = std::chrono::steady_clock::now();
+      }
+    }
+
+    /**
+     * Stops timing the phase, adding the elapsed time to the phase.
+     */
+    ~ScopedTimer()
+    {
+      if (active)
+      {
+        const auto elapsed = std::chrono::steady_clock::now() - start;
+        const auto idx     = static_cast<size_t>(phase);
+        instrument::nanoseconds[idx].fetch_add(
+            static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()),
+            std::memory_order_relaxed);
+        instrument::calls[idx].fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+
+    ScopedTimer(const ScopedTimer&)            = delete;
+    ScopedTimer(ScopedTimer&&)                 = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(ScopedTimer&&)      = delete;
+
+   private:
+    Phase phase;                                  // The phase being timed
+    bool active;                                  // Whether the phase is being timed
+    std::chrono::steady_clock::time_point start;  // The start of the phase
+  };
+
+  /**
+   * Returns a copy of this rank's instrumentation data.
+   */
+  [[nodiscard]] Profile profile();
+
+  /**
+   * Clears this rank's instrumentation data.
+   */
+  void reset_profile();
+
+  /**
+   * Collectively reduces the instrumentation data of the ranks of a communicator.
+   *
+   * @param local The instrumentation data of this rank.
+   * @param comm  The communicator.
+   * @param root  The rank gathering the data of every rank.
+   * @returns The report, the statistics are held by every rank and the data of each rank only by
+   *          the root.
+   */
+  [[nodiscard]] ProfileReport reduce_profile(const Profile& local, MPI_Comm comm, const int root = 0);
+
+  /**
+   * Writes a report as a table of the statistics of each phase and counter.
+   *
+   * @param os     The output stream.
+   * @param report The report.
+   */
+  void write_profile_table(std::ostream& os, const ProfileReport& report);
+
+  /**
+   * Writes a report as JSON, giving the number of ranks as `n_ranks` and, for each phase and
+   * counter, the statistics over the ranks as `stats` and the value of each rank as `ranks`. The
+   * phases also give the number of calls of each rank as `calls`. Times are in seconds.
+   *
+   * @param os     The output stream.
+   * @param report The report, as held by the root.
+   */
+  void write_profile_json(std::ostream& os, const ProfileReport& report);
+}  // namespace cfg::utils
+
+#endif  // __CFG_INSTRUMENT_H_
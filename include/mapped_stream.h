@@ -0,0 +1,390 @@
+/**
+ * mapped_stream.h
+ *
+ * A memory-mapped alternative to `std::ifstream` for reading mesh files.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef __CFG_MAPPED_STREAM_H_
+#define __CFG_MAPPED_STREAM_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <ios>
+#include <istream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <number_parser.h>
+
+namespace cfg::reader
+{
+  /**
+   * A custom exception class that is raised by `CFGrid` when a file cannot be memory-mapped.
+   */
+  class mapping_error : public std::runtime_error
+  {
+   public:
+    /**
+     * Constructor for the `mapping_error` error.
+     *
+     * @param msg The message to be returned as part of the error.
+     */
+    mapping_error(const std::string& msg) : std::runtime_error{msg} {};
+  };
+
+  /**
+   * A read-only memory-mapping of a file, the mapping is released when the object is destroyed.
+   */
+  class MappedFile
+  {
+   public:
+    /**
+     * Maps a file into memory for reading, raises a `mapping_error` if this fails.
+     *
+     * @param path The path to the file.
+     */
+    explicit MappedFile(const std::filesystem::path& path);
+    ~MappedFile();
+
+    // The mapping is owned by this object, copying or moving it would result in a double unmap.
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile(MappedFile&&)                 = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&&)      = delete;
+
+    /**
+     * Returns a view of the mapped bytes.
+     */
+    [[nodiscard]] std::string_view bytes() const
+    {
+      return {addr, length};
+    }
+
+   private:
+    const char* addr{nullptr};  // Start of the mapping
+    size_t length{0};           // Size of the mapping in bytes
+  };
+
+  /**
+   * Provides a stream-like interface to a read-only span of bytes, typically a `MappedFile`.
+   *
+   * This implements the subset of the `std::istream` interface used by `CFGrid` to read meshes so
+   * that the readers and parsers can operate on either, the state flags follow the `std::istream`
+   * semantics. As the bytes are accessed in place, no intermediate buffering/copying takes place.
+   */
+  class MappedStream
+  {
+   public:
+    using pos_type = std::istream::pos_type;  ///< Type used to locate the cursor in the stream.
+    using off_type = std::istream::off_type;  ///< Type used to offset the cursor in the stream.
+
+    /**
+     * Constructs a `MappedStream` over a span of bytes, the bytes must outlive the stream.
+     *
+     * @param bytes The bytes to be read.
+     */
+    explicit MappedStream(const std::string_view bytes) : bytes(bytes) {}
+
+    /**
+     * Constructs a `MappedStream` over a `MappedFile`, the mapping must outlive the stream.
+     *
+     * @param file The memory-mapped file to be read.
+     */
+    explicit MappedStream(const MappedFile& file) : MappedStream(file.bytes()) {}
+
+    /**
+     * Returns the complete span of bytes underlying the stream.
+     */
+    [[nodiscard]] std::string_view view() const
+    {
+      return bytes;
+    }
+
+    /**
+     * Tests whether the end of the stream was reached.
+     */
+    [[nodiscard]] bool eof() const
+    {
+      return (state & std::ios::eofbit) != 0;
+    }
+
+    /**
+     * Tests whether an operation on the stream failed.
+     */
+    [[nodiscard]] bool fail() const
+    {
+      return (state & (std::ios::failbit | std::ios::badbit)) != 0;
+    }
+
+    /**
+     * Tests whether the stream is in a good state.
+     */
+    [[nodiscard]] bool good() const
+    {
+      return state == std::ios::goodbit;
+    }
+
+    /**
+     * Tests whether the stream is in a usable state, i.e. the last operation did not fail.
+     */
+    explicit operator bool() const
+    {
+      return !fail();
+    }
+
+    /**
+     * Resets the stream state flags.
+     */
+    void clear()
+    {
+      state = std::ios::goodbit;
+    }
+
+    /**
+     * Returns the current location in the stream, or `-1` if the stream has failed.
+     */
+    [[nodiscard]] pos_type tellg() const
+    {
+      if (fail())
+      {
+        return pos_type(off_type(-1));
+      }
+      return pos_type(off_type(cursor));
+    }
+
+    /**
+     * Seeks an absolute location in the stream.
+     *
+     * @param pos The location to move to.
+     * @returns   The stream.
+     */
+    MappedStream& seekg(const pos_type pos)
+    {
+      return seekg(off_type(pos), std::ios::beg);
+    }
+
+    /**
+     * Seeks a location in the stream, relative to the beginning, end or current location.
+     *
+     * @param off The offset to move by.
+     * @param dir The position the offset is relative to.
+     * @returns   The stream.
+     */
+    MappedStream& seekg(const off_type off, const std::ios::seekdir dir)
+    {
+      state &= ~std::ios::eofbit;
+      if (fail())
+      {
+        return *this;
+      }
+
+      const auto base = [this, dir]() -> off_type
+      {
+        if (dir == std::ios::beg)
+        {
+          return 0;
+        }
+        if (dir == std::ios::end)
+        {
+          return static_cast<off_type>(bytes.size());
+        }
+        return static_cast<off_type>(cursor);
+      }();
+
+      const auto target = base + off;
+      if ((target < 0) || (target > static_cast<off_type>(bytes.size())))
+      {
+        state |= std::ios::failbit;
+      }
+      else
+      {
+        cursor = static_cast<size_t>(target);
+      }
+
+      return *this;
+    }
+
+    /**
+     * Reads a number of bytes from the stream, if insufficient bytes remain those available are read
+     * and the stream is set to fail.
+     *
+     * @param dst   The destination to read into.
+     * @param count The number of bytes to read.
+     * @returns     The stream.
+     */
+    MappedStream& read(char* dst, const std::streamsize count)
+    {
+      if (fail())
+      {
+        return *this;
+      }
+
+      const auto nbytes = std::min(static_cast<size_t>(count), bytes.size() - cursor);
+      std::memcpy(dst, bytes.data() + cursor, nbytes);  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      cursor += nbytes;
+      if (nbytes < static_cast<size_t>(count))
+      {
+        state |= std::ios::eofbit | std::ios::failbit;
+      }
+
+      return *this;
+    }
+
+    /**
+     * Skips a number of bytes in the stream.
+     *
+     * @param count The number of bytes to skip.
+     * @returns     The stream.
+     */
+    MappedStream& ignore(const std::streamsize count = 1)
+    {
+      if (fail())
+      {
+        return *this;
+      }
+
+      const auto nbytes = std::min(static_cast<size_t>(count), bytes.size() - cursor);
+      cursor += nbytes;
+      if (nbytes < static_cast<size_t>(count))
+      {
+        state |= std::ios::eofbit;
+      }
+
+      return *this;
+    }
+
+    /**
+     * Extracts a formatted number from the stream, the number is parsed in place by the fast number
+     * parser.
+     *
+     * @param val The destination the value is written into.
+     * @returns   The stream.
+     */
+    template <class T, std::enable_if_t<std::is_arithmetic_v<T>, bool> = true>
+    MappedStream& operator>>(T& val)
+    {
+      if (!skip_space())
+      {
+        return *this;
+      }
+
+      const auto* const first = bytes.data() + cursor;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      const auto* const last  = bytes.data() + bytes.size();  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      const auto [ptr, ec]    = cfg::utils::parse_number(first, last, val);
+      if (ec != std::errc{})
+      {
+        state |= std::ios::failbit;
+        return *this;
+      }
+
+      cursor += static_cast<size_t>(ptr - first);
+      if (cursor == bytes.size())
+      {
+        state |= std::ios::eofbit;
+      }
+
+      return *this;
+    }
+
+    /**
+     * Extracts a whitespace-delimited word from the stream.
+     *
+     * @param val The string the word is written into.
+     * @returns   The stream.
+     */
+    MappedStream& operator>>(std::string& val)
+    {
+      if (!skip_space())
+      {
+        return *this;
+      }
+
+      const auto start = cursor;
+      while ((cursor < bytes.size()) && !cfg::utils::is_space(bytes[cursor]))
+      {
+        cursor++;
+      }
+      val.assign(bytes.substr(start, cursor - start));
+      if (cursor == bytes.size())
+      {
+        state |= std::ios::eofbit;
+      }
+
+      return *this;
+    }
+
+    /**
+     * Reads a line from the stream, analogous to `std::getline`.
+     *
+     * @param stream The stream being read.
+     * @param line   The string the line is written into, excluding the newline.
+     * @returns      The stream.
+     */
+    friend MappedStream& getline(MappedStream& stream, std::string& line)
+    {
+      line.clear();
+      if (stream.fail())
+      {
+        return stream;
+      }
+      if (stream.cursor == stream.bytes.size())
+      {
+        stream.state |= std::ios::eofbit | std::ios::failbit;
+        return stream;
+      }
+
+      const auto tail = stream.bytes.substr(stream.cursor);
+      const auto eol  = tail.find('\n');
+      if (eol == std::string_view::npos)
+      {
+        line.assign(tail);
+        stream.cursor = stream.bytes.size();
+        stream.state |= std::ios::eofbit;
+      }
+      else
+      {
+        line.assign(tail.substr(0, eol));
+        stream.cursor += eol + 1;
+      }
+
+      return stream;
+    }
+
+   private:
+    std::string_view bytes;                     // The bytes being read
+    size_t cursor{0};                           // Current location in the bytes
+    std::ios::iostate state{std::ios::goodbit};  // The stream state flags
+
+    /**
+     * Skips any whitespace ahead of the next formatted extraction, setting the stream state if the
+     * end of stream is reached.
+     *
+     * @returns Whether there is anything left to extract (`true`) or not (`false`).
+     */
+    [[nodiscard]] bool skip_space()
+    {
+      if (fail())
+      {
+        return false;
+      }
+      while ((cursor < bytes.size()) && cfg::utils::is_space(bytes[cursor]))
+      {
+        cursor++;
+      }
+      if (cursor == bytes.size())
+      {
+        state |= std::ios::eofbit | std::ios::failbit;
+        return false;
+      }
+
+      return true;
+    }
+  };
+}  // namespace cfg::reader
+
+#endif  // __CFG_MAPPED_STREAM_H_
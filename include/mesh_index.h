@@ -0,0 +1,193 @@
+/**
+ * mesh_index.h
+ *
+ * An index of the layout of a GMSH file, which may be cached in a sidecar file next to the mesh so
+ * that repeated loads of the same mesh skip locating its data.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef __CFG_MESH_INDEX_H_
+#define __CFG_MESH_INDEX_H_
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <utility>
+
+#include <_element_parser.h>
+#include <_node_parser.h>
+#include <section_index.h>
+#include <section_reader.h>
+
+namespace cfg::reader
+{
+  /**
+   * The layout of a GMSH file: the location of each section, the Nodes and Elements section headers
+   * and the location of each node and element block.
+   */
+  struct MeshIndex
+  {
+    SectionIndex sections;                        ///< The sections of the file.
+    cfg::parser::NodeHeader node_header{};        ///< The Nodes section header.
+    cfg::parser::NodeLayout nodes;                ///< The layout of the node blocks.
+    cfg::parser::ElementHeader element_header{};  ///< The Elements section header.
+    cfg::parser::ElementLayout elements;          ///< The layout of the element blocks.
+  };
+
+  /**
+   * Identifies the contents of a mesh file, an index cached for a mesh file is only valid while the
+   * key is unchanged.
+   */
+  struct FileKey
+  {
+    uint64_t size{};  ///< The size of the file in bytes.
+    int64_t mtime{};  ///< The last modification time of the file, in the filesystem clock's ticks.
+    uint64_t hash{};  ///< A hash of samples of the file contents.
+
+    [[nodiscard]] bool operator==(const FileKey& other) const
+    {
+      return (size == other.size) && (mtime == other.mtime) && (hash == other.hash);
+    }
+  };
+
+  /**
+   * Computes the key of a mesh file.
+   *
+   * The contents are hashed (64-bit FNV-1a) from evenly spaced samples covering the start and end of
+   * the file, so that the cost of computing the key is bounded for large meshes, small files are
+   * hashed in full.
+   *
+   * @param mesh_file The path to the mesh file.
+   * @returns The key of the file.
+   */
+  [[nodiscard]] FileKey file_key(const std::filesystem::path& mesh_file);
+
+  /**
+   * Returns the path of the sidecar index file of a mesh file, `<mesh_file>.cfgidx`.
+   *
+   * @param mesh_file The path to the mesh file.
+   * @returns The path to the index file.
+   */
+  [[nodiscard]] std::filesystem::path index_path(const std::filesystem::path& mesh_file);
+
+  /**
+   * Writes an index file, the file is written under a temporary name and renamed into place so that
+   * concurrent readers never see a partial index.
+   *
+   * @param index_file The path to the index file.
+   * @param key        The key of the mesh file the index describes.
+   * @param index      The mesh index.
+   * @returns Whether the index file was written (`true`) or not (`false`), e.g. if the directory is
+   *          not writable.
+   */
+  bool write_index(const std::filesystem::path& index_file, const FileKey& key, const MeshIndex& index);
+
+  /**
+   * Reads an index file.
+   *
+   * @param index_file The path to the index file.
+   * @param key        The key of the mesh file the index should describe.
+   * @returns The mesh index, or `std::nullopt` if the index file is missing, unreadable or stale,
+   *          i.e. it was written for a different key.
+   */
+  [[nodiscard]] std::optional<MeshIndex> read_index(const std::filesystem::path& index_file, const FileKey& key);
+
+  /**
+   * Builds the index of a mesh file of a given encoding by scanning it. The sections are located in
+   * a single pass, then the Nodes and Elements section headers are parsed and their block headers
+   * scanned, skipping the node and element data.
+   *
+   * @tparam E          The encoding of the mesh file, see `cfg::parser::Encoding`.
+   * @param mesh_stream The mesh data stream.
+   * @returns The mesh index.
+   */
+  template <class E, class S>
+  [[nodiscard]] MeshIndex build_mesh_index(S& mesh_stream)
+  {
+    MeshIndex index;
+    index.sections = SectionIndex{mesh_stream};
+
+    const SectionReader node_reader("Nodes", mesh_stream, index.sections);
+    index.node_header = cfg::parser::HeaderParser::parse<E>(node_reader, mesh_stream);
+    index.nodes       = cfg::parser::scan_node_layout<E>(node_reader, mesh_stream, index.node_header);
+
+    const SectionReader element_reader("Elements", mesh_stream, index.sections);
+    index.element_header = cfg::parser::ElementHeaderParser::parse<E>(element_reader, mesh_stream);
+    index.elements       = cfg::parser::scan_element_layout<E>(element_reader, mesh_stream, index.element_header);
+
+    return index;
+  }
+
+  /**
+   * Builds the index of a mesh file by scanning it, see `build_mesh_index` for an encoding. The
+   * file's `size_t` values are expected to be of the native width.
+   *
+   * @param mesh_stream The mesh data stream.
+   * @param mode        Indicates the data mode of the mesh stream, currently either ASCII or BINARY.
+   * @returns The mesh index.
+   */
+  template <class S>
+  [[nodiscard]] MeshIndex build_mesh_index(S& mesh_stream, const cfg::parser::Mode mode)
+  {
+    return cfg::parser::with_encoding(mode,
+                                      [&mesh_stream](auto encoding) -> MeshIndex
+                                      {
+                                        return build_mesh_index<decltype(encoding)>(mesh_stream);
+                                      });
+  }
+
+  /**
+   * Loads the index of a mesh file of a given encoding from its sidecar index file, if this is
+   * missing or stale the index is rebuilt by scanning the mesh and optionally written to the sidecar.
+   *
+   * @tparam E          The encoding of the mesh file, see `cfg::parser::Encoding`.
+   * @param mesh_file   The path to the mesh file.
+   * @param mesh_stream The mesh data stream.
+   * @param write       Whether a rebuilt index is written to the sidecar, typically only by one rank.
+   * @returns The mesh index.
+   */
+  template <class E, class S>
+  [[nodiscard]] MeshIndex load_mesh_index(const std::filesystem::path& mesh_file, S& mesh_stream, const bool write)
+  {
+    const auto key        = file_key(mesh_file);
+    const auto index_file = index_path(mesh_file);
+    if (auto cached = read_index(index_file, key))
+    {
+      return std::move(*cached);
+    }
+
+    auto index = build_mesh_index<E>(mesh_stream);
+    if (write)
+    {
+      // The index is a cache, failing to write it does not prevent reading the mesh
+      write_index(index_file, key, index);
+    }
+
+    return index;
+  }
+
+  /**
+   * Loads the index of a mesh file from its sidecar index file, see `load_mesh_index` for an
+   * encoding. The file's `size_t` values are expected to be of the native width.
+   *
+   * @param mesh_file   The path to the mesh file.
+   * @param mesh_stream The mesh data stream.
+   * @param mode        Indicates the data mode of the mesh stream, currently either ASCII or BINARY.
+   * @param write       Whether a rebuilt index is written to the sidecar, typically only by one rank.
+   * @returns The mesh index.
+   */
+  template <class S>
+  [[nodiscard]] MeshIndex load_mesh_index(const std::filesystem::path& mesh_file,
+                                          S& mesh_stream,
+                                          const cfg::parser::Mode mode,
+                                          const bool write)
+  {
+    return cfg::parser::with_encoding(mode,
+                                      [&mesh_file, &mesh_stream, write](auto encoding) -> MeshIndex
+                                      {
+                                        return load_mesh_index<decltype(encoding)>(mesh_file, mesh_stream, write);
+                                      });
+  }
+}  // namespace cfg::reader
+
+#endif  // __CFG_MESH_INDEX_H_
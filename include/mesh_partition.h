@@ -0,0 +1,188 @@
+/**
+ * mesh_partition.h
+ *
+ * Partitioning of the mesh cells by an external graph partitioner, ParMETIS or PT-Scotch when
+ * `CFGrid` is built with them, and migration of the mesh to the partition.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef __CFG_MESH_PARTITION_H_
+#define __CFG_MESH_PARTITION_H_
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <mpi.h>
+
+#include <dual_graph.h>
+#include <element_parser.h>
+#include <node_set.h>
+#include <partitioned_mesh.h>
+#include <utils.h>
+
+namespace cfg::utils
+{
+  /**
+   * Identifies the partitioner of the mesh cells.
+   */
+  enum class Partitioner
+  {
+    PARMETIS,  ///< `ParMETIS_V3_PartKway` on the dual graph, if built with ParMETIS.
+    SCOTCH,    ///< `SCOTCH_dgraphPart` on the dual graph, if built with PT-Scotch.
+    GEOMETRIC  ///< Recursive coordinate bisection of the cell centroids, always available.
+  };
+
+  /**
+   * Returns whether a partitioner is available, i.e. whether `CFGrid` was built with its library.
+   */
+  [[nodiscard]] bool partitioner_available(const Partitioner partitioner);
+
+  /**
+   * Returns the default partitioner: ParMETIS if available, otherwise PT-Scotch if available,
+   * otherwise the geometric partitioner.
+   */
+  [[nodiscard]] Partitioner default_partitioner();
+
+  /**
+   * Parses a partitioner by name, `parmetis`, `scotch` or `geometric`, raising an error if the name
+   * is unknown.
+   */
+  [[nodiscard]] Partitioner partitioner_by_name(const std::string& name);
+
+  /**
+   * The name of a partitioner, as parsed by `partitioner_by_name`.
+   */
+  [[nodiscard]] std::string partitioner_name(const Partitioner partitioner);
+
+  /**
+   * Partitions the cells of a mesh, the vertices of its dual graph, with one part per rank.
+   *
+   * The dual graph is handed to ParMETIS or PT-Scotch in their distributed CSR form. The geometric
+   * partitioner computes the centroid of each cell, gathering the coordinates of its nodes from the
+   * ranks holding them, and partitions the centroids with an `RCBPartition`. ParMETIS cannot
+   * partition a graph when a rank holds no vertices, in which case the geometric partitioner is
+   * used instead.
+   *
+   * The partition then describes the cells assigned to this rank, which are identified by their
+   * global vertex index.
+   */
+  class CellPartition : public Partition
+  {
+   public:
+    /**
+     * Constructs the cell partition, this must be called collectively. An error is raised if the
+     * partitioner requested is not available.
+     *
+     * @param graph       The dual graph of the elements held by this rank.
+     * @param nodes       The nodes held by this rank.
+     * @param elements    The elements held by this rank.
+     * @param comm        The communicator the mesh is distributed over.
+     * @param partitioner The partitioner.
+     */
+    CellPartition(const DualGraph& graph,
+                  const cfg::parser::NodeSet<3>& nodes,
+                  const cfg::parser::ElementSet& elements,
+                  MPI_Comm comm,
+                  const Partitioner partitioner = default_partitioner());
+
+    /**
+     * Determines whether a cell is in this rank's partition.
+     *
+     * @param idx The global vertex index of the cell to test.
+     * @returns Whether the cell is in the partition or not.
+     */
+    [[nodiscard]] bool pick(const size_t idx) const override;
+
+    /**
+     * Returns the number of cells in this rank's partition.
+     */
+    [[nodiscard]] size_t size() const
+    {
+      return owned.size();
+    }
+
+    /**
+     * Returns the destination rank of each of the cells held by this rank, in the order of the graph.
+     */
+    [[nodiscard]] const std::vector<int>& destinations() const
+    {
+      return cell_destinations;
+    }
+
+    /**
+     * Returns the partitioner used, which differs from the one requested if ParMETIS fell back to
+     * the geometric partitioner.
+     */
+    [[nodiscard]] Partitioner partitioner() const
+    {
+      return used;
+    }
+
+    /**
+     * Returns the load imbalance of the partition, i.e. the ratio of the largest partition size to
+     * the mean partition size. A perfectly balanced partition has an imbalance of 1.
+     */
+    [[nodiscard]] double imbalance() const
+    {
+      return load_imbalance;
+    }
+
+    /**
+     * Writes a summary of the partition, the partitioner used and its imbalance, to a stream.
+     *
+     * @param os The output stream.
+     */
+    void report(std::ostream& os) const;
+
+   private:
+    std::vector<int> cell_destinations;  // The destination rank of each cell held by this rank
+    std::vector<size_t> owned;           // The sorted global vertex indices of the cells in this partition
+    Partitioner used;                    // The partitioner used
+    double load_imbalance{1.0};          // The ratio of the largest to the mean partition size
+  };
+
+  /**
+   * Moves the nodes and elements of a mesh to the ranks owning them after partitioning its cells,
+   * this must be called collectively.
+   *
+   * Each cell moves to its destination rank. Each node is owned by the lowest ranked owner of the
+   * cells containing it, and each lower dimensional element, e.g. a boundary face, by the owner of
+   * its first node. The owners of the nodes are agreed through a directory distributed over the
+   * ranks by node tag. Nodes that belong to no cell, and elements whose first node belongs to no
+   * cell, stay on their rank. Nodes and elements keep their natural and global indices and are moved
+   * by the migration engine, see `migrate_nodes` and `migrate_elements`.
+   *
+   * @param nodes     The nodes held by this rank.
+   * @param elements  The elements held by this rank.
+   * @param graph     The dual graph of the elements.
+   * @param partition The partition of the cells.
+   * @param comm      The communicator the mesh is distributed over.
+   * @returns The nodes and elements owned by this rank.
+   */
+  [[nodiscard]] cfg::hpc::PartitionedMesh migrate_mesh(const cfg::parser::NodeSet<3>& nodes,
+                                                       const cfg::parser::ElementSet& elements,
+                                                       const DualGraph& graph,
+                                                       const CellPartition& partition,
+                                                       MPI_Comm comm);
+
+  /**
+   * Partitions a mesh, building the dual graph of its elements, partitioning the cells and
+   * migrating the nodes and elements to their owners. This must be called collectively.
+   *
+   * @param nodes       The nodes held by this rank, as read.
+   * @param elements    The elements held by this rank, as read.
+   * @param comm        The communicator the mesh is distributed over.
+   * @param partitioner The partitioner.
+   * @param os          If not null, the stream rank 0 reports the partition to.
+   * @returns The nodes and elements owned by this rank.
+   */
+  [[nodiscard]] cfg::hpc::PartitionedMesh partition_mesh(const cfg::parser::NodeSet<3>& nodes,
+                                                         const cfg::parser::ElementSet& elements,
+                                                         MPI_Comm comm,
+                                                         const Partitioner partitioner = default_partitioner(),
+                                                         std::ostream* os             = nullptr);
+}  // namespace cfg::utils
+
+#endif  // __CFG_MESH_PARTITION_H_
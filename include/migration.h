@@ -0,0 +1,77 @@
+/**
+ * migration.h
+ *
+ * Migration of the nodes and elements of a mesh to arbitrary owner ranks, e.g. as assigned by a
+ * partitioner.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef __CFG_MIGRATION_H_
+#define __CFG_MIGRATION_H_
+
+#include <cstddef>
+#include <vector>
+
+#include <mpi.h>
+
+#include <element_parser.h>
+#include <node_set.h>
+#include <partitioned_mesh.h>
+
+namespace cfg::utils
+{
+  /**
+   * Moves each node to its owner rank, this must be called collectively.
+   *
+   * The nodes sent to each rank are packed into a single buffer of 64-bit words, their natural and
+   * global indices followed by their coordinates, and moved in one `MPI_Alltoallv`. The nodes
+   * received are renumbered by increasing global index, which is their local index on this rank,
+   * independently of the rank they came from.
+   *
+   * Besides one `int` count and displacement per rank for the exchange, the memory used is
+   * proportional to the number of nodes sent and received.
+   *
+   * @param nodes  The nodes held by this rank.
+   * @param owners The owner rank of each node.
+   * @param comm   The communicator.
+   * @returns The nodes owned by this rank, ordered by global index.
+   */
+  [[nodiscard]] cfg::parser::NodeSet<3> migrate_nodes(const cfg::parser::NodeSet<3>& nodes,
+                                                      const std::vector<int>& owners,
+                                                      MPI_Comm comm);
+
+  /**
+   * Moves each element to its owner rank, this must be called collectively.
+   *
+   * Each element is packed as its natural and global indices, its type and number of nodes, and its
+   * nodes, and the elements sent to each rank are moved in one `MPI_Alltoallv` as for
+   * `migrate_nodes`. The elements received are renumbered by increasing global index.
+   *
+   * @param elements The elements held by this rank.
+   * @param owners   The owner rank of each element.
+   * @param comm     The communicator.
+   * @returns The elements owned by this rank, ordered by global index.
+   */
+  [[nodiscard]] cfg::parser::ElementSet migrate_elements(const cfg::parser::ElementSet& elements,
+                                                         const std::vector<int>& owners,
+                                                         MPI_Comm comm);
+
+  /**
+   * Moves the nodes and elements of a mesh to their owner ranks, see `migrate_nodes` and
+   * `migrate_elements`. This must be called collectively.
+   *
+   * @param nodes          The nodes held by this rank.
+   * @param node_owners    The owner rank of each node.
+   * @param elements       The elements held by this rank.
+   * @param element_owners The owner rank of each element.
+   * @param comm           The communicator.
+   * @returns The nodes and elements owned by this rank.
+   */
+  [[nodiscard]] cfg::hpc::PartitionedMesh migrate_mesh(const cfg::parser::NodeSet<3>& nodes,
+                                                       const std::vector<int>& node_owners,
+                                                       const cfg::parser::ElementSet& elements,
+                                                       const std::vector<int>& element_owners,
+                                                       MPI_Comm comm);
+}  // namespace cfg::utils
+
+#endif  // __CFG_MIGRATION_H_
@@ -0,0 +1,260 @@
+/**
+ * mpi_utils.h
+ *
+ * Utilities shared by the MPI-based components of CFGrid.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef __CFG_MPI_UTILS_H_
+#define __CFG_MPI_UTILS_H_
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <mpi.h>
+
+#include <utils.h>
+
+namespace cfg::utils
+{
+  /**
+   * Raises an error if an MPI call failed.
+   *
+   * @param ierr The MPI error code.
+   * @param what Description of the failed operation.
+   */
+  inline void chkerr(const int ierr, const std::string& what)
+  {
+    if (ierr != MPI_SUCCESS)
+    {
+      throw std::runtime_error("MPI raised an error: " + what);
+    }
+  }
+
+  /**
+   * Describes the parallel environment of a communicator.
+   *
+   * @param comm The communicator.
+   * @returns The parallel environment.
+   */
+  [[nodiscard]] inline Parallel make_parallel(MPI_Comm comm)
+  {
+    int rank = 0;
+    int size = 0;
+    chkerr(MPI_Comm_rank(comm, &rank), "MPI_Comm_rank");
+    chkerr(MPI_Comm_size(comm, &size), "MPI_Comm_size");
+
+    Parallel parallel{};
+    parallel.rank = static_cast<unsigned int>(rank);
+    parallel.size = static_cast<unsigned int>(size);
+    return parallel;
+  }
+
+  /**
+   * Returns the MPI datatype corresponding to a C++ type.
+   */
+  template <class T>
+  [[nodiscard]] MPI_Datatype mpi_type()
+  {
+    if constexpr (std::is_same_v<T, double>)
+    {
+      return MPI_DOUBLE;
+    }
+    else if constexpr (std::is_same_v<T, int>)
+    {
+      return MPI_INT;
+    }
+    else if constexpr (std::is_integral_v<T> && std::is_unsigned_v<T> && (sizeof(T) == sizeof(std::uint64_t)))
+    {
+      return MPI_UINT64_T;
+    }
+    else if constexpr (std::is_integral_v<T> && std::is_signed_v<T> && (sizeof(T) == sizeof(std::int64_t)))
+    {
+      return MPI_INT64_T;
+    }
+    else
+    {
+      static_assert(!std::is_same_v<T, T>, "No MPI datatype for type");
+    }
+  }
+
+  /**
+   * Collectively exchanges values between all ranks of a communicator, each rank sends a contiguous
+   * range of its values to every rank. The values must be trivially copyable, they are sent as
+   * bytes.
+   *
+   * @param send        The values to send, ordered by destination rank.
+   * @param send_counts The number of values sent to each rank.
+   * @param comm        The communicator.
+   * @param recv_counts Set to the number of values received from each rank.
+   * @returns The values received, ordered by source rank.
+   */
+  template <class T>
+  [[nodiscard]] std::vector<T> exchange(const std::vector<T>& send,
+                                        const std::vector<int>& send_counts,
+                                        MPI_Comm comm,
+                                        std::vector<int>& recv_counts)
+  {
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be exchanged");
+
+    const auto n_ranks = send_counts.size();
+    recv_counts.assign(n_ranks, 0);
+    chkerr(MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1, MPI_INT, comm), "MPI_Alltoall");
+
+    std::vector<int> send_displs(n_ranks, 0);
+    std::vector<int> recv_displs(n_ranks, 0);
+    size_t n_sent = 0;
+    size_t n_recv = 0;
+    for (size_t rank = 0; rank < n_ranks; rank++)
+    {
+      if ((n_sent > INT_MAX) || (n_recv > INT_MAX))
+      {
+        throw std::runtime_error("Too many values to exchange on a single rank");
+      }
+      send_displs[rank] = static_cast<int>(n_sent);
+      recv_displs[rank] = static_cast<int>(n_recv);
+      n_sent += static_cast<size_t>(send_counts[rank]);
+      n_recv += static_cast<size_t>(recv_counts[rank]);
+    }
+
+    MPI_Datatype value_type = MPI_DATATYPE_NULL;
+    chkerr(MPI_Type_contiguous(sizeof(T), MPI_BYTE, &value_type), "MPI_Type_contiguous");
+    chkerr(MPI_Type_commit(&value_type), "MPI_Type_commit");
+
+    std::vector<T> recv(n_recv);
+    chkerr(MPI_Alltoallv(send.data(),
+                         send_counts.data(),
+                         send_displs.data(),
+                         value_type,
+                         recv.data(),
+                         recv_counts.data(),
+                         recv_displs.data(),
+                         value_type,
+                         comm),
+           "MPI_Alltoallv");
+    chkerr(MPI_Type_free(&value_type), "MPI_Type_free");
+
+    return recv;
+  }
+
+  /**
+   * The route of the items held by a rank to their owner ranks.
+   */
+  struct Route
+  {
+    std::vector<int> counts;    ///< The number of items sent to each rank
+    std::vector<size_t> order;  ///< The items, ordered by owner rank and then by their position
+  };
+
+  /**
+   * Routes items to their owner ranks by a counting sort, the items sent to a rank retain their
+   * order.
+   *
+   * @param owners  The owner rank of each item.
+   * @param n_ranks The number of ranks.
+   * @returns The route.
+   */
+  [[nodiscard]] inline Route route(const std::vector<int>& owners, const size_t n_ranks)
+  {
+    Route items{std::vector<int>(n_ranks, 0), std::vector<size_t>(owners.size())};
+    for (const auto owner : owners)
+    {
+      items.counts[static_cast<size_t>(owner)]++;
+    }
+    std::vector<size_t> next(n_ranks, 0);
+    for (size_t rank = 1; rank < n_ranks; rank++)
+    {
+      next[rank] = next[rank - 1] + static_cast<size_t>(items.counts[rank - 1]);
+    }
+    for (size_t i = 0; i < owners.size(); i++)
+    {
+      items.order[next[static_cast<size_t>(owners[i])]++] = i;
+    }
+
+    return items;
+  }
+
+  /**
+   * Collectively sends each value to a rank, see `exchange`.
+   *
+   * @param values  The values to send.
+   * @param rank_of Returns the destination rank of a value.
+   * @param comm    The communicator.
+   * @returns The values received, ordered by source rank and then in the order they were given.
+   */
+  template <class T, class F>
+  [[nodiscard]] std::vector<T> send_to_ranks(const std::vector<T>& values, const F& rank_of, MPI_Comm comm)
+  {
+    const auto n_ranks = static_cast<size_t>(make_parallel(comm).size);
+
+    std::vector<int> owners(values.size());
+    for (size_t i = 0; i < values.size(); i++)
+    {
+      owners[i] = static_cast<int>(rank_of(values[i]));
+    }
+    const auto items = route(owners, n_ranks);
+
+    std::vector<T> send(values.size());
+    for (size_t i = 0; i < values.size(); i++)
+    {
+      send[i] = values[items.order[i]];
+    }
+
+    std::vector<int> recv_counts;
+    return exchange(send, items.counts, comm, recv_counts);
+  }
+
+  /**
+   * Collectively reads a set of extents from a file into a contiguous buffer. The extents are
+   * measured in values of type `T` but may be located at arbitrary byte offsets.
+   *
+   * @param fh      The open file.
+   * @param offsets The byte offsets of each extent in the file.
+   * @param lengths The number of values in each extent.
+   * @param buf     The destination buffer, sized to the total number of values.
+   */
+  template <class T>
+  void read_extents(MPI_File fh,
+                    const std::vector<MPI_Aint>& offsets,
+                    const std::vector<int>& lengths,
+                    std::vector<T>& buf)
+  {
+    if (buf.size() > INT_MAX)
+    {
+      throw std::runtime_error("Too many values to read collectively on a single rank");
+    }
+
+    // File views must be built from the elementary type, as the extents are not aligned to the
+    // size of T this must be bytes
+    MPI_Datatype value_type = MPI_DATATYPE_NULL;
+    chkerr(MPI_Type_contiguous(sizeof(T), MPI_BYTE, &value_type), "MPI_Type_contiguous");
+    chkerr(MPI_Type_commit(&value_type), "MPI_Type_commit");
+
+    MPI_Datatype file_type = value_type;
+    if (!lengths.empty())
+    {
+      chkerr(MPI_Type_create_hindexed(
+                 static_cast<int>(lengths.size()), lengths.data(), offsets.data(), value_type, &file_type),
+             "MPI_Type_create_hindexed");
+      chkerr(MPI_Type_commit(&file_type), "MPI_Type_commit");
+    }
+
+    std::string datarep{"native"};
+    chkerr(MPI_File_set_view(fh, 0, MPI_BYTE, file_type, datarep.data(), MPI_INFO_NULL), "MPI_File_set_view");
+    chkerr(MPI_File_read_at_all(fh, 0, buf.data(), static_cast<int>(buf.size()), value_type, MPI_STATUS_IGNORE),
+           "MPI_File_read_at_all");
+
+    if (file_type != value_type)
+    {
+      chkerr(MPI_Type_free(&file_type), "MPI_Type_free");
+    }
+    chkerr(MPI_Type_free(&value_type), "MPI_Type_free");
+  }
+}  // namespace cfg::utils
+
+#endif  // __CFG_MPI_UTILS_H_
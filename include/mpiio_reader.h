@@ -0,0 +1,49 @@
+/**
+ * mpiio_reader.h
+ *
+ * Collective MPI-IO reading of binary GMSH files.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef __CFG_MPIIO_READER_H_
+#define __CFG_MPIIO_READER_H_
+
+#include <filesystem>
+#include <vector>
+
+#include <mpi.h>
+
+#include <node_parser.h>
+
+namespace cfg::parser
+{
+  /**
+   * Reads this rank's partition of the nodes from a binary GMSH file using collective MPI-IO.
+   *
+   * Only rank 0 searches the file, locating the Nodes section and the layout of its blocks which
+   * are broadcast to the other ranks, all ranks then read their nodes in a single collective
+   * operation. This must be called by all ranks in the communicator.
+   *
+   * @param mesh_file  The filepath to a binary GMSH file.
+   * @param comm       The communicator the nodes are partitioned over.
+   * @param validation How thoroughly the nodes read are validated.
+   * @returns The node vector.
+   */
+  [[nodiscard]] std::vector<Node<3>> read_nodes_collective(const std::filesystem::path& mesh_file,
+                                                           MPI_Comm comm,
+                                                           const Validation validation = Validation::GLOBAL);
+
+  /**
+   * Reads the nodes from a binary GMSH file using collective MPI-IO.
+   *
+   * @param mesh_file  The filepath to a binary GMSH file.
+   * @param comm       The communicator the nodes are partitioned over.
+   * @param validation How thoroughly the nodes read are validated.
+   * @returns The nodes held by this rank.
+   */
+  [[nodiscard]] std::vector<Node<3>> read_nodes(const std::filesystem::path& mesh_file,
+                                                MPI_Comm comm,
+                                                const Validation validation = Validation::GLOBAL);
+}  // namespace cfg::parser
+
+#endif  // __CFG_MPIIO_READER_H_
@@ -8,11 +8,27 @@
 
 #include <array>
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <istream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
+#include <instrument.h>
+#include <mapped_stream.h>
+#include <number_parser.h>
+#include <section_index.h>
 #include <section_reader.h>
 #include <utils.h>
 
+namespace cfg::reader
+{
+  struct MeshIndex;
+}  // namespace cfg::reader
+
 namespace cfg::parser
 {
   /**
@@ -25,22 +41,285 @@ namespace cfg::parser
   };
 
   /**
-   * Reads a single item from the reader, according to the mode.
+   * Identifies how thoroughly the nodes read are validated.
+   */
+  enum class Validation
+  {
+    TRUST,   ///< Only the number of nodes read by each rank is checked, the node indices are trusted.
+    LOCAL,   ///< The node indices held by each rank are checked for their range and for duplicates.
+    GLOBAL   ///< As `LOCAL`, and the nodes read by all ranks are checked for consistency with the file.
+  };
+
+  /**
+   * Describes how the data of a mesh file is encoded, at compile time: the mode and the types of the
+   * values as stored in the file. The parsers are instantiated for each encoding so that the mode is
+   * dispatched on once per section, rather than for every value, see `with_encoding`.
+   *
+   * GMSH stores node and element tags and counts as `size_t` values, whose width is given by the
+   * data size of the mesh file header, and coordinates as `double` values. In ASCII mode the widths
+   * do not apply.
+   *
+   * @tparam M The data mode of the mesh file.
+   * @tparam I The type of `size_t` values as stored in the mesh file.
+   * @tparam R The type of floating point values as stored in the mesh file.
    */
-  template <class C>
-  [[nodiscard]] C read_one(const cfg::reader::SectionReader& node_reader, std::istream& mesh_stream, const Mode mode)
+  template <Mode M, class I = uint64_t, class R = double>
+  struct Encoding
+  {
+    static constexpr Mode mode = M;  ///< The data mode of the mesh file.
+    using index_type           = I;  ///< The type of `size_t` values as stored in the mesh file.
+    using real_type            = R;  ///< The type of floating point values as stored in the mesh file.
+  };
+
+  using AsciiEncoding    = Encoding<Mode::ASCII>;             ///< ASCII mesh files.
+  using BinaryEncoding   = Encoding<Mode::BINARY>;            ///< Binary mesh files with a data size of 8.
+  using BinaryEncoding32 = Encoding<Mode::BINARY, uint32_t>;  ///< Binary mesh files with a data size of 4.
+
+  /**
+   * The type a value of type `C` is stored as in a mesh file of encoding `E`.
+   */
+  template <class E, class C>
+  using stored_type_t = std::conditional_t<std::is_same_v<C, size_t>,
+                                           typename E::index_type,
+                                           std::conditional_t<std::is_same_v<C, double>, typename E::real_type, C>>;
+
+  /**
+   * Calls a function with the encoding of a mesh file, this is the only point at which the encoding
+   * is dispatched on at runtime.
+   *
+   * @param mode      The data mode of the mesh file.
+   * @param data_size The data size of the mesh file header, i.e. the width of its `size_t` values.
+   * @param fn        The function, called as `fn(E{})` for the encoding `E` of the mesh file.
+   * @returns The result of the function.
+   */
+  template <class F>
+  decltype(auto) with_encoding(const Mode mode, const size_t data_size, F&& fn)
   {
-    C val;
     if (mode == Mode::ASCII)
     {
-      node_reader(mesh_stream) >> val;
+      return std::forward<F>(fn)(AsciiEncoding{});
+    }
+    if (data_size == sizeof(uint64_t))
+    {
+      return std::forward<F>(fn)(BinaryEncoding{});
+    }
+    if (data_size == sizeof(uint32_t))
+    {
+      return std::forward<F>(fn)(BinaryEncoding32{});
+    }
+    throw std::runtime_error("Unsupported GMSH data size: " + std::to_string(data_size));
+  }
+
+  /**
+   * Calls a function with the encoding of a mesh file of the native data size.
+   *
+   * @param mode The data mode of the mesh file.
+   * @param fn   The function, called as `fn(E{})` for the encoding `E` of the mesh file.
+   * @returns The result of the function.
+   */
+  template <class F>
+  decltype(auto) with_encoding(const Mode mode, F&& fn)
+  {
+    return with_encoding(mode, sizeof(size_t), std::forward<F>(fn));
+  }
+
+  /**
+   * Reads a single item from the reader, according to the encoding.
+   */
+  template <class C, class E, class S>
+  [[nodiscard]] C read_one(const cfg::reader::SectionReader& section_reader, S& mesh_stream)
+  {
+    if constexpr (E::mode == Mode::ASCII)
+    {
+      C val{};
+      section_reader(mesh_stream) >> val;
+      return val;
     }
     else
     {
-      const size_t nchar = sizeof(C) / sizeof(char);
-      mesh_stream.read((char*)&val, nchar);
+      stored_type_t<E, C> val{};
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      mesh_stream.read(reinterpret_cast<char*>(&val), sizeof(val));
+      return static_cast<C>(val);
+    }
+  }
+
+  /**
+   * Reads a single item from the reader, according to the mode.
+   */
+  template <class C, class S>
+  [[nodiscard]] C read_one(const cfg::reader::SectionReader& node_reader, S& mesh_stream, const Mode mode)
+  {
+    return with_encoding(mode,
+                         [&node_reader, &mesh_stream](auto encoding) -> C
+                         {
+                           return read_one<C, decltype(encoding)>(node_reader, mesh_stream);
+                         });
+  }
+
+  /**
+   * Reads a single item of section data from the stream, according to the encoding.
+   *
+   * Unlike `read_one` the stream position is not checked against the section, this is intended for
+   * the inner loops of the data parsers once the data has been located. In ASCII mode the value is
+   * parsed directly from the stream's buffer by the fast number parser.
+   */
+  template <class C, class E, class S>
+  [[nodiscard]] C read_data(S& mesh_stream)
+  {
+    if constexpr (E::mode == Mode::ASCII)
+    {
+      C val{};
+      if constexpr (std::is_base_of_v<std::istream, S>)
+      {
+        cfg::utils::extract_number(mesh_stream, val);
+      }
+      else
+      {
+        mesh_stream >> val;
+      }
+      return val;
+    }
+    else
+    {
+      stored_type_t<E, C> val{};
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      mesh_stream.read(reinterpret_cast<char*>(&val), sizeof(val));
+      return static_cast<C>(val);
+    }
+  }
+
+  /**
+   * Reads a single item of section data from the stream, according to the mode, see `read_data` for
+   * an encoding.
+   */
+  template <class C, class S>
+  [[nodiscard]] C read_data(S& mesh_stream, const Mode mode)
+  {
+    return with_encoding(mode,
+                         [&mesh_stream](auto encoding) -> C
+                         {
+                           return read_data<C, decltype(encoding)>(mesh_stream);
+                         });
+  }
+
+  /**
+   * Reads a contiguous array of section data from the stream into a buffer, according to the
+   * encoding.
+   *
+   * The buffer is resized to hold `count` items, allowing its storage to be reused across calls. In
+   * BINARY mode the array is read by a single unformatted read directly into the buffer, items
+   * stored narrower than their in-memory type are then widened in place.
+   *
+   * @param mesh_stream The mesh data stream, positioned at the start of the array.
+   * @param count       The number of items to read.
+   * @param buf         The buffer the items are read into.
+   */
+  template <class E, class S, class C>
+  void read_block(S& mesh_stream, const size_t count, std::vector<C>& buf)
+  {
+    cfg::utils::count(cfg::utils::Counter::TOKENS_PARSED, count);
+
+    buf.resize(count);
+    if constexpr (E::mode == Mode::ASCII)
+    {
+      for (auto& val : buf)
+      {
+        val = read_data<C, E>(mesh_stream);
+      }
+    }
+    else
+    {
+      using D = stored_type_t<E, C>;
+      if constexpr (std::is_same_v<D, C>)
+      {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        mesh_stream.read(reinterpret_cast<char*>(buf.data()), static_cast<std::streamsize>(count * sizeof(C)));
+      }
+      else
+      {
+        // The stored values are read into the back of the buffer, so they are widened in place
+        static_assert(sizeof(D) <= sizeof(C), "Stored values must not be wider than their in-memory type");
+        // NOLINTBEGIN(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        auto* const bytes = reinterpret_cast<char*>(buf.data());
+        const auto offset = count * (sizeof(C) - sizeof(D));
+        mesh_stream.read(bytes + offset, static_cast<std::streamsize>(count * sizeof(D)));
+        for (size_t i = 0; i < count; i++)
+        {
+          D val{};
+          std::memcpy(&val, bytes + offset + (i * sizeof(D)), sizeof(D));
+          buf[i] = static_cast<C>(val);
+        }
+        // NOLINTEND(cppcoreguidelines-pro-type-reinterpret-cast,cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      }
+    }
+  }
+
+  /**
+   * Reads a contiguous array of section data from the stream into a buffer, according to the mode,
+   * see `read_block` for an encoding.
+   *
+   * @param mesh_stream The mesh data stream, positioned at the start of the array.
+   * @param mode        Indicates the data mode of the mesh stream, currently either ASCII or BINARY.
+   * @param count       The number of items to read.
+   * @param buf         The buffer the items are read into.
+   */
+  template <class S, class C>
+  void read_block(S& mesh_stream, const Mode mode, const size_t count, std::vector<C>& buf)
+  {
+    with_encoding(mode,
+                  [&mesh_stream, count, &buf](auto encoding)
+                  {
+                    read_block<decltype(encoding)>(mesh_stream, count, buf);
+                  });
+  }
+
+  /**
+   * Skips a number of lines of an ASCII mesh stream, the stream should be positioned at the start
+   * of the first line.
+   *
+   * @param mesh_stream The mesh data stream.
+   * @param n_lines     The number of lines to skip.
+   */
+  template <class S>
+  void skip_lines(S& mesh_stream, const size_t n_lines)
+  {
+    using std::getline;  // Allows streams to provide their own getline
+
+    std::string line;
+    for (size_t i = 0; i < n_lines; i++)
+    {
+      getline(mesh_stream, line);
+    }
+  }
+
+  /**
+   * Marks the position of the mesh stream at the start of a read counted by `count_bytes_read`. The
+   * position is only queried when instrumentation is enabled.
+   *
+   * @param mesh_stream The mesh data stream, positioned at the first byte to be read.
+   * @returns The stream position, or 0 if instrumentation is disabled.
+   */
+  template <class S>
+  [[nodiscard]] std::streamoff mark_position(S& mesh_stream)
+  {
+    return cfg::utils::profiling() ? std::streamoff(mesh_stream.tellg()) : 0;
+  }
+
+  /**
+   * Counts the bytes of the mesh stream read since a marked position as bytes read by this rank.
+   *
+   * @param mesh_stream The mesh data stream, positioned after the last byte read.
+   * @param start       The position marked by `mark_position` before reading.
+   */
+  template <class S>
+  void count_bytes_read(S& mesh_stream, const std::streamoff start)
+  {
+    if (cfg::utils::profiling())
+    {
+      const auto end = std::streamoff(mesh_stream.tellg());
+      cfg::utils::count(cfg::utils::Counter::BYTES_READ, (end > start) ? static_cast<uint64_t>(end - start) : 0);
     }
-    return val;
   }
 
   /**
@@ -55,34 +334,179 @@ namespace cfg::parser
   };
 
   /**
-   * Constructs a function that can read a Section of a GMSH file.
+   * Constructs a function that can read a Section of a GMSH file of a given encoding.
    *
+   * The header and data parsers are instantiated for the encoding, so the encoding is not dispatched
+   * on within the section.
+   *
+   * @tparam Enc        The encoding of the mesh file, see `Encoding`.
    * @param hdr_parser  An object that parses the header of the targeted Section.
    * @param data_parser An object that parses the data of the targeted Section.
    * @param environment Allows passing data from the calling environment to the DataParser.
    * @param validator   An object that validates the read data.
    */
-  template <class H, class D, class E, class V>
+  template <class Enc, class H, class D, class E, class V>
   auto read_X(const H hdr_parser, const D data_parser, const E environment, const V validator)
   {
-    return [hdr_parser, data_parser, environment, validator](
-               const cfg::reader::SectionReader& section_reader, std::ifstream& mesh_stream, const Mode mode)
+    return [hdr_parser, data_parser, environment, validator](const cfg::reader::SectionReader& section_reader,
+                                                             auto& mesh_stream)
     {
-      const auto hdr       = hdr_parser.parse(section_reader, mesh_stream, mode);
-      const auto data      = data_parser.parse(section_reader, mesh_stream, mode, hdr, environment);
-      validator.validate(data, hdr);
+      const auto hdr = [&]()
+      {
+        const cfg::utils::ScopedTimer timer{cfg::utils::Phase::HEADER_PARSE};
+        return hdr_parser.template parse<Enc>(section_reader, mesh_stream);
+      }();
+      const auto data = [&]()
+      {
+        const cfg::utils::ScopedTimer timer{cfg::utils::Phase::DATA_PARSE};
+        return data_parser.template parse<Enc>(section_reader, mesh_stream, hdr, environment);
+      }();
+      {
+        const cfg::utils::ScopedTimer timer{cfg::utils::Phase::VALIDATION};
+        validator.validate(data, hdr);
+      }
       return data;
     };
   }
 
   /**
-   * Reads the nodes from a mesh file.
+   * Provides a section header that is already known, e.g. recorded by a mesh index, in place of a
+   * header parser for `read_X`. The stream is not read.
+   */
+  template <class H>
+  struct KnownHeader
+  {
+    H header;  ///< The section header.
+
+    /**
+     * Returns the known header.
+     */
+    template <class E, class S>
+    [[nodiscard]] H parse(const cfg::reader::SectionReader& /* section_reader */, S& /* mesh_stream */) const
+    {
+      return header;
+    }
+  };
+
+  /**
+   * Reads the nodes from a mesh file of a given encoding.
+   *
+   * Instantiated for each `Encoding` alias and for both a `SectionIndex` and a `MeshIndex`, a mesh
+   * index records the node blocks so that only this rank's node blocks are read.
+   *
+   * @tparam E          The encoding of the mesh file.
+   * @param mesh_stream The data stream associated with the mesh file.
+   * @param parallel    The parallel environment.
+   * @param index       The index of the mesh file, either a `SectionIndex` or a `MeshIndex`.
+   * @param validation  How thoroughly the nodes read are validated.
+   * @param comm        The communicator corresponding to the parallel environment, required by
+   *                    global validation on more than one rank.
+   * @returns The nodes held by this rank.
+   */
+  template <class E, class I>
+  [[nodiscard]] std::vector<Node<3>> read_nodes(std::istream& mesh_stream,
+                                                const cfg::utils::Parallel& parallel,
+                                                const I& index,
+                                                const Validation validation = Validation::LOCAL,
+                                                MPI_Comm comm               = MPI_COMM_NULL);
+
+  /**
+   * Reads the nodes from a memory-mapped mesh file of a given encoding, see `read_nodes` for streams.
+   *
+   * @tparam E          The encoding of the mesh file.
+   * @param mesh_stream The memory-mapped stream associated with the mesh file.
+   * @param parallel    The parallel environment.
+   * @param index       The index of the mesh file, either a `SectionIndex` or a `MeshIndex`.
+   * @param validation  How thoroughly the nodes read are validated.
+   * @param comm        The communicator corresponding to the parallel environment, required by
+   *                    global validation on more than one rank.
+   * @returns The nodes held by this rank.
+   */
+  template <class E, class I>
+  [[nodiscard]] std::vector<Node<3>> read_nodes(cfg::reader::MappedStream& mesh_stream,
+                                                const cfg::utils::Parallel& parallel,
+                                                const I& index,
+                                                const Validation validation = Validation::LOCAL,
+                                                MPI_Comm comm               = MPI_COMM_NULL);
+
+  /**
+   * Reads the nodes from a mesh file, dispatching on its mode. The file's `size_t` values are
+   * expected to be of the native width.
    *
    * @param mesh_stream The data stream associated with the mesh file.
    * @param mode        Flag indicating whether the file was opened in ASCII or binary mode.
    * @param parallel    The parallel environment.
+   * @param index       The index of the sections of the mesh file.
+   * @param validation  How thoroughly the nodes read are validated.
+   * @param comm        The communicator corresponding to the parallel environment, required by
+   *                    global validation on more than one rank.
+   * @returns The nodes held by this rank.
+   */
+  [[nodiscard]] std::vector<Node<3>> read_nodes(std::istream& mesh_stream,
+                                                const Mode mode,
+                                                const cfg::utils::Parallel& parallel,
+                                                const cfg::reader::SectionIndex& index,
+                                                const Validation validation = Validation::LOCAL,
+                                                MPI_Comm comm               = MPI_COMM_NULL);
+
+  /**
+   * Reads the nodes from a memory-mapped mesh file.
+   *
+   * @param mesh_stream The memory-mapped stream associated with the mesh file.
+   * @param mode        Flag indicating whether the file is in ASCII or binary mode.
+   * @param parallel    The parallel environment.
+   * @param index       The index of the sections of the mesh file.
+   * @param validation  How thoroughly the nodes read are validated.
+   * @param comm        The communicator corresponding to the parallel environment, required by
+   *                    global validation on more than one rank.
+   * @returns The nodes held by this rank.
+   */
+  [[nodiscard]] std::vector<Node<3>> read_nodes(cfg::reader::MappedStream& mesh_stream,
+                                                const Mode mode,
+                                                const cfg::utils::Parallel& parallel,
+                                                const cfg::reader::SectionIndex& index,
+                                                const Validation validation = Validation::LOCAL,
+                                                MPI_Comm comm               = MPI_COMM_NULL);
+
+  /**
+   * Reads the nodes from a mesh file, using the Nodes section header and node block layout recorded
+   * in a mesh index to read only this rank's node blocks.
+   *
+   * @param mesh_stream The data stream associated with the mesh file.
+   * @param mode        Flag indicating whether the file was opened in ASCII or binary mode.
+   * @param parallel    The parallel environment.
+   * @param index       The index of the mesh file.
+   * @param validation  How thoroughly the nodes read are validated.
+   * @param comm        The communicator corresponding to the parallel environment, required by
+   *                    global validation on more than one rank.
+   * @returns The nodes held by this rank.
+   */
+  [[nodiscard]] std::vector<Node<3>> read_nodes(std::istream& mesh_stream,
+                                                const Mode mode,
+                                                const cfg::utils::Parallel& parallel,
+                                                const cfg::reader::MeshIndex& index,
+                                                const Validation validation = Validation::LOCAL,
+                                                MPI_Comm comm               = MPI_COMM_NULL);
+
+  /**
+   * Reads the nodes from a memory-mapped mesh file, using the Nodes section header and node block
+   * layout recorded in a mesh index to read only this rank's node blocks.
+   *
+   * @param mesh_stream The memory-mapped stream associated with the mesh file.
+   * @param mode        Flag indicating whether the file is in ASCII or binary mode.
+   * @param parallel    The parallel environment.
+   * @param index       The index of the mesh file.
+   * @param validation  How thoroughly the nodes read are validated.
+   * @param comm        The communicator corresponding to the parallel environment, required by
+   *                    global validation on more than one rank.
+   * @returns The nodes held by this rank.
    */
-  void read_nodes(std::ifstream& mesh_stream, const Mode mode, const cfg::utils::Parallel& parallel);
+  [[nodiscard]] std::vector<Node<3>> read_nodes(cfg::reader::MappedStream& mesh_stream,
+                                                const Mode mode,
+                                                const cfg::utils::Parallel& parallel,
+                                                const cfg::reader::MeshIndex& index,
+                                                const Validation validation = Validation::LOCAL,
+                                                MPI_Comm comm               = MPI_COMM_NULL);
 }  // namespace cfg::parser
 
 #endif  // __CFG_NODE_PARSER_H_
@@ -0,0 +1,263 @@
+/**
+ * node_set.h
+ *
+ * Structure-of-arrays storage for mesh nodes.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef __CFG_NODE_SET_H_
+#define __CFG_NODE_SET_H_
+
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include <node_parser.h>
+#include <utils.h>
+
+namespace cfg::parser
+{
+  /**
+   * A set of mesh nodes of arbitrary dimension `d`, stored as a structure of arrays.
+   *
+   * Each field of `Node<d>` is stored in a separate contiguous, cache-line aligned array, with the
+   * coordinates stored one axis per array, so that operations over a single field, e.g. computing
+   * the bounding box or space-filling-curve keys, make full use of the cache and vectorise. The
+   * arrays are kept the same size by the member functions, node `i` is described by entry `i` of
+   * each array.
+   *
+   * Code that expects `Node<d>` can access the set through `operator[]` and iteration, which yield
+   * `Node<d>` values, or convert to and from a vector of nodes using `to_nodes` and `to_node_set`.
+   */
+  template <unsigned int d>
+  struct NodeSet
+  {
+    template <class T>
+    using Array = std::vector<T, utils::AlignedAllocator<T>>;  ///< The aligned array type.
+
+    Array<size_t> natural_idx;       ///< The natural indices of the nodes
+    Array<size_t> global_idx;        ///< The global indices of the nodes
+    std::array<Array<double>, d> x;  ///< The node coordinates, one array per axis
+
+    /**
+     * Iterates over the nodes of a `NodeSet`, yielding `Node<d>` values.
+     */
+    class const_iterator
+    {
+     public:
+      using iterator_category = std::input_iterator_tag;  ///< Nodes are assembled on dereference.
+      using value_type        = Node<d>;                  ///< The type of the nodes.
+      using difference_type   = std::ptrdiff_t;           ///< The type of the distance between nodes.
+      using pointer           = void;                     ///< Nodes cannot be accessed by pointer.
+      using reference         = Node<d>;                  ///< Nodes are returned by value.
+
+      /**
+       * Constructs an iterator pointing at a node of a set.
+       *
+       * @param nodes The set of nodes.
+       * @param idx   The index of the node.
+       */
+      const_iterator(const NodeSet& nodes, const size_t idx) : nodes{&nodes}, idx{idx} {}
+
+      /**
+       * Returns the node the iterator points to.
+       */
+      [[nodiscard]] Node<d> operator*() const
+      {
+        return (*nodes)[idx];
+      }
+
+      /**
+       * Advances the iterator to the next node.
+       */
+      const_iterator& operator++()
+      {
+        idx++;
+        return *this;
+      }
+
+      /**
+       * Advances the iterator to the next node, returning the current value.
+       */
+      const_iterator operator++(int)
+      {
+        auto current = *this;
+        idx++;
+        return current;
+      }
+
+      /**
+       * Tests whether two iterators point to the same node.
+       */
+      [[nodiscard]] bool operator==(const const_iterator& other) const
+      {
+        return (nodes == other.nodes) && (idx == other.idx);
+      }
+
+      /**
+       * Tests whether two iterators point to different nodes.
+       */
+      [[nodiscard]] bool operator!=(const const_iterator& other) const
+      {
+        return !(*this == other);
+      }
+
+     private:
+      const NodeSet* nodes;  // The set being iterated over
+      size_t idx;            // The index of the current node
+    };
+
+    NodeSet() = default;
+
+    /**
+     * Constructs a set of `n` (zero-initialised) nodes.
+     *
+     * @param n The number of nodes.
+     */
+    explicit NodeSet(const size_t n)
+    {
+      resize(n);
+    }
+
+    /**
+     * Returns the number of nodes in the set.
+     */
+    [[nodiscard]] size_t size() const
+    {
+      return natural_idx.size();
+    }
+
+    /**
+     * Tests whether the set is empty.
+     */
+    [[nodiscard]] bool empty() const
+    {
+      return natural_idx.empty();
+    }
+
+    /**
+     * Resizes the set to hold `n` nodes.
+     *
+     * @param n The number of nodes.
+     */
+    void resize(const size_t n)
+    {
+      natural_idx.resize(n);
+      global_idx.resize(n);
+      for (auto& axis : x)
+      {
+        axis.resize(n);
+      }
+    }
+
+    /**
+     * Reserves storage for `n` nodes.
+     *
+     * @param n The number of nodes.
+     */
+    void reserve(const size_t n)
+    {
+      natural_idx.reserve(n);
+      global_idx.reserve(n);
+      for (auto& axis : x)
+      {
+        axis.reserve(n);
+      }
+    }
+
+    /**
+     * Returns a node of the set.
+     *
+     * @param i The index of the node in the set.
+     * @returns The node.
+     */
+    [[nodiscard]] Node<d> operator[](const size_t i) const
+    {
+      Node<d> node{natural_idx[i], global_idx[i], {}};
+      for (unsigned int axis = 0; axis < d; axis++)
+      {
+        node.x[axis] = x[axis][i];
+      }
+      return node;
+    }
+
+    /**
+     * Overwrites a node of the set.
+     *
+     * @param i    The index of the node in the set.
+     * @param node The node.
+     */
+    void set(const size_t i, const Node<d>& node)
+    {
+      natural_idx[i] = node.natural_idx;
+      global_idx[i]  = node.global_idx;
+      for (unsigned int axis = 0; axis < d; axis++)
+      {
+        x[axis][i] = node.x[axis];
+      }
+    }
+
+    /**
+     * Appends a node to the set.
+     *
+     * @param node The node.
+     */
+    void push_back(const Node<d>& node)
+    {
+      natural_idx.push_back(node.natural_idx);
+      global_idx.push_back(node.global_idx);
+      for (unsigned int axis = 0; axis < d; axis++)
+      {
+        x[axis].push_back(node.x[axis]);
+      }
+    }
+
+    /**
+     * Returns an iterator to the first node of the set.
+     */
+    [[nodiscard]] const_iterator begin() const
+    {
+      return {*this, 0};
+    }
+
+    /**
+     * Returns an iterator past the last node of the set.
+     */
+    [[nodiscard]] const_iterator end() const
+    {
+      return {*this, size()};
+    }
+  };
+
+  /**
+   * Converts a set of nodes to a vector of nodes.
+   *
+   * @param nodes The set of nodes.
+   * @returns The node vector.
+   */
+  template <unsigned int d>
+  [[nodiscard]] std::vector<Node<d>> to_nodes(const NodeSet<d>& nodes)
+  {
+    return {nodes.begin(), nodes.end()};
+  }
+
+  /**
+   * Converts a vector of nodes to a set of nodes.
+   *
+   * @param nodes The node vector.
+   * @returns The set of nodes.
+   */
+  template <unsigned int d>
+  [[nodiscard]] NodeSet<d> to_node_set(const std::vector<Node<d>>& nodes)
+  {
+    NodeSet<d> node_set(nodes.size());
+    for (size_t i = 0; i < nodes.size(); i++)
+    {
+      node_set.set(i, nodes[i]);
+    }
+    return node_set;
+  }
+}  // namespace cfg::parser
+
+#endif  // __CFG_NODE_SET_H_
@@ -0,0 +1,294 @@
+/**
+ * number_parser.h
+ *
+ * Fast parsing of ASCII numbers from character buffers and streams.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef __CFG_NUMBER_PARSER_H_
+#define __CFG_NUMBER_PARSER_H_
+
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <system_error>
+#include <type_traits>
+
+namespace cfg::utils
+{
+  /**
+   * Tests whether a character is whitespace, matching the classic "C" locale.
+   *
+   * @param c The character to test.
+   * @returns Whether the character is whitespace (`true`) or not (`false`).
+   */
+  // Simple test of a character, short names are clear.
+  // NOLINTNEXTLINE(readability-identifier-length)
+  [[nodiscard]] constexpr bool is_space(const char c) noexcept
+  {
+    return (c == ' ') || (c == '\n') || (c == '\t') || (c == '\r') || (c == '\v') || (c == '\f');
+  }
+
+  /**
+   * Tests whether a character is a decimal digit.
+   *
+   * @param c The character to test.
+   * @returns Whether the character is a digit (`true`) or not (`false`).
+   */
+  // Simple test of a character, short names are clear.
+  // NOLINTNEXTLINE(readability-identifier-length)
+  [[nodiscard]] constexpr bool is_digit(const char c) noexcept
+  {
+    return (c >= '0') && (c <= '9');
+  }
+
+  /**
+   * Parses an integer from a character buffer, analogous to `std::from_chars` but also accepting a
+   * leading `+` as `std::istream` does.
+   *
+   * @param first The start of the buffer.
+   * @param last  The end of the buffer.
+   * @param val   The destination the value is written into, unmodified on error.
+   * @returns     The end of the parsed number and an error code.
+   */
+  template <class T, std::enable_if_t<std::is_integral_v<T>, bool> = true>
+  [[nodiscard]] std::from_chars_result parse_number(const char* first, const char* last, T& val) noexcept
+  {
+    using U = std::make_unsigned_t<T>;
+
+    // The character buffer is scanned directly.
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const char* ptr     = first;
+    const bool negative = (ptr != last) && (*ptr == '-');
+    if ((ptr != last) && ((*ptr == '-') || (*ptr == '+')))
+    {
+      ptr++;
+    }
+    if (negative && std::is_unsigned_v<T>)
+    {
+      return {first, std::errc::invalid_argument};
+    }
+
+    const U limit = negative ? static_cast<U>(std::numeric_limits<T>::max()) + 1 : std::numeric_limits<T>::max();
+
+    const char* digits = ptr;
+    U acc              = 0;
+    bool overflow      = false;
+    for (; (ptr != last) && is_digit(*ptr); ptr++)
+    {
+      const auto digit = static_cast<U>(*ptr - '0');
+      overflow         = overflow || (acc > (limit - digit) / 10);
+      acc              = acc * 10 + digit;
+    }
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+    if (ptr == digits)
+    {
+      return {first, std::errc::invalid_argument};
+    }
+    if (overflow)
+    {
+      return {ptr, std::errc::result_out_of_range};
+    }
+
+    val = negative ? static_cast<T>(U{0} - acc) : static_cast<T>(acc);
+    return {ptr, std::errc{}};
+  }
+
+  /**
+   * Parses a floating point number from a character buffer, analogous to `std::from_chars` but also
+   * accepting a leading `+` as `std::istream` does.
+   *
+   * Numbers with at most 19 significant digits whose mantissa and decimal exponent are exactly
+   * representable are computed directly with a single correctly-rounded operation, all other numbers
+   * are passed to `std::from_chars`. Either way the result is the correctly-rounded value, i.e. it is
+   * bit-identical to `strtod` and the `std::istream` extraction.
+   *
+   * @param first The start of the buffer.
+   * @param last  The end of the buffer.
+   * @param val   The destination the value is written into, unmodified on error.
+   * @returns     The end of the parsed number and an error code.
+   */
+  template <class T, std::enable_if_t<std::is_floating_point_v<T>, bool> = true>
+  [[nodiscard]] std::from_chars_result parse_number(const char* first, const char* last, T& val) noexcept
+  {
+    // Powers of ten that are exactly representable as doubles
+    constexpr std::array<double, 23> pow10{1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,
+                                           1e8,  1e9,  1e10, 1e11, 1e12, 1e13, 1e14, 1e15,
+                                           1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+    constexpr uint64_t max_exact = uint64_t{1} << 53U;  // Largest exactly representable mantissa
+    constexpr int max_digits     = 19;                  // Significant digits that fit in 64 bits
+    constexpr int max_exponent   = 22;                  // Largest exactly representable power of ten
+
+    // The character buffer is scanned directly.
+    // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const char* ptr     = first;
+    const bool negative = (ptr != last) && (*ptr == '-');
+    if ((ptr != last) && ((*ptr == '-') || (*ptr == '+')))
+    {
+      ptr++;
+    }
+
+    // Anything not handled by the fast path, including special values and malformed input, is
+    // handled by std::from_chars which rejects the leading '+'.
+    const char* unsigned_first = ptr;
+    const auto fallback        = [first, unsigned_first, last, negative, &val]() -> std::from_chars_result
+    {
+      return std::from_chars(negative ? first : unsigned_first, last, val);
+    };
+    if constexpr (!std::is_same_v<T, double>)
+    {
+      return fallback();
+    }
+
+    uint64_t mantissa = 0;
+    int n_digits      = 0;  // Significant digits in mantissa
+    int exponent      = 0;
+    bool any_digits   = false;
+    const auto accumulate = [&mantissa, &n_digits](const char ch)
+    {
+      const auto digit = static_cast<uint64_t>(ch - '0');
+      if ((mantissa != 0) || (digit != 0))
+      {
+        n_digits++;
+      }
+      mantissa = mantissa * 10 + digit;
+    };
+
+    for (; (ptr != last) && is_digit(*ptr); ptr++)
+    {
+      accumulate(*ptr);
+      any_digits = true;
+    }
+    if ((ptr != last) && (*ptr == '.'))
+    {
+      for (ptr++; (ptr != last) && is_digit(*ptr); ptr++)
+      {
+        accumulate(*ptr);
+        exponent--;
+        any_digits = true;
+      }
+    }
+    if (!any_digits || (n_digits > max_digits))
+    {
+      return fallback();
+    }
+
+    if ((ptr != last) && ((*ptr == 'e') || (*ptr == 'E')))
+    {
+      ptr++;
+      const bool negative_exponent = (ptr != last) && (*ptr == '-');
+      if ((ptr != last) && ((*ptr == '-') || (*ptr == '+')))
+      {
+        ptr++;
+      }
+      if ((ptr == last) || !is_digit(*ptr))
+      {
+        return fallback();
+      }
+
+      int exp10 = 0;
+      for (; (ptr != last) && is_digit(*ptr); ptr++)
+      {
+        if (exp10 > std::numeric_limits<int>::max() / 16)
+        {
+          return fallback();
+        }
+        exp10 = exp10 * 10 + (*ptr - '0');
+      }
+      exponent += negative_exponent ? -exp10 : exp10;
+    }
+    // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+
+    if (mantissa == 0)
+    {
+      val = static_cast<T>(negative ? -0.0 : 0.0);
+      return {ptr, std::errc{}};
+    }
+    if ((mantissa > max_exact) || (exponent < -max_exponent) || (exponent > max_exponent))
+    {
+      return fallback();
+    }
+
+    // Both operands are exact so the result is correctly rounded.
+    auto value = static_cast<double>(mantissa);
+    if (exponent < 0)
+    {
+      value /= pow10[static_cast<size_t>(-exponent)];
+    }
+    else
+    {
+      value *= pow10[static_cast<size_t>(exponent)];
+    }
+    val = static_cast<T>(negative ? -value : value);
+
+    return {ptr, std::errc{}};
+  }
+
+  /**
+   * Extracts a number from a stream, analogous to `stream >> val` in the classic "C" locale.
+   *
+   * Rather than the locale-aware formatted extraction, characters are scanned directly from the
+   * stream buffer and parsed by `parse_number`.
+   *
+   * @param stream The stream to extract from.
+   * @param val    The destination the value is written into.
+   * @returns      The stream.
+   */
+  template <class T>
+  std::istream& extract_number(std::istream& stream, T& val)
+  {
+    using traits = std::istream::traits_type;
+
+    if (!stream.good())
+    {
+      stream.setstate(std::ios::failbit);
+      return stream;
+    }
+
+    auto* buf = stream.rdbuf();
+    auto c    = buf->sgetc();
+    while (!traits::eq_int_type(c, traits::eof()) && is_space(traits::to_char_type(c)))
+    {
+      c = buf->snextc();
+    }
+
+    // Collect the characters that could form a number
+    const auto is_number_char = [](const char ch) -> bool
+    {
+      return is_digit(ch) || (ch == '-') || (ch == '+') || (ch == '.') || (ch == 'e') || (ch == 'E');
+    };
+    std::array<char, 64> token{};
+    size_t len = 0;
+    while (!traits::eq_int_type(c, traits::eof()) && is_number_char(traits::to_char_type(c)))
+    {
+      if (len == token.size())
+      {
+        stream.setstate(std::ios::failbit);
+        return stream;
+      }
+      token[len++] = traits::to_char_type(c);
+      c            = buf->snextc();
+    }
+
+    auto state = std::ios::goodbit;
+    if (traits::eq_int_type(c, traits::eof()))
+    {
+      state |= std::ios::eofbit;
+    }
+
+    const auto* const last = token.data() + len;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const auto [ptr, ec]   = parse_number(token.data(), last, val);
+    if ((ec != std::errc{}) || (ptr != last))
+    {
+      state |= std::ios::failbit;
+    }
+    stream.setstate(state);
+
+    return stream;
+  }
+}  // namespace cfg::utils
+
+#endif  // __CFG_NUMBER_PARSER_H_
@@ -0,0 +1,27 @@
+/**
+ * partitioned_mesh.h
+ *
+ * A rank's partition of a mesh, as produced by partitioning and migration or loaded from the CFGrid
+ * partitioned mesh format.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef __CFG_PARTITIONED_MESH_H_
+#define __CFG_PARTITIONED_MESH_H_
+
+#include <element_parser.h>
+#include <node_set.h>
+
+namespace cfg::hpc
+{
+  /**
+   * A rank's partition of a mesh.
+   */
+  struct PartitionedMesh
+  {
+    cfg::parser::NodeSet<3> nodes;     ///< The nodes held by this rank.
+    cfg::parser::ElementSet elements;  ///< The elements held by this rank.
+  };
+}  // namespace cfg::hpc
+
+#endif  // __CFG_PARTITIONED_MESH_H_
@@ -10,8 +10,18 @@
 #include <string>
 #include <utility>
 #include <fstream>
+#include <memory>
+#include <type_traits>
 
+#include <mpi.h>
+
+#include <async_stream.h>
+#include <element_parser.h>
+#include <mapped_stream.h>
+#include <mesh_index.h>
+#include <mpiio_reader.h>
 #include <node_parser.h>
+#include <node_set.h>
 
 namespace cfg::reader
 {
@@ -22,14 +32,14 @@ namespace cfg::reader
   {
     std::string version;  ///< The GMSH mesh file format version.
     bool binary;          ///< Flag indicating whether the mesh file is in binary or ASCII format.
-    size_t dsize;         ///< Value indicating the number of bytes used for floating point numbers.
+    size_t dsize;         ///< The data size of the file, i.e. the number of bytes of its `size_t` values.
 
     /**
      * Constructor for the `gmsh_header` object.
      *
      * @param version A version string, for example "4.1".
      * @param binary  A flag indicating whether the file is in binary or ASCII format.
-     * @param dsize   The size in bytes of floating point numbers in the file.
+     * @param dsize   The data size of the file, i.e. the size in bytes of its `size_t` values.
      */
     GmshHeader(std::string version, const bool binary, const size_t dsize)
         : version(std::move(version)), binary(binary), dsize(dsize){};
@@ -60,36 +70,150 @@ namespace cfg::reader
   };
 
   /**
-   * Reads a GMSH file.
+   * Identifies how the `GmshReader` accesses the mesh file.
+   */
+  enum class Backend
+  {
+    STREAM,  ///< Read through an `std::ifstream`.
+    MMAP,    ///< Read through a memory-mapping of the file, falling back to `STREAM` if this fails.
+    MPIIO,   ///< Read binary nodes collectively through MPI-IO, all other data is read as for `MMAP`.
+    ASYNC    ///< Read through an `AsyncFileStream`, overlapping reading the file with parsing it.
+  };
+
+  /**
+   * Reads a GMSH file, holding this rank's nodes and elements.
    */
   class GmshReader
   {
-  public:
+   public:
     /**
      * Constructs a `GmshReader` object.
      *
-     * @param mesh_file The filepath to a GMSH file (assumed valid).
-     * @param parallel  The parallel environment.
+     * @param mesh_file  The filepath to a GMSH file (assumed valid).
+     * @param parallel   The parallel environment.
+     * @param backend    How the mesh file should be accessed.
+     * @param comm       The communicator corresponding to the parallel environment, required by the
+     *                   `MPIIO` backend and by global validation.
+     * @param use_index  Whether to use the sidecar index of the mesh file, see `load_mesh_index`. The
+     *                   index is rebuilt, and rewritten by rank 0, if it is missing or stale.
+     * @param validation How thoroughly the nodes read are validated, by default globally over `comm`.
      */
-    GmshReader(const std::filesystem::path& mesh_file, const cfg::utils::Parallel& parallel)
+    GmshReader(const std::filesystem::path& mesh_file,
+               const cfg::utils::Parallel& parallel,
+               const Backend backend                    = Backend::MMAP,
+               MPI_Comm comm                            = MPI_COMM_WORLD,
+               const bool use_index                     = false,
+               const cfg::parser::Validation validation = cfg::parser::Validation::GLOBAL)
     {
       const GmshHeader header = read_header(mesh_file);
+      const auto mode         = header.binary ? cfg::parser::Mode::BINARY : cfg::parser::Mode::ASCII;
+
+      // The encoding is dispatched on once, the sections are read by readers specialised for it
+      cfg::parser::with_encoding(mode,
+                                 header.dsize,
+                                 [&](auto encoding)
+                                 {
+                                   read_mesh<decltype(encoding)>(
+                                       mesh_file, parallel, backend, comm, use_index, validation);
+                                 });
+    }
+
+    /**
+     * Returns the nodes held by this rank.
+     */
+    [[nodiscard]] const cfg::parser::NodeSet<3>& nodes() const
+    {
+      return mesh_nodes;
+    }
 
-      if (header.binary)
+    /**
+     * Returns the elements held by this rank.
+     */
+    [[nodiscard]] const cfg::parser::ElementSet& elements() const
+    {
+      return mesh_elements;
+    }
+
+   private:
+    cfg::parser::NodeSet<3> mesh_nodes;     // The nodes held by this rank
+    cfg::parser::ElementSet mesh_elements;  // The elements held by this rank
+
+    /**
+     * Reads the nodes and elements of a mesh file of a given encoding, see the constructor.
+     *
+     * @tparam E The encoding of the mesh file, see `cfg::parser::Encoding`.
+     */
+    template <class E>
+    void read_mesh(const std::filesystem::path& mesh_file,
+                   const cfg::utils::Parallel& parallel,
+                   const Backend backend,
+                   MPI_Comm comm,
+                   const bool use_index,
+                   const cfg::parser::Validation validation)
+    {
+      // Binary nodes may be read collectively, the remaining sections are read by the stream backends.
+      // The collective reader only supports 8 byte `size_t` values.
+      const bool collective = (backend == Backend::MPIIO) && std::is_same_v<E, cfg::parser::BinaryEncoding>;
+      if (collective)
       {
-	// Binary
-	std::ifstream mesh_stream{mesh_file, std::ios::in | std::ios::binary};
-	cfg::parser::read_nodes(mesh_stream, cfg::parser::Mode::BINARY, parallel);
+        mesh_nodes = cfg::parser::to_node_set(cfg::parser::read_nodes(mesh_file, comm, validation));
+      }
+
+      // The sections are located in a single pass over the file, or loaded from the sidecar index
+      // along with the location of each node and element block
+      const auto read_indexed = [this, collective, &parallel, validation, comm](auto& mesh_stream, const auto& index)
+      {
+        if (!collective)
+        {
+          mesh_nodes =
+              cfg::parser::to_node_set(cfg::parser::read_nodes<E>(mesh_stream, parallel, index, validation, comm));
+        }
+        mesh_elements = cfg::parser::read_elements<E>(mesh_stream, parallel, index);
+      };
+      const auto read_sections = [&read_indexed, &mesh_file, use_index, &parallel](auto& mesh_stream)
+      {
+        if (use_index)
+        {
+          read_indexed(mesh_stream, load_mesh_index<E>(mesh_file, mesh_stream, parallel.rank == 0));
+        }
+        else
+        {
+          read_indexed(mesh_stream, SectionIndex{mesh_stream});
+        }
+      };
+
+      if ((backend == Backend::MMAP) || (backend == Backend::MPIIO))
+      {
+        const auto mapping = map_file(mesh_file);
+        if (mapping)
+        {
+          MappedStream mesh_stream{*mapping};
+          read_sections(mesh_stream);
+          return;
+        }
+      }
+
+      if (backend == Backend::ASYNC)
+      {
+        AsyncFileStream mesh_stream{mesh_file};
+        read_sections(mesh_stream);
+        return;
+      }
+
+      if constexpr (E::mode == cfg::parser::Mode::BINARY)
+      {
+        // Binary
+        std::ifstream mesh_stream{mesh_file, std::ios::in | std::ios::binary};
+        read_sections(mesh_stream);
       }
       else
       {
-	// ASCII
-	std::ifstream mesh_stream{mesh_file};
-	cfg::parser::read_nodes(mesh_stream, cfg::parser::Mode::ASCII, parallel);
+        // ASCII
+        std::ifstream mesh_stream{mesh_file};
+        read_sections(mesh_stream);
       }
     }
 
-   private:
     /**
      * Convenience function to parse out the header of a GMSH mesh file given the file path.
      *
@@ -97,6 +221,14 @@ namespace cfg::reader
      * @returns        The GMSH header data structure.
      */
     [[nodiscard]] static GmshHeader read_header(const std::filesystem::path& meshfile);
+
+    /**
+     * Attempts to memory-map a mesh file.
+     *
+     * @param meshfile The path to the file.
+     * @returns        The mapped file, or `nullptr` if the file could not be mapped.
+     */
+    [[nodiscard]] static std::unique_ptr<MappedFile> map_file(const std::filesystem::path& meshfile);
   };
 }  // namespace cfg::reader
 
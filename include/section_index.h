@@ -0,0 +1,132 @@
+/**
+ * section_index.h
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef __CFG_SECTION_INDEX_H_
+#define __CFG_SECTION_INDEX_H_
+
+#include <cstddef>
+#include <istream>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <mapped_stream.h>
+
+namespace cfg::reader
+{
+  /**
+   * Locates every section of a GMSH file in a single pass over the file.
+   *
+   * The file is scanned line by line, using `memchr` to find the line ends in the raw bytes, and
+   * each line beginning with a `$` sygil is checked. Once a `$NAME` line opens a section, only its
+   * `$EndNAME` line is recognised, so the data of a binary section is not interpreted.
+   */
+  class SectionIndex
+  {
+   public:
+    /**
+     * Marks a section without an end in the file.
+     */
+    static constexpr size_t npos = std::numeric_limits<size_t>::max();
+
+    /**
+     * The location of a section in the file.
+     */
+    struct Section
+    {
+      size_t start{};    ///< The offset of the `$NAME` sygil.
+      size_t end{npos};  ///< The offset of the `$EndNAME` sygil, or `npos` if the section is not closed.
+
+      [[nodiscard]] bool operator==(const Section& other) const
+      {
+        return (start == other.start) && (end == other.end);
+      }
+    };
+
+    /**
+     * Constructs an empty `SectionIndex`.
+     */
+    SectionIndex() = default;
+
+    /**
+     * Constructs a `SectionIndex` by scanning a span of bytes, e.g. a memory-mapped file.
+     *
+     * @param bytes The contents of the mesh file.
+     */
+    explicit SectionIndex(const std::string_view bytes);
+
+    /**
+     * Constructs a `SectionIndex` by scanning the bytes underlying a `MappedStream`.
+     *
+     * @param mesh_data The memory-mapped mesh stream.
+     */
+    explicit SectionIndex(const MappedStream& mesh_data) : SectionIndex(mesh_data.view()) {}
+
+    /**
+     * Constructs a `SectionIndex` by scanning a stream from its beginning in fixed-size chunks, the
+     * stream is returned to its beginning with its state cleared.
+     *
+     * @param mesh_data The mesh stream.
+     */
+    explicit SectionIndex(std::istream& mesh_data);
+
+    /**
+     * Constructs a `SectionIndex` from previously located sections, e.g. loaded from a cached index.
+     *
+     * @param sections The sections of the file, in the order they appear.
+     */
+    explicit SectionIndex(std::vector<std::pair<std::string, Section>> sections) : entries(std::move(sections)) {}
+
+    /**
+     * Tests whether the file contains a section.
+     *
+     * @param section_name The name of the section, i.e. without the `$` sygil.
+     * @returns Whether the section is in the file (`true`) or not (`false`).
+     */
+    [[nodiscard]] bool contains(const std::string& section_name) const;
+
+    /**
+     * Locates a section, raising an error if it is not found. If a section occurs more than once
+     * the first is returned.
+     *
+     * @param section_name The name of the section, i.e. without the `$` sygil.
+     * @returns The location of the section.
+     */
+    [[nodiscard]] const Section& find(const std::string& section_name) const;
+
+    /**
+     * Returns the sections of the file, in the order they appear.
+     */
+    [[nodiscard]] const std::vector<std::pair<std::string, Section>>& sections() const
+    {
+      return entries;
+    }
+
+   private:
+    std::vector<std::pair<std::string, Section>> entries;  // The sections, in file order
+    bool open{false};                                      // Whether the last section is open
+
+    /**
+     * Scans a span of bytes, recording the sections found.
+     *
+     * @param bytes The bytes to scan, the first byte must begin a line.
+     * @param base  The offset of the bytes in the file.
+     * @returns The number of bytes scanned, any remaining bytes form an incomplete line.
+     */
+    size_t scan(const std::string_view bytes, const size_t base);
+
+    /**
+     * Processes a line of the file, recording it if it opens or closes a section.
+     *
+     * @param line The line, excluding the newline.
+     * @param pos  The offset of the line in the file.
+     */
+    void add_line(std::string_view line, size_t pos);
+  };
+}  // namespace cfg::reader
+
+#endif  // __CFG_SECTION_INDEX_H_
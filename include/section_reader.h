@@ -9,6 +9,8 @@
 #include <istream>
 #include <string>
 
+#include <section_index.h>
+
 namespace cfg::reader
 {
   /**
@@ -18,18 +20,17 @@ namespace cfg::reader
    * @note This class is intended to be created as a temporary/intermediate object and not used
    *       directly by users.
    */
-  template <class SR>
+  template <class SR, class S = std::istream>
   class SectionReaderExtractor
   {
    public:
     /**
-     * Constructs a `SectionReaderExtractor` for a `SectionReader` and associated `std::istream`
-     * object.
+     * Constructs a `SectionReaderExtractor` for a `SectionReader` and associated stream object.
      *
-     * @param reader The `SectionReader` object that is reading a section from the `std::istream`.
-     * @param stream The `std::istream` that is being read.
+     * @param reader The `SectionReader` object that is reading a section from the stream.
+     * @param stream The stream that is being read.
      */
-    SectionReaderExtractor(const SR& reader, std::istream& stream) : reader(reader), stream(stream) {}
+    SectionReaderExtractor(const SR& reader, S& stream) : reader(reader), stream(stream) {}
 
     /**
      * Extraction operator, extracts an item from the underlying stream.
@@ -38,7 +39,7 @@ namespace cfg::reader
      * @returns   The stream reference.
      */
     template <class T>
-    std::istream& operator>>(T& val)
+    S& operator>>(T& val)
     {
       return reader.pop_word(stream, val);
     }
@@ -47,8 +48,8 @@ namespace cfg::reader
     // Generally we should not capture a reference as part of a class/structure, however this is a
     // temporary object that exists only to implement the operator>> for SectionReader and this
     // temporary capture should be OK.
-    const SR& reader;      // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
-    std::istream& stream;  // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
+    const SR& reader;  // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
+    S& stream;         // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
   };
 
   /**
@@ -56,6 +57,9 @@ namespace cfg::reader
    *
    * GMSH file sections are bracketed by `$NAME` and `$EndNAME` lines and these are used to identify
    * the limits of the section stream.
+   *
+   * The stream may be any type implementing the `std::istream` subset used here, i.e. an
+   * `std::istream` or a `MappedStream`.
    */
   class SectionReader
   {
@@ -67,7 +71,8 @@ namespace cfg::reader
      *                     `$section_name` and `$Endsection_name` in the GMSH file.
      * @param mesh_data Stream to read mesh from.
      */
-    SectionReader(const std::string& section_name, std::istream& mesh_data)
+    template <class S>
+    SectionReader(const std::string& section_name, S& mesh_data)
         : start_sygil("$" + section_name), end_sygil("$End" + section_name)
     {
       // Searches the mesh for the `section_name` sygil.
@@ -104,12 +109,31 @@ namespace cfg::reader
       }
       catch (const std::runtime_error& e)
       {
-        // Try again from the start
+        // Try again from the start, the failed search will have set the stream state
+        clear(mesh_data);
         mesh_data.seekg(0);
         start = search(start_sygil);
       }
     }
 
+    /**
+     * Constructs a `SectionReader` object, locating the section from an index of the mesh file
+     * rather than searching the stream. The stream is left following the section's opening sygil.
+     *
+     * @param section_name The identifier for the section, i.e. this will read between
+     *                     `$section_name` and `$Endsection_name` in the GMSH file.
+     * @param mesh_data    Stream to read mesh from.
+     * @param index        The index of the sections of the mesh file.
+     */
+    template <class S>
+    SectionReader(const std::string& section_name, S& mesh_data, const SectionIndex& index)
+        : start_sygil("$" + section_name),
+          end_sygil("$End" + section_name),
+          start(static_cast<std::streamoff>(index.find(section_name).start))
+    {
+      seekg(mesh_data, static_cast<std::streamoff>(start_sygil.size()));
+    }
+
     /**
      * Seeks a location of the mesh stream, relative to the beginning of the section, resetting any
      * flags.
@@ -118,7 +142,8 @@ namespace cfg::reader
      * @param pos The position to go to, reltive to section start: e.g. `pos=0` would go to the
      *            start of the section.
      */
-    void seekg(std::istream& mesh_data, const std::istream::pos_type pos) const
+    template <class S>
+    void seekg(S& mesh_data, const std::istream::pos_type pos) const
     {
       clear(mesh_data);
       mesh_data.seekg(start + pos);
@@ -131,8 +156,8 @@ namespace cfg::reader
      * @param val       The destination the value is inserted into.
      * @returns         The stream.
      */
-    template <class T>
-    [[nodiscard]] std::istream& pop_word(std::istream& mesh_data, T& val) const
+    template <class S, class T>
+    [[nodiscard]] S& pop_word(S& mesh_data, T& val) const
     {
       ffwd(mesh_data);
       mesh_data >> val;
@@ -148,7 +173,8 @@ namespace cfg::reader
      * @param val       The string the word is inserted into.
      * @returns         The stream.
      */
-    [[nodiscard]] std::istream& pop_word(std::istream& mesh_data, std::string& val) const
+    template <class S>
+    [[nodiscard]] S& pop_word(S& mesh_data, std::string& val) const
     {
       ffwd(mesh_data);
       mesh_data >> val;
@@ -171,7 +197,8 @@ namespace cfg::reader
      * @param mesh_data The stream being read.
      * @returns         A (temporary) `SectionReaderExtractor`.
      */
-    [[nodiscard]] SectionReaderExtractor<SectionReader> operator()(std::istream& mesh_data) const
+    template <class S>
+    [[nodiscard]] SectionReaderExtractor<SectionReader, S> operator()(S& mesh_data) const
     {
       return {*this, mesh_data};
     }
@@ -186,10 +213,13 @@ namespace cfg::reader
      *       seems more natural to return it directly. The `std::getline` calling convention could
      *       be implemented as an overload of this if required.
      */
-    [[nodiscard]] std::string getline(std::istream& mesh_data) const
+    template <class S>
+    [[nodiscard]] std::string getline(S& mesh_data) const
     {
+      using std::getline;  // Allows streams to provide their own getline
+
       std::string line;
-      std::getline(mesh_data, line);
+      getline(mesh_data, line);
 
       if (is_section_end(line))
       {
@@ -212,7 +242,8 @@ namespace cfg::reader
     // This could be static, but the idea of the SectionReader is to have some state wrt the section
     // being read, and this would defeat the purpose.
     // NOLINTNEXTLINE(readability-convert-member-functions-to-static)
-    void clear(std::istream& mesh_data) const
+    template <class S>
+    void clear(S& mesh_data) const
     {
       mesh_data.clear();  // Reset data stream flags
     }
@@ -222,7 +253,8 @@ namespace cfg::reader
      *
      * @param mesh_data The mesh stream.
      */
-    void ffwd(std::istream& mesh_data) const
+    template <class S>
+    void ffwd(S& mesh_data) const
     {
       if (mesh_data.tellg() < start)
       {
@@ -249,7 +281,8 @@ namespace cfg::reader
     // This could be static, but the idea of the SectionReader is to have some state wrt the section
     // being read, and this would defeat the purpose.
     // NOLINTNEXTLINE(readability-convert-member-functions-to-static)
-    void set_end(std::istream& mesh_data) const
+    template <class S>
+    void set_end(S& mesh_data) const
     {
       mesh_data.seekg(0, std::ios::end);
     }
@@ -0,0 +1,114 @@
+/**
+ * sfc_partition.h
+ *
+ * Partitioning and ordering of mesh nodes along a space-filling curve.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef __CFG_SFC_PARTITION_H_
+#define __CFG_SFC_PARTITION_H_
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <mpi.h>
+
+#include <geometric_partition.h>
+#include <node_set.h>
+#include <utils.h>
+
+namespace cfg::utils
+{
+  /**
+   * Identifies the space-filling curve used to order nodes.
+   */
+  enum class Curve
+  {
+    MORTON,  ///< The Morton (Z-order) curve, cheapest to compute.
+    HILBERT  ///< The Hilbert curve, consecutive keys are always spatial neighbours.
+  };
+
+  /**
+   * The number of bits per axis of the space-filling-curve keys, three axes fit in a 64-bit key.
+   */
+  constexpr unsigned int sfc_bits = 21;
+
+  /**
+   * Computes the Morton key of a point on the integer grid.
+   *
+   * @param x The grid coordinates, each less than `2^sfc_bits`.
+   * @returns The key, the bits of the coordinates interleaved with `x[0]` least significant.
+   */
+  [[nodiscard]] uint64_t morton_key(const std::array<uint32_t, 3>& x);
+
+  /**
+   * Computes the Hilbert key of a point on the integer grid.
+   *
+   * @param x The grid coordinates, each less than `2^sfc_bits`.
+   * @returns The key.
+   */
+  [[nodiscard]] uint64_t hilbert_key(const std::array<uint32_t, 3>& x);
+
+  /**
+   * Computes the bounding box of the nodes held by all ranks, this must be called collectively.
+   *
+   * @param nodes The nodes held by this rank.
+   * @param comm  The communicator.
+   * @returns The bounding box.
+   */
+  [[nodiscard]] BoundingBox<3> global_bounding_box(const cfg::parser::NodeSet<3>& nodes, MPI_Comm comm);
+
+  /**
+   * Computes the space-filling-curve keys of the nodes, the bounding box is mapped onto the integer
+   * grid of the curve.
+   *
+   * The coordinates are quantised one axis at a time and the keys computed by branch-free bit
+   * manipulation, so the loops over the node arrays vectorise.
+   *
+   * @param nodes The nodes.
+   * @param box   The bounding box mapped to the curve, containing the nodes.
+   * @param curve The space-filling curve.
+   * @returns The key of each node.
+   */
+  [[nodiscard]] std::vector<uint64_t> sfc_keys(const cfg::parser::NodeSet<3>& nodes,
+                                               const BoundingBox<3>& box,
+                                               const Curve curve);
+
+  /**
+   * Reorders this rank's nodes along a space-filling curve and renumbers their global indices, the
+   * nodes of all ranks are numbered consecutively in rank order. This must be called collectively.
+   *
+   * Following an `SFCPartition` of the same curve, and migration of the nodes to their destination
+   * ranks, the global indices follow the curve across all ranks.
+   *
+   * @param nodes The nodes held by this rank, reordered and renumbered on return.
+   * @param comm  The communicator.
+   * @param curve The space-filling curve.
+   */
+  void sfc_renumber(cfg::parser::NodeSet<3>& nodes, MPI_Comm comm, const Curve curve = Curve::HILBERT);
+
+  /**
+   * Partitions nodes into equal ranges along a space-filling curve.
+   *
+   * Each rank computes the keys of its nodes and sorts them locally, the keys splitting the curve
+   * into equal ranges are then located by a distributed search that bisects the key space of all
+   * ranges simultaneously, using one reduction per step. Nodes with keys equal to a splitter are
+   * assigned in rank order to exactly balance the partition, so no global sort or exchange of keys
+   * is required.
+   */
+  class SFCPartition : public GeometricPartition
+  {
+   public:
+    /**
+     * Constructs the space-filling-curve partition, this must be called collectively.
+     *
+     * @param nodes The nodes held by this rank.
+     * @param comm  The communicator the nodes are partitioned over.
+     * @param curve The space-filling curve.
+     */
+    SFCPartition(const cfg::parser::NodeSet<3>& nodes, MPI_Comm comm, const Curve curve = Curve::HILBERT);
+  };
+}  // namespace cfg::utils
+
+#endif  // __CFG_SFC_PARTITION_H_
@@ -0,0 +1,77 @@
+/**
+ * thread_utils.h
+ *
+ * Shared-memory threading within a rank, independent of the MPI parallel environment.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef __CFG_THREAD_UTILS_H_
+#define __CFG_THREAD_UTILS_H_
+
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace cfg::utils
+{
+  /**
+   * Processes a range of items in parallel, splitting it into contiguous chunks of (nearly) equal
+   * size, one per thread. The calling thread processes the first chunk and the call returns once
+   * every chunk has been processed, if any thread raises an exception the first is rethrown.
+   *
+   * @param n_threads The number of threads, including the calling thread.
+   * @param n_items   The number of items.
+   * @param fn        The function processing a chunk, called as `fn(thread, first, last)` for the
+   *                  items `[first, last)`.
+   */
+  template <class F>
+  void parallel_for(const unsigned int n_threads, const size_t n_items, const F& fn)
+  {
+    const auto chunk_start = [n_threads, n_items](const size_t thread) -> size_t
+    {
+      return (thread * n_items) / n_threads;
+    };
+
+    if (n_threads <= 1)
+    {
+      fn(0U, size_t{0}, n_items);
+      return;
+    }
+
+    std::vector<std::exception_ptr> errors(n_threads);
+    const auto run = [&fn, &errors, &chunk_start](const unsigned int thread)
+    {
+      try
+      {
+        fn(thread, chunk_start(thread), chunk_start(thread + 1));
+      }
+      catch (...)
+      {
+        errors[thread] = std::current_exception();
+      }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(n_threads - 1);
+    for (unsigned int thread = 1; thread < n_threads; thread++)
+    {
+      threads.emplace_back(run, thread);
+    }
+    run(0);
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+
+    for (const auto& error : errors)
+    {
+      if (error)
+      {
+        std::rethrow_exception(error);
+      }
+    }
+  }
+}  // namespace cfg::utils
+
+#endif  // __CFG_THREAD_UTILS_H_
@@ -7,6 +7,9 @@
 #define __CFG_UTILS_H_
 
 #include <algorithm>
+#include <array>
+#include <cstddef>
+#include <new>
 #include <vector>
 
 namespace cfg::utils
@@ -50,14 +53,95 @@ namespace cfg::utils
                               }) == last;
   }
 
+  /**
+   * An allocator providing storage aligned to a number of bytes, by default a cache line, so that
+   * arrays can be streamed and vectorised efficiently.
+   */
+  template <class T, std::size_t alignment = 64>
+  class AlignedAllocator
+  {
+   public:
+    using value_type = T;  ///< The type of the allocated elements.
+
+    /**
+     * Provides the equivalent allocator for another element type.
+     */
+    template <class U>
+    struct rebind
+    {
+      using other = AlignedAllocator<U, alignment>;  ///< The allocator for elements of type `U`.
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    /**
+     * Converting constructor, the allocator is stateless so there is nothing to copy.
+     */
+    template <class U>
+    // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+    AlignedAllocator(const AlignedAllocator<U, alignment>& /* other */) noexcept
+    {
+    }
+
+    /**
+     * Allocates aligned storage for a number of elements.
+     *
+     * @param n The number of elements.
+     * @returns The storage.
+     */
+    [[nodiscard]] T* allocate(const std::size_t n)
+    {
+      return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{alignment}));
+    }
+
+    /**
+     * Releases storage obtained from `allocate`.
+     *
+     * @param ptr The storage.
+     */
+    void deallocate(T* ptr, const std::size_t /* n */) noexcept
+    {
+      ::operator delete(ptr, std::align_val_t{alignment});
+    }
+
+    /**
+     * The allocator is stateless, so storage from any instance can be released by any other.
+     */
+    template <class U>
+    [[nodiscard]] bool operator==(const AlignedAllocator<U, alignment>& /* other */) const noexcept
+    {
+      return true;
+    }
+
+    /**
+     * The allocator is stateless, so storage from any instance can be released by any other.
+     */
+    template <class U>
+    [[nodiscard]] bool operator!=(const AlignedAllocator<U, alignment>& /* other */) const noexcept
+    {
+      return false;
+    }
+  };
+
+  /**
+   * An axis-aligned bounding box in `d` dimensions.
+   */
+  template <unsigned int d>
+  struct BoundingBox
+  {
+    std::array<double, d> min;  ///< The lower corner of the box
+    std::array<double, d> max;  ///< The upper corner of the box
+  };
+
   /**
    * A structure describing the parallel environment.
    */
   struct Parallel
   {
    public:
-    unsigned int rank;  ///< ID of this processing element (PE) in the parallel environment.
-    unsigned int size;  ///< Size of the parallel environment (how many PEs?).
+    unsigned int rank;          ///< ID of this processing element (PE) in the parallel environment.
+    unsigned int size;          ///< Size of the parallel environment (how many PEs?).
+    unsigned int n_threads{1};  ///< The number of threads each PE may use, independent of `size`.
   };
 
   /**
@@ -152,6 +236,14 @@ namespace cfg::utils
       return local_count;
     }
 
+    /**
+     * Returns the index of the first element in the partition.
+     */
+    [[nodiscard]] size_t start() const
+    {
+      return local_start;
+    }
+
    private:
     size_t local_count;
     size_t local_start;
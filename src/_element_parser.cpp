@@ -0,0 +1,96 @@
+/**
+ * _element_parser.cpp
+ *
+ * Implements the internal components of the element_parser module.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <_element_parser.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <utils.h>
+
+namespace cfg::parser
+{
+  void validate_elements(const ElementSet& elements,
+                         const ElementHeader& element_header,
+                         const cfg::utils::Parallel& parallel)
+  {
+    // Validate that we read enough data based on the naive partition
+    const cfg::utils::NaivePartition partition{parallel, element_header.n_elements};
+    if (elements.size() != partition.size())
+    {
+      throw std::runtime_error("The number of elements does not match expectation");
+    }
+
+    // Validate the connectivity structure
+    if ((elements.offsets.size() != (elements.size() + 1)) || (elements.offsets.back() != elements.nodes.size()))
+    {
+      throw std::runtime_error("The element connectivity is inconsistent");
+    }
+
+    // Validate data
+    const auto [it_min, it_max] = std::minmax_element(elements.natural_idx.begin(), elements.natural_idx.end());
+    if ((it_min != elements.natural_idx.end()) && (*it_min < element_header.min_tag))
+    {
+      throw std::runtime_error("The element indices are below the expected range");
+    }
+    if ((it_max != elements.natural_idx.end()) && (*it_max > element_header.max_tag))
+    {
+      throw std::runtime_error("The element indices are above the expected range");
+    }
+  }
+
+  template <class S>
+  std::function<ElementSet(const cfg::reader::SectionReader&, S&, const Mode)> make_element_reader(
+      const cfg::utils::Parallel& parallel)
+  {
+    // Return the element reader function, the encoding is dispatched on once per call
+    return [&parallel](const cfg::reader::SectionReader& element_reader, S& mesh_stream, const Mode mode)
+    {
+      return with_encoding(mode,
+                           [&](auto encoding) -> ElementSet
+                           {
+                             return read_X<decltype(encoding)>(ElementHeaderParser{},
+                                                               ElementDataParser{},
+                                                               ElementEnvironment{parallel},
+                                                               ElementValidator{parallel})(element_reader, mesh_stream);
+                           });
+    };
+  }
+
+  template <class S>
+  std::function<ElementSet(const cfg::reader::SectionReader&, S&, const Mode)> make_indexed_element_reader(
+      const cfg::utils::Parallel& parallel, const ElementHeader& element_header, const ElementLayout& layout)
+  {
+    // Return the element reader function, the encoding is dispatched on once per call
+    return [&parallel, element_header, &layout](
+               const cfg::reader::SectionReader& element_reader, S& mesh_stream, const Mode mode)
+    {
+      return with_encoding(mode,
+                           [&](auto encoding) -> ElementSet
+                           {
+                             return read_X<decltype(encoding)>(KnownHeader<ElementHeader>{element_header},
+                                                               ElementDataParser{},
+                                                               ElementEnvironment{parallel, &layout},
+                                                               ElementValidator{parallel})(element_reader, mesh_stream);
+                           });
+    };
+  }
+
+  template std::function<ElementSet(const cfg::reader::SectionReader&, std::istream&, const Mode)>
+  make_element_reader<std::istream>(const cfg::utils::Parallel& parallel);
+  template std::function<ElementSet(const cfg::reader::SectionReader&, cfg::reader::MappedStream&, const Mode)>
+  make_element_reader<cfg::reader::MappedStream>(const cfg::utils::Parallel& parallel);
+  template std::function<ElementSet(const cfg::reader::SectionReader&, std::istream&, const Mode)>
+  make_indexed_element_reader<std::istream>(const cfg::utils::Parallel& parallel,
+                                            const ElementHeader& element_header,
+                                            const ElementLayout& layout);
+  template std::function<ElementSet(const cfg::reader::SectionReader&, cfg::reader::MappedStream&, const Mode)>
+  make_indexed_element_reader<cfg::reader::MappedStream>(const cfg::utils::Parallel& parallel,
+                                                         const ElementHeader& element_header,
+                                                         const ElementLayout& layout);
+}  // namespace cfg::parser
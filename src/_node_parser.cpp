@@ -9,122 +9,539 @@
 #include <_node_parser.h>
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <stdexcept>
+#include <tuple>
 
+#include <mpi_utils.h>
 #include <utils.h>
 
 namespace cfg::parser
 {
-  /**
-   * Performs validation of the strides in node indices. Either the nodes are contiguous in which
-   * case the indices should be stride one, otherwise if there are holes in the index range we
-   * expect that there are no duplicate indices. An error is raised if the validation fails.
-   *
-   * @param nodes       The vector of nodes.
-   * @prarm node_header The global description of the nodes in the mesh that is used to test the data.
-   */
-  void validate_strides(const std::vector<Node<3>>& nodes, const NodeHeader& node_header)
+  std::vector<NodeRange> local_node_ranges(const std::vector<NodeBlock>& blocks, const utils::NaivePartition& partition)
   {
-    // Utility function to check whether the node range covers the number of
-    // nodes, therefore nodes should be contiguous (when sorted)
-    auto should_be_contiguous = [](const NodeHeader& node_header) -> bool
+    const auto local_start = partition.start();
+    const auto local_end   = partition.start() + partition.size();
+
+    std::vector<NodeRange> ranges;
+    for (size_t b = 0; b < blocks.size(); b++)
     {
-      return (node_header.max_tag - (node_header.min_tag - 1)) == node_header.n_nodes;
-    };
+      const auto block_start = blocks[b].first;
+      const auto block_end   = blocks[b].first + blocks[b].n_nodes;
+
+      // Blocks are in global index order, skip until we reach the partition and stop after it
+      if (block_end <= local_start)
+      {
+        continue;
+      }
+      if (block_start >= local_end)
+      {
+        break;
+      }
+
+      const auto start = std::max(block_start, local_start);
+      const auto end   = std::min(block_end, local_end);
+      ranges.push_back(NodeRange{b, start - block_start, end - start});
+    }
+
+    return ranges;
+  }
 
-    // Utility function to compute the stride in indexes between two nodes, short names are clear.
-    // NOLINTNEXTLINE(readability-identifier-length)
-    auto test_node_stride = [](const Node<3>& a, const Node<3>& b) -> size_t
+  LineIndex::LineIndex(const std::string_view bytes, const unsigned int n_threads, const size_t chunk_size)
+      : bytes{bytes}, chunk_size{std::max(chunk_size, size_t{1})}
+  {
+    // Only the newlines before the last byte start a line
+    const auto n_chunks = (bytes.size() + this->chunk_size - 1) / this->chunk_size;
+    newlines_before.assign(n_chunks + 1, 0);
+    const auto count_chunks = [this](const unsigned int /* thread */, const size_t first, const size_t last)
     {
-      return (b.natural_idx - a.natural_idx);
+      for (auto chunk = first; chunk < last; chunk++)
+      {
+        const auto start = chunk * this->chunk_size;
+        const auto end   = std::min(start + this->chunk_size, this->bytes.size() - 1);
+        newlines_before[chunk + 1] =
+            (start < end) ? static_cast<size_t>(std::count(
+                                this->bytes.begin() + static_cast<std::ptrdiff_t>(start),
+                                this->bytes.begin() + static_cast<std::ptrdiff_t>(end),
+                                '\n'))
+                          : 0;
+      }
     };
+    utils::parallel_for(std::max(n_threads, 1U), n_chunks, count_chunks);
+    for (size_t chunk = 0; chunk < n_chunks; chunk++)
+    {
+      newlines_before[chunk + 1] += newlines_before[chunk];
+    }
+
+    n_lines = bytes.empty() ? 0 : (newlines_before.back() + 1);
+  }
+
+  size_t LineIndex::line_start(const size_t line) const
+  {
+    if (line == 0)
+    {
+      return 0;
+    }
+
+    // The line follows the line-th newline, found in the last chunk with fewer newlines before it
+    const auto next  = std::lower_bound(newlines_before.begin(), newlines_before.end(), line);
+    const auto chunk = static_cast<size_t>(next - newlines_before.begin()) - 1;
+    auto pos         = chunk * chunk_size;
+    for (auto n = newlines_before[chunk]; n < line; n++)
+    {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      const auto* eol = static_cast<const char*>(std::memchr(bytes.data() + pos, '\n', bytes.size() - pos));
+      pos             = static_cast<size_t>(eol - bytes.data()) + 1;
+    }
+
+    return pos;
+  }
+
+  namespace
+  {
+    /**
+     * Duplicate node tags are detected with a bitmap of the tag range when it holds at most this
+     * many tags per node, i.e. when the bitmap is no larger than the tags themselves.
+     */
+    constexpr size_t max_bits_per_node = 64;
+
+    /**
+     * The minimum number of nodes validated by each thread.
+     */
+    constexpr size_t min_nodes_per_thread = size_t{1} << 15U;
+
+    // The validation failures of a rank, as bit flags so that they can be combined over the ranks
+    constexpr uint64_t count_failure     = 1U << 0U;  // The number of nodes does not match expectation
+    constexpr uint64_t below_failure     = 1U << 1U;  // A node index is below the expected range
+    constexpr uint64_t above_failure     = 1U << 2U;  // A node index is above the expected range
+    constexpr uint64_t duplicate_failure = 1U << 3U;  // A node index was found twice
 
-    // Create a sorted copy of the nodes based on their indices for checking strides
-    auto nodes_copy = nodes;
-    std::sort(nodes_copy.begin(),
-              nodes_copy.end(),
-              [](const Node<3>& node_a, const Node<3>& node_b) -> bool
-              {
-                return node_a.natural_idx < node_b.natural_idx;
-              });
-    if (should_be_contiguous(node_header))
+    /**
+     * Describes the first of a set of validation failures.
+     */
+    [[nodiscard]] std::string failure_message(const uint64_t failures)
     {
-      // Nodes should be contiguous when sorted
-      if (!cfg::utils::test_stride<Node<3>>(nodes_copy.begin(), nodes_copy.end(), test_node_stride))
+      if ((failures & count_failure) != 0)
       {
-        throw std::runtime_error("Expected contiguous node indices, yet sorted indices were non-contiguous");
+        return "The number of nodes does not match expectation";
       }
+      if ((failures & below_failure) != 0)
+      {
+        return "The node indices are below the expected range";
+      }
+      if ((failures & above_failure) != 0)
+      {
+        return "The node indices are above the expected range";
+      }
+      return "Duplicate node indices were found";
+    }
+
+    /**
+     * Determines whether the tags `[lo, hi]` are few enough to check the tags of `n_nodes` nodes
+     * for duplicates with a bitmap.
+     */
+    [[nodiscard]] bool dense(const size_t lo, const size_t hi, const size_t n_nodes)
+    {
+      return (lo <= hi) && (((hi - lo) / max_bits_per_node) < n_nodes);
+    }
+
+    /**
+     * Determines whether the node tags described by a header are contiguous, i.e. every tag in the
+     * range is used exactly once.
+     */
+    [[nodiscard]] bool contiguous(const NodeHeader& node_header)
+    {
+      return (node_header.n_nodes > 0) && (node_header.min_tag <= node_header.max_tag) &&
+             ((node_header.max_tag - node_header.min_tag) == (node_header.n_nodes - 1));
+    }
+
+    /**
+     * Hashes a node tag (the splitmix64 finaliser), the sum of the hashes of a set of tags is its
+     * fingerprint.
+     */
+    [[nodiscard]] uint64_t hash_tag(uint64_t tag)
+    {
+      constexpr uint64_t mul1 = 0xbf58476d1ce4e5b9;
+      constexpr uint64_t mul2 = 0x94d049bb133111eb;
+
+      tag = (tag ^ (tag >> 30U)) * mul1;
+      tag = (tag ^ (tag >> 27U)) * mul2;
+      return tag ^ (tag >> 31U);
     }
-    else
+
+    /**
+     * Marks a bit of a bitmap word, returning whether it was already marked.
+     */
+    [[nodiscard]] bool test_and_set(uint64_t& word, const uint64_t bit)
     {
-      // Nodes should at least not contain any duplicates
-      using NodesIterator = std::vector<Node<3>>::iterator;
-      auto test_nodup     = [test_node_stride](NodesIterator first, NodesIterator last) -> bool
+      const bool marked = (word & bit) != 0;
+      word |= bit;
+      return marked;
+    }
+
+    /**
+     * Marks a bit of a bitmap word shared by threads, returning whether it was already marked.
+     */
+    [[nodiscard]] bool test_and_set(std::atomic<uint64_t>& word, const uint64_t bit)
+    {
+      return (word.fetch_or(bit, std::memory_order_relaxed) & bit) != 0;
+    }
+
+    /**
+     * The result of scanning the node tags held by a rank.
+     */
+    struct TagScan
+    {
+      size_t min_tag{std::numeric_limits<size_t>::max()};  // The minimum tag
+      size_t max_tag{0};                                   // The maximum tag
+      bool duplicates{false};                              // Whether a tag was found twice
+      uint64_t fingerprint{0};                             // The sum of the hashes of the tags
+
+      /**
+       * Combines the scan of another range of tags into this scan.
+       */
+      void merge(const TagScan& other)
       {
-        return !cfg::utils::test_stride<Node<3>>(first, last, test_node_stride, 0);
-      };
+        min_tag = std::min(min_tag, other.min_tag);
+        max_tag = std::max(max_tag, other.max_tag);
+        duplicates |= other.duplicates;
+        fingerprint += other.fingerprint;
+      }
+    };
+
+    /**
+     * Scans node tags in a single parallel pass, finding their range, marking the tags within
+     * `[lo, hi]` in a bitmap to detect duplicates and optionally fingerprinting them.
+     *
+     * @param tags        Returns the tag of the i-th node.
+     * @param n_nodes     The number of nodes.
+     * @param lo          The tag of the first bit of the bitmap.
+     * @param hi          The tag of the last bit of the bitmap.
+     * @param bitmap      The zeroed bitmap, `nullptr` if duplicates are not detected.
+     * @param fingerprint Whether to fingerprint the tags.
+     * @param n_threads   The number of threads.
+     * @returns The scan of the tags.
+     */
+    template <class T, class W>
+    [[nodiscard]] TagScan scan_tags(const T& tags,
+                                    const size_t n_nodes,
+                                    const size_t lo,
+                                    const size_t hi,
+                                    W* bitmap,
+                                    const bool fingerprint,
+                                    const unsigned int n_threads)
+    {
+      std::vector<TagScan> scans(n_threads);
+      utils::parallel_for(n_threads,
+                          n_nodes,
+                          [&](const unsigned int thread, const size_t first, const size_t last)
+                          {
+                            TagScan scan;
+                            for (auto i = first; i < last; i++)
+                            {
+                              const size_t tag = tags(i);
+                              scan.min_tag     = std::min(scan.min_tag, tag);
+                              scan.max_tag     = std::max(scan.max_tag, tag);
+                              if (fingerprint)
+                              {
+                                scan.fingerprint += hash_tag(tag);
+                              }
+                              if ((bitmap != nullptr) && (tag >= lo) && (tag <= hi))
+                              {
+                                const auto bit = tag - lo;
+                                // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+                                scan.duplicates |= test_and_set(bitmap[bit / 64], uint64_t{1} << (bit % 64));
+                              }
+                            }
+                            scans[thread] = scan;
+                          });
 
-      if (!test_nodup(nodes_copy.begin(), nodes_copy.end()))
+      TagScan scan;
+      for (const auto& thread_scan : scans)
       {
-        throw std::runtime_error("Expected non-contiguous node indices: duplicate indices were found");
+        scan.merge(thread_scan);
       }
+
+      return scan;
     }
-  }
 
-  void validate_nodes(const std::vector<Node<3>>& nodes,
-                      const NodeHeader& node_header,
-                      const cfg::utils::Parallel& parallel)
-  {
-    // Validate that we read enough data based on the naive partition
-    const cfg::utils::NaivePartition partition{parallel, node_header.n_nodes};
-    if (nodes.size() != partition.size())
+    /**
+     * Scans node tags, optionally marking the tags `[lo, hi]` in a bitmap. The bitmap is held as
+     * atomic words when it is shared by several threads.
+     */
+    template <class T>
+    [[nodiscard]] TagScan scan_tags(const T& tags,
+                                    const size_t n_nodes,
+                                    const size_t lo,
+                                    const size_t hi,
+                                    const bool mark,
+                                    const bool fingerprint,
+                                    const unsigned int n_threads)
     {
-      throw std::runtime_error("The number of nodes does not match expectation");
-    }
+      if (!mark)
+      {
+        return scan_tags<T, uint64_t>(tags, n_nodes, lo, hi, nullptr, fingerprint, n_threads);
+      }
 
-    // Validate data
+      const auto n_words = ((hi - lo) / 64) + 1;
+      if (n_threads == 1)
+      {
+        std::vector<uint64_t> bitmap(n_words);
+        return scan_tags(tags, n_nodes, lo, hi, bitmap.data(), fingerprint, n_threads);
+      }
+      std::vector<std::atomic<uint64_t>> bitmap(n_words);
+      return scan_tags(tags, n_nodes, lo, hi, bitmap.data(), fingerprint, n_threads);
+    }
 
-    // Utility function to get the minimum and maximum of a vector
-    using const_NodesIterator = std::vector<Node<3>>::const_iterator;
-    auto get_min_max          = [](const_NodesIterator first, const_NodesIterator last) -> std::pair<size_t, size_t>
+    /**
+     * Checks the node tags held by a rank against the expected range and for duplicates.
+     *
+     * When the tag range of the header is dense the duplicates are detected in the same pass that
+     * finds the range of the tags, otherwise a second pass marks a bitmap of the local tag range if
+     * that is dense, or a sorted copy of the tags is searched.
+     *
+     * @param tags        Returns the tag of the i-th node.
+     * @param n_nodes     The number of nodes.
+     * @param node_header The global description of the nodes in the mesh.
+     * @param fingerprint Whether to fingerprint the tags.
+     * @param n_threads   The number of threads.
+     * @returns The validation failures and the scan of the tags.
+     */
+    template <class T>
+    [[nodiscard]] std::pair<uint64_t, TagScan> check_tags(const T& tags,
+                                                          const size_t n_nodes,
+                                                          const NodeHeader& node_header,
+                                                          const bool fingerprint,
+                                                          const unsigned int n_threads)
     {
-      const auto [it_min, it_max] = std::minmax_element(first,
-                                                        last,
-                                                        [](const Node<3>& node1, const Node<3>& node2)
-                                                        {
-                                                          return node1.natural_idx < node2.natural_idx;
-                                                        });
-      return {(*it_min).natural_idx, (*it_max).natural_idx};
-    };
+      const bool fused = dense(node_header.min_tag, node_header.max_tag, n_nodes);
+      auto scan = scan_tags(tags, n_nodes, node_header.min_tag, node_header.max_tag, fused, fingerprint, n_threads);
+      if (n_nodes == 0)
+      {
+        return {0, scan};
+      }
 
-    const auto [idx_min, idx_max] = get_min_max(nodes.begin(), nodes.end());
-    if (idx_min < node_header.min_tag)
+      uint64_t failures = 0;
+      if (scan.min_tag < node_header.min_tag)
+      {
+        failures |= below_failure;
+      }
+      if (scan.max_tag > node_header.max_tag)
+      {
+        failures |= above_failure;
+      }
+      if (!fused && (failures == 0))
+      {
+        if (dense(scan.min_tag, scan.max_tag, n_nodes))
+        {
+          scan.duplicates = scan_tags(tags, n_nodes, scan.min_tag, scan.max_tag, true, false, n_threads).duplicates;
+        }
+        else
+        {
+          // Only the tags are copied, not the nodes
+          std::vector<size_t> sorted(n_nodes);
+          for (size_t i = 0; i < n_nodes; i++)
+          {
+            sorted[i] = tags(i);
+          }
+          std::sort(sorted.begin(), sorted.end());
+          scan.duplicates = std::adjacent_find(sorted.begin(), sorted.end()) != sorted.end();
+        }
+      }
+      if (scan.duplicates)
+      {
+        failures |= duplicate_failure;
+      }
+
+      return {failures, scan};
+    }
+
+    /**
+     * The fingerprint of this rank's share of a contiguous tag range, split over the ranks as the
+     * nodes are.
+     */
+    [[nodiscard]] uint64_t expected_fingerprint(const NodeHeader& node_header,
+                                                const utils::NaivePartition& partition,
+                                                const unsigned int n_threads)
     {
-      throw std::runtime_error("The node indices are below the expected range");
+      const auto first_tag = node_header.min_tag + partition.start();
+      const auto share     = [first_tag](const size_t i) -> size_t
+      {
+        return first_tag + i;
+      };
+      return scan_tags(share, partition.size(), 0, 0, false, true, n_threads).fingerprint;
     }
-    if (idx_max > node_header.max_tag)
+
+    /**
+     * Validates the node tags held by a rank, see `validate_nodes`.
+     *
+     * @param tags        Returns the tag of the i-th node.
+     * @param n_nodes     The number of nodes.
+     * @param node_header The global description of the nodes in the mesh.
+     * @param parallel    The parallel environment.
+     * @param validation  How thoroughly the nodes are validated.
+     * @param comm        The communicator corresponding to the parallel environment.
+     */
+    template <class T>
+    void validate_tags(const T& tags,
+                       const size_t n_nodes,
+                       const NodeHeader& node_header,
+                       const utils::Parallel& parallel,
+                       const Validation validation,
+                       MPI_Comm comm)
     {
-      throw std::runtime_error("The node indices are above the expected range");
+      const bool global = (validation == Validation::GLOBAL) && (parallel.size > 1);
+      if (global && (comm == MPI_COMM_NULL))
+      {
+        throw std::runtime_error("Validating the nodes across the ranks requires a communicator");
+      }
+
+      // Validate that we read enough data based on the naive partition
+      const utils::NaivePartition partition{parallel, node_header.n_nodes};
+      uint64_t failures = (n_nodes != partition.size()) ? count_failure : 0;
+
+      // Validate the data, a contiguous tag range is fingerprinted to detect duplicates across ranks
+      const auto n_threads =
+          static_cast<unsigned int>(std::clamp<size_t>(n_nodes / min_nodes_per_thread, 1, parallel.n_threads));
+      const bool fingerprint = global && contiguous(node_header);
+      TagScan scan;
+      if ((validation != Validation::TRUST) && (failures == 0))
+      {
+        std::tie(failures, scan) = check_tags(tags, n_nodes, node_header, fingerprint, n_threads);
+      }
+
+      if (!global)
+      {
+        if (failures != 0)
+        {
+          throw std::runtime_error(failure_message(failures));
+        }
+        return;
+      }
+
+      // Every rank takes part in the reductions before raising an error, so that all ranks agree.
+      // The minimum tag is reduced as the maximum of its complement to share a single reduction.
+      const auto expected = fingerprint ? expected_fingerprint(node_header, partition, n_threads) : 0;
+      std::array<uint64_t, 2> sums{n_nodes, scan.fingerprint - expected};
+      std::array<uint64_t, 3> maxima{failures, scan.max_tag, ~scan.min_tag};
+      utils::chkerr(MPI_Allreduce(MPI_IN_PLACE, sums.data(), sums.size(), MPI_UINT64_T, MPI_SUM, comm),
+                    "MPI_Allreduce");
+      utils::chkerr(MPI_Allreduce(MPI_IN_PLACE, maxima.data(), maxima.size(), MPI_UINT64_T, MPI_MAX, comm),
+                    "MPI_Allreduce");
+
+      const auto [global_failures, global_max, global_min] = std::make_tuple(maxima[0], maxima[1], ~maxima[2]);
+      if (global_failures != 0)
+      {
+        throw std::runtime_error(failure_message(global_failures));
+      }
+      if (sums[0] != node_header.n_nodes)
+      {
+        throw std::runtime_error("The number of nodes read by all ranks does not match expectation");
+      }
+      if ((validation != Validation::TRUST) && (node_header.n_nodes > 0) &&
+          ((global_min != node_header.min_tag) || (global_max != node_header.max_tag)))
+      {
+        throw std::runtime_error("The node indices read by all ranks do not span the expected range");
+      }
+      if (fingerprint && (sums[1] != 0))
+      {
+        throw std::runtime_error("Duplicate node indices were found across ranks");
+      }
     }
+  }  // namespace
+
+  void validate_nodes(const std::vector<Node<3>>& nodes,
+                      const NodeHeader& node_header,
+                      const cfg::utils::Parallel& parallel,
+                      const Validation validation,
+                      MPI_Comm comm)
+  {
+    const auto tags = [&nodes](const size_t i) -> size_t
+    {
+      return nodes[i].natural_idx;
+    };
+    validate_tags(tags, nodes.size(), node_header, parallel, validation, comm);
   }
 
-  std::function<std::vector<Node<3>>(const cfg::reader::SectionReader&, std::ifstream&, const Mode)> make_node_reader(
-      const cfg::utils::Parallel& parallel)
+  void validate_nodes(const NodeSet<3>& nodes,
+                      const NodeHeader& node_header,
+                      const cfg::utils::Parallel& parallel,
+                      const Validation validation,
+                      MPI_Comm comm)
   {
-    class Validator
+    // The indices are stored contiguously so are scanned directly
+    const auto* const natural_idx = nodes.natural_idx.data();
+    const auto tags               = [natural_idx](const size_t i) -> size_t
     {
-     public:
-      Validator(const utils::Parallel& parallel) : parallel{parallel} {}
-      void validate(const std::vector<Node<3>>& nodes, const NodeHeader& node_header) const
-      {
-        validate_nodes(nodes, node_header, parallel);
-      }
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      return natural_idx[i];
+    };
+    validate_tags(tags, nodes.size(), node_header, parallel, validation, comm);
+  }
 
-     private:
-      const utils::Parallel& parallel;
+  template <class S>
+  std::function<std::vector<Node<3>>(const cfg::reader::SectionReader&, S&, const Mode)> make_node_reader(
+      const cfg::utils::Parallel& parallel, const Validation validation, MPI_Comm comm)
+  {
+    // Return the node reader function, the encoding is dispatched on once per call
+    return [&parallel, validation, comm](const cfg::reader::SectionReader& node_reader, S& mesh_stream, const Mode mode)
+    {
+      return with_encoding(mode,
+                           [&](auto encoding) -> std::vector<Node<3>>
+                           {
+                             return read_X<decltype(encoding)>(HeaderParser{},
+                                                               DataParser{},
+                                                               NodeEnvironment{parallel},
+                                                               NodeValidator{parallel, validation, comm})(
+                                 node_reader, mesh_stream);
+                           });
     };
+  }
 
-    // Return the node reader function
-    return read_X(HeaderParser{}, DataParser{}, NodeEnvironment{parallel}, Validator{parallel});
+  template <class S>
+  std::function<std::vector<Node<3>>(const cfg::reader::SectionReader&, S&, const Mode)> make_indexed_node_reader(
+      const cfg::utils::Parallel& parallel,
+      const NodeHeader& node_header,
+      const NodeLayout& layout,
+      const Validation validation,
+      MPI_Comm comm)
+  {
+    // Return the node reader function, the encoding is dispatched on once per call
+    return [&parallel, node_header, &layout, validation, comm](
+               const cfg::reader::SectionReader& node_reader, S& mesh_stream, const Mode mode)
+    {
+      return with_encoding(mode,
+                           [&](auto encoding) -> std::vector<Node<3>>
+                           {
+                             return read_X<decltype(encoding)>(KnownHeader<NodeHeader>{node_header},
+                                                               DataParser{},
+                                                               NodeEnvironment{parallel, ReadStrategy::LOCAL, &layout},
+                                                               NodeValidator{parallel, validation, comm})(
+                                 node_reader, mesh_stream);
+                           });
+    };
   }
+
+  template std::function<std::vector<Node<3>>(const cfg::reader::SectionReader&, std::istream&, const Mode)>
+  make_node_reader<std::istream>(const cfg::utils::Parallel& parallel, const Validation validation, MPI_Comm comm);
+  template std::function<std::vector<Node<3>>(const cfg::reader::SectionReader&, cfg::reader::MappedStream&, const Mode)>
+  make_node_reader<cfg::reader::MappedStream>(const cfg::utils::Parallel& parallel,
+                                              const Validation validation,
+                                              MPI_Comm comm);
+  template std::function<std::vector<Node<3>>(const cfg::reader::SectionReader&, std::istream&, const Mode)>
+  make_indexed_node_reader<std::istream>(const cfg::utils::Parallel& parallel,
+                                         const NodeHeader& node_header,
+                                         const NodeLayout& layout,
+                                         const Validation validation,
+                                         MPI_Comm comm);
+  template std::function<std::vector<Node<3>>(const cfg::reader::SectionReader&, cfg::reader::MappedStream&, const Mode)>
+  make_indexed_node_reader<cfg::reader::MappedStream>(const cfg::utils::Parallel& parallel,
+                                                      const NodeHeader& node_header,
+                                                      const NodeLayout& layout,
+                                                      const Validation validation,
+                                                      MPI_Comm comm);
 }  // namespace cfg::parser
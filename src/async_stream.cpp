@@ -0,0 +1,237 @@
+/**
+ * async_stream.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+
+#include <async_stream.h>
+
+namespace cfg::reader
+{
+  AsyncFileBuf::AsyncFileBuf(const std::filesystem::path& path, const size_t chunk_size, const size_t depth)
+      : chunk_size(std::max(chunk_size, size_t{1})), ring(std::max(depth, size_t{2}))
+  {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg,hicpp-vararg)
+    fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+      throw std::runtime_error{"Could not open " + path.string()};
+    }
+
+    struct stat status
+    {
+    };
+    if (fstat(fd, &status) != 0)
+    {
+      close(fd);
+      throw std::runtime_error{"Could not determine the size of " + path.string()};
+    }
+    file_size = static_cast<size_t>(status.st_size);
+
+    // Meshes are (mostly) read front-to-back, this is only a hint so failure is not an error
+    (void)posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    for (auto& slot : ring)
+    {
+      slot.data.resize(this->chunk_size);
+    }
+    reader = std::thread{&AsyncFileBuf::read_ahead, this};
+  }
+
+  AsyncFileBuf::~AsyncFileBuf()
+  {
+    {
+      const std::lock_guard<std::mutex> lock{mutex};
+      stop = true;
+    }
+    space_cv.notify_one();
+    reader.join();
+    close(fd);
+  }
+
+  void AsyncFileBuf::read_ahead()
+  {
+    std::unique_lock<std::mutex> lock{mutex};
+    while (true)
+    {
+      space_cv.wait(lock,
+                    [this]() -> bool
+                    {
+                      return stop || ((filled < ring.size()) && (read_offset < file_size) && error.empty());
+                    });
+      if (stop)
+      {
+        return;
+      }
+
+      // Claim the next chunk, the buffer at the tail is free and not visible to the consumer
+      const auto read_generation = generation;
+      const auto offset          = read_offset;
+      const auto size            = std::min(chunk_size, file_size - offset);
+      auto& slot                 = ring[tail];
+      read_offset                = offset + size;
+      in_flight                  = true;
+
+      // Read the chunk without holding the lock, so the consumer can parse the current chunk
+      lock.unlock();
+      size_t nread = 0;
+      std::string read_error;
+      while (nread < size)
+      {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        const auto count = pread(fd, slot.data.data() + nread, size - nread, static_cast<off_t>(offset + nread));
+        if ((count < 0) && (errno == EINTR))
+        {
+          continue;
+        }
+        if (count <= 0)
+        {
+          read_error = "Failed to read the file at offset " + std::to_string(offset + nread);
+          break;
+        }
+        nread += static_cast<size_t>(count);
+      }
+      lock.lock();
+
+      in_flight = false;
+      if (read_generation != generation)
+      {
+        data_cv.notify_one();
+        continue;  // The consumer seeked elsewhere while the chunk was read
+      }
+      if (!read_error.empty())
+      {
+        error = read_error;
+      }
+      else
+      {
+        slot.offset = offset;
+        slot.size   = size;
+        tail        = (tail + 1) % ring.size();
+        filled++;
+      }
+      data_cv.notify_one();
+    }
+  }
+
+  AsyncFileBuf::int_type AsyncFileBuf::underflow()
+  {
+    if (gptr() < egptr())
+    {
+      return traits_type::to_int_type(*gptr());
+    }
+
+    std::unique_lock<std::mutex> lock{mutex};
+    if (holding)
+    {
+      // Release the current chunk to the reader thread
+      head    = (head + 1) % ring.size();
+      holding = false;
+      filled--;
+      space_cv.notify_one();
+    }
+
+    data_cv.wait(lock,
+                 [this]() -> bool
+                 {
+                   return (filled > 0) || !error.empty() || (!in_flight && (read_offset >= file_size));
+                 });
+    if (filled == 0)
+    {
+      setg(nullptr, nullptr, nullptr);
+      chunk_offset = read_offset;
+      if (!error.empty())
+      {
+        // The stream catches this and sets its badbit
+        throw std::runtime_error{error};
+      }
+      return traits_type::eof();
+    }
+
+    auto& slot   = ring[head];
+    holding      = true;
+    chunk_offset = slot.offset;
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    setg(slot.data.data(), slot.data.data(), slot.data.data() + slot.size);
+
+    return traits_type::to_int_type(*gptr());
+  }
+
+  AsyncFileBuf::pos_type AsyncFileBuf::seekoff(const off_type off,
+                                               const std::ios::seekdir dir,
+                                               const std::ios::openmode which)
+  {
+    if ((which & std::ios::in) == 0)
+    {
+      return pos_type(off_type(-1));
+    }
+
+    const auto current = static_cast<off_type>(chunk_offset) + (gptr() - eback());
+    if (dir == std::ios::beg)
+    {
+      return seek_to(off);
+    }
+    if (dir == std::ios::end)
+    {
+      return seek_to(static_cast<off_type>(file_size) + off);
+    }
+    if (off == 0)
+    {
+      return current;  // Querying the position, e.g. by `tellg`
+    }
+    return seek_to(current + off);
+  }
+
+  AsyncFileBuf::pos_type AsyncFileBuf::seekpos(const pos_type pos, const std::ios::openmode which)
+  {
+    if ((which & std::ios::in) == 0)
+    {
+      return pos_type(off_type(-1));
+    }
+
+    return seek_to(off_type(pos));
+  }
+
+  AsyncFileBuf::pos_type AsyncFileBuf::seek_to(const off_type target)
+  {
+    if ((target < 0) || (target > static_cast<off_type>(file_size)))
+    {
+      return pos_type(off_type(-1));
+    }
+
+    // Within the current chunk only the get pointer moves
+    const auto pos = static_cast<size_t>(target);
+    if ((eback() != nullptr) && (pos >= chunk_offset) && (pos < chunk_offset + static_cast<size_t>(egptr() - eback())))
+    {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      setg(eback(), eback() + (pos - chunk_offset), egptr());
+      return target;
+    }
+
+    // Otherwise the chunks read ahead are discarded and the reader restarts at the target
+    {
+      const std::lock_guard<std::mutex> lock{mutex};
+      generation++;
+      read_offset = pos;
+      head        = 0;
+      tail        = 0;
+      filled      = 0;
+      holding     = false;
+      error.clear();
+    }
+    space_cv.notify_one();
+
+    setg(nullptr, nullptr, nullptr);
+    chunk_offset = pos;
+
+    return target;
+  }
+}  // namespace cfg::reader
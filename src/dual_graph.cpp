@@ -0,0 +1,350 @@
+/**
+ * dual_graph.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <dual_graph.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+#include <mpi_utils.h>
+
+namespace cfg::utils
+{
+  namespace
+  {
+    constexpr size_t max_face_nodes = 4;  // The number of nodes of the largest face, a quadrangle
+    constexpr size_t max_faces      = 6;  // The number of faces of the element with most faces, a hexahedron
+
+    /**
+     * The faces of an element type, each face lists the positions of its nodes in the element's
+     * connectivity, padded with -1 for faces with fewer nodes.
+     */
+    struct FaceTable
+    {
+      size_t n_faces;                                                 // The number of faces
+      std::array<std::array<int, max_face_nodes>, max_faces> faces;  // The nodes of each face
+    };
+
+    // The faces of the elements in the GMSH node ordering, the faces of a cell of dimension d are its
+    // entities of dimension d - 1. The order of the nodes of a face is irrelevant, as faces are
+    // matched by their sorted node tags.
+    // NOLINTBEGIN(readability-magic-numbers)
+    constexpr FaceTable point_faces{0, {}};
+    constexpr FaceTable line_faces{2, {{{0, -1, -1, -1}, {1, -1, -1, -1}}}};
+    constexpr FaceTable triangle_faces{3, {{{0, 1, -1, -1}, {1, 2, -1, -1}, {2, 0, -1, -1}}}};
+    constexpr FaceTable quadrangle_faces{4, {{{0, 1, -1, -1}, {1, 2, -1, -1}, {2, 3, -1, -1}, {3, 0, -1, -1}}}};
+    constexpr FaceTable tetrahedron_faces{4, {{{0, 2, 1, -1}, {0, 1, 3, -1}, {0, 3, 2, -1}, {1, 2, 3, -1}}}};
+    constexpr FaceTable hexahedron_faces{
+        6, {{{0, 3, 2, 1}, {0, 1, 5, 4}, {0, 4, 7, 3}, {1, 2, 6, 5}, {2, 3, 7, 6}, {4, 5, 6, 7}}}};
+    constexpr FaceTable prism_faces{5, {{{0, 2, 1, -1}, {3, 4, 5, -1}, {0, 1, 4, 3}, {0, 3, 5, 2}, {1, 2, 5, 4}}}};
+    constexpr FaceTable pyramid_faces{5, {{{0, 3, 2, 1}, {0, 1, 4, -1}, {0, 4, 3, -1}, {1, 2, 4, -1}, {2, 3, 4, -1}}}};
+    // NOLINTEND(readability-magic-numbers)
+
+    /**
+     * Looks up the faces of a GMSH element type, raising an error if the type is unsupported.
+     */
+    [[nodiscard]] const FaceTable& face_table(const int type)
+    {
+      // NOLINTBEGIN(readability-magic-numbers)
+      switch (type)
+      {
+      case 1:
+        return line_faces;
+      case 2:
+        return triangle_faces;
+      case 3:
+        return quadrangle_faces;
+      case 4:
+        return tetrahedron_faces;
+      case 5:
+        return hexahedron_faces;
+      case 6:
+        return prism_faces;
+      case 7:
+        return pyramid_faces;
+      case 15:
+        return point_faces;
+      default:
+        throw std::runtime_error("Unsupported GMSH element type " + std::to_string(type));
+      }
+      // NOLINTEND(readability-magic-numbers)
+    }
+
+    /**
+     * A face of a cell.
+     */
+    struct Face
+    {
+      std::array<size_t, max_face_nodes> nodes;  // The sorted tags of the face's nodes, padded with zeros
+      uint64_t hash;                             // The hash of the face's nodes
+      size_t vertex;                             // The global index of the cell the face belongs to
+    };
+
+    /**
+     * An adjacency between a cell held by the receiving rank and a cell of another rank.
+     */
+    struct Adjacency
+    {
+      size_t vertex;     // The global index of the cell held by the receiving rank
+      size_t neighbour;  // The global index of the adjacent cell
+    };
+
+    /**
+     * Mixes the bits of a value, the finaliser of the splitmix64 generator.
+     */
+    [[nodiscard]] inline uint64_t mix(uint64_t x)
+    {
+      // NOLINTBEGIN(readability-magic-numbers)
+      x = (x ^ (x >> 30U)) * 0xbf58476d1ce4e5b9U;
+      x = (x ^ (x >> 27U)) * 0x94d049bb133111ebU;
+      return x ^ (x >> 31U);
+      // NOLINTEND(readability-magic-numbers)
+    }
+
+    /**
+     * Orders faces by their hash, then their nodes, so that equal faces are adjacent.
+     */
+    [[nodiscard]] inline bool face_less(const Face& a, const Face& b)
+    {
+      return (a.hash < b.hash) || ((a.hash == b.hash) && (a.nodes < b.nodes));
+    }
+
+    /**
+     * Lists the faces of the cells held by this rank.
+     *
+     * GMSH node tags are positive, so faces with fewer nodes are padded with zeros, which sort first.
+     *
+     * @param elements The elements held by this rank.
+     * @param cells    The index in the element set of each cell.
+     * @param first    The global index of the first cell.
+     * @returns The faces of the cells.
+     */
+    [[nodiscard]] std::vector<Face> cell_faces(const cfg::parser::ElementSet& elements,
+                                               const std::vector<size_t>& cells,
+                                               const size_t first)
+    {
+      std::vector<Face> faces;
+      faces.reserve(cells.size() * max_faces);
+      for (size_t v = 0; v < cells.size(); v++)
+      {
+        const auto cell         = cells[v];
+        const auto& table       = face_table(elements.type[cell]);
+        const auto* const nodes = &elements.nodes[elements.offsets[cell]];
+        for (size_t f = 0; f < table.n_faces; f++)
+        {
+          Face face{{}, 0, first + v};
+          for (size_t j = 0; j < max_face_nodes; j++)
+          {
+            const auto position = table.faces[f][j];
+            // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+            face.nodes[j] = (position < 0) ? 0 : nodes[position];
+          }
+          std::sort(face.nodes.begin(), face.nodes.end());
+
+          face.hash = mix(face.nodes[0]);
+          for (size_t j = 1; j < max_face_nodes; j++)
+          {
+            face.hash = mix(face.hash ^ face.nodes[j]);
+          }
+          faces.push_back(face);
+        }
+      }
+
+      return faces;
+    }
+
+    /**
+     * Matches sorted faces, calling `on_pair` for each face shared by two cells and `on_single` for
+     * each face of a single cell.
+     *
+     * @param faces     The faces, ordered by `face_less`.
+     * @param on_pair   Called with the two faces of each shared face.
+     * @param on_single Called with each face that is not shared.
+     * @returns Whether a face is shared by more than two cells.
+     */
+    template <class P, class S>
+    [[nodiscard]] bool match_faces(const std::vector<Face>& faces, const P& on_pair, const S& on_single)
+    {
+      bool non_manifold = false;
+      for (size_t i = 0; i < faces.size();)
+      {
+        auto j = i + 1;
+        while ((j < faces.size()) && (faces[j].hash == faces[i].hash) && (faces[j].nodes == faces[i].nodes))
+        {
+          j++;
+        }
+
+        if (j - i == 1)
+        {
+          on_single(faces[i]);
+        }
+        else if (j - i == 2)
+        {
+          on_pair(faces[i], faces[i + 1]);
+        }
+        else
+        {
+          non_manifold = true;
+        }
+        i = j;
+      }
+
+      return non_manifold;
+    }
+  }  // namespace
+
+  DualGraph build_dual_graph(const cfg::parser::ElementSet& elements, MPI_Comm comm, const bool check_manifold)
+  {
+    const auto parallel = make_parallel(comm);
+    const auto n_ranks  = static_cast<size_t>(parallel.size);
+
+    DualGraph graph;
+
+    // The cells are the elements of the highest dimension held by any rank
+    int local_dim = 0;
+    for (const auto type : elements.type)
+    {
+      local_dim = std::max(local_dim, cfg::parser::element_type(type).dim);
+    }
+    chkerr(MPI_Allreduce(&local_dim, &graph.dim, 1, MPI_INT, MPI_MAX, comm), "MPI_Allreduce");
+    for (size_t i = 0; i < elements.size(); i++)
+    {
+      if (cfg::parser::element_type(elements.type[i]).dim == graph.dim)
+      {
+        graph.cells.push_back(i);
+      }
+    }
+
+    // The global vertices are numbered in rank order
+    const uint64_t n_local = graph.cells.size();
+    std::vector<uint64_t> counts(n_ranks);
+    chkerr(MPI_Allgather(&n_local, 1, MPI_UINT64_T, counts.data(), 1, MPI_UINT64_T, comm), "MPI_Allgather");
+    graph.vtxdist.assign(n_ranks + 1, 0);
+    for (size_t rank = 0; rank < n_ranks; rank++)
+    {
+      graph.vtxdist[rank + 1] = graph.vtxdist[rank] + counts[rank];
+    }
+    const auto first   = graph.vtxdist[parallel.rank];
+    const auto rank_of = [&graph](const size_t vertex) -> size_t
+    {
+      const auto next = std::upper_bound(graph.vtxdist.begin(), graph.vtxdist.end(), vertex);
+      return static_cast<size_t>(next - graph.vtxdist.begin()) - 1;
+    };
+
+    // Each adjacency of a local vertex, as the local index of the vertex and the global index of
+    // its neighbour
+    std::vector<std::pair<size_t, size_t>> edges;
+
+    // Match the faces within this rank, the unmatched faces are sent to the rank given by their hash.
+    // When checked, only the hashes of the matched faces are sent to these ranks
+    auto faces = cell_faces(elements, graph.cells, first);
+    std::sort(faces.begin(), faces.end(), face_less);
+    std::vector<Face> unmatched;
+    std::vector<uint64_t> matched;
+    bool non_manifold = match_faces(
+        faces,
+        [&edges, &matched, check_manifold, first](const Face& a, const Face& b)
+        {
+          edges.emplace_back(a.vertex - first, b.vertex);
+          edges.emplace_back(b.vertex - first, a.vertex);
+          if (check_manifold)
+          {
+            matched.push_back(a.hash);
+          }
+        },
+        [&unmatched](const Face& face)
+        {
+          unmatched.push_back(face);
+        });
+    faces = std::vector<Face>{};
+
+    const auto owner = [n_ranks](const Face& face) -> size_t
+    {
+      return static_cast<size_t>(face.hash % n_ranks);
+    };
+    auto received = send_to_ranks(unmatched, owner, comm);
+    unmatched = std::vector<Face>{};
+
+    // Match the faces received, the faces left unmatched lie on the boundary of the mesh
+    std::sort(received.begin(), received.end(), face_less);
+    std::vector<Adjacency> adjacencies;
+    non_manifold |= match_faces(
+        received,
+        [&adjacencies](const Face& a, const Face& b)
+        {
+          adjacencies.push_back(Adjacency{a.vertex, b.vertex});
+          adjacencies.push_back(Adjacency{b.vertex, a.vertex});
+        },
+        [](const Face& /* face */) {});
+
+    // A face matched within a rank has a third cell if another rank holds the face
+    if (check_manifold)
+    {
+      auto hashes = send_to_ranks(
+          matched,
+          [n_ranks](const uint64_t hash) -> size_t
+          {
+            return static_cast<size_t>(hash % n_ranks);
+          },
+          comm);
+      matched = std::vector<uint64_t>{};
+      std::sort(hashes.begin(), hashes.end());
+      non_manifold |= (std::adjacent_find(hashes.begin(), hashes.end()) != hashes.end());
+      for (const auto& face : received)
+      {
+        non_manifold |= std::binary_search(hashes.begin(), hashes.end(), face.hash);
+      }
+    }
+    received = std::vector<Face>{};
+
+    int invalid = non_manifold ? 1 : 0;
+    chkerr(MPI_Allreduce(MPI_IN_PLACE, &invalid, 1, MPI_INT, MPI_MAX, comm), "MPI_Allreduce");
+    if (invalid != 0)
+    {
+      throw std::runtime_error("A face of the mesh is shared by more than two cells");
+    }
+
+    // Return the adjacencies across ranks to the ranks holding their vertices
+    const auto holder = [&rank_of](const Adjacency& adjacency) -> size_t
+    {
+      return rank_of(adjacency.vertex);
+    };
+    const auto remote = send_to_ranks(adjacencies, holder, comm);
+    for (const auto& adjacency : remote)
+    {
+      edges.emplace_back(adjacency.vertex - first, adjacency.neighbour);
+    }
+
+    // Assemble the adjacency lists in CSR form
+    graph.offsets.assign(graph.cells.size() + 1, 0);
+    for (const auto& edge : edges)
+    {
+      graph.offsets[edge.first + 1]++;
+    }
+    for (size_t v = 0; v < graph.cells.size(); v++)
+    {
+      graph.offsets[v + 1] += graph.offsets[v];
+    }
+    graph.adjacency.resize(edges.size());
+    {
+      auto next = graph.offsets;
+      for (const auto& edge : edges)
+      {
+        graph.adjacency[next[edge.first]++] = edge.second;
+      }
+    }
+    for (size_t v = 0; v < graph.cells.size(); v++)
+    {
+      std::sort(graph.adjacency.begin() + static_cast<std::ptrdiff_t>(graph.offsets[v]),
+                graph.adjacency.begin() + static_cast<std::ptrdiff_t>(graph.offsets[v + 1]));
+    }
+
+    return graph;
+  }
+}  // namespace cfg::utils
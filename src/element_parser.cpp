@@ -0,0 +1,198 @@
+/**
+ * element_parser.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <_element_parser.h>
+
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+#include <mesh_index.h>
+
+namespace cfg::parser
+{
+  ElementType element_type(const int type)
+  {
+    switch (type)
+    {
+    case 1:
+      return {1, 2};  // Line
+    case 2:
+      return {2, 3};  // Triangle
+    case 3:
+      return {2, 4};  // Quadrangle
+    case 4:
+      return {3, 4};  // Tetrahedron
+    case 5:
+      return {3, 8};  // Hexahedron
+    case 6:
+      return {3, 6};  // Prism
+    case 7:
+      return {3, 5};  // Pyramid
+    case 15:
+      return {0, 1};  // Point
+    default:
+      throw std::runtime_error("Unsupported GMSH element type " + std::to_string(type));
+    }
+  }
+
+  namespace
+  {
+    /**
+     * Reads the elements from a mesh stream, implements `read_elements` for each encoding and stream
+     * type.
+     *
+     * @tparam E          The encoding of the mesh file.
+     * @param mesh_stream The data stream associated with the mesh file.
+     * @param parallel    The parallel environment.
+     * @param index       The index of the mesh file, either a `SectionIndex` or a `MeshIndex`.
+     * @returns The elements held by this rank.
+     */
+    template <class E, class S, class I>
+    [[nodiscard]] ElementSet read_elements_from(S& mesh_stream,
+                                                const cfg::utils::Parallel& parallel,
+                                                const I& index)
+    {
+      std::cout << "+ Reading elements" << std::endl;
+
+      // Read the elements, a mesh index records the element blocks so only this rank's blocks are visited
+      const auto [element_reader, elements] = [&mesh_stream, &parallel, &index]()
+      {
+        if constexpr (std::is_same_v<I, cfg::reader::MeshIndex>)
+        {
+          cfg::reader::SectionReader section_reader("Elements", mesh_stream, index.sections);
+          auto data = read_X<E>(KnownHeader<ElementHeader>{index.element_header},
+                                ElementDataParser{},
+                                ElementEnvironment{parallel, &index.elements},
+                                ElementValidator{parallel})(section_reader, mesh_stream);
+          return std::make_pair(std::move(section_reader), std::move(data));
+        }
+        else
+        {
+          cfg::reader::SectionReader section_reader("Elements", mesh_stream, index);
+          auto data = read_X<E>(ElementHeaderParser{},
+                                ElementDataParser{},
+                                ElementEnvironment{parallel},
+                                ElementValidator{parallel})(section_reader, mesh_stream);
+          return std::make_pair(std::move(section_reader), std::move(data));
+        }
+      }();
+
+      // Check that we read the Elements section correctly -> we should read "$EndElements"
+      std::string line;
+      element_reader(mesh_stream) >> line;
+      if (line != "$EndElements")
+      {
+        throw std::runtime_error("The Elements section was read incorrectly");
+      }
+
+      cfg::utils::count(cfg::utils::Counter::ELEMENTS, elements.size());
+
+      // Report how many elements we read
+      std::cout << "++ Rank " << parallel.rank << " read " << elements.size() << " elements" << std::endl;
+
+      return elements;
+    }
+  }  // namespace
+
+  template <class E, class I>
+  ElementSet read_elements(std::istream& mesh_stream, const cfg::utils::Parallel& parallel, const I& index)
+  {
+    return read_elements_from<E>(mesh_stream, parallel, index);
+  }
+
+  template <class E, class I>
+  ElementSet read_elements(cfg::reader::MappedStream& mesh_stream, const cfg::utils::Parallel& parallel, const I& index)
+  {
+    return read_elements_from<E>(mesh_stream, parallel, index);
+  }
+
+  template ElementSet read_elements<AsciiEncoding>(std::istream&,
+                                                   const cfg::utils::Parallel&,
+                                                   const cfg::reader::SectionIndex&);
+  template ElementSet read_elements<AsciiEncoding>(std::istream&,
+                                                   const cfg::utils::Parallel&,
+                                                   const cfg::reader::MeshIndex&);
+  template ElementSet read_elements<AsciiEncoding>(cfg::reader::MappedStream&,
+                                                   const cfg::utils::Parallel&,
+                                                   const cfg::reader::SectionIndex&);
+  template ElementSet read_elements<AsciiEncoding>(cfg::reader::MappedStream&,
+                                                   const cfg::utils::Parallel&,
+                                                   const cfg::reader::MeshIndex&);
+  template ElementSet read_elements<BinaryEncoding>(std::istream&,
+                                                    const cfg::utils::Parallel&,
+                                                    const cfg::reader::SectionIndex&);
+  template ElementSet read_elements<BinaryEncoding>(std::istream&,
+                                                    const cfg::utils::Parallel&,
+                                                    const cfg::reader::MeshIndex&);
+  template ElementSet read_elements<BinaryEncoding>(cfg::reader::MappedStream&,
+                                                    const cfg::utils::Parallel&,
+                                                    const cfg::reader::SectionIndex&);
+  template ElementSet read_elements<BinaryEncoding>(cfg::reader::MappedStream&,
+                                                    const cfg::utils::Parallel&,
+                                                    const cfg::reader::MeshIndex&);
+  template ElementSet read_elements<BinaryEncoding32>(std::istream&,
+                                                      const cfg::utils::Parallel&,
+                                                      const cfg::reader::SectionIndex&);
+  template ElementSet read_elements<BinaryEncoding32>(std::istream&,
+                                                      const cfg::utils::Parallel&,
+                                                      const cfg::reader::MeshIndex&);
+  template ElementSet read_elements<BinaryEncoding32>(cfg::reader::MappedStream&,
+                                                      const cfg::utils::Parallel&,
+                                                      const cfg::reader::SectionIndex&);
+  template ElementSet read_elements<BinaryEncoding32>(cfg::reader::MappedStream&,
+                                                      const cfg::utils::Parallel&,
+                                                      const cfg::reader::MeshIndex&);
+
+  ElementSet read_elements(std::istream& mesh_stream,
+                           const Mode mode,
+                           const cfg::utils::Parallel& parallel,
+                           const cfg::reader::SectionIndex& index)
+  {
+    return with_encoding(mode,
+                         [&](auto encoding) -> ElementSet
+                         {
+                           return read_elements<decltype(encoding)>(mesh_stream, parallel, index);
+                         });
+  }
+
+  ElementSet read_elements(std::istream& mesh_stream,
+                           const Mode mode,
+                           const cfg::utils::Parallel& parallel,
+                           const cfg::reader::MeshIndex& index)
+  {
+    return with_encoding(mode,
+                         [&](auto encoding) -> ElementSet
+                         {
+                           return read_elements<decltype(encoding)>(mesh_stream, parallel, index);
+                         });
+  }
+
+  ElementSet read_elements(cfg::reader::MappedStream& mesh_stream,
+                           const Mode mode,
+                           const cfg::utils::Parallel& parallel,
+                           const cfg::reader::SectionIndex& index)
+  {
+    return with_encoding(mode,
+                         [&](auto encoding) -> ElementSet
+                         {
+                           return read_elements<decltype(encoding)>(mesh_stream, parallel, index);
+                         });
+  }
+
+  ElementSet read_elements(cfg::reader::MappedStream& mesh_stream,
+                           const Mode mode,
+                           const cfg::utils::Parallel& parallel,
+                           const cfg::reader::MeshIndex& index)
+  {
+    return with_encoding(mode,
+                         [&](auto encoding) -> ElementSet
+                         {
+                           return read_elements<decltype(encoding)>(mesh_stream, parallel, index);
+                         });
+  }
+}  // namespace cfg::parser
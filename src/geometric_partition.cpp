@@ -0,0 +1,347 @@
+/**
+ * geometric_partition.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <geometric_partition.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+#include <mpi_utils.h>
+
+namespace cfg::utils
+{
+  namespace
+  {
+    /**
+     * Maps a coordinate to an unsigned integer key with the same ordering, so that the coordinates
+     * can be bisected over their bit patterns.
+     *
+     * @param x The coordinate.
+     * @returns The key.
+     */
+    // Simple conversion of a coordinate, short names are clear.
+    // NOLINTNEXTLINE(readability-identifier-length)
+    [[nodiscard]] uint64_t order_key(const double x)
+    {
+      constexpr uint64_t sign = uint64_t{1} << 63U;
+
+      uint64_t bits = 0;
+      std::memcpy(&bits, &x, sizeof(bits));
+      return ((bits & sign) != 0) ? ~bits : (bits | sign);
+    }
+
+    /**
+     * Computes the number of nodes and the bounding box of the nodes in each group, over all ranks.
+     *
+     * @param nodes  The nodes held by this rank.
+     * @param groups The group of each node, identified by an index in `[0, n_groups)`.
+     * @param active Flags which groups are considered, nodes of inactive groups are ignored.
+     * @param comm   The communicator the nodes are partitioned over.
+     * @param counts The number of nodes in each group.
+     * @param boxes  The bounding box of each group.
+     */
+    template <class G>
+    void reduce_groups(const cfg::parser::NodeSet<3>& nodes,
+                       const std::vector<G>& groups,
+                       const std::vector<bool>& active,
+                       MPI_Comm comm,
+                       std::vector<uint64_t>& counts,
+                       std::vector<BoundingBox<3>>& boxes)
+    {
+      const auto n_groups = active.size();
+      counts.assign(n_groups, 0);
+      std::vector<double> lower(3 * n_groups, std::numeric_limits<double>::max());
+      std::vector<double> upper(3 * n_groups, std::numeric_limits<double>::lowest());
+      for (size_t i = 0; i < nodes.size(); i++)
+      {
+        const auto group = static_cast<size_t>(groups[i]);
+        if (!active[group])
+        {
+          continue;
+        }
+
+        counts[group]++;
+        for (size_t axis = 0; axis < 3; axis++)
+        {
+          lower[3 * group + axis] = std::min(lower[3 * group + axis], nodes.x[axis][i]);
+          upper[3 * group + axis] = std::max(upper[3 * group + axis], nodes.x[axis][i]);
+        }
+      }
+
+      chkerr(MPI_Allreduce(
+                 MPI_IN_PLACE, counts.data(), static_cast<int>(n_groups), mpi_type<uint64_t>(), MPI_SUM, comm),
+             "MPI_Allreduce");
+      chkerr(MPI_Allreduce(MPI_IN_PLACE, lower.data(), static_cast<int>(3 * n_groups), MPI_DOUBLE, MPI_MIN, comm),
+             "MPI_Allreduce");
+      chkerr(MPI_Allreduce(MPI_IN_PLACE, upper.data(), static_cast<int>(3 * n_groups), MPI_DOUBLE, MPI_MAX, comm),
+             "MPI_Allreduce");
+
+      boxes.resize(n_groups);
+      for (size_t group = 0; group < n_groups; group++)
+      {
+        for (size_t axis = 0; axis < 3; axis++)
+        {
+          boxes[group].min[axis] = lower[3 * group + axis];
+          boxes[group].max[axis] = upper[3 * group + axis];
+        }
+      }
+    }
+  }  // namespace
+
+  bool GeometricPartition::pick(const size_t idx) const
+  {
+    return std::binary_search(owned.begin(), owned.end(), idx);
+  }
+
+  void GeometricPartition::report(std::ostream& os) const
+  {
+    os << "++ Partition imbalance: " << load_imbalance << "\n";
+    for (size_t rank = 0; rank < boxes.size(); rank++)
+    {
+      const auto& box = boxes[rank];
+      os << "++ Rank " << rank << " bounding box: [" << box.min[0] << ", " << box.min[1] << ", " << box.min[2]
+         << "] - [" << box.max[0] << ", " << box.max[1] << ", " << box.max[2] << "]\n";
+    }
+  }
+
+  void GeometricPartition::finalise(const cfg::parser::NodeSet<3>& nodes, MPI_Comm comm)
+  {
+    const auto n_ranks = static_cast<size_t>(make_parallel(comm).size);
+
+    // Compute the size and bounding box of each rank's partition
+    std::vector<uint64_t> counts;
+    reduce_groups(nodes, node_destinations, std::vector<bool>(n_ranks, true), comm, counts, boxes);
+
+    uint64_t n_total = 0;
+    uint64_t n_max   = 0;
+    for (const auto count : counts)
+    {
+      n_total += count;
+      n_max = std::max(n_max, count);
+    }
+    load_imbalance = (n_total == 0) ? 1.0 : static_cast<double>(n_max * n_ranks) / static_cast<double>(n_total);
+
+    // Send the global indices of the nodes to their destination ranks
+    std::vector<int> send_counts(n_ranks, 0);
+    for (const auto dst : node_destinations)
+    {
+      send_counts[static_cast<size_t>(dst)]++;
+    }
+    std::vector<int> send_displs(n_ranks, 0);
+    for (size_t rank = 1; rank < n_ranks; rank++)
+    {
+      send_displs[rank] = send_displs[rank - 1] + send_counts[rank - 1];
+    }
+    std::vector<size_t> send_idx(nodes.size());
+    {
+      auto next = send_displs;
+      for (size_t i = 0; i < nodes.size(); i++)
+      {
+        send_idx[static_cast<size_t>(next[static_cast<size_t>(node_destinations[i])]++)] = nodes.global_idx[i];
+      }
+    }
+
+    std::vector<int> recv_counts(n_ranks, 0);
+    chkerr(MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1, MPI_INT, comm), "MPI_Alltoall");
+    std::vector<int> recv_displs(n_ranks, 0);
+    size_t n_recv = 0;
+    for (size_t rank = 0; rank < n_ranks; rank++)
+    {
+      if (n_recv > INT_MAX)
+      {
+        throw std::runtime_error("Too many nodes in partition to exchange");
+      }
+      recv_displs[rank] = static_cast<int>(n_recv);
+      n_recv += static_cast<size_t>(recv_counts[rank]);
+    }
+
+    owned.resize(n_recv);
+    chkerr(MPI_Alltoallv(send_idx.data(),
+                         send_counts.data(),
+                         send_displs.data(),
+                         mpi_type<size_t>(),
+                         owned.data(),
+                         recv_counts.data(),
+                         recv_displs.data(),
+                         mpi_type<size_t>(),
+                         comm),
+           "MPI_Alltoallv");
+    std::sort(owned.begin(), owned.end());
+  }
+
+  RCBPartition::RCBPartition(const cfg::parser::NodeSet<3>& nodes, MPI_Comm comm)
+  {
+    const auto n_ranks = static_cast<size_t>(make_parallel(comm).size);
+    const auto n_nodes = nodes.size();
+
+    // The ranks are split into groups, identified by their first rank, and each node is assigned to a
+    // group. The groups are bisected until each group is a single rank.
+    std::vector<size_t> group_size(n_ranks, 0);  // Size of the group starting at each rank
+    group_size[0] = n_ranks;
+    std::vector<size_t> node_group(n_nodes, 0);
+
+    std::vector<uint64_t> keys(n_nodes);
+    while (std::any_of(group_size.begin(),
+                       group_size.end(),
+                       [](const size_t size) -> bool
+                       {
+                         return size > 1;
+                       }))
+    {
+      std::vector<bool> active(n_ranks);
+      std::transform(group_size.begin(),
+                     group_size.end(),
+                     active.begin(),
+                     [](const size_t size) -> bool
+                     {
+                       return size > 1;
+                     });
+
+      std::vector<uint64_t> counts;
+      std::vector<BoundingBox<3>> boxes;
+      reduce_groups(nodes, node_group, active, comm, counts, boxes);
+
+      // Each group is bisected along the longest axis of its bounding box, the target is the number
+      // of nodes that should be assigned to the first half of the group's ranks.
+      std::vector<size_t> axis(n_ranks, 0);
+      std::vector<uint64_t> target(n_ranks, 0);
+      std::vector<uint64_t> key_lo(n_ranks, 0);  // Invariant: no more than target nodes below key_lo
+      std::vector<uint64_t> key_hi(n_ranks, 0);  // Invariant: more than target nodes below key_hi
+      std::vector<uint64_t> below_lo(n_ranks, 0);
+      for (size_t group = 0; group < n_ranks; group++)
+      {
+        if (!active[group] || (counts[group] == 0))
+        {
+          continue;
+        }
+
+        const auto& box = boxes[group];
+        for (size_t ax = 1; ax < 3; ax++)
+        {
+          if ((box.max[ax] - box.min[ax]) > (box.max[axis[group]] - box.min[axis[group]]))
+          {
+            axis[group] = ax;
+          }
+        }
+
+        target[group] = counts[group] * (group_size[group] / 2) / group_size[group];
+        key_lo[group] = order_key(box.min[axis[group]]);
+        key_hi[group] = order_key(box.max[axis[group]]) + 1;
+      }
+
+      for (size_t i = 0; i < n_nodes; i++)
+      {
+        const auto group = node_group[i];
+        keys[i]          = active[group] ? order_key(nodes.x[axis[group]][i]) : 0;
+      }
+
+      // Distributed median search, all groups are searched simultaneously
+      std::vector<uint64_t> mid(n_ranks, 0);
+      std::vector<uint64_t> below(n_ranks, 0);
+      while (true)
+      {
+        bool searching = false;
+        for (size_t group = 0; group < n_ranks; group++)
+        {
+          mid[group] = key_lo[group] + (key_hi[group] - key_lo[group]) / 2;
+          searching  = searching || (mid[group] != key_lo[group]);
+        }
+        if (!searching)
+        {
+          break;
+        }
+
+        std::fill(below.begin(), below.end(), 0);
+        for (size_t i = 0; i < n_nodes; i++)
+        {
+          const auto group = node_group[i];
+          if (active[group] && (keys[i] < mid[group]))
+          {
+            below[group]++;
+          }
+        }
+        chkerr(MPI_Allreduce(
+                   MPI_IN_PLACE, below.data(), static_cast<int>(n_ranks), mpi_type<uint64_t>(), MPI_SUM, comm),
+               "MPI_Allreduce");
+
+        for (size_t group = 0; group < n_ranks; group++)
+        {
+          if (mid[group] == key_lo[group])
+          {
+            continue;
+          }
+          if (below[group] <= target[group])
+          {
+            key_lo[group]   = mid[group];
+            below_lo[group] = below[group];
+          }
+          else
+          {
+            key_hi[group] = mid[group];
+          }
+        }
+      }
+
+      // Nodes below the median go to the first half of the group, the remaining target is made up from
+      // the nodes equal to the median in rank order.
+      std::vector<uint64_t> ties(n_ranks, 0);
+      for (size_t i = 0; i < n_nodes; i++)
+      {
+        const auto group = node_group[i];
+        if (active[group] && (keys[i] == key_lo[group]))
+        {
+          ties[group]++;
+        }
+      }
+      std::vector<uint64_t> ties_before(n_ranks, 0);
+      chkerr(MPI_Exscan(
+                 ties.data(), ties_before.data(), static_cast<int>(n_ranks), mpi_type<uint64_t>(), MPI_SUM, comm),
+             "MPI_Exscan");
+      if (make_parallel(comm).rank == 0)
+      {
+        std::fill(ties_before.begin(), ties_before.end(), 0);  // Undefined on the first rank
+      }
+
+      for (size_t i = 0; i < n_nodes; i++)
+      {
+        const auto group = node_group[i];
+        if (!active[group])
+        {
+          continue;
+        }
+
+        bool first_half = keys[i] < key_lo[group];
+        if (keys[i] == key_lo[group])
+        {
+          first_half = (ties_before[group] + below_lo[group]) < target[group];
+          ties_before[group]++;
+        }
+        if (!first_half)
+        {
+          node_group[i] = group + group_size[group] / 2;
+        }
+      }
+
+      // Split the groups
+      for (size_t group = 0; group < n_ranks; group++)
+      {
+        if (active[group])
+        {
+          const auto half          = group_size[group] / 2;
+          group_size[group + half] = group_size[group] - half;
+          group_size[group]        = half;
+        }
+      }
+    }
+
+    node_destinations.assign(node_group.begin(), node_group.end());
+    finalise(nodes, comm);
+  }
+}  // namespace cfg::utils
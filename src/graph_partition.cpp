@@ -0,0 +1,984 @@
+/**
+ * graph_partition.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <graph_partition.h>
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+
+#include <mpi_utils.h>
+#include <thread_utils.h>
+
+namespace cfg::utils
+{
+  namespace
+  {
+    constexpr size_t coarsest_per_part  = 100;   // Coarsening stops at this many vertices per part
+    constexpr double min_reduction      = 0.95;  // Coarsening stops once a level removes fewer vertices
+    constexpr double max_vertex_share   = 1.5;   // The heaviest coarse vertex, relative to the coarsest mean
+    constexpr size_t n_initial_trials   = 4;     // The number of initial bisections of the coarsest graph
+    constexpr size_t n_bisection_trials = 3;     // The number of multilevel bisections computed per split
+    constexpr size_t n_refine_passes    = 8;     // The maximum number of refinement passes per level
+    constexpr size_t stall_limit        = 200;   // Uphill moves tried before a refinement pass stops
+    constexpr uint64_t seed             = 42;    // The seed of the matching orders and initial seeds
+
+    constexpr size_t unmatched = std::numeric_limits<size_t>::max();
+
+    /**
+     * A level of the coarsening: the coarse graph and the coarse vertex of each vertex of the finer
+     * graph.
+     */
+    struct Level
+    {
+      WeightedGraph graph;      // The coarse graph
+      std::vector<size_t> map;  // The coarse vertex of each finer vertex
+    };
+
+    /**
+     * The total weight of the vertices of a graph.
+     */
+    [[nodiscard]] uint64_t total_weight(const WeightedGraph& graph)
+    {
+      return std::accumulate(graph.vertex_weights.begin(), graph.vertex_weights.end(), uint64_t{0});
+    }
+
+    /**
+     * Matches each vertex to the unmatched neighbour with the best rating, visiting the vertices in
+     * random order. An edge of weight `w` to a neighbour of weight `c` is rated `w * w / c`, which
+     * favours heavy edges to light neighbours and so keeps the coarse vertices compact. Vertices left
+     * unmatched are matched with themselves.
+     *
+     * @param graph      The graph.
+     * @param max_weight The largest weight of a matched pair.
+     * @param gen        The random generator ordering the vertices.
+     * @returns The vertex matched with each vertex.
+     */
+    [[nodiscard]] std::vector<size_t> heavy_edge_matching(const WeightedGraph& graph,
+                                                          const uint64_t max_weight,
+                                                          std::mt19937_64& gen)
+    {
+      std::vector<size_t> order(graph.size());
+      std::iota(order.begin(), order.end(), 0);
+      std::shuffle(order.begin(), order.end(), gen);
+
+      std::vector<size_t> mate(graph.size(), unmatched);
+      for (const auto v : order)
+      {
+        if (mate[v] != unmatched)
+        {
+          continue;
+        }
+
+        auto best          = v;
+        double best_rating = 0.0;
+        for (auto e = graph.offsets[v]; e < graph.offsets[v + 1]; e++)
+        {
+          const auto u = graph.adjacency[e];
+          if ((mate[u] == unmatched) && (u != v) && (graph.vertex_weights[v] + graph.vertex_weights[u] <= max_weight))
+          {
+            const auto weight = static_cast<double>(graph.edge_weights[e]);
+            const auto rating = weight * weight / static_cast<double>(graph.vertex_weights[u]);
+            if (rating > best_rating)
+            {
+              best        = u;
+              best_rating = rating;
+            }
+          }
+        }
+        mate[v]    = best;
+        mate[best] = v;
+      }
+
+      return mate;
+    }
+
+    /**
+     * Contracts the matched vertices of a graph, the edges between merged vertices are summed.
+     *
+     * @param graph     The graph.
+     * @param mate      The vertex matched with each vertex.
+     * @param n_threads The number of threads.
+     * @returns The coarse graph and the coarse vertex of each vertex.
+     */
+    [[nodiscard]] Level contract(const WeightedGraph& graph,
+                                 const std::vector<size_t>& mate,
+                                 const unsigned int n_threads)
+    {
+      // The coarse vertices are numbered in the order of their first vertex
+      Level level;
+      level.map.resize(graph.size());
+      std::vector<size_t> first;
+      for (size_t v = 0; v < graph.size(); v++)
+      {
+        if (v <= mate[v])
+        {
+          level.map[v]       = first.size();
+          level.map[mate[v]] = first.size();
+          first.push_back(v);
+        }
+      }
+      const auto n_coarse = first.size();
+
+      // Each thread assembles the rows of a range of coarse vertices
+      std::vector<std::vector<size_t>> adjacency(n_threads);
+      std::vector<std::vector<uint64_t>> weights(n_threads);
+      std::vector<size_t> degrees(n_coarse);
+      auto& coarse = level.graph;
+      coarse.vertex_weights.resize(n_coarse);
+      parallel_for(n_threads,
+                   n_coarse,
+                   [&](const unsigned int thread, const size_t first_vertex, const size_t last_vertex)
+                   {
+                     auto& row_adjacency = adjacency[thread];
+                     auto& row_weights   = weights[thread];
+                     std::vector<size_t> slot(n_coarse, unmatched);  // The position of a neighbour in the row
+                     for (auto c = first_vertex; c < last_vertex; c++)
+                     {
+                       const auto row_start = row_adjacency.size();
+                       const auto v         = first[c];
+                       const auto u         = mate[v];
+                       for (const auto member : {v, u})
+                       {
+                         for (auto e = graph.offsets[member]; e < graph.offsets[member + 1]; e++)
+                         {
+                           const auto neighbour = level.map[graph.adjacency[e]];
+                           if (neighbour == c)
+                           {
+                             continue;
+                           }
+                           if (slot[neighbour] == unmatched)
+                           {
+                             slot[neighbour] = row_adjacency.size();
+                             row_adjacency.push_back(neighbour);
+                             row_weights.push_back(0);
+                           }
+                           row_weights[slot[neighbour]] += graph.edge_weights[e];
+                         }
+                         if (u == v)
+                         {
+                           break;
+                         }
+                       }
+                       for (auto j = row_start; j < row_adjacency.size(); j++)
+                       {
+                         slot[row_adjacency[j]] = unmatched;
+                       }
+
+                       degrees[c] = row_adjacency.size() - row_start;
+                       coarse.vertex_weights[c] =
+                           graph.vertex_weights[v] + ((u == v) ? 0 : graph.vertex_weights[u]);
+                     }
+                   });
+
+      coarse.offsets.assign(n_coarse + 1, 0);
+      std::partial_sum(degrees.begin(), degrees.end(), coarse.offsets.begin() + 1);
+      coarse.adjacency.reserve(coarse.offsets.back());
+      coarse.edge_weights.reserve(coarse.offsets.back());
+      for (unsigned int thread = 0; thread < n_threads; thread++)
+      {
+        coarse.adjacency.insert(coarse.adjacency.end(), adjacency[thread].begin(), adjacency[thread].end());
+        coarse.edge_weights.insert(coarse.edge_weights.end(), weights[thread].begin(), weights[thread].end());
+      }
+
+      return level;
+    }
+
+    /**
+     * Computes the largest weight of each part of a balanced partition, the parts sharing the total
+     * weight in proportion to their shares.
+     *
+     * @param graph     The graph.
+     * @param shares    The share of each part.
+     * @param tolerance The load imbalance tolerated.
+     * @returns The largest weight of each part.
+     */
+    [[nodiscard]] std::vector<uint64_t> part_limits(const WeightedGraph& graph,
+                                                    const std::vector<size_t>& shares,
+                                                    const double tolerance)
+    {
+      const auto total    = total_weight(graph);
+      const auto n_shares = std::accumulate(shares.begin(), shares.end(), size_t{0});
+      std::vector<uint64_t> limits(shares.size());
+      for (size_t part = 0; part < shares.size(); part++)
+      {
+        const auto target =
+            static_cast<double>(total) * static_cast<double>(shares[part]) / static_cast<double>(n_shares);
+        const auto rounded_up = (total * shares[part] + n_shares - 1) / n_shares;
+        limits[part]          = std::max(static_cast<uint64_t>((1.0 + tolerance) * target), rounded_up);
+      }
+
+      return limits;
+    }
+
+    /**
+     * Bisects a graph by greedy graph growing: the first half is grown from a random seed, adding
+     * the vertex that most reduces the cut between the halves, until it holds its share of the
+     * weight.
+     *
+     * @param graph  The graph.
+     * @param shares The shares of the two halves.
+     * @param gen    The random generator choosing the seeds.
+     * @returns The half of each vertex.
+     */
+    [[nodiscard]] std::vector<int> grow_bisection(const WeightedGraph& graph,
+                                                  const std::array<size_t, 2>& shares,
+                                                  std::mt19937_64& gen)
+    {
+      // The vertices are initially all in the second half
+      std::vector<int> parts(graph.size(), 1);
+      const auto target = total_weight(graph) * shares[0] / (shares[0] + shares[1]);
+
+      // The gain of moving a vertex to the first half, the weight of its edges to the first half
+      // less those to the second half
+      std::vector<int64_t> gain(graph.size(), 0);
+      for (size_t v = 0; v < graph.size(); v++)
+      {
+        for (auto e = graph.offsets[v]; e < graph.offsets[v + 1]; e++)
+        {
+          gain[v] -= static_cast<int64_t>(graph.edge_weights[e]);
+        }
+      }
+
+      std::vector<size_t> seeds(graph.size());
+      std::iota(seeds.begin(), seeds.end(), 0);
+      std::shuffle(seeds.begin(), seeds.end(), gen);
+      std::priority_queue<std::pair<int64_t, size_t>> frontier;
+      size_t next_seed = 0;
+      uint64_t grown   = 0;
+      while (grown < target)
+      {
+        if (frontier.empty())
+        {
+          // Start from a new seed, the first or one in another connected component
+          while ((next_seed < seeds.size()) && (parts[seeds[next_seed]] != 1))
+          {
+            next_seed++;
+          }
+          if (next_seed == seeds.size())
+          {
+            break;
+          }
+          frontier.emplace(gain[seeds[next_seed]], seeds[next_seed]);
+        }
+
+        const auto [vertex_gain, v] = frontier.top();
+        frontier.pop();
+        if ((parts[v] != 1) || (vertex_gain != gain[v]))
+        {
+          continue;  // Already grown, or a stale entry
+        }
+
+        // Stop short of the target if adding the vertex overshoots it by more
+        const auto w = graph.vertex_weights[v];
+        if ((grown > 0) && (grown + w > target) && (grown + w - target > target - grown))
+        {
+          break;
+        }
+        parts[v] = 0;
+        grown += w;
+        for (auto e = graph.offsets[v]; e < graph.offsets[v + 1]; e++)
+        {
+          const auto u = graph.adjacency[e];
+          if (parts[u] == 1)
+          {
+            gain[u] += 2 * static_cast<int64_t>(graph.edge_weights[e]);
+            frontier.emplace(gain[u], u);
+          }
+        }
+      }
+
+      return parts;
+    }
+
+    /**
+     * A candidate move of a vertex to another part.
+     */
+    struct Move
+    {
+      int64_t gain;  // The reduction of the edge cut
+      int to;        // The destination part, negative if the vertex cannot move
+    };
+
+    /**
+     * Refines a k-way partition by Fiduccia-Mattheyses passes. Each move depends on the moves before
+     * it, so a pass is serial.
+     */
+    class Refiner
+    {
+     public:
+      /**
+       * Prepares to refine a partition of a graph.
+       *
+       * @param graph  The graph.
+       * @param limits The largest weight of each part, as computed by `part_limits`.
+       * @param parts  The part of each vertex, refined in place.
+       */
+      Refiner(const WeightedGraph& graph, const std::vector<uint64_t>& limits, std::vector<int>& parts)
+          : graph(graph), limits(limits), parts(parts), part_weights(limits.size(), 0)
+      {
+        for (size_t v = 0; v < graph.size(); v++)
+        {
+          part_weights[static_cast<size_t>(parts[v])] += graph.vertex_weights[v];
+          if (on_boundary(v))
+          {
+            boundary.push_back(v);
+          }
+        }
+      }
+
+      /**
+       * Refines the partition until a pass no longer improves it.
+       *
+       * @param cut The edge cut of the partition, updated.
+       */
+      void refine(uint64_t& cut)
+      {
+        for (size_t pass = 0; pass < n_refine_passes; pass++)
+        {
+          if (!fm_pass(cut))
+          {
+            break;
+          }
+        }
+      }
+
+      /**
+       * The largest weight by which a part exceeds its limit.
+       */
+      [[nodiscard]] uint64_t overweight() const
+      {
+        uint64_t excess = 0;
+        for (size_t part = 0; part < limits.size(); part++)
+        {
+          excess = std::max(excess, (part_weights[part] > limits[part]) ? part_weights[part] - limits[part] : 0);
+        }
+
+        return excess;
+      }
+
+     private:
+      /**
+       * Whether a vertex has a neighbour in another part.
+       */
+      [[nodiscard]] bool on_boundary(const size_t v) const
+      {
+        for (auto e = graph.offsets[v]; e < graph.offsets[v + 1]; e++)
+        {
+          if (parts[graph.adjacency[e]] != parts[v])
+          {
+            return true;
+          }
+        }
+
+        return false;
+      }
+
+      /**
+       * Finds the best move of a vertex, to the adjacent part that most reduces the cut while
+       * respecting the balance, or reducing the weight of an overweight part.
+       *
+       * @param v          The vertex.
+       * @param connection Zeroed scratch space of one entry per part, left zeroed.
+       * @param touched    Scratch space.
+       * @returns The move.
+       */
+      [[nodiscard]] Move best_move(const size_t v, std::vector<int64_t>& connection, std::vector<int>& touched) const
+      {
+        touched.clear();
+        for (auto e = graph.offsets[v]; e < graph.offsets[v + 1]; e++)
+        {
+          const auto part = parts[graph.adjacency[e]];
+          if (connection[static_cast<size_t>(part)] == 0)
+          {
+            touched.push_back(part);
+          }
+          connection[static_cast<size_t>(part)] += static_cast<int64_t>(graph.edge_weights[e]);
+        }
+
+        const auto from     = static_cast<size_t>(parts[v]);
+        const auto w        = graph.vertex_weights[v];
+        const auto from_w   = part_weights[from];
+        const auto internal = connection[from];
+        Move best{std::numeric_limits<int64_t>::min(), -1};
+        for (const auto to : touched)
+        {
+          const auto to_w   = part_weights[static_cast<size_t>(to)];
+          const auto to_max = limits[static_cast<size_t>(to)];
+          if ((static_cast<size_t>(to) == from) ||
+              ((to_w + w > to_max) && ((from_w <= limits[from]) || (to_w + w - to_max >= from_w - limits[from]))))
+          {
+            continue;
+          }
+
+          const auto gain = connection[static_cast<size_t>(to)] - internal;
+          if ((gain > best.gain) || ((gain == best.gain) && (to_w < part_weights[static_cast<size_t>(best.to)])))
+          {
+            best = Move{gain, to};
+          }
+        }
+        for (const auto part : touched)
+        {
+          connection[static_cast<size_t>(part)] = 0;
+        }
+
+        return best;
+      }
+
+      /**
+       * Moves a vertex to another part.
+       */
+      void move(const size_t v, const int to)
+      {
+        part_weights[static_cast<size_t>(parts[v])] -= graph.vertex_weights[v];
+        part_weights[static_cast<size_t>(to)] += graph.vertex_weights[v];
+        parts[v] = to;
+      }
+
+      /**
+       * Performs a pass of moves, each vertex moving at most once in order of decreasing gain. Moves
+       * that increase the cut are allowed, the pass stops after `stall_limit` moves without
+       * improvement and rolls back to the best partition seen, preferring balance over cut.
+       *
+       * @param cut The edge cut of the partition, updated.
+       * @returns Whether the partition was improved.
+       */
+      [[nodiscard]] bool fm_pass(uint64_t& cut)
+      {
+        using Entry = std::tuple<int64_t, size_t, uint64_t>;  // The gain, vertex and version of a move
+
+        // Only the vertices on the boundary of their part can move
+        std::vector<int64_t> connection(limits.size(), 0);
+        std::vector<int> touched;
+        std::priority_queue<Entry> queue;
+        std::vector<uint64_t> version(graph.size(), 0);
+        for (const auto v : boundary)
+        {
+          const auto initial = best_move(v, connection, touched);
+          if (initial.to >= 0)
+          {
+            queue.emplace(initial.gain, v, 0);
+          }
+        }
+
+        std::vector<bool> locked(graph.size(), false);
+        std::vector<std::pair<size_t, int>> moves;  // Each vertex moved and its original part
+
+        auto current      = std::make_pair(overweight(), cut);
+        auto best         = current;
+        size_t best_moves = 0;
+        size_t stalled    = 0;
+        while (!queue.empty() && (stalled < stall_limit))
+        {
+          const auto [gain, v, stamp] = queue.top();
+          queue.pop();
+          if (locked[v] || (stamp != version[v]))
+          {
+            continue;
+          }
+
+          // The balance may have changed since the move was queued
+          const auto candidate = best_move(v, connection, touched);
+          if (candidate.to < 0)
+          {
+            continue;
+          }
+          if (candidate.gain != gain)
+          {
+            queue.emplace(candidate.gain, v, ++version[v]);
+            continue;
+          }
+
+          moves.emplace_back(v, parts[v]);
+          move(v, candidate.to);
+          locked[v] = true;
+          current   = std::make_pair(overweight(), static_cast<uint64_t>(static_cast<int64_t>(current.second) - gain));
+          if (current < best)
+          {
+            best       = current;
+            best_moves = moves.size();
+            stalled    = 0;
+          }
+          else
+          {
+            stalled++;
+          }
+
+          for (auto e = graph.offsets[v]; e < graph.offsets[v + 1]; e++)
+          {
+            const auto u = graph.adjacency[e];
+            if (!locked[u])
+            {
+              const auto neighbour_move = best_move(u, connection, touched);
+              ++version[u];
+              if (neighbour_move.to >= 0)
+              {
+                queue.emplace(neighbour_move.gain, u, version[u]);
+              }
+            }
+          }
+        }
+
+        while (moves.size() > best_moves)
+        {
+          move(moves.back().first, moves.back().second);
+          moves.pop_back();
+        }
+        cut = best.second;
+
+        // The boundary only changes around the vertices moved
+        for (const auto& [v, from] : moves)
+        {
+          boundary.push_back(v);
+          boundary.insert(boundary.end(),
+                          graph.adjacency.begin() + static_cast<std::ptrdiff_t>(graph.offsets[v]),
+                          graph.adjacency.begin() + static_cast<std::ptrdiff_t>(graph.offsets[v + 1]));
+        }
+        std::sort(boundary.begin(), boundary.end());
+        boundary.erase(std::unique(boundary.begin(), boundary.end()), boundary.end());
+        boundary.erase(std::remove_if(boundary.begin(),
+                                      boundary.end(),
+                                      [this](const size_t v) -> bool
+                                      {
+                                        return !on_boundary(v);
+                                      }),
+                       boundary.end());
+
+        return best_moves > 0;
+      }
+
+      const WeightedGraph& graph;            // The graph
+      const std::vector<uint64_t>& limits;   // The largest weight of each part
+      std::vector<int>& parts;               // The part of each vertex
+      std::vector<uint64_t> part_weights;    // The weight of each part
+      std::vector<size_t> boundary;          // The vertices with a neighbour in another part
+    };
+
+    /**
+     * A bisection of a graph and its quality.
+     */
+    struct Bisection
+    {
+      std::vector<int> parts;  // The half of each vertex
+      uint64_t overweight{};   // The largest weight by which a half exceeds its limit
+      uint64_t cut{};          // The edge cut
+
+      /**
+       * Whether the bisection is better than another, a balanced bisection is preferred to a
+       * smaller cut.
+       */
+      [[nodiscard]] bool operator<(const Bisection& other) const
+      {
+        return std::make_pair(overweight, cut) < std::make_pair(other.overweight, other.cut);
+      }
+    };
+
+    /**
+     * Computes the initial bisection of the coarsest graph, the best of several bisections grown
+     * from different seeds by the threads, each refined.
+     *
+     * @param graph     The coarsest graph.
+     * @param limits    The largest weight of each half.
+     * @param shares    The shares of the two halves.
+     * @param seed      The seed of the first bisection.
+     * @param n_threads The number of threads.
+     * @returns The half of each vertex.
+     */
+    [[nodiscard]] Bisection initial_bisection(const WeightedGraph& graph,
+                                              const std::vector<uint64_t>& limits,
+                                              const std::array<size_t, 2>& shares,
+                                              const uint64_t seed,
+                                              const unsigned int n_threads)
+    {
+      std::vector<Bisection> trials(n_initial_trials);
+      parallel_for(static_cast<unsigned int>(std::min<size_t>(n_threads, n_initial_trials)),
+                   n_initial_trials,
+                   [&](const unsigned int /* thread */, const size_t first, const size_t last)
+                   {
+                     for (auto trial = first; trial < last; trial++)
+                     {
+                       std::mt19937_64 gen{seed + trial};
+                       auto& bisection = trials[trial];
+                       bisection.parts = grow_bisection(graph, shares, gen);
+                       bisection.cut   = partition_cut(graph, bisection.parts);
+                       Refiner refiner{graph, limits, bisection.parts};
+                       refiner.refine(bisection.cut);
+                       bisection.overweight = refiner.overweight();
+                     }
+                   });
+
+      return std::move(*std::min_element(trials.begin(), trials.end()));
+    }
+
+    /**
+     * Bisects a graph by the multilevel scheme: the graph is coarsened by contracting a heavy-edge
+     * matching until it is small, the coarsest graph is bisected, and the bisection is projected
+     * back through the levels, refined on each.
+     *
+     * @param graph     The graph.
+     * @param shares    The shares of the two halves.
+     * @param tolerance The load imbalance tolerated.
+     * @param seed      The seed of the matching orders and initial seeds.
+     * @param n_threads The number of threads.
+     * @returns The bisection.
+     */
+    [[nodiscard]] Bisection multilevel_bisection(const WeightedGraph& graph,
+                                                 const std::array<size_t, 2>& shares,
+                                                 const double tolerance,
+                                                 const uint64_t seed,
+                                                 const unsigned int n_threads)
+    {
+      // Coarsen the graph until it is small, or matching no longer reduces it
+      const auto coarsest   = coarsest_per_part * shares.size();
+      const auto max_weight = std::max<uint64_t>(
+          1, static_cast<uint64_t>(max_vertex_share * static_cast<double>(total_weight(graph)) / coarsest));
+      std::mt19937_64 gen{seed};
+      std::vector<Level> levels;
+      while (true)
+      {
+        const auto& fine = levels.empty() ? graph : levels.back().graph;
+        if (fine.size() <= coarsest)
+        {
+          break;
+        }
+
+        auto level = contract(fine, heavy_edge_matching(fine, max_weight, gen), n_threads);
+        if (static_cast<double>(level.graph.size()) > min_reduction * static_cast<double>(fine.size()))
+        {
+          break;
+        }
+        levels.push_back(std::move(level));
+      }
+
+      // Bisect the coarsest graph, then project the bisection back through the levels, refining it
+      // on each, the levels have the same total weight
+      const auto limits = part_limits(graph, {shares[0], shares[1]}, tolerance);
+      auto bisection =
+          initial_bisection(levels.empty() ? graph : levels.back().graph, limits, shares, seed, n_threads);
+      for (auto level = levels.size(); level-- > 0;)
+      {
+        const auto& fine = (level == 0) ? graph : levels[level - 1].graph;
+        std::vector<int> fine_parts(fine.size());
+        for (size_t v = 0; v < fine.size(); v++)
+        {
+          fine_parts[v] = bisection.parts[levels[level].map[v]];
+        }
+        bisection.parts = std::move(fine_parts);
+        levels.pop_back();
+
+        Refiner refiner{fine, limits, bisection.parts};
+        refiner.refine(bisection.cut);
+        bisection.overweight = refiner.overweight();
+      }
+
+      return bisection;
+    }
+
+    /**
+     * Extracts the subgraph induced by the vertices of a part.
+     *
+     * @param graph    The graph.
+     * @param parts    The part of each vertex.
+     * @param part     The part.
+     * @param vertices The vertex of the graph of each vertex of the subgraph, set.
+     * @returns The subgraph.
+     */
+    [[nodiscard]] WeightedGraph induced_subgraph(const WeightedGraph& graph,
+                                                 const std::vector<int>& parts,
+                                                 const int part,
+                                                 std::vector<size_t>& vertices)
+    {
+      vertices.clear();
+      std::vector<size_t> local(graph.size(), unmatched);  // The subgraph vertex of each vertex
+      for (size_t v = 0; v < graph.size(); v++)
+      {
+        if (parts[v] == part)
+        {
+          local[v] = vertices.size();
+          vertices.push_back(v);
+        }
+      }
+
+      WeightedGraph subgraph;
+      subgraph.offsets.reserve(vertices.size() + 1);
+      subgraph.vertex_weights.reserve(vertices.size());
+      for (const auto v : vertices)
+      {
+        for (auto e = graph.offsets[v]; e < graph.offsets[v + 1]; e++)
+        {
+          if (local[graph.adjacency[e]] != unmatched)
+          {
+            subgraph.adjacency.push_back(local[graph.adjacency[e]]);
+            subgraph.edge_weights.push_back(graph.edge_weights[e]);
+          }
+        }
+        subgraph.offsets.push_back(subgraph.adjacency.size());
+        subgraph.vertex_weights.push_back(graph.vertex_weights[v]);
+      }
+
+      return subgraph;
+    }
+
+    /**
+     * Partitions a graph by recursive multilevel bisection, each half split into its share of the
+     * parts. The two halves are partitioned concurrently when there are threads to spare, each with
+     * a share of the threads.
+     *
+     * @param graph      The graph.
+     * @param first_part The first of the parts the vertices are split into.
+     * @param n_parts    The number of parts the vertices are split into.
+     * @param tolerance  The load imbalance tolerated by each bisection.
+     * @param n_threads  The number of threads.
+     * @param parts      The part of each vertex, set.
+     */
+    void recursive_bisection(const WeightedGraph& graph,
+                             const int first_part,
+                             const size_t n_parts,
+                             const double tolerance,
+                             const unsigned int n_threads,
+                             std::vector<int>& parts)
+    {
+      if ((n_parts <= 1) || (graph.size() == 0))
+      {
+        std::fill(parts.begin(), parts.end(), first_part);
+        return;
+      }
+
+      // The best of several multilevel bisections, computed by the threads, each bisection has its
+      // own seed so that the partition is independent of the number of threads
+      const auto n_first         = n_parts / 2;
+      const auto n_trial_threads = static_cast<unsigned int>(std::min<size_t>(n_threads, n_bisection_trials));
+      std::vector<Bisection> trials(n_bisection_trials);
+      parallel_for(n_trial_threads,
+                   n_bisection_trials,
+                   [&](const unsigned int /* thread */, const size_t first, const size_t last)
+                   {
+                     for (auto trial = first; trial < last; trial++)
+                     {
+                       const auto split      = (static_cast<uint64_t>(first_part) << 32U) | (n_parts << 8U) | trial;
+                       const auto trial_seed = seed + split * n_initial_trials;
+                       trials[trial] = multilevel_bisection(
+                           graph, {n_first, n_parts - n_first}, tolerance, trial_seed, n_threads / n_trial_threads);
+                     }
+                   });
+      auto halves = std::move(std::min_element(trials.begin(), trials.end())->parts);
+      trials      = std::vector<Bisection>{};
+
+      std::array<std::vector<size_t>, 2> vertices;
+      std::array<WeightedGraph, 2> subgraphs;
+      for (int half = 0; half < 2; half++)
+      {
+        subgraphs[static_cast<size_t>(half)] =
+            induced_subgraph(graph, halves, half, vertices[static_cast<size_t>(half)]);
+      }
+      parallel_for(std::min(n_threads, 2U),
+                   2,
+                   [&](const unsigned int /* thread */, const size_t first, const size_t last)
+                   {
+                     for (auto half = first; half < last; half++)
+                     {
+                       const auto half_threads =
+                           (n_threads < 2) ? 1U : ((half == 0) ? n_threads / 2 : n_threads - (n_threads / 2));
+                       std::vector<int> half_parts(subgraphs[half].size());
+                       recursive_bisection(subgraphs[half],
+                                           first_part + ((half == 0) ? 0 : static_cast<int>(n_first)),
+                                           (half == 0) ? n_first : n_parts - n_first,
+                                           tolerance,
+                                           half_threads,
+                                           half_parts);
+                       for (size_t v = 0; v < half_parts.size(); v++)
+                       {
+                         parts[vertices[half][v]] = half_parts[v];
+                       }
+                     }
+                   });
+    }
+  }  // namespace
+
+  std::vector<int> partition_graph(const WeightedGraph& graph,
+                                   const size_t n_parts,
+                                   const unsigned int n_threads,
+                                   const double tolerance)
+  {
+    if (n_parts == 0)
+    {
+      throw std::runtime_error("A graph must be partitioned into at least one part");
+    }
+    if ((n_parts == 1) || (graph.size() == 0))
+    {
+      return std::vector<int>(graph.size(), 0);
+    }
+
+    // The imbalances of the bisections compound over the levels of the recursion
+    size_t n_levels = 0;
+    while ((size_t{1} << n_levels) < n_parts)
+    {
+      n_levels++;
+    }
+    const auto bisection_tolerance = std::pow(1.0 + tolerance, 1.0 / static_cast<double>(n_levels)) - 1.0;
+    std::vector<int> parts(graph.size(), 0);
+    recursive_bisection(graph, 0, n_parts, bisection_tolerance, std::max(n_threads, 1U), parts);
+
+    // Refine the parts against each other
+    const auto limits = part_limits(graph, std::vector<size_t>(n_parts, 1), tolerance);
+    uint64_t cut      = partition_cut(graph, parts);
+    Refiner{graph, limits, parts}.refine(cut);
+
+    return parts;
+  }
+
+  uint64_t partition_cut(const WeightedGraph& graph, const std::vector<int>& parts)
+  {
+    uint64_t cut = 0;
+    for (size_t v = 0; v < graph.size(); v++)
+    {
+      for (auto e = graph.offsets[v]; e < graph.offsets[v + 1]; e++)
+      {
+        if (parts[graph.adjacency[e]] != parts[v])
+        {
+          cut += graph.edge_weights[e];
+        }
+      }
+    }
+
+    return cut / 2;
+  }
+
+  double partition_imbalance(const WeightedGraph& graph, const std::vector<int>& parts, const size_t n_parts)
+  {
+    std::vector<uint64_t> weights(n_parts, 0);
+    for (size_t v = 0; v < graph.size(); v++)
+    {
+      weights[static_cast<size_t>(parts[v])] += graph.vertex_weights[v];
+    }
+
+    const auto total = std::accumulate(weights.begin(), weights.end(), uint64_t{0});
+    const auto max   = *std::max_element(weights.begin(), weights.end());
+    return (total == 0) ? 1.0 : static_cast<double>(max * n_parts) / static_cast<double>(total);
+  }
+
+  GraphPartition::GraphPartition(const DistributedGraph& graph,
+                                 MPI_Comm comm,
+                                 const unsigned int n_threads,
+                                 const double tolerance)
+  {
+    const auto parallel = make_parallel(comm);
+    const auto n_ranks  = static_cast<size_t>(parallel.size);
+    constexpr int root  = 0;
+
+    // Gather the graph on the root, the vertices of the ranks are numbered consecutively
+    std::vector<int> counts(n_ranks);
+    std::vector<int> displs(n_ranks);
+    const auto gather = [&](const std::vector<size_t>& local) -> std::vector<size_t>
+    {
+      const auto n_local = static_cast<uint64_t>(local.size());
+      std::vector<uint64_t> sizes(n_ranks);
+      chkerr(MPI_Gather(&n_local, 1, mpi_type<uint64_t>(), sizes.data(), 1, mpi_type<uint64_t>(), root, comm),
+             "MPI_Gather");
+      size_t n_total = 0;
+      for (size_t rank = 0; rank < n_ranks; rank++)
+      {
+        if (n_total + sizes[rank] > INT_MAX)
+        {
+          throw std::runtime_error("Graph too large to gather on a single rank");
+        }
+        counts[rank] = static_cast<int>(sizes[rank]);
+        displs[rank] = static_cast<int>(n_total);
+        n_total += sizes[rank];
+      }
+
+      std::vector<size_t> global(n_total);
+      chkerr(MPI_Gatherv(local.data(),
+                         static_cast<int>(local.size()),
+                         mpi_type<size_t>(),
+                         global.data(),
+                         counts.data(),
+                         displs.data(),
+                         mpi_type<size_t>(),
+                         root,
+                         comm),
+             "MPI_Gatherv");
+      return global;
+    };
+
+    std::vector<size_t> degrees(graph.size());
+    for (size_t i = 0; i < graph.size(); i++)
+    {
+      degrees[i] = graph.degree(i);
+    }
+    const auto global_degrees = gather(degrees);
+    auto global_adjacency     = gather(graph.adjacency);
+
+    // Partition the graph on the root, each vertex and edge has unit weight
+    std::vector<int> global_parts;
+    std::array<double, 2> summary{1.0, 0.0};  // The imbalance and edge cut, broadcast from the root
+    if (parallel.rank == root)
+    {
+      WeightedGraph global;
+      global.offsets.assign(global_degrees.size() + 1, 0);
+      std::partial_sum(global_degrees.begin(), global_degrees.end(), global.offsets.begin() + 1);
+      global.adjacency = std::move(global_adjacency);
+      global.edge_weights.assign(global.adjacency.size(), 1);
+      global.vertex_weights.assign(global.size(), 1);
+
+      global_parts = partition_graph(global, n_ranks, n_threads, tolerance);
+      summary      = {partition_imbalance(global, global_parts, n_ranks),
+                      static_cast<double>(partition_cut(global, global_parts))};
+    }
+    chkerr(MPI_Bcast(summary.data(), 2, MPI_DOUBLE, root, comm), "MPI_Bcast");
+    load_imbalance = summary[0];
+    cut            = static_cast<uint64_t>(summary[1]);
+
+    // Return the destination of each vertex to the rank holding it
+    for (size_t rank = 0; rank < n_ranks; rank++)
+    {
+      counts[rank] = static_cast<int>(graph.vtxdist[rank + 1] - graph.vtxdist[rank]);
+      displs[rank] = static_cast<int>(graph.vtxdist[rank]);
+    }
+    vertex_destinations.resize(graph.size());
+    chkerr(MPI_Scatterv(global_parts.data(),
+                        counts.data(),
+                        displs.data(),
+                        MPI_INT,
+                        vertex_destinations.data(),
+                        static_cast<int>(graph.size()),
+                        MPI_INT,
+                        root,
+                        comm),
+           "MPI_Scatterv");
+
+    // Send the global indices of the vertices to their destination ranks
+    std::vector<size_t> global_idx(graph.size());
+    std::iota(global_idx.begin(), global_idx.end(), graph.vtxdist[parallel.rank]);
+    owned = send_to_ranks(
+        global_idx,
+        [this, &graph, &parallel](const size_t idx) -> int
+        {
+          return vertex_destinations[idx - graph.vtxdist[parallel.rank]];
+        },
+        comm);
+    std::sort(owned.begin(), owned.end());
+  }
+
+  bool GraphPartition::pick(const size_t idx) const
+  {
+    return std::binary_search(owned.begin(), owned.end(), idx);
+  }
+
+  void GraphPartition::report(std::ostream& os) const
+  {
+    os << "++ Partition imbalance: " << load_imbalance << "\n";
+    os << "++ Partition edge cut: " << cut << "\n";
+  }
+}  // namespace cfg::utils
@@ -0,0 +1,490 @@
+/**
+ * halo.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <halo.h>
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+#include <directory.h>
+#include <migration.h>
+
+namespace cfg::utils
+{
+  namespace
+  {
+    /**
+     * An item, a node or a cell, owned by a rank.
+     */
+    struct ItemRef
+    {
+      int rank;           // The rank owning the item
+      size_t idx;         // The local index of the item on its owner
+      size_t global_idx;  // The global index of the item
+    };
+
+    /**
+     * An item owned by this rank that is a ghost of a neighbour, as the neighbour's rank and the
+     * local index of the item.
+     */
+    using Served = std::pair<int, size_t>;
+
+    /**
+     * The requests received by this rank for the items it owns.
+     */
+    struct Requests
+    {
+      std::vector<int> sources;  // The rank requesting each item
+      std::vector<size_t> idx;   // The local index of each item requested
+    };
+
+    /**
+     * Orders items by their owner and then their local index on the owner.
+     */
+    [[nodiscard]] inline bool by_owner(const ItemRef& a, const ItemRef& b)
+    {
+      return (a.rank < b.rank) || ((a.rank == b.rank) && (a.idx < b.idx));
+    }
+
+    /**
+     * Sorts a vector and removes its duplicates.
+     */
+    template <class T>
+    void sort_unique(std::vector<T>& values)
+    {
+      std::sort(values.begin(), values.end());
+      values.erase(std::unique(values.begin(), values.end()), values.end());
+    }
+
+    /**
+     * Finds the nodes of this rank's cells that are shared with the cells of other ranks, the
+     * directory holding each node tells the ranks publishing its cells when they are not all the
+     * same. This must be called collectively.
+     *
+     * @param cells The directory of the cells of each node held by this rank.
+     * @param comm  The communicator.
+     * @returns The sorted tags of the shared nodes of this rank's cells.
+     */
+    [[nodiscard]] std::vector<size_t> shared_nodes(const std::vector<DirectoryEntry<ItemRef>>& cells, MPI_Comm comm)
+    {
+      // The entries of a tag are ordered by the rank publishing them
+      std::vector<DirectoryEntry<int>> notices;
+      for (auto first = cells.begin(); first != cells.end();)
+      {
+        const auto last = std::find_if(first,
+                                       cells.end(),
+                                       [tag = first->tag](const DirectoryEntry<ItemRef>& entry) -> bool
+                                       {
+                                         return entry.tag != tag;
+                                       });
+        if (std::prev(last)->value.rank != first->value.rank)
+        {
+          for (auto entry = first; entry != last; ++entry)
+          {
+            if ((entry == first) || (std::prev(entry)->value.rank != entry->value.rank))
+            {
+              notices.push_back(DirectoryEntry<int>{entry->tag, entry->value.rank});
+            }
+          }
+        }
+        first = last;
+      }
+
+      const auto received = send_to_ranks(
+          notices,
+          [](const DirectoryEntry<int>& notice) -> int
+          {
+            return notice.value;
+          },
+          comm);
+      std::vector<size_t> tags(received.size());
+      std::transform(received.begin(),
+                     received.end(),
+                     tags.begin(),
+                     [](const DirectoryEntry<int>& notice) -> size_t
+                     {
+                       return notice.tag;
+                     });
+      std::sort(tags.begin(), tags.end());
+      return tags;
+    }
+
+    /**
+     * Sends requests for items to their owners, this must be called collectively.
+     *
+     * @param refs The items requested by this rank.
+     * @param comm The communicator.
+     * @returns The items requested from this rank, ordered by the rank requesting them.
+     */
+    [[nodiscard]] Requests send_requests(const std::vector<ItemRef>& refs, MPI_Comm comm)
+    {
+      const auto n_ranks = static_cast<size_t>(make_parallel(comm).size);
+
+      std::vector<int> owners(refs.size());
+      std::transform(refs.begin(),
+                     refs.end(),
+                     owners.begin(),
+                     [](const ItemRef& ref) -> int
+                     {
+                       return ref.rank;
+                     });
+      const auto items = route(owners, n_ranks);
+      std::vector<size_t> send(refs.size());
+      for (size_t k = 0; k < refs.size(); k++)
+      {
+        send[k] = refs[items.order[k]].idx;
+      }
+
+      Requests requests;
+      std::vector<int> recv_counts;
+      requests.idx = exchange(send, items.counts, comm, recv_counts);
+      requests.sources.reserve(requests.idx.size());
+      for (size_t rank = 0; rank < n_ranks; rank++)
+      {
+        requests.sources.insert(requests.sources.end(), static_cast<size_t>(recv_counts[rank]), static_cast<int>(rank));
+      }
+
+      return requests;
+    }
+
+    /**
+     * Fetches cells from their owners, this must be called collectively.
+     *
+     * @param refs     The cells fetched by this rank.
+     * @param elements The elements owned by this rank.
+     * @param served   Appended with the cells this rank sends to the ranks fetching them.
+     * @param comm     The communicator.
+     * @returns The cells fetched, ordered by global index.
+     */
+    [[nodiscard]] cfg::parser::ElementSet fetch_elements(const std::vector<ItemRef>& refs,
+                                                         const cfg::parser::ElementSet& elements,
+                                                         std::vector<Served>& served,
+                                                         MPI_Comm comm)
+    {
+      const auto requests = send_requests(refs, comm);
+
+      cfg::parser::ElementSet requested;
+      requested.reserve(requests.idx.size());
+      for (size_t i = 0; i < requests.idx.size(); i++)
+      {
+        const auto idx           = requests.idx[i];
+        const auto [first, last] = elements.connectivity(idx);
+        requested.push_back(elements.natural_idx[idx], elements.global_idx[idx], elements.type[idx], first, last);
+        served.emplace_back(requests.sources[i], idx);
+      }
+
+      return migrate_elements(requested, requests.sources, comm);
+    }
+
+    /**
+     * Fetches nodes from their owners, this must be called collectively.
+     *
+     * @param refs   The nodes fetched by this rank.
+     * @param nodes  The nodes owned by this rank.
+     * @param served Appended with the nodes this rank sends to the ranks fetching them.
+     * @param comm   The communicator.
+     * @returns The nodes fetched, ordered by global index.
+     */
+    [[nodiscard]] cfg::parser::NodeSet<3> fetch_nodes(const std::vector<ItemRef>& refs,
+                                                      const cfg::parser::NodeSet<3>& nodes,
+                                                      std::vector<Served>& served,
+                                                      MPI_Comm comm)
+    {
+      const auto requests = send_requests(refs, comm);
+
+      cfg::parser::NodeSet<3> requested(requests.idx.size());
+      for (size_t i = 0; i < requests.idx.size(); i++)
+      {
+        const auto idx            = requests.idx[i];
+        requested.natural_idx[i]  = nodes.natural_idx[idx];
+        requested.global_idx[i]   = nodes.global_idx[idx];
+        for (size_t axis = 0; axis < 3; axis++)
+        {
+          requested.x[axis][i] = nodes.x[axis][idx];
+        }
+        served.emplace_back(requests.sources[i], idx);
+      }
+
+      return migrate_nodes(requested, requests.sources, comm);
+    }
+
+    /**
+     * Orders a set of elements by global index.
+     */
+    [[nodiscard]] cfg::parser::ElementSet sort_elements(const cfg::parser::ElementSet& elements)
+    {
+      std::vector<size_t> order(elements.size());
+      std::iota(order.begin(), order.end(), 0);
+      std::sort(order.begin(),
+                order.end(),
+                [&elements](const size_t a, const size_t b) -> bool
+                {
+                  return elements.global_idx[a] < elements.global_idx[b];
+                });
+
+      cfg::parser::ElementSet sorted;
+      sorted.reserve(elements.size());
+      sorted.nodes.reserve(elements.nodes.size());
+      for (const auto i : order)
+      {
+        const auto [first, last] = elements.connectivity(i);
+        sorted.push_back(elements.natural_idx[i], elements.global_idx[i], elements.type[i], first, last);
+      }
+
+      return sorted;
+    }
+
+    /**
+     * Assembles the pattern of a halo exchange.
+     *
+     * @param neighbours The neighbours of this rank, sorted.
+     * @param served     The items sent to the neighbours, sorted.
+     * @param ghosts     The ghosts received from the neighbours, ordered by `by_owner`.
+     * @param global_idx The global index of each ghost in the halo, sorted.
+     * @returns The pattern.
+     */
+    template <class A>
+    [[nodiscard]] HaloPattern make_pattern(const std::vector<int>& neighbours,
+                                           const std::vector<Served>& served,
+                                           const std::vector<ItemRef>& ghosts,
+                                           const A& global_idx)
+    {
+      const auto position = [&neighbours](const int rank) -> size_t
+      {
+        return static_cast<size_t>(std::lower_bound(neighbours.begin(), neighbours.end(), rank) - neighbours.begin());
+      };
+
+      HaloPattern pattern;
+      pattern.send_offsets.assign(neighbours.size() + 1, 0);
+      pattern.recv_offsets.assign(neighbours.size() + 1, 0);
+      for (const auto& [rank, idx] : served)
+      {
+        pattern.send_offsets[position(rank) + 1]++;
+        pattern.send_idx.push_back(idx);
+      }
+      for (const auto& ghost : ghosts)
+      {
+        pattern.recv_offsets[position(ghost.rank) + 1]++;
+        pattern.recv_idx.push_back(static_cast<size_t>(
+            std::lower_bound(global_idx.begin(), global_idx.end(), ghost.global_idx) - global_idx.begin()));
+      }
+      for (size_t k = 0; k < neighbours.size(); k++)
+      {
+        pattern.send_offsets[k + 1] += pattern.send_offsets[k];
+        pattern.recv_offsets[k + 1] += pattern.recv_offsets[k];
+      }
+
+      return pattern;
+    }
+  }  // namespace
+
+  Halo build_halo(const cfg::parser::NodeSet<3>& nodes,
+                  const cfg::parser::ElementSet& elements,
+                  const unsigned int depth,
+                  MPI_Comm comm)
+  {
+    const auto rank = static_cast<int>(make_parallel(comm).rank);
+
+    Halo halo;
+    halo.depth = depth;
+
+    // The cells are the elements of the highest dimension held by any rank, they are published
+    // under each of their nodes
+    int dim = 0;
+    for (const auto type : elements.type)
+    {
+      dim = std::max(dim, cfg::parser::element_type(type).dim);
+    }
+    chkerr(MPI_Allreduce(MPI_IN_PLACE, &dim, 1, MPI_INT, MPI_MAX, comm), "MPI_Allreduce");
+    std::vector<DirectoryEntry<ItemRef>> entries;
+    for (size_t i = 0; i < elements.size(); i++)
+    {
+      if (cfg::parser::element_type(elements.type[i]).dim != dim)
+      {
+        continue;
+      }
+      const auto [first, last] = elements.connectivity(i);
+      for (auto tag = first; tag != last; ++tag)
+      {
+        entries.push_back(DirectoryEntry<ItemRef>{*tag, ItemRef{rank, i, elements.global_idx[i]}});
+      }
+    }
+    const auto cells = publish(entries, comm);
+    entries = std::vector<DirectoryEntry<ItemRef>>{};
+
+    // Each layer of ghost cells are the cells of other ranks containing a node of the last layer,
+    // only the nodes shared with other ranks can reach them from this rank's cells, and the
+    // directory does not return this rank's own cells
+    std::vector<size_t> frontier;  // The tags of the nodes of the last layer of cells
+    if (depth > 0)
+    {
+      frontier = shared_nodes(cells, comm);
+    }
+    const auto others = [](const ItemRef& ref, const int requester) -> bool
+    {
+      return ref.rank != requester;
+    };
+    std::vector<ItemRef> ghost_cells;
+    std::vector<Served> served_cells;
+    std::vector<size_t> known;     // The sorted global indices of the ghost cells
+    std::vector<size_t> expanded;  // The sorted tags of the nodes whose cells are known
+    for (unsigned int layer = 0; layer < depth; layer++)
+    {
+      sort_unique(frontier);
+      std::vector<size_t> tags;
+      std::set_difference(frontier.begin(), frontier.end(), expanded.begin(), expanded.end(), std::back_inserter(tags));
+      std::vector<size_t> merged;
+      std::merge(expanded.begin(), expanded.end(), tags.begin(), tags.end(), std::back_inserter(merged));
+      expanded.swap(merged);
+
+      const auto matches = lookup_all(cells, tags, others, comm);
+      std::vector<ItemRef> refs;
+      for (const auto& ref : matches.values)
+      {
+        if (!std::binary_search(known.begin(), known.end(), ref.global_idx))
+        {
+          refs.push_back(ref);
+        }
+      }
+      std::sort(refs.begin(),
+                refs.end(),
+                [](const ItemRef& a, const ItemRef& b) -> bool
+                {
+                  return a.global_idx < b.global_idx;
+                });
+      refs.erase(std::unique(refs.begin(),
+                             refs.end(),
+                             [](const ItemRef& a, const ItemRef& b) -> bool
+                             {
+                               return a.global_idx == b.global_idx;
+                             }),
+                 refs.end());
+      for (const auto& ref : refs)
+      {
+        known.push_back(ref.global_idx);
+      }
+      std::sort(known.begin(), known.end());
+
+      const auto fetched = fetch_elements(refs, elements, served_cells, comm);
+      for (size_t i = 0; i < fetched.size(); i++)
+      {
+        const auto [first, last] = fetched.connectivity(i);
+        halo.elements.push_back(fetched.natural_idx[i], fetched.global_idx[i], fetched.type[i], first, last);
+      }
+      ghost_cells.insert(ghost_cells.end(), refs.begin(), refs.end());
+      frontier = fetched.nodes;
+    }
+    halo.elements = sort_elements(halo.elements);
+
+    // The ghost nodes complete this rank's elements and the ghost cells
+    std::vector<size_t> owned(nodes.natural_idx.begin(), nodes.natural_idx.end());
+    std::sort(owned.begin(), owned.end());
+    std::vector<size_t> referenced(elements.nodes);
+    referenced.insert(referenced.end(), halo.elements.nodes.begin(), halo.elements.nodes.end());
+    sort_unique(referenced);
+    std::vector<size_t> tags;
+    std::set_difference(
+        referenced.begin(), referenced.end(), owned.begin(), owned.end(), std::back_inserter(tags));
+    referenced = std::vector<size_t>{};
+
+    std::vector<DirectoryEntry<ItemRef>> node_entries(nodes.size());
+    for (size_t i = 0; i < nodes.size(); i++)
+    {
+      node_entries[i] = DirectoryEntry<ItemRef>{nodes.natural_idx[i], ItemRef{rank, i, nodes.global_idx[i]}};
+    }
+    const auto node_owners = publish(
+        node_entries,
+        [](const ItemRef& a, const ItemRef& /* b */) -> ItemRef
+        {
+          return a;
+        },
+        comm);
+    node_entries = std::vector<DirectoryEntry<ItemRef>>{};
+    auto ghost_nodes = lookup(node_owners, tags, ItemRef{-1, 0, 0}, comm);
+
+    int missing = std::any_of(ghost_nodes.begin(),
+                              ghost_nodes.end(),
+                              [](const ItemRef& ref) -> bool
+                              {
+                                return ref.rank < 0;
+                              })
+                      ? 1
+                      : 0;
+    chkerr(MPI_Allreduce(MPI_IN_PLACE, &missing, 1, MPI_INT, MPI_MAX, comm), "MPI_Allreduce");
+    if (missing != 0)
+    {
+      throw std::runtime_error("An element refers to a node that is not owned by any rank");
+    }
+
+    std::vector<Served> served_nodes;
+    halo.nodes = fetch_nodes(ghost_nodes, nodes, served_nodes, comm);
+
+    // The neighbours send or receive ghosts, the relation is symmetric
+    std::vector<int> neighbours;
+    for (const auto* ghosts : {&ghost_nodes, &ghost_cells})
+    {
+      for (const auto& ref : *ghosts)
+      {
+        neighbours.push_back(ref.rank);
+      }
+    }
+    for (const auto* served : {&served_nodes, &served_cells})
+    {
+      for (const auto& item : *served)
+      {
+        neighbours.push_back(item.first);
+      }
+    }
+    sort_unique(neighbours);
+
+    std::sort(served_nodes.begin(), served_nodes.end());
+    std::sort(served_cells.begin(), served_cells.end());
+    std::sort(ghost_nodes.begin(), ghost_nodes.end(), by_owner);
+    std::sort(ghost_cells.begin(), ghost_cells.end(), by_owner);
+    halo.node_pattern    = make_pattern(neighbours, served_nodes, ghost_nodes, halo.nodes.global_idx);
+    halo.element_pattern = make_pattern(neighbours, served_cells, ghost_cells, halo.elements.global_idx);
+    halo.neighbours      = std::move(neighbours);
+
+    return halo;
+  }
+
+  MPI_Comm halo_communicator(const Halo& halo, MPI_Comm comm)
+  {
+    const auto n_neighbours = halo.neighbours.size();
+
+    std::vector<int> source_weights(n_neighbours);
+    std::vector<int> destination_weights(n_neighbours);
+    for (size_t k = 0; k < n_neighbours; k++)
+    {
+      const auto n_sent = halo.node_pattern.send_offsets[k + 1] - halo.node_pattern.send_offsets[k] +
+                          halo.element_pattern.send_offsets[k + 1] - halo.element_pattern.send_offsets[k];
+      const auto n_recv = halo.node_pattern.recv_offsets[k + 1] - halo.node_pattern.recv_offsets[k] +
+                          halo.element_pattern.recv_offsets[k + 1] - halo.element_pattern.recv_offsets[k];
+      destination_weights[k] = static_cast<int>(std::min<size_t>(n_sent, INT_MAX));
+      source_weights[k]      = static_cast<int>(std::min<size_t>(n_recv, INT_MAX));
+    }
+
+    // Empty weights must be marked as such rather than passed as a null array
+    const auto degree = static_cast<int>(n_neighbours);
+    MPI_Comm halo_comm = MPI_COMM_NULL;
+    chkerr(MPI_Dist_graph_create_adjacent(comm,
+                                          degree,
+                                          halo.neighbours.data(),
+                                          (degree == 0) ? MPI_WEIGHTS_EMPTY : source_weights.data(),
+                                          degree,
+                                          halo.neighbours.data(),
+                                          (degree == 0) ? MPI_WEIGHTS_EMPTY : destination_weights.data(),
+                                          MPI_INFO_NULL,
+                                          0,
+                                          &halo_comm),
+           "MPI_Dist_graph_create_adjacent");
+
+    return halo_comm;
+  }
+}  // namespace cfg::utils
@@ -0,0 +1,483 @@
+/**
+ * hpc_reader.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <hpc_reader.h>
+
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <mpi_utils.h>
+
+namespace cfg::hpc
+{
+  namespace
+  {
+    using cfg::utils::chkerr;
+    using cfg::utils::read_extents;
+
+    /**
+     * The header and part table of a partitioned mesh file, as broadcast from rank 0.
+     */
+    struct MeshLayout
+    {
+      FileHeader header{};           // The file header
+      std::vector<PartEntry> table;  // The part table
+    };
+
+    /**
+     * Reads the header and part table of a partitioned mesh file.
+     *
+     * @param mesh_file The filepath to a partitioned mesh file.
+     * @returns The layout of the file.
+     */
+    [[nodiscard]] MeshLayout read_layout(const std::filesystem::path& mesh_file)
+    {
+      MeshLayout layout;
+      layout.header = read_header(mesh_file);
+
+      std::ifstream file{mesh_file, std::ios::in | std::ios::binary};
+      layout.table.resize(layout.header.n_parts);
+      file.seekg(static_cast<std::streamoff>(layout.header.table_offset));
+      // The table is read as raw bytes
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      file.read(reinterpret_cast<char*>(layout.table.data()),
+                static_cast<std::streamsize>(layout.table.size() * sizeof(PartEntry)));
+      if (!file)
+      {
+        throw std::runtime_error("Could not read the part table of " + mesh_file.string());
+      }
+
+      return layout;
+    }
+
+    /**
+     * Reads the layout of a partitioned mesh file on rank 0 and broadcasts it to all ranks. If rank 0
+     * fails to read the layout all ranks raise an error.
+     *
+     * @param mesh_file The filepath to a partitioned mesh file.
+     * @param comm      The communicator.
+     * @returns The layout of the file.
+     */
+    [[nodiscard]] MeshLayout broadcast_layout(const std::filesystem::path& mesh_file, MPI_Comm comm)
+    {
+      const auto parallel = cfg::utils::make_parallel(comm);
+
+      MeshLayout layout;
+      std::string error;
+      if (parallel.rank == 0)
+      {
+        try
+        {
+          layout = read_layout(mesh_file);
+        }
+        catch (const std::runtime_error& e)
+        {
+          error = e.what();
+        }
+      }
+
+      // Make sure no rank is left waiting on rank 0 if it failed
+      int ok = error.empty() ? 1 : 0;
+      chkerr(MPI_Bcast(&ok, 1, MPI_INT, 0, comm), "MPI_Bcast");
+      if (ok == 0)
+      {
+        throw std::runtime_error(parallel.rank == 0 ? error : "Rank 0 failed to read the partitioned mesh layout");
+      }
+
+      chkerr(MPI_Bcast(&layout.header, sizeof(FileHeader), MPI_BYTE, 0, comm), "MPI_Bcast");
+      layout.table.resize(layout.header.n_parts);
+      chkerr(MPI_Bcast(layout.table.data(),
+                       static_cast<int>(layout.table.size() * sizeof(PartEntry)),
+                       MPI_BYTE,
+                       0,
+                       comm),
+             "MPI_Bcast");
+
+      return layout;
+    }
+
+    /**
+     * Copies values from an array in a buffer of part data.
+     *
+     * @param data   The part data.
+     * @param offset The byte offset of the array in the part data.
+     * @param count  The number of values to copy.
+     * @param values The destination array.
+     * @param dst    The index of the first value to copy into in the destination array.
+     */
+    template <class A>
+    void unpack(const char* data, const uint64_t offset, const size_t count, A& values, const size_t dst)
+    {
+      if (count > 0)
+      {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+        std::memcpy(values.data() + dst, data + offset, count * sizeof(typename A::value_type));
+      }
+    }
+
+    /**
+     * Sizes a partitioned mesh to hold the given number of nodes, elements and element nodes.
+     *
+     * @param n_nodes        The number of nodes.
+     * @param n_elements     The number of elements.
+     * @param n_connectivity The number of element nodes.
+     * @returns The mesh.
+     */
+    [[nodiscard]] PartitionedMesh make_mesh(const size_t n_nodes, const size_t n_elements, const size_t n_connectivity)
+    {
+      PartitionedMesh mesh{cfg::parser::NodeSet<3>(n_nodes), {}};
+      mesh.elements.natural_idx.resize(n_elements);
+      mesh.elements.global_idx.resize(n_elements);
+      mesh.elements.type.resize(n_elements);
+      mesh.elements.offsets.resize(n_elements + 1);
+      mesh.elements.nodes.resize(n_connectivity);
+      return mesh;
+    }
+
+    /**
+     * Loads a range of neighbouring parts, merging them. The parts are contiguous in the file and
+     * are read with a single collective read.
+     *
+     * @param fh         The open file.
+     * @param layout     The layout of the file.
+     * @param assignment The parts assigned to this rank.
+     * @returns This rank's partition of the mesh.
+     */
+    [[nodiscard]] PartitionedMesh merge_parts(MPI_File fh, const MeshLayout& layout, const PartAssignment& assignment)
+    {
+      size_t n_nodes        = 0;
+      size_t n_elements     = 0;
+      size_t n_connectivity = 0;
+      uint64_t n_bytes      = 0;
+      for (auto part = assignment.first; part < assignment.first + assignment.count; part++)
+      {
+        const auto& entry = layout.table[part];
+        n_nodes += entry.n_nodes;
+        n_elements += entry.n_elements;
+        n_connectivity += entry.n_connectivity;
+        n_bytes += PartLayout{entry}.size;
+      }
+
+      std::vector<uint64_t> buf(n_bytes / sizeof(uint64_t));
+      if (buf.size() > INT_MAX)
+      {
+        throw std::runtime_error("Too much data to read collectively on a single rank");
+      }
+      const auto offset = (assignment.count > 0) ? layout.table[assignment.first].offset : 0;
+      chkerr(MPI_File_read_at_all(fh,
+                                  static_cast<MPI_Offset>(offset),
+                                  buf.data(),
+                                  static_cast<int>(buf.size()),
+                                  MPI_UINT64_T,
+                                  MPI_STATUS_IGNORE),
+             "MPI_File_read_at_all");
+
+      auto mesh = make_mesh(n_nodes, n_elements, n_connectivity);
+
+      // The buffer is interpreted as raw bytes
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+      const auto* data = reinterpret_cast<const char*>(buf.data());
+      size_t node      = 0;
+      size_t element   = 0;
+      size_t node_ctr  = 0;  // Counts the element nodes
+      for (auto part = assignment.first; part < assignment.first + assignment.count; part++)
+      {
+        const auto& entry = layout.table[part];
+        const PartLayout part_layout{entry};
+
+        unpack(data, part_layout.node_natural_idx, entry.n_nodes, mesh.nodes.natural_idx, node);
+        unpack(data, part_layout.node_global_idx, entry.n_nodes, mesh.nodes.global_idx, node);
+        for (size_t axis = 0; axis < 3; axis++)
+        {
+          unpack(data, part_layout.node_x[axis], entry.n_nodes, mesh.nodes.x[axis], node);
+        }
+
+        unpack(data, part_layout.element_natural_idx, entry.n_elements, mesh.elements.natural_idx, element);
+        unpack(data, part_layout.element_global_idx, entry.n_elements, mesh.elements.global_idx, element);
+        unpack(data, part_layout.element_type, entry.n_elements, mesh.elements.type, element);
+        unpack(data, part_layout.element_nodes, entry.n_connectivity, mesh.elements.nodes, node_ctr);
+
+        // The part's offsets start from zero, shift them to follow the preceding parts
+        unpack(data, part_layout.element_offsets, entry.n_elements + 1, mesh.elements.offsets, element);
+        for (size_t i = 0; i <= entry.n_elements; i++)
+        {
+          mesh.elements.offsets[element + i] += node_ctr;
+        }
+
+        node += entry.n_nodes;
+        element += entry.n_elements;
+        node_ctr += entry.n_connectivity;
+        data += part_layout.size;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      }
+
+      return mesh;
+    }
+
+    /**
+     * Loads a piece of a part, splitting the part's nodes and elements into contiguous ranges. The
+     * piece's ranges are read directly from each array of the part.
+     *
+     * @param fh         The open file.
+     * @param layout     The layout of the file.
+     * @param assignment The piece assigned to this rank.
+     * @returns This rank's partition of the mesh.
+     */
+    [[nodiscard]] PartitionedMesh split_part(MPI_File fh, const MeshLayout& layout, const PartAssignment& assignment)
+    {
+      const auto& entry = layout.table[assignment.first];
+      const PartLayout part_layout{entry};
+      const auto base = entry.offset;
+
+      const auto node_first    = entry.n_nodes * assignment.piece / assignment.n_pieces;
+      const auto n_nodes       = entry.n_nodes * (assignment.piece + 1) / assignment.n_pieces - node_first;
+      const auto element_first = entry.n_elements * assignment.piece / assignment.n_pieces;
+      const auto n_elements    = entry.n_elements * (assignment.piece + 1) / assignment.n_pieces - element_first;
+
+      // Describes the extent of a range of an array of the part
+      const auto extent = [base](const uint64_t offset, const uint64_t first, const size_t value_size) -> MPI_Aint
+      {
+        return static_cast<MPI_Aint>(base + offset + first * value_size);
+      };
+      const auto length = [](const uint64_t count) -> int
+      {
+        if (count > INT_MAX)
+        {
+          throw std::runtime_error("Too much data to read collectively on a single rank");
+        }
+        return static_cast<int>(count);
+      };
+
+      // Read the indices and element offsets
+      std::vector<uint64_t> indices(2 * n_nodes + 3 * n_elements + 1);
+      read_extents(fh,
+                   {extent(part_layout.node_natural_idx, node_first, sizeof(uint64_t)),
+                    extent(part_layout.node_global_idx, node_first, sizeof(uint64_t)),
+                    extent(part_layout.element_natural_idx, element_first, sizeof(uint64_t)),
+                    extent(part_layout.element_global_idx, element_first, sizeof(uint64_t)),
+                    extent(part_layout.element_offsets, element_first, sizeof(uint64_t))},
+                   {length(n_nodes), length(n_nodes), length(n_elements), length(n_elements), length(n_elements + 1)},
+                   indices);
+
+      // Read the coordinates and element types
+      std::vector<double> coords(3 * n_nodes);
+      read_extents(fh,
+                   {extent(part_layout.node_x[0], node_first, sizeof(double)),
+                    extent(part_layout.node_x[1], node_first, sizeof(double)),
+                    extent(part_layout.node_x[2], node_first, sizeof(double))},
+                   {length(n_nodes), length(n_nodes), length(n_nodes)},
+                   coords);
+      std::vector<int32_t> types(n_elements);
+      read_extents(fh, {extent(part_layout.element_type, element_first, sizeof(int32_t))}, {length(n_elements)}, types);
+
+      // Read the element nodes
+      const auto offsets        = 2 * n_nodes + 2 * n_elements;  // The position of the offsets in the indices
+      const auto conn_first     = indices[offsets];
+      const auto n_connectivity = indices[offsets + n_elements] - conn_first;
+      auto mesh                 = make_mesh(n_nodes, n_elements, n_connectivity);
+      read_extents(fh,
+                   {extent(part_layout.element_nodes, conn_first, sizeof(uint64_t))},
+                   {length(n_connectivity)},
+                   mesh.elements.nodes);
+
+      // Assemble the piece
+      for (size_t i = 0; i < n_nodes; i++)
+      {
+        mesh.nodes.natural_idx[i] = indices[i];
+        mesh.nodes.global_idx[i]  = indices[n_nodes + i];
+        for (size_t axis = 0; axis < 3; axis++)
+        {
+          mesh.nodes.x[axis][i] = coords[axis * n_nodes + i];
+        }
+      }
+      for (size_t i = 0; i < n_elements; i++)
+      {
+        mesh.elements.natural_idx[i] = indices[2 * n_nodes + i];
+        mesh.elements.global_idx[i]  = indices[2 * n_nodes + n_elements + i];
+        mesh.elements.type[i]        = types[i];
+      }
+      for (size_t i = 0; i <= n_elements; i++)
+      {
+        mesh.elements.offsets[i] = indices[offsets + i] - conn_first;
+      }
+
+      return mesh;
+    }
+  }  // namespace
+
+  PartAssignment assign_parts(const uint64_t n_parts, const cfg::utils::Parallel& parallel)
+  {
+    const uint64_t rank    = parallel.rank;
+    const uint64_t n_ranks = parallel.size;
+
+    PartAssignment assignment{};
+    if (n_parts >= n_ranks)
+    {
+      // Merge neighbouring parts
+      assignment.first    = rank * n_parts / n_ranks;
+      assignment.count    = (rank + 1) * n_parts / n_ranks - assignment.first;
+      assignment.piece    = 0;
+      assignment.n_pieces = 1;
+    }
+    else
+    {
+      // Split each part over neighbouring ranks, part p is split over the ranks [r0(p), r0(p + 1))
+      const auto first_rank = [n_parts, n_ranks](const uint64_t part) -> uint64_t
+      {
+        return (part * n_ranks + n_parts - 1) / n_parts;
+      };
+
+      assignment.first    = rank * n_parts / n_ranks;
+      assignment.count    = 1;
+      assignment.piece    = rank - first_rank(assignment.first);
+      assignment.n_pieces = first_rank(assignment.first + 1) - first_rank(assignment.first);
+    }
+
+    return assignment;
+  }
+
+  FileHeader read_header(const std::filesystem::path& mesh_file)
+  {
+    std::ifstream file{mesh_file, std::ios::in | std::ios::binary};
+
+    FileHeader header{};
+    // The header is read as raw bytes
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    file.read(reinterpret_cast<char*>(&header), sizeof(FileHeader));
+    if (!file || (header.magic != magic))
+    {
+      throw std::runtime_error(mesh_file.string() + " is not a partitioned mesh file");
+    }
+    if (header.byte_order != byte_order)
+    {
+      throw std::runtime_error(mesh_file.string() + " was written with a different byte order");
+    }
+    if ((header.version < 1) || (header.version > format_version))
+    {
+      throw std::runtime_error("Unsupported partitioned mesh format version: " + std::to_string(header.version));
+    }
+
+    return header;
+  }
+
+  PartitionedMesh read_mesh(const std::filesystem::path& mesh_file, MPI_Comm comm)
+  {
+    const auto parallel   = cfg::utils::make_parallel(comm);
+    const auto layout     = broadcast_layout(mesh_file, comm);
+    const auto assignment = assign_parts(layout.header.n_parts, parallel);
+
+    std::string path{mesh_file.string()};
+    MPI_File fh = MPI_FILE_NULL;
+    chkerr(MPI_File_open(comm, path.data(), MPI_MODE_RDONLY, MPI_INFO_NULL, &fh), "MPI_File_open");
+    auto mesh = (layout.header.n_parts >= parallel.size) ? merge_parts(fh, layout, assignment)
+                                                         : split_part(fh, layout, assignment);
+    chkerr(MPI_File_close(&fh), "MPI_File_close");
+
+    return mesh;
+  }
+
+  cfg::utils::Halo read_halo(const std::filesystem::path& mesh_file, MPI_Comm comm)
+  {
+    const auto parallel = cfg::utils::make_parallel(comm);
+    const auto layout   = broadcast_layout(mesh_file, comm);
+    if ((layout.header.version < 2) || (layout.header.halo_offset == 0))
+    {
+      throw std::runtime_error(mesh_file.string() + " has no halo");
+    }
+    if (layout.header.n_parts != parallel.size)
+    {
+      throw std::runtime_error("The halo of " + mesh_file.string() + " can only be loaded on the " +
+                               std::to_string(layout.header.n_parts) + " ranks that wrote it");
+    }
+
+    std::string path{mesh_file.string()};
+    MPI_File fh = MPI_FILE_NULL;
+    chkerr(MPI_File_open(comm, path.data(), MPI_MODE_RDONLY, MPI_INFO_NULL, &fh), "MPI_File_open");
+    HaloEntry entry{};
+    chkerr(MPI_File_read_at_all(fh,
+                                static_cast<MPI_Offset>(layout.header.halo_offset + parallel.rank * sizeof(HaloEntry)),
+                                &entry,
+                                sizeof(HaloEntry),
+                                MPI_BYTE,
+                                MPI_STATUS_IGNORE),
+           "MPI_File_read_at_all");
+    const HaloLayout halo_layout{entry};
+    std::vector<uint64_t> buf(halo_layout.size / sizeof(uint64_t));
+    if (buf.size() > INT_MAX)
+    {
+      throw std::runtime_error("Too much data to read collectively on a single rank");
+    }
+    chkerr(MPI_File_read_at_all(fh,
+                                static_cast<MPI_Offset>(entry.offset),
+                                buf.data(),
+                                static_cast<int>(buf.size()),
+                                MPI_UINT64_T,
+                                MPI_STATUS_IGNORE),
+           "MPI_File_read_at_all");
+    chkerr(MPI_File_close(&fh), "MPI_File_close");
+
+    // The buffer is interpreted as raw bytes
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    const auto* data = reinterpret_cast<const char*>(buf.data());
+
+    cfg::utils::Halo halo;
+    halo.depth = static_cast<unsigned int>(entry.depth);
+    halo.neighbours.resize(entry.n_neighbours);
+    unpack(data, halo_layout.neighbours, entry.n_neighbours, halo.neighbours, 0);
+
+    const auto& ghosts = halo_layout.ghosts;
+    auto mesh          = make_mesh(entry.n_nodes, entry.n_elements, entry.n_connectivity);
+    unpack(data, ghosts.node_natural_idx, entry.n_nodes, mesh.nodes.natural_idx, 0);
+    unpack(data, ghosts.node_global_idx, entry.n_nodes, mesh.nodes.global_idx, 0);
+    for (size_t axis = 0; axis < 3; axis++)
+    {
+      unpack(data, ghosts.node_x[axis], entry.n_nodes, mesh.nodes.x[axis], 0);
+    }
+    unpack(data, ghosts.element_natural_idx, entry.n_elements, mesh.elements.natural_idx, 0);
+    unpack(data, ghosts.element_global_idx, entry.n_elements, mesh.elements.global_idx, 0);
+    unpack(data, ghosts.element_type, entry.n_elements, mesh.elements.type, 0);
+    unpack(data, ghosts.element_offsets, entry.n_elements + 1, mesh.elements.offsets, 0);
+    unpack(data, ghosts.element_nodes, entry.n_connectivity, mesh.elements.nodes, 0);
+    halo.nodes    = std::move(mesh.nodes);
+    halo.elements = std::move(mesh.elements);
+
+    // Reads the pattern of an exchange
+    const auto unpack_pattern = [data, &entry](cfg::utils::HaloPattern& pattern,
+                                               const uint64_t send_offsets,
+                                               const uint64_t send_idx,
+                                               const uint64_t recv_offsets,
+                                               const uint64_t recv_idx,
+                                               const uint64_t n_recv)
+    {
+      pattern.send_offsets.resize(entry.n_neighbours + 1);
+      pattern.recv_offsets.resize(entry.n_neighbours + 1);
+      unpack(data, send_offsets, entry.n_neighbours + 1, pattern.send_offsets, 0);
+      unpack(data, recv_offsets, entry.n_neighbours + 1, pattern.recv_offsets, 0);
+      pattern.send_idx.resize(pattern.send_offsets.back());
+      pattern.recv_idx.resize(n_recv);
+      unpack(data, send_idx, pattern.send_idx.size(), pattern.send_idx, 0);
+      unpack(data, recv_idx, n_recv, pattern.recv_idx, 0);
+    };
+    unpack_pattern(halo.node_pattern,
+                   halo_layout.node_send_offsets,
+                   halo_layout.node_send_idx,
+                   halo_layout.node_recv_offsets,
+                   halo_layout.node_recv_idx,
+                   entry.n_nodes);
+    unpack_pattern(halo.element_pattern,
+                   halo_layout.element_send_offsets,
+                   halo_layout.element_send_idx,
+                   halo_layout.element_recv_offsets,
+                   halo_layout.element_recv_idx,
+                   entry.n_elements);
+
+    return halo;
+  }
+}  // namespace cfg::hpc
@@ -0,0 +1,265 @@
+/**
+ * hpc_writer.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <hpc_writer.h>
+
+#include <climits>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <mpi_utils.h>
+
+namespace cfg::hpc
+{
+  namespace
+  {
+    using cfg::utils::chkerr;
+
+    static_assert(sizeof(size_t) == sizeof(uint64_t), "Indices are written as 64-bit values");
+    static_assert(sizeof(int) == sizeof(int32_t), "Element types are written as 32-bit values");
+
+    /**
+     * Copies an array into a part's data buffer.
+     *
+     * @param buf    The part's data buffer.
+     * @param offset The offset of the array in the part, in bytes.
+     * @param values The array.
+     */
+    template <class A>
+    void pack(std::vector<uint64_t>& buf, const uint64_t offset, const A& values)
+    {
+      if (!values.empty())
+      {
+        // The buffer is written as raw bytes
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        std::memcpy(reinterpret_cast<char*>(buf.data()) + offset,
+                    values.data(),
+                    values.size() * sizeof(typename A::value_type));
+      }
+    }
+
+    /**
+     * Packs nodes and elements into a buffer laid out as a part.
+     *
+     * @param buf      The buffer.
+     * @param nodes    The nodes.
+     * @param elements The elements.
+     * @param layout   The layout of the part, relative to the start of the buffer.
+     */
+    void pack_mesh(std::vector<uint64_t>& buf,
+                   const cfg::parser::NodeSet<3>& nodes,
+                   const cfg::parser::ElementSet& elements,
+                   const PartLayout& layout)
+    {
+      pack(buf, layout.node_natural_idx, nodes.natural_idx);
+      pack(buf, layout.node_global_idx, nodes.global_idx);
+      for (size_t axis = 0; axis < 3; axis++)
+      {
+        pack(buf, layout.node_x[axis], nodes.x[axis]);
+      }
+      pack(buf, layout.element_natural_idx, elements.natural_idx);
+      pack(buf, layout.element_global_idx, elements.global_idx);
+      pack(buf, layout.element_type, elements.type);
+      pack(buf, layout.element_offsets, elements.offsets);
+      pack(buf, layout.element_nodes, elements.nodes);
+    }
+
+    /**
+     * Packs this rank's nodes and elements into a part's data buffer.
+     *
+     * @param nodes    The nodes held by this rank.
+     * @param elements The elements held by this rank.
+     * @param layout   The layout of the part.
+     * @returns The part's data.
+     */
+    [[nodiscard]] std::vector<uint64_t> pack_part(const cfg::parser::NodeSet<3>& nodes,
+                                                  const cfg::parser::ElementSet& elements,
+                                                  const PartLayout& layout)
+    {
+      std::vector<uint64_t> buf(layout.size / sizeof(uint64_t), 0);
+      pack_mesh(buf, nodes, elements, layout);
+
+      return buf;
+    }
+
+    /**
+     * Packs this rank's halo into a part's halo data buffer.
+     *
+     * @param halo   The halo of this rank.
+     * @param layout The layout of the part's halo data.
+     * @returns The part's halo data.
+     */
+    [[nodiscard]] std::vector<uint64_t> pack_halo(const cfg::utils::Halo& halo, const HaloLayout& layout)
+    {
+      std::vector<uint64_t> buf(layout.size / sizeof(uint64_t), 0);
+
+      pack(buf, layout.neighbours, halo.neighbours);
+      pack_mesh(buf, halo.nodes, halo.elements, layout.ghosts);
+      pack(buf, layout.node_send_offsets, halo.node_pattern.send_offsets);
+      pack(buf, layout.node_send_idx, halo.node_pattern.send_idx);
+      pack(buf, layout.node_recv_offsets, halo.node_pattern.recv_offsets);
+      pack(buf, layout.node_recv_idx, halo.node_pattern.recv_idx);
+      pack(buf, layout.element_send_offsets, halo.element_pattern.send_offsets);
+      pack(buf, layout.element_send_idx, halo.element_pattern.send_idx);
+      pack(buf, layout.element_recv_offsets, halo.element_pattern.recv_offsets);
+      pack(buf, layout.element_recv_idx, halo.element_pattern.recv_idx);
+
+      return buf;
+    }
+
+    /**
+     * Writes a table of entries, one per rank, on rank 0 and each rank's data collectively.
+     *
+     * @param fh           The open file.
+     * @param table_offset The offset of the table in the file.
+     * @param entry        This rank's entry of the table.
+     * @param data_offset  The offset of this rank's data in the file.
+     * @param buf          This rank's data.
+     * @param comm         The communicator.
+     */
+    template <class E>
+    void write_table_and_data(MPI_File fh,
+                              const uint64_t table_offset,
+                              const E& entry,
+                              const uint64_t data_offset,
+                              const std::vector<uint64_t>& buf,
+                              MPI_Comm comm)
+    {
+      const auto parallel = cfg::utils::make_parallel(comm);
+
+      // The table is assembled on rank 0
+      constexpr int entry_words = sizeof(E) / sizeof(uint64_t);
+      std::vector<E> table((parallel.rank == 0) ? parallel.size : 0);
+      chkerr(MPI_Gather(&entry, entry_words, MPI_UINT64_T, table.data(), entry_words, MPI_UINT64_T, 0, comm),
+             "MPI_Gather");
+      if (parallel.rank == 0)
+      {
+        chkerr(MPI_File_write_at(fh,
+                                 static_cast<MPI_Offset>(table_offset),
+                                 table.data(),
+                                 static_cast<int>(table.size() * sizeof(E)),
+                                 MPI_BYTE,
+                                 MPI_STATUS_IGNORE),
+               "MPI_File_write_at");
+      }
+
+      if (buf.size() > INT_MAX)
+      {
+        throw std::runtime_error("Too much data to write collectively on a single rank");
+      }
+      chkerr(MPI_File_write_at_all(fh,
+                                   static_cast<MPI_Offset>(data_offset),
+                                   buf.data(),
+                                   static_cast<int>(buf.size()),
+                                   MPI_UINT64_T,
+                                   MPI_STATUS_IGNORE),
+             "MPI_File_write_at_all");
+    }
+
+    /**
+     * Writes a partitioned mesh with an optional halo, see `write_mesh`.
+     */
+    void write_parts(const std::filesystem::path& mesh_file,
+                     const cfg::parser::NodeSet<3>& nodes,
+                     const cfg::parser::ElementSet& elements,
+                     const cfg::utils::Halo* halo,
+                     MPI_Comm comm)
+    {
+      const auto parallel = cfg::utils::make_parallel(comm);
+
+      // Describe this rank's part, its offset follows the parts of the preceding ranks
+      PartEntry entry{};
+      entry.n_nodes        = nodes.size();
+      entry.n_elements     = elements.size();
+      entry.n_connectivity = elements.nodes.size();
+      const PartLayout layout{entry};
+
+      chkerr(MPI_Exscan(&layout.size, &entry.offset, 1, MPI_UINT64_T, MPI_SUM, comm), "MPI_Exscan");
+      if (parallel.rank == 0)
+      {
+        entry.offset = 0;  // Undefined on the first rank
+      }
+
+      FileHeader header{};
+      header.magic        = magic;
+      header.version      = format_version;
+      header.byte_order   = byte_order;
+      header.n_parts      = parallel.size;
+      header.n_nodes      = entry.n_nodes;
+      header.n_elements   = entry.n_elements;
+      header.table_offset = sizeof(FileHeader);
+      header.data_offset  = header.table_offset + header.n_parts * sizeof(PartEntry);
+      chkerr(MPI_Allreduce(MPI_IN_PLACE, &header.n_nodes, 1, MPI_UINT64_T, MPI_SUM, comm), "MPI_Allreduce");
+      chkerr(MPI_Allreduce(MPI_IN_PLACE, &header.n_elements, 1, MPI_UINT64_T, MPI_SUM, comm), "MPI_Allreduce");
+      entry.offset += header.data_offset;
+
+      uint64_t file_size = entry.offset + layout.size;
+      chkerr(MPI_Allreduce(MPI_IN_PLACE, &file_size, 1, MPI_UINT64_T, MPI_MAX, comm), "MPI_Allreduce");
+
+      // The halo follows the parts, its data follows the halo table in the same way
+      HaloEntry halo_entry{};
+      if (halo != nullptr)
+      {
+        halo_entry.depth          = halo->depth;
+        halo_entry.n_neighbours   = halo->neighbours.size();
+        halo_entry.n_nodes        = halo->nodes.size();
+        halo_entry.n_elements     = halo->elements.size();
+        halo_entry.n_connectivity = halo->elements.nodes.size();
+        halo_entry.n_node_send    = halo->node_pattern.send_idx.size();
+        halo_entry.n_element_send = halo->element_pattern.send_idx.size();
+        const HaloLayout halo_layout{halo_entry};
+
+        chkerr(MPI_Exscan(&halo_layout.size, &halo_entry.offset, 1, MPI_UINT64_T, MPI_SUM, comm), "MPI_Exscan");
+        if (parallel.rank == 0)
+        {
+          halo_entry.offset = 0;  // Undefined on the first rank
+        }
+        header.halo_offset = file_size;
+        halo_entry.offset += header.halo_offset + header.n_parts * sizeof(HaloEntry);
+
+        file_size = halo_entry.offset + halo_layout.size;
+        chkerr(MPI_Allreduce(MPI_IN_PLACE, &file_size, 1, MPI_UINT64_T, MPI_MAX, comm), "MPI_Allreduce");
+      }
+
+      std::string path{mesh_file.string()};
+      MPI_File fh = MPI_FILE_NULL;
+      chkerr(MPI_File_open(comm, path.data(), MPI_MODE_CREATE | MPI_MODE_WRONLY, MPI_INFO_NULL, &fh),
+             "MPI_File_open");
+      chkerr(MPI_File_set_size(fh, static_cast<MPI_Offset>(file_size)), "MPI_File_set_size");
+      if (parallel.rank == 0)
+      {
+        chkerr(MPI_File_write_at(fh, 0, &header, sizeof(FileHeader), MPI_BYTE, MPI_STATUS_IGNORE),
+               "MPI_File_write_at");
+      }
+      write_table_and_data(fh, header.table_offset, entry, entry.offset, pack_part(nodes, elements, layout), comm);
+      if (halo != nullptr)
+      {
+        const auto buf = pack_halo(*halo, HaloLayout{halo_entry});
+        write_table_and_data(fh, header.halo_offset, halo_entry, halo_entry.offset, buf, comm);
+      }
+      chkerr(MPI_File_close(&fh), "MPI_File_close");
+    }
+  }  // namespace
+
+  void write_mesh(const std::filesystem::path& mesh_file,
+                  const cfg::parser::NodeSet<3>& nodes,
+                  const cfg::parser::ElementSet& elements,
+                  MPI_Comm comm)
+  {
+    write_parts(mesh_file, nodes, elements, nullptr, comm);
+  }
+
+  void write_mesh(const std::filesystem::path& mesh_file,
+                  const cfg::parser::NodeSet<3>& nodes,
+                  const cfg::parser::ElementSet& elements,
+                  const cfg::utils::Halo& halo,
+                  MPI_Comm comm)
+  {
+    write_parts(mesh_file, nodes, elements, &halo, comm);
+  }
+}  // namespace cfg::hpc
@@ -0,0 +1,238 @@
+/**
+ * instrument.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <instrument.h>
+
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include <string>
+
+#include <mpi_utils.h>
+
+namespace cfg::utils
+{
+  namespace
+  {
+    constexpr std::array<std::string_view, n_phases> phase_names{"detect_format",
+                                                                 "read_header",
+                                                                 "section_search",
+                                                                 "header_parse",
+                                                                 "data_parse",
+                                                                 "partition_filter",
+                                                                 "validation"};
+
+    constexpr std::array<std::string_view, n_counters> counter_names{
+        "bytes_scanned", "bytes_read", "tokens_parsed", "blocks", "nodes", "elements"};
+
+    /**
+     * Reduces values over the ranks, each value is reduced independently.
+     *
+     * @param values The values on this rank.
+     * @param comm   The communicator.
+     * @returns The statistics of each value.
+     */
+    [[nodiscard]] std::vector<Stats> reduce_stats(const std::vector<double>& values, MPI_Comm comm)
+    {
+      int size = 0;
+      chkerr(MPI_Comm_size(comm, &size), "MPI_Comm_size");
+
+      const auto n = static_cast<int>(values.size());
+      std::vector<double> min(values.size());
+      std::vector<double> max(values.size());
+      std::vector<double> sum(values.size());
+      chkerr(MPI_Allreduce(values.data(), min.data(), n, MPI_DOUBLE, MPI_MIN, comm), "MPI_Allreduce");
+      chkerr(MPI_Allreduce(values.data(), max.data(), n, MPI_DOUBLE, MPI_MAX, comm), "MPI_Allreduce");
+      chkerr(MPI_Allreduce(values.data(), sum.data(), n, MPI_DOUBLE, MPI_SUM, comm), "MPI_Allreduce");
+
+      std::vector<Stats> stats(values.size());
+      for (size_t i = 0; i < values.size(); i++)
+      {
+        stats[i] = Stats{min[i], max[i], sum[i] / size};
+      }
+
+      return stats;
+    }
+
+    /**
+     * Writes the statistics of a value as a JSON object.
+     */
+    void write_stats(std::ostream& os, const Stats& stats)
+    {
+      os << R"({"min": )" << stats.min << R"(, "max": )" << stats.max << R"(, "mean": )" << stats.mean << "}";
+    }
+
+    /**
+     * Writes the value of each rank as a JSON array.
+     */
+    template <class F>
+    void write_ranks(std::ostream& os, const std::vector<Profile>& ranks, const F& value)
+    {
+      os << "[";
+      for (size_t rank = 0; rank < ranks.size(); rank++)
+      {
+        os << ((rank == 0) ? "" : ", ") << value(ranks[rank]);
+      }
+      os << "]";
+    }
+  }  // namespace
+
+  std::string_view phase_name(const Phase phase)
+  {
+    return phase_names.at(static_cast<size_t>(phase));
+  }
+
+  std::string_view counter_name(const Counter counter)
+  {
+    return counter_names.at(static_cast<size_t>(counter));
+  }
+
+  Profile profile()
+  {
+    Profile local;
+    for (size_t i = 0; i < n_phases; i++)
+    {
+      local.seconds[i] = static_cast<double>(instrument::nanoseconds[i].load(std::memory_order_relaxed)) * 1.0e-9;
+      local.calls[i]   = instrument::calls[i].load(std::memory_order_relaxed);
+    }
+    for (size_t i = 0; i < n_counters; i++)
+    {
+      local.counts[i] = instrument::counts[i].load(std::memory_order_relaxed);
+    }
+
+    return local;
+  }
+
+  void reset_profile()
+  {
+    for (size_t i = 0; i < n_phases; i++)
+    {
+      instrument::nanoseconds[i].store(0, std::memory_order_relaxed);
+      instrument::calls[i].store(0, std::memory_order_relaxed);
+    }
+    for (auto& counter : instrument::counts)
+    {
+      counter.store(0, std::memory_order_relaxed);
+    }
+  }
+
+  ProfileReport reduce_profile(const Profile& local, MPI_Comm comm, const int root)
+  {
+    int rank = 0;
+    int size = 0;
+    chkerr(MPI_Comm_rank(comm, &rank), "MPI_Comm_rank");
+    chkerr(MPI_Comm_size(comm, &size), "MPI_Comm_size");
+
+    // The phase times are followed by the counters
+    std::vector<double> values(local.seconds.begin(), local.seconds.end());
+    for (const auto count : local.counts)
+    {
+      values.push_back(static_cast<double>(count));
+    }
+    const auto stats = reduce_stats(values, comm);
+
+    ProfileReport report;
+    std::copy_n(stats.begin(), n_phases, report.seconds.begin());
+    std::copy_n(stats.begin() + n_phases, n_counters, report.counts.begin());
+
+    // The profile is trivially copyable, so it is gathered as bytes
+    if (rank == root)
+    {
+      report.ranks.resize(static_cast<size_t>(size));
+    }
+    chkerr(MPI_Gather(&local,
+                      sizeof(Profile),
+                      MPI_BYTE,
+                      report.ranks.data(),
+                      sizeof(Profile),
+                      MPI_BYTE,
+                      root,
+                      comm),
+           "MPI_Gather");
+
+    return report;
+  }
+
+  void write_profile_table(std::ostream& os, const ProfileReport& report)
+  {
+    const auto flags     = os.flags();
+    const auto precision = os.precision();
+
+    os << std::left << std::setw(18) << "phase" << std::right << std::setw(12) << "min [s]" << std::setw(12)
+       << "max [s]" << std::setw(12) << "mean [s]" << "\n";
+    os << std::fixed << std::setprecision(6);
+    for (size_t i = 0; i < n_phases; i++)
+    {
+      const auto& stats = report.seconds[i];
+      os << std::left << std::setw(18) << phase_names[i] << std::right << std::setw(12) << stats.min
+         << std::setw(12) << stats.max << std::setw(12) << stats.mean << "\n";
+    }
+
+    os << std::left << std::setw(18) << "counter" << std::right << std::setw(12) << "min" << std::setw(12) << "max"
+       << std::setw(12) << "mean" << "\n";
+    os << std::setprecision(0);
+    for (size_t i = 0; i < n_counters; i++)
+    {
+      const auto& stats = report.counts[i];
+      os << std::left << std::setw(18) << counter_names[i] << std::right << std::setw(12) << stats.min
+         << std::setw(12) << stats.max << std::setw(12) << stats.mean << "\n";
+    }
+
+    os.flags(flags);
+    os.precision(precision);
+  }
+
+  void write_profile_json(std::ostream& os, const ProfileReport& report)
+  {
+    const auto precision = os.precision();
+    os << std::setprecision(std::numeric_limits<double>::max_digits10);
+
+    os << "{\n";
+    os << R"(  "n_ranks": )" << report.ranks.size() << ",\n";
+
+    os << R"(  "phases": {)";
+    for (size_t i = 0; i < n_phases; i++)
+    {
+      os << ((i == 0) ? "\n" : ",\n") << R"(    ")" << phase_names[i] << R"(": {"stats": )";
+      write_stats(os, report.seconds[i]);
+      os << R"(, "ranks": )";
+      write_ranks(os,
+                  report.ranks,
+                  [i](const Profile& rank) -> double
+                  {
+                    return rank.seconds[i];
+                  });
+      os << R"(, "calls": )";
+      write_ranks(os,
+                  report.ranks,
+                  [i](const Profile& rank) -> uint64_t
+                  {
+                    return rank.calls[i];
+                  });
+      os << "}";
+    }
+    os << "\n  },\n";
+
+    os << R"(  "counters": {)";
+    for (size_t i = 0; i < n_counters; i++)
+    {
+      os << ((i == 0) ? "\n" : ",\n") << R"(    ")" << counter_names[i] << R"(": {"stats": )";
+      write_stats(os, report.counts[i]);
+      os << R"(, "ranks": )";
+      write_ranks(os,
+                  report.ranks,
+                  [i](const Profile& rank) -> uint64_t
+                  {
+                    return rank.counts[i];
+                  });
+      os << "}";
+    }
+    os << "\n  }\n";
+    os << "}\n";
+
+    os.precision(precision);
+  }
+}  // namespace cfg::utils
@@ -4,14 +4,23 @@
 
 #include <sysexits.h>
 
+#include <algorithm>
+#include <fstream>
 #include <iostream>
+#include <optional>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 #include "utils.h"
 
 #include <mpi.h>
 
 #include <detect_format.h>
+#include <halo.h>
+#include <hpc_reader.h>
+#include <hpc_writer.h>
+#include <instrument.h>
+#include <mesh_partition.h>
 #include <node_parser.h>
 #include <reader.h>
 #include <section_reader.h>
@@ -45,16 +54,385 @@
   return args;
 }
 
-void read_mesh(const std::filesystem::path& mesh_file, const cfg::utils::Parallel& parallel)
+/**
+ * Checks that each optional argument is a known flag, raising an error otherwise. A flag ending in
+ * `=` takes a value and matches any argument it prefixes, other flags must match exactly.
+ *
+ * @param args The vector of argument strings, the first is the mesh file.
+ */
+void check_args(const std::vector<std::string>& args)
+{
+  const std::vector<std::string> known_flags{"--io=",
+                                             "--output=",
+                                             "--index",
+                                             "--threads=",
+                                             "--profile",
+                                             "--profile=",
+                                             "--validate=",
+                                             "--partition",
+                                             "--partition=",
+                                             "--halo",
+                                             "--halo="};
+
+  for (size_t i = 1; i < args.size(); i++)
+  {
+    const auto known = std::any_of(known_flags.begin(),
+                                   known_flags.end(),
+                                   [&arg = args[i]](const std::string& flag) -> bool
+                                   {
+                                     return (flag.back() == '=') ? (arg.rfind(flag, 0) == 0) : (arg == flag);
+                                   });
+    if (!known)
+    {
+      throw std::runtime_error("Unknown argument: " + args[i]);
+    }
+  }
+}
+
+/**
+ * Determines the I/O backend from the optional arguments, selected by `--io=stream|mmap|mpiio|async`.
+ *
+ * @param args The vector of argument strings, the first is the mesh file.
+ * @returns    The I/O backend, by default `MMAP`.
+ */
+[[nodiscard]] cfg::reader::Backend get_backend(const std::vector<std::string>& args)
+{
+  const std::string flag{"--io="};
+
+  auto backend = cfg::reader::Backend::MMAP;
+  for (size_t i = 1; i < args.size(); i++)
+  {
+    if (args[i].rfind(flag, 0) != 0)
+    {
+      continue;
+    }
+
+    const auto name = args[i].substr(flag.size());
+    if (name == "stream")
+    {
+      backend = cfg::reader::Backend::STREAM;
+    }
+    else if (name == "mmap")
+    {
+      backend = cfg::reader::Backend::MMAP;
+    }
+    else if (name == "mpiio")
+    {
+      backend = cfg::reader::Backend::MPIIO;
+    }
+    else if (name == "async")
+    {
+      backend = cfg::reader::Backend::ASYNC;
+    }
+    else
+    {
+      throw std::runtime_error("Unknown I/O backend: " + name);
+    }
+  }
+
+  return backend;
+}
+
+/**
+ * Determines the output file from the optional arguments, given by `--output=<file>`.
+ *
+ * @param args The vector of argument strings, the first is the mesh file.
+ * @returns    The file to write the partitioned mesh to, empty if the mesh is not written.
+ */
+[[nodiscard]] std::filesystem::path get_output(const std::vector<std::string>& args)
+{
+  const std::string flag{"--output="};
+
+  std::filesystem::path output;
+  for (size_t i = 1; i < args.size(); i++)
+  {
+    if (args[i].rfind(flag, 0) == 0)
+    {
+      output = args[i].substr(flag.size());
+    }
+  }
+
+  return output;
+}
+
+/**
+ * Determines whether the sidecar index of a GMSH file is used from the optional arguments, enabled
+ * by `--index`.
+ *
+ * @param args The vector of argument strings, the first is the mesh file.
+ * @returns    Whether the sidecar index is used, by default `false`.
+ */
+[[nodiscard]] bool get_use_index(const std::vector<std::string>& args)
+{
+  for (size_t i = 1; i < args.size(); i++)
+  {
+    if (args[i] == "--index")
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+/**
+ * Determines the number of threads each rank uses from the optional arguments, given by
+ * `--threads=<n>`.
+ *
+ * @param args The vector of argument strings, the first is the mesh file.
+ * @returns    The number of threads, by default 1.
+ */
+[[nodiscard]] unsigned int get_n_threads(const std::vector<std::string>& args)
+{
+  const std::string flag{"--threads="};
+
+  unsigned int n_threads = 1;
+  for (size_t i = 1; i < args.size(); i++)
+  {
+    if (args[i].rfind(flag, 0) == 0)
+    {
+      const auto value = std::stoi(args[i].substr(flag.size()));
+      if (value < 1)
+      {
+        throw std::runtime_error("The number of threads must be positive: " + args[i]);
+      }
+      n_threads = static_cast<unsigned int>(value);
+    }
+  }
+
+  return n_threads;
+}
+
+/**
+ * Determines how thoroughly the nodes read are validated from the optional arguments, selected by
+ * `--validate=global|local|trust`.
+ *
+ * @param args The vector of argument strings, the first is the mesh file.
+ * @returns    The validation, by default `GLOBAL`.
+ */
+[[nodiscard]] cfg::parser::Validation get_validation(const std::vector<std::string>& args)
+{
+  const std::string flag{"--validate="};
+
+  auto validation = cfg::parser::Validation::GLOBAL;
+  for (size_t i = 1; i < args.size(); i++)
+  {
+    if (args[i].rfind(flag, 0) != 0)
+    {
+      continue;
+    }
+
+    const auto name = args[i].substr(flag.size());
+    if (name == "global")
+    {
+      validation = cfg::parser::Validation::GLOBAL;
+    }
+    else if (name == "local")
+    {
+      validation = cfg::parser::Validation::LOCAL;
+    }
+    else if (name == "trust")
+    {
+      validation = cfg::parser::Validation::TRUST;
+    }
+    else
+    {
+      throw std::runtime_error("Unknown validation: " + name);
+    }
+  }
+
+  return validation;
+}
+
+/**
+ * Determines whether the mesh is repartitioned after reading from the optional arguments, enabled by
+ * `--partition` with the default partitioner or by `--partition=parmetis|scotch|geometric`.
+ *
+ * @param args The vector of argument strings, the first is the mesh file.
+ * @returns    The partitioner, empty if the mesh is not repartitioned.
+ */
+[[nodiscard]] std::optional<cfg::utils::Partitioner> get_partitioner(const std::vector<std::string>& args)
+{
+  const std::string flag{"--partition="};
+
+  std::optional<cfg::utils::Partitioner> partitioner;
+  for (size_t i = 1; i < args.size(); i++)
+  {
+    if (args[i] == "--partition")
+    {
+      partitioner = cfg::utils::default_partitioner();
+    }
+    else if (args[i].rfind(flag, 0) == 0)
+    {
+      partitioner = cfg::utils::partitioner_by_name(args[i].substr(flag.size()));
+    }
+  }
+
+  return partitioner;
+}
+
+/**
+ * Determines whether the halo of the mesh is built from the optional arguments, enabled by `--halo`
+ * with the default depth or by `--halo=<depth>` giving the number of layers of ghost cells.
+ *
+ * @param args The vector of argument strings, the first is the mesh file.
+ * @returns    The depth of the halo, empty if the halo is not built.
+ */
+[[nodiscard]] std::optional<unsigned int> get_halo_depth(const std::vector<std::string>& args)
+{
+  const std::string flag{"--halo="};
+
+  std::optional<unsigned int> depth;
+  for (size_t i = 1; i < args.size(); i++)
+  {
+    if (args[i] == "--halo")
+    {
+      depth = cfg::utils::default_halo_depth;
+    }
+    else if (args[i].rfind(flag, 0) == 0)
+    {
+      const auto value = std::stoi(args[i].substr(flag.size()));
+      if (value < 0)
+      {
+        throw std::runtime_error("The halo depth must not be negative: " + args[i]);
+      }
+      depth = static_cast<unsigned int>(value);
+    }
+  }
+
+  return depth;
+}
+
+/**
+ * Determines whether reading the mesh is profiled from the optional arguments, enabled by
+ * `--profile` or by `--profile=<file>` which also writes the profile to a JSON file.
+ *
+ * @param args The vector of argument strings, the first is the mesh file.
+ * @returns    Whether the mesh reading is profiled, and the JSON file which is empty if the profile
+ *             is not written.
+ */
+[[nodiscard]] std::pair<bool, std::filesystem::path> get_profile(const std::vector<std::string>& args)
 {
+  const std::string flag{"--profile="};
+
+  bool enabled = false;
+  std::filesystem::path json;
+  for (size_t i = 1; i < args.size(); i++)
+  {
+    if (args[i] == "--profile")
+    {
+      enabled = true;
+    }
+    else if (args[i].rfind(flag, 0) == 0)
+    {
+      enabled = true;
+      json    = args[i].substr(flag.size());
+    }
+  }
+
+  return {enabled, json};
+}
+
+/**
+ * Reports the profile of reading the mesh: rank 0 prints the statistics of each phase and counter
+ * over the ranks and optionally writes every rank's profile to a JSON file.
+ *
+ * @param parallel The parallel environment.
+ * @param json     The JSON file, empty if the profile is not written.
+ */
+void report_profile(const cfg::utils::Parallel& parallel, const std::filesystem::path& json)
+{
+  const auto report = cfg::utils::reduce_profile(cfg::utils::profile(), MPI_COMM_WORLD);
+  if (parallel.rank != 0)
+  {
+    return;
+  }
+
+  std::cout << "Profile over " << parallel.size << " ranks:" << std::endl;
+  cfg::utils::write_profile_table(std::cout, report);
+  if (!json.empty())
+  {
+    std::ofstream json_stream{json};
+    cfg::utils::write_profile_json(json_stream, report);
+    if (!json_stream)
+    {
+      throw std::runtime_error("Couldn't write the profile to " + json.string());
+    }
+    std::cout << "Profile written to " << json << std::endl;
+  }
+}
+
+void read_mesh(const std::filesystem::path& mesh_file,
+               const cfg::utils::Parallel& parallel,
+               const cfg::reader::Backend backend,
+               const std::filesystem::path& output,
+               const bool use_index,
+               const cfg::parser::Validation validation,
+               const std::optional<cfg::utils::Partitioner>& partitioner,
+               const std::optional<unsigned int>& halo_depth)
+{
+  const auto write_mesh = [&output, &halo_depth, &parallel](const auto& nodes, const auto& elements)
+  {
+    if (!halo_depth)
+    {
+      if (!output.empty())
+      {
+        std::cout << "Writing partitioned mesh file: " << output << std::endl;
+        cfg::hpc::write_mesh(output, nodes, elements, MPI_COMM_WORLD);
+      }
+      return;
+    }
+
+    if (parallel.rank == 0)
+    {
+      std::cout << "+ Building halo of depth " << *halo_depth << std::endl;
+    }
+    const auto halo = cfg::utils::build_halo(nodes, elements, *halo_depth, MPI_COMM_WORLD);
+    std::cout << "++ Rank " << parallel.rank << " has " << halo.nodes.size() << " ghost nodes and "
+              << halo.elements.size() << " ghost elements from " << halo.neighbours.size() << " neighbours"
+              << std::endl;
+    if (!output.empty())
+    {
+      std::cout << "Writing partitioned mesh file: " << output << std::endl;
+      cfg::hpc::write_mesh(output, nodes, elements, halo, MPI_COMM_WORLD);
+    }
+  };
+  const auto repartition = [&write_mesh, &partitioner, &parallel](const auto& nodes, const auto& elements)
+  {
+    if (!partitioner)
+    {
+      write_mesh(nodes, elements);
+      return;
+    }
+
+    if (parallel.rank == 0)
+    {
+      std::cout << "+ Partitioning mesh" << std::endl;
+    }
+    const auto mesh = cfg::utils::partition_mesh(nodes, elements, MPI_COMM_WORLD, *partitioner, &std::cout);
+    std::cout << "++ Rank " << parallel.rank << " owns " << mesh.nodes.size() << " nodes and "
+              << mesh.elements.size() << " elements" << std::endl;
+    write_mesh(mesh.nodes, mesh.elements);
+  };
+
   std::cout << "Reading mesh file: " << mesh_file << std::endl;
-  if (cfg::reader::FormatDetector::get_format(mesh_file) == cfg::reader::MeshFormat::GMSH)
+  const auto format = cfg::reader::FormatDetector::get_format(mesh_file);
+  if (format == cfg::reader::MeshFormat::GMSH)
+  {
+    cfg::reader::GmshReader reader(mesh_file, parallel, backend, MPI_COMM_WORLD, use_index, validation);
+    repartition(reader.nodes(), reader.elements());
+  }
+  else if (format == cfg::reader::MeshFormat::PARTITIONED)
   {
-    cfg::reader::GmshReader reader(mesh_file, parallel);
+    std::cout << "+ Loading partitioned mesh" << std::endl;
+    const auto mesh = cfg::hpc::read_mesh(mesh_file, MPI_COMM_WORLD);
+    std::cout << "++ Rank " << parallel.rank << " loaded " << mesh.nodes.size() << " nodes and "
+              << mesh.elements.size() << " elements" << std::endl;
+    repartition(mesh.nodes, mesh.elements);
   }
   else
   {
-    throw std::runtime_error("CFGrid only supports reading GMSH files currently");
+    throw std::runtime_error("CFGrid cannot read this mesh format");
   }
 }
 
@@ -75,7 +453,7 @@ int main(int argc, char* argv[])
   ierr                = MPI_Init(&argc, &argv); chkerr(ierr);
   ierr                = MPI_Comm_size(MPI_COMM_WORLD, &size); chkerr(ierr);
   ierr                = MPI_Comm_rank(MPI_COMM_WORLD, &rank); chkerr(ierr);
-  const auto parallel = [rank, size]() -> cfg::utils::Parallel
+  auto parallel       = [rank, size]() -> cfg::utils::Parallel
   {
     cfg::utils::Parallel parallel{};
     parallel.rank = rank;
@@ -85,9 +463,23 @@ int main(int argc, char* argv[])
 
   // Parse args
   const auto args = get_argvector(argc, argv);
+  check_args(args);
+  parallel.n_threads = get_n_threads(args);
   std::filesystem::path mesh_file(args[0]);
+  const auto backend     = get_backend(args);
+  const auto output      = get_output(args);
+  const auto use_index   = get_use_index(args);
+  const auto validation  = get_validation(args);
+  const auto partitioner = get_partitioner(args);
+  const auto halo_depth  = get_halo_depth(args);
 
-  read_mesh(mesh_file, parallel);
+  const auto [profile, profile_json] = get_profile(args);
+  cfg::utils::set_profiling(profile);
+  read_mesh(mesh_file, parallel, backend, output, use_index, validation, partitioner, halo_depth);
+  if (profile)
+  {
+    report_profile(parallel, profile_json);
+  }
 
   ierr = MPI_Finalize(); chkerr(ierr);
 
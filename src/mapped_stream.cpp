@@ -0,0 +1,62 @@
+/**
+ * mapped_stream.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <mapped_stream.h>
+
+namespace cfg::reader
+{
+  MappedFile::MappedFile(const std::filesystem::path& path)
+  {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg,hicpp-vararg)
+    const int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+      throw mapping_error{"Could not open " + path.string() + " for mapping"};
+    }
+
+    struct stat status
+    {
+    };
+    if (fstat(fd, &status) != 0)
+    {
+      close(fd);
+      throw mapping_error{"Could not determine the size of " + path.string()};
+    }
+    length = static_cast<size_t>(status.st_size);
+
+    // Mapping an empty file is an error, however an empty view is valid
+    if (length > 0)
+    {
+      void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (mapping == MAP_FAILED)  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+      {
+        close(fd);
+        throw mapping_error{"Could not map " + path.string()};
+      }
+
+      // Meshes are (mostly) read front-to-back, this is only a hint so failure is not an error
+      (void)madvise(mapping, length, MADV_SEQUENTIAL);
+      addr = static_cast<const char*>(mapping);
+    }
+
+    // The mapping remains valid after closing the file
+    close(fd);
+  }
+
+  MappedFile::~MappedFile()
+  {
+    if (addr != nullptr)
+    {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-type-const-cast)
+      munmap(const_cast<char*>(addr), length);
+    }
+  }
+}  // namespace cfg::reader
@@ -0,0 +1,394 @@
+/**
+ * mesh_index.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <mesh_index.h>
+
+#include <instrument.h>
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+#include <vector>
+
+namespace cfg::reader
+{
+  namespace
+  {
+    /**
+     * Identifies an index file.
+     */
+    constexpr std::array<char, 8> index_magic{'C', 'F', 'G', 'I', 'N', 'D', 'E', 'X'};
+
+    /**
+     * The version of the index file format, incremented whenever the recorded layout changes.
+     */
+    constexpr uint32_t index_version = 1;
+
+    /**
+     * The byte order marker, as written by the writer.
+     */
+    constexpr uint32_t index_byte_order = 0x01020304;
+
+    /**
+     * The number of samples of the file contents that are hashed, and the size of each sample.
+     */
+    constexpr uint64_t n_samples   = 64;
+    constexpr uint64_t sample_size = uint64_t{1} << 14U;
+
+    /**
+     * Accumulates bytes into a 64-bit FNV-1a hash.
+     *
+     * @param hash  The hash so far.
+     * @param bytes The bytes to hash.
+     * @returns The updated hash.
+     */
+    [[nodiscard]] uint64_t fnv1a(uint64_t hash, const std::string_view bytes)
+    {
+      constexpr uint64_t prime = 0x100000001b3;
+      for (const auto byte : bytes)
+      {
+        hash ^= static_cast<unsigned char>(byte);
+        hash *= prime;
+      }
+
+      return hash;
+    }
+
+    /**
+     * Serialises the index into a byte buffer, values are stored in the byte order of the writer.
+     */
+    class IndexWriter
+    {
+     public:
+      template <class T>
+      void put(const T val)
+      {
+        static_assert(std::is_trivially_copyable_v<T>);
+        const auto pos = buf.size();
+        buf.resize(pos + sizeof(T));
+        std::memcpy(&buf[pos], &val, sizeof(T));
+      }
+
+      void put(const std::string& str)
+      {
+        put<uint64_t>(str.size());
+        buf += str;
+      }
+
+      [[nodiscard]] const std::string& bytes() const
+      {
+        return buf;
+      }
+
+     private:
+      std::string buf;  // The serialised index
+    };
+
+    /**
+     * Deserialises the index from a byte buffer, raising an error if the buffer is too short.
+     */
+    class IndexParser
+    {
+     public:
+      explicit IndexParser(const std::string_view bytes) : bytes(bytes) {}
+
+      template <class T>
+      [[nodiscard]] T get()
+      {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T val{};
+        std::memcpy(&val, take(sizeof(T)).data(), sizeof(T));
+        return val;
+      }
+
+      [[nodiscard]] std::string get_string()
+      {
+        return std::string{take(get<uint64_t>())};
+      }
+
+      [[nodiscard]] bool done() const
+      {
+        return pos == bytes.size();
+      }
+
+     private:
+      std::string_view bytes;  // The serialised index
+      size_t pos{};            // The current position in the bytes
+
+      [[nodiscard]] std::string_view take(const size_t count)
+      {
+        if (count > (bytes.size() - pos))
+        {
+          throw std::runtime_error("The index file is truncated");
+        }
+        const auto taken = bytes.substr(pos, count);
+        pos += count;
+        return taken;
+      }
+    };
+
+    /**
+     * Serialises the layout of a node block.
+     */
+    void put_block(IndexWriter& writer, const cfg::parser::NodeBlock& block)
+    {
+      writer.put<int32_t>(block.dim);
+      writer.put<int32_t>(block.tag);
+      writer.put<uint8_t>(block.parametric ? 1 : 0);
+      writer.put<uint64_t>(block.n_nodes);
+      writer.put<uint64_t>(block.first);
+      writer.put<uint64_t>(block.tags_offset);
+      writer.put<uint64_t>(block.coords_offset);
+    }
+
+    /**
+     * Serialises the layout of an element block.
+     */
+    void put_block(IndexWriter& writer, const cfg::parser::ElementBlock& block)
+    {
+      writer.put<int32_t>(block.dim);
+      writer.put<int32_t>(block.tag);
+      writer.put<int32_t>(block.type);
+      writer.put<uint64_t>(block.n_elements);
+      writer.put<uint64_t>(block.first);
+      writer.put<uint64_t>(block.offset);
+    }
+
+    /**
+     * Deserialises the layout of a node block.
+     */
+    void get_block(IndexParser& parser, cfg::parser::NodeBlock& block)
+    {
+      block.dim           = parser.get<int32_t>();
+      block.tag           = parser.get<int32_t>();
+      block.parametric    = (parser.get<uint8_t>() != 0);
+      block.n_nodes       = parser.get<uint64_t>();
+      block.first         = parser.get<uint64_t>();
+      block.tags_offset   = parser.get<uint64_t>();
+      block.coords_offset = parser.get<uint64_t>();
+    }
+
+    /**
+     * Deserialises the layout of an element block.
+     */
+    void get_block(IndexParser& parser, cfg::parser::ElementBlock& block)
+    {
+      block.dim        = parser.get<int32_t>();
+      block.tag        = parser.get<int32_t>();
+      block.type       = parser.get<int32_t>();
+      block.n_elements = parser.get<uint64_t>();
+      block.first      = parser.get<uint64_t>();
+      block.offset     = parser.get<uint64_t>();
+    }
+
+    /**
+     * Serialises the blocks of a node or element layout, followed by the end of the data.
+     */
+    template <class L>
+    void put_layout(IndexWriter& writer, const L& layout)
+    {
+      writer.put<uint64_t>(layout.blocks.size());
+      for (const auto& block : layout.blocks)
+      {
+        put_block(writer, block);
+      }
+      writer.put<uint64_t>(layout.end);
+    }
+
+    /**
+     * Deserialises the blocks of a node or element layout, followed by the end of the data.
+     */
+    template <class L>
+    void get_layout(IndexParser& parser, L& layout)
+    {
+      layout.blocks.resize(parser.get<uint64_t>());
+      for (auto& block : layout.blocks)
+      {
+        get_block(parser, block);
+      }
+      layout.end = parser.get<uint64_t>();
+    }
+  }  // namespace
+
+  FileKey file_key(const std::filesystem::path& mesh_file)
+  {
+    FileKey key;
+    key.size  = std::filesystem::file_size(mesh_file);
+    key.mtime = static_cast<int64_t>(std::filesystem::last_write_time(mesh_file).time_since_epoch().count());
+
+    std::ifstream mesh_stream{mesh_file, std::ios::in | std::ios::binary};
+    if (!mesh_stream)
+    {
+      throw std::runtime_error("Couldn't open mesh file " + mesh_file.string());
+    }
+
+    constexpr uint64_t fnv_offset = 0xcbf29ce484222325;
+    key.hash                      = fnv_offset;
+    std::string sample;
+    if (key.size <= (n_samples * sample_size))
+    {
+      sample.assign(std::istreambuf_iterator<char>{mesh_stream}, std::istreambuf_iterator<char>{});
+      key.hash = fnv1a(key.hash, sample);
+    }
+    else
+    {
+      // The first sample is at the start of the file and the last at the end
+      sample.resize(sample_size);
+      for (uint64_t i = 0; i < n_samples; i++)
+      {
+        const auto offset = ((key.size - sample_size) / (n_samples - 1)) * i;
+        mesh_stream.seekg(static_cast<std::streamoff>((i + 1 == n_samples) ? (key.size - sample_size) : offset));
+        mesh_stream.read(sample.data(), static_cast<std::streamsize>(sample_size));
+        key.hash = fnv1a(key.hash, sample);
+      }
+    }
+
+    return key;
+  }
+
+  std::filesystem::path index_path(const std::filesystem::path& mesh_file)
+  {
+    auto index_file = mesh_file;
+    index_file += ".cfgidx";
+    return index_file;
+  }
+
+  bool write_index(const std::filesystem::path& index_file, const FileKey& key, const MeshIndex& index)
+  {
+    IndexWriter writer;
+    for (const auto c : index_magic)
+    {
+      writer.put<char>(c);
+    }
+    writer.put<uint32_t>(index_version);
+    writer.put<uint32_t>(index_byte_order);
+    writer.put<uint64_t>(key.size);
+    writer.put<int64_t>(key.mtime);
+    writer.put<uint64_t>(key.hash);
+
+    writer.put<uint64_t>(index.sections.sections().size());
+    for (const auto& [name, section] : index.sections.sections())
+    {
+      writer.put(name);
+      writer.put<uint64_t>(section.start);
+      writer.put<uint64_t>(section.end);
+    }
+
+    writer.put<uint64_t>(index.node_header.n_nodes);
+    writer.put<uint64_t>(index.node_header.n_blocks);
+    writer.put<uint64_t>(index.node_header.min_tag);
+    writer.put<uint64_t>(index.node_header.max_tag);
+    put_layout(writer, index.nodes);
+
+    writer.put<uint64_t>(index.element_header.n_elements);
+    writer.put<uint64_t>(index.element_header.n_blocks);
+    writer.put<uint64_t>(index.element_header.min_tag);
+    writer.put<uint64_t>(index.element_header.max_tag);
+    put_layout(writer, index.elements);
+
+    // Write under a temporary name then rename, so a reader only ever sees a complete index
+    auto tmp_file = index_file;
+    tmp_file += ".tmp";
+    {
+      std::ofstream index_stream{tmp_file, std::ios::out | std::ios::binary | std::ios::trunc};
+      index_stream.write(writer.bytes().data(), static_cast<std::streamsize>(writer.bytes().size()));
+      if (!index_stream)
+      {
+        std::error_code ec;
+        std::filesystem::remove(tmp_file, ec);
+        return false;
+      }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmp_file, index_file, ec);
+    if (ec)
+    {
+      std::filesystem::remove(tmp_file, ec);
+      return false;
+    }
+
+    return true;
+  }
+
+  std::optional<MeshIndex> read_index(const std::filesystem::path& index_file, const FileKey& key)
+  {
+    const cfg::utils::ScopedTimer timer{cfg::utils::Phase::SECTION_SEARCH};
+
+    std::ifstream index_stream{index_file, std::ios::in | std::ios::binary};
+    if (!index_stream)
+    {
+      return std::nullopt;
+    }
+    const std::string bytes{std::istreambuf_iterator<char>{index_stream}, std::istreambuf_iterator<char>{}};
+
+    try
+    {
+      IndexParser parser{bytes};
+      for (const auto c : index_magic)
+      {
+        if (parser.get<char>() != c)
+        {
+          return std::nullopt;
+        }
+      }
+      if ((parser.get<uint32_t>() != index_version) || (parser.get<uint32_t>() != index_byte_order))
+      {
+        return std::nullopt;
+      }
+
+      FileKey index_key;
+      index_key.size  = parser.get<uint64_t>();
+      index_key.mtime = parser.get<int64_t>();
+      index_key.hash  = parser.get<uint64_t>();
+      if (!(index_key == key))
+      {
+        return std::nullopt;  // The index is stale
+      }
+
+      std::vector<std::pair<std::string, SectionIndex::Section>> sections(parser.get<uint64_t>());
+      for (auto& [name, section] : sections)
+      {
+        name          = parser.get_string();
+        section.start = parser.get<uint64_t>();
+        section.end   = parser.get<uint64_t>();
+      }
+
+      MeshIndex index;
+      index.sections = SectionIndex{std::move(sections)};
+
+      index.node_header.n_nodes  = parser.get<uint64_t>();
+      index.node_header.n_blocks = parser.get<uint64_t>();
+      index.node_header.min_tag  = parser.get<uint64_t>();
+      index.node_header.max_tag  = parser.get<uint64_t>();
+      get_layout(parser, index.nodes);
+
+      index.element_header.n_elements = parser.get<uint64_t>();
+      index.element_header.n_blocks   = parser.get<uint64_t>();
+      index.element_header.min_tag    = parser.get<uint64_t>();
+      index.element_header.max_tag    = parser.get<uint64_t>();
+      get_layout(parser, index.elements);
+
+      if (!parser.done())
+      {
+        return std::nullopt;
+      }
+
+      return index;
+    }
+    catch (const std::exception&)
+    {
+      // A corrupt index, e.g. with an implausible block count, is treated as missing
+      return std::nullopt;
+    }
+  }
+}  // namespace cfg::reader
@@ -0,0 +1,465 @@
+/**
+ * mesh_partition.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <mesh_partition.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+
+#ifdef CFG_HAVE_PARMETIS
+#include <parmetis.h>
+#endif
+#ifdef CFG_HAVE_PTSCOTCH
+#include <cstdio>  // Required by ptscotch.h
+
+#include <ptscotch.h>
+#endif
+
+#include <directory.h>
+#include <geometric_partition.h>
+#include <graph_partition.h>
+#include <migration.h>
+#include <mpi_utils.h>
+
+namespace cfg::utils
+{
+  namespace
+  {
+    /**
+     * Computes the centroid of each cell, gathering the coordinates of its nodes from the ranks
+     * holding them. This must be called collectively.
+     *
+     * @param graph    The dual graph of the elements.
+     * @param nodes    The nodes held by this rank.
+     * @param elements The elements held by this rank.
+     * @param comm     The communicator.
+     * @returns The centroids, identified by the global vertex index of their cell.
+     */
+    [[nodiscard]] cfg::parser::NodeSet<3> cell_centroids(const DualGraph& graph,
+                                                         const cfg::parser::NodeSet<3>& nodes,
+                                                         const cfg::parser::ElementSet& elements,
+                                                         MPI_Comm comm)
+    {
+      using Coordinates = std::array<double, 3>;
+
+      std::vector<DirectoryEntry<Coordinates>> entries(nodes.size());
+      for (size_t i = 0; i < nodes.size(); i++)
+      {
+        entries[i] = DirectoryEntry<Coordinates>{nodes.natural_idx[i], {nodes.x[0][i], nodes.x[1][i], nodes.x[2][i]}};
+      }
+      const auto directory = publish(
+          entries,
+          [](const Coordinates& a, const Coordinates& /* b */) -> Coordinates
+          {
+            return a;
+          },
+          comm);
+
+      std::vector<size_t> tags;
+      for (const auto cell : graph.cells)
+      {
+        const auto [first, last] = elements.connectivity(cell);
+        tags.insert(tags.end(), first, last);
+      }
+      constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+      const auto coordinates = lookup(directory, tags, Coordinates{nan, nan, nan}, comm);
+
+      int missing = std::any_of(coordinates.begin(),
+                                coordinates.end(),
+                                [](const Coordinates& x) -> bool
+                                {
+                                  return std::isnan(x[0]);
+                                })
+                        ? 1
+                        : 0;
+      chkerr(MPI_Allreduce(MPI_IN_PLACE, &missing, 1, MPI_INT, MPI_MAX, comm), "MPI_Allreduce");
+      if (missing != 0)
+      {
+        throw std::runtime_error("An element refers to a node that was not read");
+      }
+
+      const auto first_vertex = graph.vtxdist[make_parallel(comm).rank];
+      cfg::parser::NodeSet<3> centroids(graph.size());
+      size_t next = 0;
+      for (size_t v = 0; v < graph.size(); v++)
+      {
+        const auto cell    = graph.cells[v];
+        const auto n_nodes = elements.n_nodes(cell);
+        for (size_t axis = 0; axis < 3; axis++)
+        {
+          double sum = 0.0;
+          for (size_t j = 0; j < n_nodes; j++)
+          {
+            sum += coordinates[next + j][axis];
+          }
+          centroids.x[axis][v] = sum / static_cast<double>(n_nodes);
+        }
+        centroids.natural_idx[v] = elements.natural_idx[cell];
+        centroids.global_idx[v]  = first_vertex + v;
+        next += n_nodes;
+      }
+
+      return centroids;
+    }
+
+#if defined(CFG_HAVE_PARMETIS) || defined(CFG_HAVE_PTSCOTCH)
+    /**
+     * Checks that the global vertex indices and the local edge count of the dual graph fit the index
+     * type of a graph partitioning library. The check is collective, so that every rank raises the
+     * error if the graph of any rank is too large.
+     *
+     * @tparam T      The index type of the library.
+     * @param graph   The dual graph.
+     * @param library The name of the library, reported in the error.
+     * @param comm    The communicator.
+     */
+    template <class T>
+    void check_index_range(const DistributedGraph& graph, const std::string& library, MPI_Comm comm)
+    {
+      const auto max = static_cast<uint64_t>(std::numeric_limits<T>::max());
+      int fits       = ((graph.global_size() <= max) && (graph.adjacency.size() <= max)) ? 1 : 0;
+      chkerr(MPI_Allreduce(MPI_IN_PLACE, &fits, 1, MPI_INT, MPI_MIN, comm), "MPI_Allreduce");
+      if (fits == 0)
+      {
+        throw std::runtime_error("Dual graph too large for the index type of " + library);
+      }
+    }
+#endif
+
+#ifdef CFG_HAVE_PARMETIS
+    /**
+     * Partitions the dual graph with `ParMETIS_V3_PartKway`, every rank must hold a vertex.
+     */
+    [[nodiscard]] std::vector<int> parmetis_partition(const DistributedGraph& graph, MPI_Comm comm)
+    {
+      const auto n_ranks = make_parallel(comm).size;
+      check_index_range<idx_t>(graph, "ParMETIS", comm);
+
+      std::vector<idx_t> vtxdist(graph.vtxdist.begin(), graph.vtxdist.end());
+      std::vector<idx_t> xadj(graph.offsets.begin(), graph.offsets.end());
+      std::vector<idx_t> adjncy(graph.adjacency.begin(), graph.adjacency.end());
+      adjncy.reserve(1);  // ParMETIS requires a valid array when a rank's vertices have no neighbours
+      idx_t wgtflag = 0;  // No weights
+      idx_t numflag = 0;  // C numbering
+      idx_t ncon    = 1;
+      auto nparts   = static_cast<idx_t>(n_ranks);
+      std::vector<real_t> tpwgts(n_ranks, static_cast<real_t>(1.0 / n_ranks));
+      auto ubvec = static_cast<real_t>(1.0 + default_tolerance);
+      std::array<idx_t, 3> options{0, 0, 0};
+      idx_t edgecut = 0;
+      std::vector<idx_t> part(graph.size());
+
+      const auto status = ParMETIS_V3_PartKway(vtxdist.data(),
+                                               xadj.data(),
+                                               adjncy.data(),
+                                               nullptr,
+                                               nullptr,
+                                               &wgtflag,
+                                               &numflag,
+                                               &ncon,
+                                               &nparts,
+                                               tpwgts.data(),
+                                               &ubvec,
+                                               options.data(),
+                                               &edgecut,
+                                               part.data(),
+                                               &comm);
+      if (status != METIS_OK)
+      {
+        throw std::runtime_error("ParMETIS_V3_PartKway failed");
+      }
+
+      return std::vector<int>(part.begin(), part.end());
+    }
+#endif
+
+#ifdef CFG_HAVE_PTSCOTCH
+    /**
+     * Partitions the dual graph with `SCOTCH_dgraphPart` and the default strategy.
+     */
+    [[nodiscard]] std::vector<int> scotch_partition(const DistributedGraph& graph, MPI_Comm comm)
+    {
+      const auto n_ranks = make_parallel(comm).size;
+      check_index_range<SCOTCH_Num>(graph, "PT-Scotch", comm);
+
+      std::vector<SCOTCH_Num> vertloctab(graph.offsets.begin(), graph.offsets.end());
+      std::vector<SCOTCH_Num> edgeloctab(graph.adjacency.begin(), graph.adjacency.end());
+      edgeloctab.reserve(1);  // A valid array is required when a rank's vertices have no neighbours
+      std::vector<SCOTCH_Num> partloctab(std::max<size_t>(graph.size(), 1));
+      const auto n_vertices = static_cast<SCOTCH_Num>(graph.size());
+      const auto n_edges    = static_cast<SCOTCH_Num>(graph.adjacency.size());
+
+      SCOTCH_Dgraph dgraph;
+      if (SCOTCH_dgraphInit(&dgraph, comm) != 0)
+      {
+        throw std::runtime_error("SCOTCH_dgraphInit failed");
+      }
+      SCOTCH_Strat strategy;
+      SCOTCH_stratInit(&strategy);
+
+      auto status = SCOTCH_dgraphBuild(&dgraph,
+                                       0,
+                                       n_vertices,
+                                       n_vertices,
+                                       vertloctab.data(),
+                                       vertloctab.data() + 1,
+                                       nullptr,
+                                       nullptr,
+                                       n_edges,
+                                       n_edges,
+                                       edgeloctab.data(),
+                                       nullptr,
+                                       nullptr);
+
+      // Partitioning is collective, every rank must have built its part of the graph to take part
+      int built = (status == 0) ? 1 : 0;
+      chkerr(MPI_Allreduce(MPI_IN_PLACE, &built, 1, MPI_INT, MPI_MIN, comm), "MPI_Allreduce");
+      if (built != 0)
+      {
+        status = SCOTCH_dgraphPart(&dgraph, static_cast<SCOTCH_Num>(n_ranks), &strategy, partloctab.data());
+      }
+      SCOTCH_stratExit(&strategy);
+      SCOTCH_dgraphExit(&dgraph);
+      if (built == 0)
+      {
+        throw std::runtime_error("SCOTCH_dgraphBuild failed");
+      }
+      if (status != 0)
+      {
+        throw std::runtime_error("SCOTCH_dgraphPart failed");
+      }
+
+      return std::vector<int>(partloctab.begin(), partloctab.begin() + static_cast<std::ptrdiff_t>(graph.size()));
+    }
+#endif
+  }  // namespace
+
+  bool partitioner_available(const Partitioner partitioner)
+  {
+    switch (partitioner)
+    {
+    case Partitioner::PARMETIS:
+#ifdef CFG_HAVE_PARMETIS
+      return true;
+#else
+      return false;
+#endif
+    case Partitioner::SCOTCH:
+#ifdef CFG_HAVE_PTSCOTCH
+      return true;
+#else
+      return false;
+#endif
+    default:
+      return true;
+    }
+  }
+
+  Partitioner default_partitioner()
+  {
+    for (const auto partitioner : {Partitioner::PARMETIS, Partitioner::SCOTCH})
+    {
+      if (partitioner_available(partitioner))
+      {
+        return partitioner;
+      }
+    }
+
+    return Partitioner::GEOMETRIC;
+  }
+
+  Partitioner partitioner_by_name(const std::string& name)
+  {
+    if (name == "parmetis")
+    {
+      return Partitioner::PARMETIS;
+    }
+    if (name == "scotch")
+    {
+      return Partitioner::SCOTCH;
+    }
+    if (name == "geometric")
+    {
+      return Partitioner::GEOMETRIC;
+    }
+
+    throw std::runtime_error("Unknown partitioner: " + name);
+  }
+
+  std::string partitioner_name(const Partitioner partitioner)
+  {
+    switch (partitioner)
+    {
+    case Partitioner::PARMETIS:
+      return "parmetis";
+    case Partitioner::SCOTCH:
+      return "scotch";
+    default:
+      return "geometric";
+    }
+  }
+
+  CellPartition::CellPartition(const DualGraph& graph,
+                               const cfg::parser::NodeSet<3>& nodes,
+                               const cfg::parser::ElementSet& elements,
+                               MPI_Comm comm,
+                               const Partitioner partitioner)
+      : used(partitioner)
+  {
+    if (!partitioner_available(partitioner))
+    {
+      throw std::runtime_error("CFGrid was built without the " + partitioner_name(partitioner) + " partitioner");
+    }
+
+    const auto parallel = make_parallel(comm);
+    const auto n_ranks  = static_cast<size_t>(parallel.size);
+
+    // ParMETIS fails if a rank holds no vertices
+    if (used == Partitioner::PARMETIS)
+    {
+      uint64_t min_size = graph.size();
+      chkerr(MPI_Allreduce(MPI_IN_PLACE, &min_size, 1, mpi_type<uint64_t>(), MPI_MIN, comm), "MPI_Allreduce");
+      if (min_size == 0)
+      {
+        used = Partitioner::GEOMETRIC;
+      }
+    }
+
+    if (used == Partitioner::PARMETIS)
+    {
+#ifdef CFG_HAVE_PARMETIS
+      cell_destinations = parmetis_partition(graph, comm);
+#endif
+    }
+    else if (used == Partitioner::SCOTCH)
+    {
+#ifdef CFG_HAVE_PTSCOTCH
+      cell_destinations = scotch_partition(graph, comm);
+#endif
+    }
+    else
+    {
+      const RCBPartition rcb{cell_centroids(graph, nodes, elements, comm), comm};
+      cell_destinations = rcb.destinations();
+    }
+
+    std::vector<uint64_t> counts(n_ranks, 0);
+    for (const auto dst : cell_destinations)
+    {
+      counts[static_cast<size_t>(dst)]++;
+    }
+    chkerr(MPI_Allreduce(MPI_IN_PLACE, counts.data(), static_cast<int>(n_ranks), mpi_type<uint64_t>(), MPI_SUM, comm),
+           "MPI_Allreduce");
+    const auto n_total = std::accumulate(counts.begin(), counts.end(), uint64_t{0});
+    const auto n_max   = *std::max_element(counts.begin(), counts.end());
+    load_imbalance = (n_total == 0) ? 1.0 : static_cast<double>(n_max * n_ranks) / static_cast<double>(n_total);
+
+    // Send the global indices of the cells to their destination ranks
+    std::vector<size_t> global_idx(graph.size());
+    std::iota(global_idx.begin(), global_idx.end(), graph.vtxdist[parallel.rank]);
+    owned = send_to_ranks(
+        global_idx,
+        [this, &graph, &parallel](const size_t idx) -> int
+        {
+          return cell_destinations[idx - graph.vtxdist[parallel.rank]];
+        },
+        comm);
+    std::sort(owned.begin(), owned.end());
+  }
+
+  bool CellPartition::pick(const size_t idx) const
+  {
+    return std::binary_search(owned.begin(), owned.end(), idx);
+  }
+
+  void CellPartition::report(std::ostream& os) const
+  {
+    os << "++ Partitioner: " << partitioner_name(used) << "\n";
+    os << "++ Partition imbalance: " << load_imbalance << "\n";
+  }
+
+  cfg::hpc::PartitionedMesh migrate_mesh(const cfg::parser::NodeSet<3>& nodes,
+                                         const cfg::parser::ElementSet& elements,
+                                         const DualGraph& graph,
+                                         const CellPartition& partition,
+                                         MPI_Comm comm)
+  {
+    const auto rank = static_cast<int>(make_parallel(comm).rank);
+
+    // Each node is owned by the lowest ranked owner of the cells containing it
+    std::vector<int> element_owners(elements.size(), -1);
+    std::vector<DirectoryEntry<int>> claims;
+    for (size_t v = 0; v < graph.size(); v++)
+    {
+      const auto cell      = graph.cells[v];
+      const auto owner     = partition.destinations()[v];
+      element_owners[cell] = owner;
+      const auto [first, last] = elements.connectivity(cell);
+      std::for_each(first,
+                    last,
+                    [&claims, owner](const size_t tag)
+                    {
+                      claims.push_back(DirectoryEntry<int>{tag, owner});
+                    });
+    }
+    const auto directory = publish(
+        claims,
+        [](const int a, const int b) -> int
+        {
+          return std::min(a, b);
+        },
+        comm);
+    claims = std::vector<DirectoryEntry<int>>{};
+
+    // The nodes, followed by the first node of each lower dimensional element, query their owners
+    std::vector<size_t> tags(nodes.natural_idx.begin(), nodes.natural_idx.end());
+    for (size_t i = 0; i < elements.size(); i++)
+    {
+      if (element_owners[i] < 0)
+      {
+        tags.push_back(elements.nodes[elements.offsets[i]]);
+      }
+    }
+    const auto owners = lookup(directory, tags, -1, comm);
+    std::vector<int> node_owners(nodes.size());
+    for (size_t i = 0; i < nodes.size(); i++)
+    {
+      node_owners[i] = (owners[i] < 0) ? rank : owners[i];
+    }
+    for (size_t i = 0, next = nodes.size(); i < elements.size(); i++)
+    {
+      if (element_owners[i] < 0)
+      {
+        element_owners[i] = (owners[next] < 0) ? rank : owners[next];
+        next++;
+      }
+    }
+
+    return migrate_mesh(nodes, node_owners, elements, element_owners, comm);
+  }
+
+  cfg::hpc::PartitionedMesh partition_mesh(const cfg::parser::NodeSet<3>& nodes,
+                                           const cfg::parser::ElementSet& elements,
+                                           MPI_Comm comm,
+                                           const Partitioner partitioner,
+                                           std::ostream* os)
+  {
+    const auto graph = build_dual_graph(elements, comm);
+    const CellPartition partition{graph, nodes, elements, comm, partitioner};
+    if ((os != nullptr) && (make_parallel(comm).rank == 0))
+    {
+      partition.report(*os);
+    }
+
+    return migrate_mesh(nodes, elements, graph, partition, comm);
+  }
+}  // namespace cfg::utils
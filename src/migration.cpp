@@ -0,0 +1,233 @@
+/**
+ * migration.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <migration.h>
+
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <stdexcept>
+
+#include <mpi_utils.h>
+
+namespace cfg::utils
+{
+  namespace
+  {
+    constexpr size_t node_words     = 5;   // The words of a node: its natural and global indices and coordinates
+    constexpr size_t element_header = 3;   // The words preceding an element's nodes
+    constexpr unsigned int type_bits = 32;  // The bits of the element header word holding the type
+
+    /**
+     * Checks that there is an owner rank for each item on every rank, this must be called collectively
+     * so that every rank raises the error.
+     */
+    void check_owners(const std::vector<int>& owners, const size_t n_items, MPI_Comm comm)
+    {
+      const auto n_ranks = static_cast<int>(make_parallel(comm).size);
+      int invalid        = ((owners.size() != n_items) || std::any_of(owners.begin(),
+                                                                owners.end(),
+                                                                [n_ranks](const int owner) -> bool
+                                                                {
+                                                                  return (owner < 0) || (owner >= n_ranks);
+                                                                }))
+                               ? 1
+                               : 0;
+      chkerr(MPI_Allreduce(MPI_IN_PLACE, &invalid, 1, MPI_INT, MPI_MAX, comm), "MPI_Allreduce");
+      if (invalid != 0)
+      {
+        throw std::runtime_error("Every item migrated requires a valid owner rank");
+      }
+    }
+
+    /**
+     * Checks that a number of words fits the `int` counts of `MPI_Alltoallv`.
+     */
+    [[nodiscard]] int word_count(const size_t n_words)
+    {
+      if (n_words > INT_MAX)
+      {
+        throw std::runtime_error("Too many values to migrate to a single rank");
+      }
+
+      return static_cast<int>(n_words);
+    }
+
+    /**
+     * Orders the items received by their global index.
+     *
+     * @param words  The words received.
+     * @param starts The position of each item in the words.
+     * @returns The item placed at each local index.
+     */
+    [[nodiscard]] std::vector<size_t> by_global_idx(const std::vector<uint64_t>& words,
+                                                    const std::vector<size_t>& starts)
+    {
+      std::vector<size_t> order(starts.size());
+      std::iota(order.begin(), order.end(), 0);
+      std::sort(order.begin(),
+                order.end(),
+                [&words, &starts](const size_t a, const size_t b) -> bool
+                {
+                  return words[starts[a] + 1] < words[starts[b] + 1];
+                });
+
+      return order;
+    }
+
+    /**
+     * Packs a coordinate into a word, bit for bit.
+     */
+    [[nodiscard]] inline uint64_t to_word(const double x)
+    {
+      uint64_t word = 0;
+      std::memcpy(&word, &x, sizeof(word));
+      return word;
+    }
+
+    /**
+     * Unpacks a coordinate from a word, bit for bit.
+     */
+    [[nodiscard]] inline double from_word(const uint64_t word)
+    {
+      double x = 0.0;
+      std::memcpy(&x, &word, sizeof(x));
+      return x;
+    }
+  }  // namespace
+
+  cfg::parser::NodeSet<3> migrate_nodes(const cfg::parser::NodeSet<3>& nodes,
+                                        const std::vector<int>& owners,
+                                        MPI_Comm comm)
+  {
+    check_owners(owners, nodes.size(), comm);
+    const auto n_ranks = static_cast<size_t>(make_parallel(comm).size);
+
+    // Pack the nodes in the order of their owners
+    const auto items = route(owners, n_ranks);
+    std::vector<int> send_counts(n_ranks);
+    for (size_t rank = 0; rank < n_ranks; rank++)
+    {
+      send_counts[rank] = word_count(static_cast<size_t>(items.counts[rank]) * node_words);
+    }
+    std::vector<uint64_t> send(nodes.size() * node_words);
+    for (size_t k = 0; k < nodes.size(); k++)
+    {
+      const auto i     = items.order[k];
+      auto* const word = &send[k * node_words];
+      // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      word[0] = nodes.natural_idx[i];
+      word[1] = nodes.global_idx[i];
+      for (size_t axis = 0; axis < 3; axis++)
+      {
+        word[2 + axis] = to_word(nodes.x[axis][i]);
+      }
+      // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    std::vector<int> recv_counts;
+    auto recv = exchange(send, send_counts, comm, recv_counts);
+    send      = std::vector<uint64_t>{};
+
+    // Unpack the nodes directly to their local index
+    std::vector<size_t> starts(recv.size() / node_words);
+    for (size_t j = 0; j < starts.size(); j++)
+    {
+      starts[j] = j * node_words;
+    }
+    const auto order = by_global_idx(recv, starts);
+    cfg::parser::NodeSet<3> migrated(order.size());
+    for (size_t k = 0; k < order.size(); k++)
+    {
+      const auto* const word = &recv[starts[order[k]]];
+      // NOLINTBEGIN(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      migrated.natural_idx[k] = word[0];
+      migrated.global_idx[k]  = word[1];
+      for (size_t axis = 0; axis < 3; axis++)
+      {
+        migrated.x[axis][k] = from_word(word[2 + axis]);
+      }
+      // NOLINTEND(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    }
+
+    return migrated;
+  }
+
+  cfg::parser::ElementSet migrate_elements(const cfg::parser::ElementSet& elements,
+                                           const std::vector<int>& owners,
+                                           MPI_Comm comm)
+  {
+    check_owners(owners, elements.size(), comm);
+    const auto n_ranks = static_cast<size_t>(make_parallel(comm).size);
+
+    // Pack the elements in the order of their owners, each followed by its nodes
+    const auto items = route(owners, n_ranks);
+    std::vector<size_t> n_words(n_ranks, 0);
+    for (size_t i = 0; i < elements.size(); i++)
+    {
+      n_words[static_cast<size_t>(owners[i])] += element_header + elements.n_nodes(i);
+    }
+    std::vector<int> send_counts(n_ranks);
+    std::transform(n_words.begin(), n_words.end(), send_counts.begin(), word_count);
+    n_words = std::vector<size_t>{};
+
+    std::vector<uint64_t> send(elements.size() * element_header + elements.nodes.size());
+    auto next = send.begin();
+    for (const auto i : items.order)
+    {
+      const auto [first, last] = elements.connectivity(i);
+      *next++ = elements.natural_idx[i];
+      *next++ = elements.global_idx[i];
+      *next++ = (static_cast<uint64_t>(elements.n_nodes(i)) << type_bits) | static_cast<uint32_t>(elements.type[i]);
+      next    = std::copy(first, last, next);
+    }
+
+    std::vector<int> recv_counts;
+    auto recv = exchange(send, send_counts, comm, recv_counts);
+    send      = std::vector<uint64_t>{};
+
+    // Locate the elements received and unpack them in the order of their local index
+    std::vector<size_t> starts;
+    for (size_t start = 0; start < recv.size(); start += element_header + (recv[start + 2] >> type_bits))
+    {
+      starts.push_back(start);
+    }
+    const auto order = by_global_idx(recv, starts);
+
+    cfg::parser::ElementSet migrated;
+    migrated.reserve(order.size());
+    migrated.nodes.reserve(recv.size() - order.size() * element_header);
+    for (const auto j : order)
+    {
+      const auto start   = starts[j];
+      const auto header  = recv[start + 2];
+      const auto n_nodes = static_cast<std::ptrdiff_t>(header >> type_bits);
+      const auto first   = recv.begin() + static_cast<std::ptrdiff_t>(start + element_header);
+      migrated.push_back(recv[start],
+                         recv[start + 1],
+                         static_cast<int>(static_cast<uint32_t>(header)),
+                         first,
+                         first + n_nodes);
+    }
+
+    return migrated;
+  }
+
+  cfg::hpc::PartitionedMesh migrate_mesh(const cfg::parser::NodeSet<3>& nodes,
+                                         const std::vector<int>& node_owners,
+                                         const cfg::parser::ElementSet& elements,
+                                         const std::vector<int>& element_owners,
+                                         MPI_Comm comm)
+  {
+    cfg::hpc::PartitionedMesh mesh;
+    mesh.nodes    = migrate_nodes(nodes, node_owners, comm);
+    mesh.elements = migrate_elements(elements, element_owners, comm);
+
+    return mesh;
+  }
+}  // namespace cfg::utils
@@ -0,0 +1,207 @@
+/**
+ * mpiio_reader.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <mpiio_reader.h>
+
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include <_node_parser.h>
+#include <instrument.h>
+#include <mapped_stream.h>
+#include <mpi_utils.h>
+#include <reader.h>
+
+namespace cfg::parser
+{
+  namespace
+  {
+    using cfg::utils::chkerr;
+    using cfg::utils::read_extents;
+
+    /**
+     * The layout of the Nodes section, as broadcast from rank 0.
+     */
+    struct BroadcastLayout
+    {
+      NodeHeader header{};            // The global node description header
+      std::vector<NodeBlock> blocks;  // The layout of the node blocks
+    };
+
+    /**
+     * Locates the Nodes section of a binary GMSH file and scans the layout of the node blocks.
+     *
+     * @param mesh_file The filepath to a binary GMSH file.
+     * @returns The layout of the Nodes section.
+     */
+    [[nodiscard]] BroadcastLayout locate_nodes(const std::filesystem::path& mesh_file)
+    {
+      const cfg::reader::MappedFile mapping{mesh_file};
+      cfg::reader::MappedStream mesh_stream{mapping};
+      const cfg::reader::SectionIndex index{mesh_stream};
+
+      const cfg::reader::SectionReader format_reader("MeshFormat", mesh_stream, index);
+      (void)format_reader.getline(mesh_stream);  // Discard remainder of "$MeshFormat" line
+      const auto header = cfg::reader::GmshHeaderParser{"4.1"}.parse_header(format_reader.getline(mesh_stream));
+      if (!header.binary)
+      {
+        throw std::runtime_error("Collective MPI-IO reading requires a binary GMSH file");
+      }
+      if (header.dsize != sizeof(uint64_t))
+      {
+        throw std::runtime_error("Collective MPI-IO reading requires a GMSH file with a data size of 8");
+      }
+
+      const cfg::reader::SectionReader node_reader("Nodes", mesh_stream, index);
+
+      BroadcastLayout layout;
+      layout.header = HeaderParser::parse<BinaryEncoding>(node_reader, mesh_stream);
+      layout.blocks = scan_node_blocks<BinaryEncoding>(node_reader, mesh_stream, layout.header);
+
+      // Check that we scanned the Nodes section correctly -> we should read "$EndNodes"
+      std::string line;
+      node_reader(mesh_stream) >> line;
+      if (line != "$EndNodes")
+      {
+        throw std::runtime_error("The Nodes section was read incorrectly");
+      }
+
+      return layout;
+    }
+
+    /**
+     * Locates the Nodes section on rank 0 and broadcasts its layout to all ranks. If rank 0 fails to
+     * locate the nodes all ranks raise an error.
+     *
+     * @param mesh_file The filepath to a binary GMSH file.
+     * @param comm      The communicator.
+     * @returns The layout of the Nodes section.
+     */
+    [[nodiscard]] BroadcastLayout broadcast_layout(const std::filesystem::path& mesh_file, MPI_Comm comm)
+    {
+      int rank = 0;
+      chkerr(MPI_Comm_rank(comm, &rank), "MPI_Comm_rank");
+
+      BroadcastLayout layout;
+      std::string error;
+      if (rank == 0)
+      {
+        try
+        {
+          layout = locate_nodes(mesh_file);
+        }
+        catch (const std::runtime_error& e)
+        {
+          error = e.what();
+        }
+      }
+
+      // Make sure no rank is left waiting on rank 0 if it failed
+      int ok = error.empty() ? 1 : 0;
+      chkerr(MPI_Bcast(&ok, 1, MPI_INT, 0, comm), "MPI_Bcast");
+      if (ok == 0)
+      {
+        throw std::runtime_error(rank == 0 ? error : "Rank 0 failed to locate the Nodes section");
+      }
+
+      chkerr(MPI_Bcast(&layout.header, sizeof(NodeHeader), MPI_BYTE, 0, comm), "MPI_Bcast");
+      layout.blocks.resize(layout.header.n_blocks);
+      chkerr(MPI_Bcast(layout.blocks.data(),
+                       static_cast<int>(layout.blocks.size() * sizeof(NodeBlock)),
+                       MPI_BYTE,
+                       0,
+                       comm),
+             "MPI_Bcast");
+
+      return layout;
+    }
+  }  // namespace
+
+  std::vector<Node<3>> read_nodes_collective(const std::filesystem::path& mesh_file,
+                                             MPI_Comm comm,
+                                             const Validation validation)
+  {
+    const auto parallel = cfg::utils::make_parallel(comm);
+
+    const auto [node_header, blocks] = broadcast_layout(mesh_file, comm);
+
+    const utils::NaivePartition partition{parallel, node_header.n_nodes};
+    const auto ranges = local_node_ranges(blocks, partition);
+
+    // Describe the extents of this rank's node tags and coordinates in the file
+    std::vector<MPI_Aint> tag_offsets;
+    std::vector<int> tag_lengths;
+    std::vector<MPI_Aint> coord_offsets;
+    std::vector<int> coord_lengths;
+    size_t n_coords = 0;
+    for (const auto& range : ranges)
+    {
+      const auto& block = blocks[range.block];
+      tag_offsets.push_back(static_cast<MPI_Aint>(block.tags_offset + range.offset * sizeof(size_t)));
+      tag_lengths.push_back(static_cast<int>(range.count));
+      coord_offsets.push_back(
+          static_cast<MPI_Aint>(block.coords_offset + range.offset * block.n_components() * sizeof(double)));
+      coord_lengths.push_back(static_cast<int>(range.count * block.n_components()));
+      n_coords += range.count * block.n_components();
+    }
+
+    std::vector<size_t> tags(partition.size());
+    std::vector<double> coords(n_coords);
+    {
+      std::string path{mesh_file.string()};
+      MPI_File fh = MPI_FILE_NULL;
+      chkerr(MPI_File_open(comm, path.data(), MPI_MODE_RDONLY, MPI_INFO_NULL, &fh), "MPI_File_open");
+      read_extents(fh, tag_offsets, tag_lengths, tags);
+      read_extents(fh, coord_offsets, coord_lengths, coords);
+      cfg::utils::count(cfg::utils::Counter::BLOCKS, ranges.size());
+      cfg::utils::count(cfg::utils::Counter::TOKENS_PARSED, tags.size() + coords.size());
+      cfg::utils::count(cfg::utils::Counter::BYTES_READ, tags.size() * sizeof(size_t) + coords.size() * sizeof(double));
+      chkerr(MPI_File_close(&fh), "MPI_File_close");
+    }
+
+    // Assemble the nodes, dropping any parametric coordinates
+    std::vector<Node<3>> nodes(partition.size());
+    size_t node  = 0;
+    size_t coord = 0;
+    for (const auto& range : ranges)
+    {
+      const auto& block = blocks[range.block];
+      for (size_t i = 0; i < range.count; i++)
+      {
+        nodes[node].natural_idx = tags[node];
+        nodes[node].global_idx  = block.first + range.offset + i;
+        nodes[node].x           = {coords[coord], coords[coord + 1], coords[coord + 2]};
+
+        node++;
+        coord += block.n_components();
+      }
+    }
+
+    {
+      const cfg::utils::ScopedTimer timer{cfg::utils::Phase::VALIDATION};
+      validate_nodes(nodes, node_header, parallel, validation, comm);
+    }
+
+    return nodes;
+  }
+
+  std::vector<Node<3>> read_nodes(const std::filesystem::path& mesh_file, MPI_Comm comm, const Validation validation)
+  {
+    int rank = 0;
+    chkerr(MPI_Comm_rank(comm, &rank), "MPI_Comm_rank");
+
+    std::cout << "+ Reading nodes (MPI-IO)" << std::endl;
+    auto nodes = read_nodes_collective(mesh_file, comm, validation);
+    cfg::utils::count(cfg::utils::Counter::NODES, nodes.size());
+
+    // Report how many nodes we read
+    std::cout << "++ Rank " << rank << " read " << nodes.size() << " nodes" << std::endl;
+
+    return nodes;
+  }
+}  // namespace cfg::parser
@@ -7,27 +7,207 @@
 #include <_node_parser.h>
 
 #include <iostream>
+#include <type_traits>
+
+#include <mesh_index.h>
 
 namespace cfg::parser
 {
-  void read_nodes(std::ifstream& mesh_stream, const Mode mode, const cfg::utils::Parallel& parallel)
+  namespace
   {
-    std::cout << "+ Reading nodes" << std::endl;
-    const cfg::reader::SectionReader node_reader("Nodes", mesh_stream);
+    /**
+     * Reads the nodes from a mesh stream, implements `read_nodes` for each encoding and stream type.
+     *
+     * @tparam E          The encoding of the mesh file.
+     * @param mesh_stream The data stream associated with the mesh file.
+     * @param parallel    The parallel environment.
+     * @param index       The index of the mesh file, either a `SectionIndex` or a `MeshIndex`.
+     * @param validation  How thoroughly the nodes read are validated.
+     * @param comm        The communicator corresponding to the parallel environment.
+     * @returns The nodes held by this rank.
+     */
+    template <class E, class S, class I>
+    [[nodiscard]] std::vector<Node<3>> read_nodes_from(S& mesh_stream,
+                                                       const cfg::utils::Parallel& parallel,
+                                                       const I& index,
+                                                       const Validation validation,
+                                                       MPI_Comm comm)
+    {
+      std::cout << "+ Reading nodes" << std::endl;
 
-    // Read the nodes
-    const auto reader = make_node_reader(parallel);
-    const auto nodes  = reader(node_reader, mesh_stream, mode);
+      // Read the nodes, a mesh index records the node blocks so only this rank's blocks are visited
+      const NodeValidator validator{parallel, validation, comm};
+      const auto [node_reader, nodes] = [&mesh_stream, &parallel, &index, &validator]()
+      {
+        if constexpr (std::is_same_v<I, cfg::reader::MeshIndex>)
+        {
+          cfg::reader::SectionReader section_reader("Nodes", mesh_stream, index.sections);
+          auto data = read_X<E>(KnownHeader<NodeHeader>{index.node_header},
+                                DataParser{},
+                                NodeEnvironment{parallel, ReadStrategy::LOCAL, &index.nodes},
+                                validator)(section_reader, mesh_stream);
+          return std::make_pair(std::move(section_reader), std::move(data));
+        }
+        else
+        {
+          cfg::reader::SectionReader section_reader("Nodes", mesh_stream, index);
+          auto data = read_X<E>(HeaderParser{}, DataParser{}, NodeEnvironment{parallel}, validator)(section_reader,
+                                                                                                   mesh_stream);
+          return std::make_pair(std::move(section_reader), std::move(data));
+        }
+      }();
 
-    // Check that we read the Nodes section correctly -> we should read "$EndNodes"
-    std::string line;
-    node_reader(mesh_stream) >> line;
-    if (line != "$EndNodes")
-    {
-      throw std::runtime_error("The Nodes section was read incorrectly");
+      // Check that we read the Nodes section correctly -> we should read "$EndNodes"
+      std::string line;
+      node_reader(mesh_stream) >> line;
+      if (line != "$EndNodes")
+      {
+        throw std::runtime_error("The Nodes section was read incorrectly");
+      }
+
+      cfg::utils::count(cfg::utils::Counter::NODES, nodes.size());
+
+      // Report how many nodes we read
+      std::cout << "++ Rank " << parallel.rank << " read " << nodes.size() << " nodes" << std::endl;
+
+      return nodes;
     }
+  }  // namespace
+
+  template <class E, class I>
+  std::vector<Node<3>> read_nodes(std::istream& mesh_stream,
+                                  const cfg::utils::Parallel& parallel,
+                                  const I& index,
+                                  const Validation validation,
+                                  MPI_Comm comm)
+  {
+    return read_nodes_from<E>(mesh_stream, parallel, index, validation, comm);
+  }
+
+  template <class E, class I>
+  std::vector<Node<3>> read_nodes(cfg::reader::MappedStream& mesh_stream,
+                                  const cfg::utils::Parallel& parallel,
+                                  const I& index,
+                                  const Validation validation,
+                                  MPI_Comm comm)
+  {
+    return read_nodes_from<E>(mesh_stream, parallel, index, validation, comm);
+  }
 
-    // Report how many nodes we read
-    std::cout << "++ Rank " << parallel.rank << " read " << nodes.size() << " nodes" << std::endl;
+  template std::vector<Node<3>> read_nodes<AsciiEncoding>(std::istream&,
+                                                          const cfg::utils::Parallel&,
+                                                          const cfg::reader::SectionIndex&,
+                                                          const Validation,
+                                                          MPI_Comm);
+  template std::vector<Node<3>> read_nodes<AsciiEncoding>(std::istream&,
+                                                          const cfg::utils::Parallel&,
+                                                          const cfg::reader::MeshIndex&,
+                                                          const Validation,
+                                                          MPI_Comm);
+  template std::vector<Node<3>> read_nodes<AsciiEncoding>(cfg::reader::MappedStream&,
+                                                          const cfg::utils::Parallel&,
+                                                          const cfg::reader::SectionIndex&,
+                                                          const Validation,
+                                                          MPI_Comm);
+  template std::vector<Node<3>> read_nodes<AsciiEncoding>(cfg::reader::MappedStream&,
+                                                          const cfg::utils::Parallel&,
+                                                          const cfg::reader::MeshIndex&,
+                                                          const Validation,
+                                                          MPI_Comm);
+  template std::vector<Node<3>> read_nodes<BinaryEncoding>(std::istream&,
+                                                           const cfg::utils::Parallel&,
+                                                           const cfg::reader::SectionIndex&,
+                                                           const Validation,
+                                                           MPI_Comm);
+  template std::vector<Node<3>> read_nodes<BinaryEncoding>(std::istream&,
+                                                           const cfg::utils::Parallel&,
+                                                           const cfg::reader::MeshIndex&,
+                                                           const Validation,
+                                                           MPI_Comm);
+  template std::vector<Node<3>> read_nodes<BinaryEncoding>(cfg::reader::MappedStream&,
+                                                           const cfg::utils::Parallel&,
+                                                           const cfg::reader::SectionIndex&,
+                                                           const Validation,
+                                                           MPI_Comm);
+  template std::vector<Node<3>> read_nodes<BinaryEncoding>(cfg::reader::MappedStream&,
+                                                           const cfg::utils::Parallel&,
+                                                           const cfg::reader::MeshIndex&,
+                                                           const Validation,
+                                                           MPI_Comm);
+  template std::vector<Node<3>> read_nodes<BinaryEncoding32>(std::istream&,
+                                                             const cfg::utils::Parallel&,
+                                                             const cfg::reader::SectionIndex&,
+                                                             const Validation,
+                                                             MPI_Comm);
+  template std::vector<Node<3>> read_nodes<BinaryEncoding32>(std::istream&,
+                                                             const cfg::utils::Parallel&,
+                                                             const cfg::reader::MeshIndex&,
+                                                             const Validation,
+                                                             MPI_Comm);
+  template std::vector<Node<3>> read_nodes<BinaryEncoding32>(cfg::reader::MappedStream&,
+                                                             const cfg::utils::Parallel&,
+                                                             const cfg::reader::SectionIndex&,
+                                                             const Validation,
+                                                             MPI_Comm);
+  template std::vector<Node<3>> read_nodes<BinaryEncoding32>(cfg::reader::MappedStream&,
+                                                             const cfg::utils::Parallel&,
+                                                             const cfg::reader::MeshIndex&,
+                                                             const Validation,
+                                                             MPI_Comm);
+
+  std::vector<Node<3>> read_nodes(std::istream& mesh_stream,
+                                  const Mode mode,
+                                  const cfg::utils::Parallel& parallel,
+                                  const cfg::reader::SectionIndex& index,
+                                  const Validation validation,
+                                  MPI_Comm comm)
+  {
+    return with_encoding(mode,
+                         [&](auto encoding) -> std::vector<Node<3>>
+                         {
+                           return read_nodes<decltype(encoding)>(mesh_stream, parallel, index, validation, comm);
+                         });
+  }
+
+  std::vector<Node<3>> read_nodes(std::istream& mesh_stream,
+                                  const Mode mode,
+                                  const cfg::utils::Parallel& parallel,
+                                  const cfg::reader::MeshIndex& index,
+                                  const Validation validation,
+                                  MPI_Comm comm)
+  {
+    return with_encoding(mode,
+                         [&](auto encoding) -> std::vector<Node<3>>
+                         {
+                           return read_nodes<decltype(encoding)>(mesh_stream, parallel, index, validation, comm);
+                         });
+  }
+
+  std::vector<Node<3>> read_nodes(cfg::reader::MappedStream& mesh_stream,
+                                  const Mode mode,
+                                  const cfg::utils::Parallel& parallel,
+                                  const cfg::reader::SectionIndex& index,
+                                  const Validation validation,
+                                  MPI_Comm comm)
+  {
+    return with_encoding(mode,
+                         [&](auto encoding) -> std::vector<Node<3>>
+                         {
+                           return read_nodes<decltype(encoding)>(mesh_stream, parallel, index, validation, comm);
+                         });
+  }
+
+  std::vector<Node<3>> read_nodes(cfg::reader::MappedStream& mesh_stream,
+                                  const Mode mode,
+                                  const cfg::utils::Parallel& parallel,
+                                  const cfg::reader::MeshIndex& index,
+                                  const Validation validation,
+                                  MPI_Comm comm)
+  {
+    return with_encoding(mode,
+                         [&](auto encoding) -> std::vector<Node<3>>
+                         {
+                           return read_nodes<decltype(encoding)>(mesh_stream, parallel, index, validation, comm);
+                         });
   }
 }  // namespace cfg::parser
@@ -7,6 +7,7 @@
 #include <fstream>
 #include <sstream>
 
+#include <instrument.h>
 #include <reader.h>
 
 namespace cfg::reader
@@ -45,6 +46,8 @@ namespace cfg::reader
 
   [[nodiscard]] GmshHeader GmshReader::read_header(const std::filesystem::path& meshfile) 
   {
+    const cfg::utils::ScopedTimer timer{cfg::utils::Phase::READ_HEADER};
+
     /*
      * The header contents should be on line 2: discard line 1 and return
      * line 2.
@@ -56,4 +59,17 @@ namespace cfg::reader
 
     return GmshHeaderParser{"4.1"}.parse_header(line);
   }
+
+  [[nodiscard]] std::unique_ptr<MappedFile> GmshReader::map_file(const std::filesystem::path& meshfile)
+  {
+    try
+    {
+      return std::make_unique<MappedFile>(meshfile);
+    }
+    catch (const mapping_error&)
+    {
+      // Not all filesystems support mapping, the caller should fall back to reading the stream
+      return nullptr;
+    }
+  }
 }  // namespace cfg::reader
@@ -0,0 +1,172 @@
+/**
+ * section_index.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <section_index.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include <instrument.h>
+
+namespace cfg::reader
+{
+  namespace
+  {
+    /**
+     * The size of the chunks a stream is scanned in.
+     */
+    constexpr size_t chunk_size = size_t{1} << 20U;
+
+    /**
+     * The longest line that is considered as a section sygil, longer lines are skipped when a
+     * stream is scanned.
+     */
+    constexpr size_t max_sygil_line = 256;
+  }  // namespace
+
+  SectionIndex::SectionIndex(const std::string_view bytes)
+  {
+    const cfg::utils::ScopedTimer timer{cfg::utils::Phase::SECTION_SEARCH};
+    cfg::utils::count(cfg::utils::Counter::BYTES_SCANNED, bytes.size());
+
+    const auto scanned = scan(bytes, 0);
+    if (scanned < bytes.size())
+    {
+      add_line(bytes.substr(scanned), scanned);  // The last line is not terminated
+    }
+  }
+
+  SectionIndex::SectionIndex(std::istream& mesh_data)
+  {
+    const cfg::utils::ScopedTimer timer{cfg::utils::Phase::SECTION_SEARCH};
+
+    mesh_data.clear();
+    mesh_data.seekg(0);
+
+    std::string buf;      // The current chunk, preceded by any incomplete line of the previous chunk
+    size_t base = 0;      // The offset of the buffer in the file
+    bool skip   = false;  // Whether the buffer begins within a line that is too long to be a sygil
+    while (mesh_data)
+    {
+      const auto kept = buf.size();
+      buf.resize(kept + chunk_size);
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      mesh_data.read(buf.data() + kept, static_cast<std::streamsize>(chunk_size));
+      buf.resize(kept + static_cast<size_t>(mesh_data.gcount()));
+      cfg::utils::count(cfg::utils::Counter::BYTES_SCANNED, static_cast<uint64_t>(mesh_data.gcount()));
+
+      const std::string_view bytes{buf};
+      size_t first = 0;
+      if (skip)
+      {
+        const auto* eol = static_cast<const char*>(std::memchr(bytes.data(), '\n', bytes.size()));
+        if (eol == nullptr)
+        {
+          base += buf.size();
+          buf.clear();
+          continue;
+        }
+        first = static_cast<size_t>(eol - bytes.data()) + 1;
+        skip  = false;
+      }
+
+      const auto scanned = first + scan(bytes.substr(first), base + first);
+      if ((buf.size() - scanned) > max_sygil_line)
+      {
+        skip = true;
+        base += buf.size();
+        buf.clear();
+      }
+      else
+      {
+        base += scanned;
+        buf.erase(0, scanned);
+      }
+    }
+    if (!skip && !buf.empty())
+    {
+      add_line(buf, base);  // The last line is not terminated
+    }
+
+    mesh_data.clear();
+    mesh_data.seekg(0);
+  }
+
+  bool SectionIndex::contains(const std::string& section_name) const
+  {
+    return std::any_of(entries.begin(),
+                       entries.end(),
+                       [&section_name](const auto& entry) -> bool
+                       {
+                         return entry.first == section_name;
+                       });
+  }
+
+  const SectionIndex::Section& SectionIndex::find(const std::string& section_name) const
+  {
+    for (const auto& [name, section] : entries)
+    {
+      if (name == section_name)
+      {
+        return section;
+      }
+    }
+
+    throw std::runtime_error("Couldn't find mesh section $" + section_name);
+  }
+
+  size_t SectionIndex::scan(const std::string_view bytes, const size_t base)
+  {
+    size_t pos = 0;
+    while (pos < bytes.size())
+    {
+      // NOLINTNEXTLINE(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      const auto* eol = static_cast<const char*>(std::memchr(bytes.data() + pos, '\n', bytes.size() - pos));
+      if (eol == nullptr)
+      {
+        break;
+      }
+
+      const auto end = static_cast<size_t>(eol - bytes.data());
+      add_line(bytes.substr(pos, end - pos), base + pos);
+      pos = end + 1;
+    }
+
+    return pos;
+  }
+
+  void SectionIndex::add_line(std::string_view line, size_t pos)
+  {
+    // Sygils may be preceded by whitespace
+    const auto first = line.find_first_not_of(" \t");
+    if ((first == std::string_view::npos) || (line[first] != '$'))
+    {
+      return;
+    }
+    line.remove_prefix(first);
+    pos += first;
+
+    const auto sygil = line.substr(0, line.find_first_of(" \t\r"));
+    const std::string_view end_prefix{"$End"};
+    if (open)
+    {
+      // Only the end of the open section is recognised
+      const auto& name = entries.back().first;
+      if ((sygil.size() == end_prefix.size() + name.size()) && (sygil.substr(0, end_prefix.size()) == end_prefix) &&
+          (sygil.substr(end_prefix.size()) == name))
+      {
+        entries.back().second.end = pos;
+        open                      = false;
+      }
+    }
+    else if ((sygil.size() > 1) && (sygil.substr(0, end_prefix.size()) != end_prefix))
+    {
+      entries.emplace_back(std::string{sygil.substr(1)}, Section{pos, npos});
+      open = true;
+    }
+  }
+}  // namespace cfg::reader
@@ -0,0 +1,304 @@
+/**
+ * sfc_partition.cpp
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <sfc_partition.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#include <mpi_utils.h>
+
+namespace cfg::utils
+{
+  namespace
+  {
+    /**
+     * Spreads the low `sfc_bits` bits of a value so that they occupy every third bit.
+     *
+     * @param v The value.
+     * @returns The spread value.
+     */
+    // Simple bit manipulation, short names are clear.
+    // NOLINTNEXTLINE(readability-identifier-length)
+    [[nodiscard]] inline uint64_t spread_bits(const uint64_t v)
+    {
+      // NOLINTBEGIN(readability-magic-numbers)
+      auto r = v & 0x1fffffU;
+      r      = (r | (r << 32U)) & 0x1f00000000ffffU;
+      r      = (r | (r << 16U)) & 0x1f0000ff0000ffU;
+      r      = (r | (r << 8U)) & 0x100f00f00f00f00fU;
+      r      = (r | (r << 4U)) & 0x10c30c30c30c30c3U;
+      r      = (r | (r << 2U)) & 0x1249249249249249U;
+      // NOLINTEND(readability-magic-numbers)
+      return r;
+    }
+
+    /**
+     * Quantises the coordinates of one axis onto the integer grid of the curve.
+     *
+     * @param x     The coordinates.
+     * @param lower The lower bound of the axis.
+     * @param upper The upper bound of the axis.
+     * @param q     The grid coordinates.
+     */
+    template <class A>
+    void quantise(const A& x, const double lower, const double upper, std::vector<uint32_t>& q)
+    {
+      constexpr double max_grid = static_cast<double>((uint32_t{1} << sfc_bits) - 1);
+      const double scale        = (upper > lower) ? max_grid / (upper - lower) : 0.0;
+
+      q.resize(x.size());
+      for (size_t i = 0; i < x.size(); i++)
+      {
+        const auto g = std::min(std::max((x[i] - lower) * scale, 0.0), max_grid);
+        q[i]         = static_cast<uint32_t>(g);
+      }
+    }
+
+    /**
+     * Sorts a vector of keys, returning the permutation that sorts them, equal keys retain their order.
+     *
+     * @param keys The keys.
+     * @returns The indices of the keys in sorted order.
+     */
+    [[nodiscard]] std::vector<size_t> sort_order(const std::vector<uint64_t>& keys)
+    {
+      std::vector<size_t> order(keys.size());
+      std::iota(order.begin(), order.end(), 0);
+      std::stable_sort(order.begin(),
+                       order.end(),
+                       [&keys](const size_t a, const size_t b) -> bool
+                       {
+                         return keys[a] < keys[b];
+                       });
+      return order;
+    }
+  }  // namespace
+
+  uint64_t morton_key(const std::array<uint32_t, 3>& x)
+  {
+    return spread_bits(x[0]) | (spread_bits(x[1]) << 1U) | (spread_bits(x[2]) << 2U);
+  }
+
+  uint64_t hilbert_key(const std::array<uint32_t, 3>& x)
+  {
+    // Converts the coordinates to the "transposed" Hilbert index, following Skilling, "Programming
+    // the Hilbert curve", AIP Conference Proceedings 707 (2004), written without branches.
+    auto X = x;  // NOLINT(readability-identifier-length)
+    for (uint32_t q = uint32_t{1} << (sfc_bits - 1); q > 1; q >>= 1U)
+    {
+      const uint32_t p = q - 1;
+      for (auto& xi : X)
+      {
+        const uint32_t set = 0U - static_cast<uint32_t>((xi & q) != 0);  // All bits set if the bit is set
+        const uint32_t t   = (X[0] ^ xi) & p & ~set;
+        X[0] ^= (p & set) | t;
+        xi ^= t;
+      }
+    }
+
+    // Gray encode
+    X[1] ^= X[0];
+    X[2] ^= X[1];
+    uint32_t t = 0;
+    for (uint32_t q = uint32_t{1} << (sfc_bits - 1); q > 1; q >>= 1U)
+    {
+      t ^= (q - 1) & (0U - static_cast<uint32_t>((X[2] & q) != 0));
+    }
+    for (auto& xi : X)
+    {
+      xi ^= t;
+    }
+
+    // The first axis holds the most significant bit of each triple
+    return spread_bits(X[2]) | (spread_bits(X[1]) << 1U) | (spread_bits(X[0]) << 2U);
+  }
+
+  BoundingBox<3> global_bounding_box(const cfg::parser::NodeSet<3>& nodes, MPI_Comm comm)
+  {
+    BoundingBox<3> box{};
+    for (size_t axis = 0; axis < 3; axis++)
+    {
+      const auto [it_min, it_max] = std::minmax_element(nodes.x[axis].begin(), nodes.x[axis].end());
+      box.min[axis] = nodes.empty() ? std::numeric_limits<double>::max() : *it_min;
+      box.max[axis] = nodes.empty() ? std::numeric_limits<double>::lowest() : *it_max;
+    }
+    chkerr(MPI_Allreduce(MPI_IN_PLACE, box.min.data(), 3, MPI_DOUBLE, MPI_MIN, comm), "MPI_Allreduce");
+    chkerr(MPI_Allreduce(MPI_IN_PLACE, box.max.data(), 3, MPI_DOUBLE, MPI_MAX, comm), "MPI_Allreduce");
+
+    return box;
+  }
+
+  std::vector<uint64_t> sfc_keys(const cfg::parser::NodeSet<3>& nodes, const BoundingBox<3>& box, const Curve curve)
+  {
+    std::array<std::vector<uint32_t>, 3> q;
+    for (size_t axis = 0; axis < 3; axis++)
+    {
+      quantise(nodes.x[axis], box.min[axis], box.max[axis], q[axis]);
+    }
+
+    std::vector<uint64_t> keys(nodes.size());
+    if (curve == Curve::MORTON)
+    {
+      for (size_t i = 0; i < keys.size(); i++)
+      {
+        keys[i] = morton_key({q[0][i], q[1][i], q[2][i]});
+      }
+    }
+    else
+    {
+      for (size_t i = 0; i < keys.size(); i++)
+      {
+        keys[i] = hilbert_key({q[0][i], q[1][i], q[2][i]});
+      }
+    }
+
+    return keys;
+  }
+
+  void sfc_renumber(cfg::parser::NodeSet<3>& nodes, MPI_Comm comm, const Curve curve)
+  {
+    const auto keys  = sfc_keys(nodes, global_bounding_box(nodes, comm), curve);
+    const auto order = sort_order(keys);
+
+    // Number the nodes consecutively in rank order
+    uint64_t n_local = nodes.size();
+    uint64_t offset  = 0;
+    chkerr(MPI_Exscan(&n_local, &offset, 1, mpi_type<uint64_t>(), MPI_SUM, comm), "MPI_Exscan");
+    if (make_parallel(comm).rank == 0)
+    {
+      offset = 0;  // Undefined on the first rank
+    }
+
+    cfg::parser::NodeSet<3> sorted(nodes.size());
+    for (size_t i = 0; i < order.size(); i++)
+    {
+      sorted.set(i, nodes[order[i]]);
+      sorted.global_idx[i] = offset + i;
+    }
+    nodes = std::move(sorted);
+  }
+
+  SFCPartition::SFCPartition(const cfg::parser::NodeSet<3>& nodes, MPI_Comm comm, const Curve curve)
+  {
+    const auto parallel     = make_parallel(comm);
+    const auto n_boundaries = static_cast<size_t>(parallel.size) - 1;
+
+    const auto keys  = sfc_keys(nodes, global_bounding_box(nodes, comm), curve);
+    const auto order = sort_order(keys);
+    std::vector<uint64_t> sorted_keys(keys.size());
+    for (size_t i = 0; i < order.size(); i++)
+    {
+      sorted_keys[i] = keys[order[i]];
+    }
+
+    uint64_t n_total = keys.size();
+    chkerr(MPI_Allreduce(MPI_IN_PLACE, &n_total, 1, mpi_type<uint64_t>(), MPI_SUM, comm), "MPI_Allreduce");
+
+    // Boundary b separates the first target[b] nodes along the curve from the remainder
+    std::vector<uint64_t> target(n_boundaries);
+    for (size_t b = 0; b < n_boundaries; b++)
+    {
+      target[b] = n_total * (b + 1) / parallel.size;
+    }
+
+    // Counts the local keys below a value
+    const auto count_below = [&sorted_keys](const uint64_t key) -> uint64_t
+    {
+      return static_cast<uint64_t>(std::lower_bound(sorted_keys.begin(), sorted_keys.end(), key) -
+                                   sorted_keys.begin());
+    };
+
+    // Distributed search for the splitting keys, all boundaries are searched simultaneously
+    std::vector<uint64_t> key_lo(n_boundaries, 0);  // Invariant: no more than target nodes below key_lo
+    std::vector<uint64_t> key_hi(n_boundaries, uint64_t{1} << (3 * sfc_bits));  // More than target below
+    std::vector<uint64_t> below_lo(n_boundaries, 0);
+    std::vector<uint64_t> mid(n_boundaries, 0);
+    std::vector<uint64_t> below(n_boundaries, 0);
+    while (true)
+    {
+      bool searching = false;
+      for (size_t b = 0; b < n_boundaries; b++)
+      {
+        mid[b]    = key_lo[b] + (key_hi[b] - key_lo[b]) / 2;
+        below[b]  = count_below(mid[b]);
+        searching = searching || (mid[b] != key_lo[b]);
+      }
+      if (!searching)
+      {
+        break;
+      }
+
+      chkerr(MPI_Allreduce(
+                 MPI_IN_PLACE, below.data(), static_cast<int>(n_boundaries), mpi_type<uint64_t>(), MPI_SUM, comm),
+             "MPI_Allreduce");
+      for (size_t b = 0; b < n_boundaries; b++)
+      {
+        if (mid[b] == key_lo[b])
+        {
+          continue;
+        }
+        if (below[b] <= target[b])
+        {
+          key_lo[b]   = mid[b];
+          below_lo[b] = below[b];
+        }
+        else
+        {
+          key_hi[b] = mid[b];
+        }
+      }
+    }
+
+    // Nodes with keys equal to a splitting key are ordered by rank
+    std::vector<uint64_t> ties(n_boundaries);
+    for (size_t b = 0; b < n_boundaries; b++)
+    {
+      ties[b] = count_below(key_lo[b] + 1) - count_below(key_lo[b]);
+    }
+    std::vector<uint64_t> ties_before(n_boundaries, 0);
+    chkerr(MPI_Exscan(
+               ties.data(), ties_before.data(), static_cast<int>(n_boundaries), mpi_type<uint64_t>(), MPI_SUM, comm),
+           "MPI_Exscan");
+    if (parallel.rank == 0)
+    {
+      std::fill(ties_before.begin(), ties_before.end(), 0);  // Undefined on the first rank
+    }
+
+    // The destination of a node is the number of boundaries it lies beyond
+    node_destinations.resize(keys.size());
+    size_t boundary = 0;
+    uint64_t n_equal = 0;  // The number of preceding local nodes with a key equal to a splitting key
+    for (size_t i = 0; i < sorted_keys.size(); i++)
+    {
+      const auto key = sorted_keys[i];
+      if ((i > 0) && (key != sorted_keys[i - 1]))
+      {
+        n_equal = 0;
+      }
+      while ((boundary < n_boundaries) && (key_lo[boundary] < key))
+      {
+        boundary++;
+      }
+
+      auto dst = boundary;
+      if ((dst < n_boundaries) && (key_lo[dst] == key))
+      {
+        // The position of the node along the curve
+        const auto pos = below_lo[boundary] + ties_before[boundary] + n_equal;
+        while ((dst < n_boundaries) && (key_lo[dst] == key) && (target[dst] <= pos))
+        {
+          dst++;
+        }
+        n_equal++;
+      }
+      node_destinations[order[i]] = static_cast<int>(dst);
+    }
+
+    finalise(nodes, comm);
+  }
+}  // namespace cfg::utils
@@ -0,0 +1,244 @@
+/**
+ * _element_parser.cpp
+ *
+ * Tests the internals of the element_parser module.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <_element_parser.h>
+#include <mapped_stream.h>
+
+TEST_CASE("Element types", "[internals]")
+{
+  REQUIRE(cfg::parser::element_type(1).n_nodes == 2);
+  REQUIRE(cfg::parser::element_type(2).n_nodes == 3);
+  REQUIRE(cfg::parser::element_type(3).n_nodes == 4);
+  REQUIRE(cfg::parser::element_type(4).n_nodes == 4);
+  REQUIRE(cfg::parser::element_type(5).n_nodes == 8);
+  REQUIRE(cfg::parser::element_type(6).n_nodes == 6);
+  REQUIRE(cfg::parser::element_type(7).n_nodes == 5);
+  REQUIRE(cfg::parser::element_type(15).n_nodes == 1);
+
+  REQUIRE(cfg::parser::element_type(4).dim == 3);
+  REQUIRE(cfg::parser::element_type(2).dim == 2);
+
+  REQUIRE_THROWS(cfg::parser::element_type(11));  // Second-order tetrahedron
+}
+
+TEST_CASE("Parse Element Header", "[internals]")
+{
+  std::istringstream header("$Elements\n3 5 1 9");  // Fake Elements section with header
+  const auto mode = cfg::parser::Mode::ASCII;
+
+  const cfg::reader::SectionReader element_reader("Elements", header);
+
+  const auto element_header = cfg::parser::ElementHeaderParser::parse(element_reader, header, mode);
+
+  REQUIRE(element_header.n_blocks == 3);
+  REQUIRE(element_header.n_elements == 5);
+  REQUIRE(element_header.min_tag == 1);
+  REQUIRE(element_header.max_tag == 9);
+}
+
+TEST_CASE("Parse Element Blocks", "[internals]")
+{
+  // Fake Elements blocks: a point, two lines and two tetrahedra
+  const std::string element_blocks{"$Elements\n0 1 15 1\n1 1\n1 1 1 2\n2 1 2\n3 2 3\n3 1 4 2\n8 1 2 3 4\n9 2 3 4 5\n"
+                                   "$EndElements\n"};
+
+  const auto mode           = cfg::parser::Mode::ASCII;
+  const auto element_header = cfg::parser::ElementHeader{5, 3, 1, 9};
+
+  const auto parse = [&](const cfg::utils::Parallel& parallel)
+  {
+    std::istringstream stream{element_blocks};
+    const cfg::reader::SectionReader element_reader("Elements", stream);
+    const cfg::parser::ElementEnvironment environment{parallel};
+    const auto elements =
+        cfg::parser::ElementDataParser::parse(element_reader, stream, mode, element_header, environment);
+    REQUIRE_NOTHROW(cfg::parser::validate_elements(elements, element_header, parallel));
+    return elements;
+  };
+
+  SECTION("Serial")
+  {
+    const auto elements = parse({0, 1});
+
+    REQUIRE(elements.size() == 5);
+    REQUIRE(elements.natural_idx == std::vector<size_t>{1, 2, 3, 8, 9});
+    REQUIRE(elements.global_idx == std::vector<size_t>{0, 1, 2, 3, 4});
+    REQUIRE(elements.type == std::vector<int>{15, 1, 1, 4, 4});
+    REQUIRE(elements.offsets == std::vector<size_t>{0, 1, 3, 5, 9, 13});
+    REQUIRE(elements.nodes == std::vector<size_t>{1, 1, 2, 2, 3, 1, 2, 3, 4, 2, 3, 4, 5});
+
+    REQUIRE(elements.n_nodes(3) == 4);
+    const auto [first, last] = elements.connectivity(4);
+    REQUIRE(std::vector<size_t>(first, last) == std::vector<size_t>{2, 3, 4, 5});
+  }
+
+  SECTION("Parallel")
+  {
+    for (unsigned int size = 1; size <= 6; size++)
+    {
+      std::vector<size_t> tags;
+      std::vector<size_t> nodes;
+      for (unsigned int rank = 0; rank < size; rank++)
+      {
+        const cfg::utils::Parallel parallel{rank, size};
+        const auto elements = parse(parallel);
+
+        const cfg::utils::NaivePartition partition{parallel, element_header.n_elements};
+        REQUIRE(elements.size() == partition.size());
+        for (size_t i = 0; i < elements.size(); i++)
+        {
+          REQUIRE(elements.global_idx[i] == partition.start() + i);
+        }
+
+        tags.insert(tags.end(), elements.natural_idx.begin(), elements.natural_idx.end());
+        nodes.insert(nodes.end(), elements.nodes.begin(), elements.nodes.end());
+      }
+      REQUIRE(tags == std::vector<size_t>{1, 2, 3, 8, 9});
+      REQUIRE(nodes == std::vector<size_t>{1, 1, 2, 2, 3, 1, 2, 3, 4, 2, 3, 4, 5});
+    }
+  }
+
+  SECTION("Mismatched element dimension")
+  {
+    std::istringstream stream{"$Elements\n2 1 4 1\n1 1 2 3 4\n$EndElements\n"};
+    const cfg::reader::SectionReader element_reader("Elements", stream);
+    const cfg::utils::Parallel parallel{0, 1};
+    const cfg::parser::ElementEnvironment environment{parallel};
+    const auto header = cfg::parser::ElementHeader{1, 1, 1, 1};
+    REQUIRE_THROWS((void)cfg::parser::ElementDataParser::parse(element_reader, stream, mode, header, environment));
+  }
+}
+
+TEST_CASE("Parse Element Blocks (data size 4)", "[internals]")
+{
+  // Fake binary Elements section of a mesh with a data size of 4: two lines and two tetrahedra
+  const std::string element_blocks = []() -> std::string
+  {
+    std::string bytes{"$Elements\n"};
+    const auto put = [&bytes](const auto val)
+    {
+      bytes.append(reinterpret_cast<const char*>(&val), sizeof(val));  // NOLINT
+    };
+
+    put(uint32_t{2}), put(uint32_t{4}), put(uint32_t{2}), put(uint32_t{9});
+    put(1), put(1), put(1), put(uint32_t{2});
+    put(uint32_t{2}), put(uint32_t{1}), put(uint32_t{2});
+    put(uint32_t{3}), put(uint32_t{2}), put(uint32_t{3});
+    put(3), put(1), put(4), put(uint32_t{2});
+    put(uint32_t{8}), put(uint32_t{1}), put(uint32_t{2}), put(uint32_t{3}), put(uint32_t{4});
+    put(uint32_t{9}), put(uint32_t{2}), put(uint32_t{3}), put(uint32_t{4}), put(uint32_t{5});
+    bytes += "\n$EndElements\n";
+    return bytes;
+  }();
+
+  using Encoding = cfg::parser::BinaryEncoding32;
+  for (unsigned int size = 1; size <= 5; size++)
+  {
+    std::vector<size_t> tags;
+    std::vector<size_t> nodes;
+    for (unsigned int rank = 0; rank < size; rank++)
+    {
+      cfg::reader::MappedStream stream{element_blocks};
+      const cfg::reader::SectionReader element_reader("Elements", stream);
+      const cfg::utils::Parallel parallel{rank, size};
+
+      const auto element_header = cfg::parser::ElementHeaderParser::parse<Encoding>(element_reader, stream);
+      const cfg::parser::ElementEnvironment environment{parallel};
+      const auto elements =
+          cfg::parser::ElementDataParser::parse<Encoding>(element_reader, stream, element_header, environment);
+      REQUIRE_NOTHROW(cfg::parser::validate_elements(elements, element_header, parallel));
+
+      // The stream should be left at the end of the data
+      std::string line;
+      element_reader(stream) >> line;
+      REQUIRE(line == "$EndElements");
+
+      tags.insert(tags.end(), elements.natural_idx.begin(), elements.natural_idx.end());
+      nodes.insert(nodes.end(), elements.nodes.begin(), elements.nodes.end());
+    }
+    REQUIRE(tags == std::vector<size_t>{2, 3, 8, 9});
+    REQUIRE(nodes == std::vector<size_t>{1, 2, 2, 3, 1, 2, 3, 4, 2, 3, 4, 5});
+  }
+}
+
+TEST_CASE("Validate Elements", "[internals]")
+{
+  const cfg::utils::Parallel parallel{0, 1};
+  const auto hdr = cfg::parser::ElementHeader{2, 1, 3, 4};
+
+  cfg::parser::ElementSet elements;
+  const std::vector<size_t> connectivity{1, 2};
+  elements.push_back(3, 0, 1, connectivity.begin(), connectivity.end());
+  elements.push_back(4, 1, 1, connectivity.begin(), connectivity.end());
+  REQUIRE_NOTHROW(cfg::parser::validate_elements(elements, hdr, parallel));
+
+  auto below           = elements;
+  below.natural_idx[0] = 2;
+  REQUIRE_THROWS(cfg::parser::validate_elements(below, hdr, parallel));
+
+  auto above           = elements;
+  above.natural_idx[1] = 5;
+  REQUIRE_THROWS(cfg::parser::validate_elements(above, hdr, parallel));
+
+  auto inconsistent = elements;
+  inconsistent.nodes.pop_back();
+  REQUIRE_THROWS(cfg::parser::validate_elements(inconsistent, hdr, parallel));
+
+  REQUIRE_THROWS(cfg::parser::validate_elements(elements, cfg::parser::ElementHeader{3, 1, 3, 4}, parallel));
+}
+
+// These are closer to integration tests
+TEST_CASE("Parse Elements from mesh", "[internals]")
+{
+  // Read the elements of a mesh file
+  const auto read = [](const std::string& mesh_file, const cfg::parser::Mode mode, const cfg::utils::Parallel& parallel)
+  {
+    const cfg::reader::MappedFile mapping{mesh_file};
+    cfg::reader::MappedStream stream{mapping};
+    const cfg::reader::SectionReader element_reader("Elements", stream);
+    const auto elements =
+        cfg::parser::make_element_reader<cfg::reader::MappedStream>(parallel)(element_reader, stream, mode);
+
+    std::string line;
+    element_reader(stream) >> line;
+    REQUIRE(line == "$EndElements");
+
+    return elements;
+  };
+
+  for (unsigned int size = 1; size <= 4; size++)
+  {
+    size_t n_elements = 0;
+    size_t n_tets     = 0;
+    for (unsigned int rank = 0; rank < size; rank++)
+    {
+      const cfg::utils::Parallel parallel{rank, size};
+      const auto txt_elements = read("box-txt.msh", cfg::parser::Mode::ASCII, parallel);
+      const auto bin_elements = read("box-bin.msh", cfg::parser::Mode::BINARY, parallel);
+
+      REQUIRE(txt_elements.natural_idx == bin_elements.natural_idx);
+      REQUIRE(txt_elements.global_idx == bin_elements.global_idx);
+      REQUIRE(txt_elements.type == bin_elements.type);
+      REQUIRE(txt_elements.offsets == bin_elements.offsets);
+      REQUIRE(txt_elements.nodes == bin_elements.nodes);
+
+      n_elements += txt_elements.size();
+      n_tets += static_cast<size_t>(std::count(txt_elements.type.begin(), txt_elements.type.end(), 4));
+    }
+    REQUIRE(n_elements == 1864);
+    REQUIRE(n_tets == 1160);
+  }
+}
@@ -8,6 +8,8 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <cstdint>
+#include <fstream>
 #include <sstream>
 #include "utils.h"
 
@@ -78,6 +80,122 @@ TEST_CASE("Parse Node Blocks", "[internals]")
   REQUIRE(nodes[5].x == std::array<double, 3>{0, 0, 0.8});
 }
 
+TEST_CASE("Parse Node Blocks (partitioned)", "[internals]")
+{
+  // Fake Nodes blocks, the middle block is split across ranks
+  const std::string node_blocks{
+      "$Nodes\n0 1 0 1\n1\n0 0 1\n1 1 0 5\n9\n10\n11\n12\n13\n0 0 0.1\n0 0 0.3\n0 0 0.5\n0 0 0.7\n0 0 0.8\n"
+      "2 1 0 2\n20\n21\n1 0 0\n2 0 0"};
+
+  const auto mode          = cfg::parser::Mode::ASCII;
+  const size_t n_nodes     = 8;
+  const auto node_header   = cfg::parser::NodeHeader{n_nodes, 3, 1, 21};
+  const auto expected_tags = std::vector<size_t>{1, 9, 10, 11, 12, 13, 20, 21};
+
+  for (unsigned int size = 1; size <= 5; size++)
+  {
+    std::vector<size_t> tags;
+    for (unsigned int rank = 0; rank < size; rank++)
+    {
+      std::istringstream stream{node_blocks};
+      const cfg::reader::SectionReader node_reader("Nodes", stream);
+
+      const cfg::utils::Parallel parallel{rank, size};
+      const cfg::parser::NodeEnvironment environment{parallel};
+      const auto nodes = cfg::parser::DataParser::parse(node_reader, stream, mode, node_header, environment);
+
+      // The nodes should be allocated exactly once
+      const cfg::utils::NaivePartition partition{parallel, n_nodes};
+      REQUIRE(nodes.size() == partition.size());
+      REQUIRE(nodes.capacity() == partition.size());
+      for (size_t i = 0; i < nodes.size(); i++)
+      {
+        REQUIRE(nodes[i].global_idx == partition.start() + i);
+        tags.push_back(nodes[i].natural_idx);
+      }
+    }
+    REQUIRE(tags == expected_tags);
+  }
+
+  SECTION("Truncated blocks")
+  {
+    // The header describes more nodes than the blocks contain
+    std::istringstream stream{node_blocks};
+    const cfg::reader::SectionReader node_reader("Nodes", stream);
+
+    const cfg::utils::Parallel parallel{0, 1};
+    const auto truncated_header = cfg::parser::NodeHeader{n_nodes + 1, 3, 1, 21};
+    const cfg::parser::NodeEnvironment environment{parallel};
+    const auto nodes = cfg::parser::DataParser::parse(node_reader, stream, mode, truncated_header, environment);
+
+    REQUIRE(nodes.size() == n_nodes);
+    REQUIRE_THROWS(cfg::parser::validate_nodes(nodes, truncated_header, parallel));
+  }
+}
+
+TEST_CASE("Read data blocks", "[internals]")
+{
+  SECTION("ASCII")
+  {
+    std::istringstream data("1 2 3\n0.5 0.25");
+    std::vector<size_t> indices;
+    std::vector<double> coords;
+    cfg::parser::read_block(data, cfg::parser::Mode::ASCII, 3, indices);
+    cfg::parser::read_block(data, cfg::parser::Mode::ASCII, 2, coords);
+
+    REQUIRE(indices == std::vector<size_t>{1, 2, 3});
+    REQUIRE(coords == std::vector<double>{0.5, 0.25});
+  }
+
+  SECTION("Binary")
+  {
+    const std::vector<double> values{0.1, 0.2, 0.3, 0.4, 0.5};
+    const std::string bytes(reinterpret_cast<const char*>(values.data()),  // NOLINT
+                            values.size() * sizeof(double));
+    cfg::reader::MappedStream data{bytes};
+
+    // The buffer is resized on each read, reusing its storage
+    std::vector<double> coords;
+    cfg::parser::read_block(data, cfg::parser::Mode::BINARY, 3, coords);
+    REQUIRE(coords == std::vector<double>{0.1, 0.2, 0.3});
+    const auto* storage = coords.data();
+    cfg::parser::read_block(data, cfg::parser::Mode::BINARY, 2, coords);
+    REQUIRE(coords == std::vector<double>{0.4, 0.5});
+    REQUIRE(coords.data() == storage);
+    REQUIRE(data.good());
+  }
+
+  SECTION("Binary (data size 4)")
+  {
+    const std::vector<uint32_t> values{7, 8, 4000000000U};
+    const std::string bytes(reinterpret_cast<const char*>(values.data()),  // NOLINT
+                            values.size() * sizeof(uint32_t));
+    cfg::reader::MappedStream data{bytes};
+
+    // The narrow values are widened to the buffer's type
+    std::vector<size_t> indices;
+    cfg::parser::read_block<cfg::parser::BinaryEncoding32>(data, 3, indices);
+    REQUIRE(indices == std::vector<size_t>{7, 8, 4000000000U});
+    REQUIRE(data.good());
+  }
+
+  SECTION("Unsupported data size")
+  {
+    const auto dispatch = [](const size_t data_size)
+    {
+      return cfg::parser::with_encoding(cfg::parser::Mode::BINARY,
+                                        data_size,
+                                        [](auto encoding) -> size_t
+                                        {
+                                          return sizeof(typename decltype(encoding)::index_type);
+                                        });
+    };
+    REQUIRE(dispatch(8) == 8);
+    REQUIRE(dispatch(4) == 4);
+    REQUIRE_THROWS(dispatch(2));
+  }
+}
+
 TEST_CASE("Validate Nodes (continuous)", "[internals]")
 {
   const size_t n_nodes = 3;
@@ -199,3 +317,445 @@ TEST_CASE("Validate Nodes (discontinuous)", "[internals]")
     REQUIRE_THROWS(cfg::parser::validate_nodes(nodes, hdr, parallel));
   }
 }
+
+TEST_CASE("Validate Nodes (duplicates)", "[internals]")
+{
+  const cfg::utils::Parallel parallel{0, 1};
+  const auto make_nodes = [](const std::vector<size_t>& tags) -> std::vector<cfg::parser::Node<3>>
+  {
+    std::vector<cfg::parser::Node<3>> nodes(tags.size());
+    for (size_t i = 0; i < tags.size(); i++)
+    {
+      nodes[i].natural_idx = tags[i];
+      nodes[i].global_idx  = i;
+    }
+    return nodes;
+  };
+
+  SECTION("Dense tag range")
+  {
+    const cfg::parser::NodeHeader hdr{4, 1, 1, 4};
+    REQUIRE_NOTHROW(cfg::parser::validate_nodes(make_nodes({4, 2, 1, 3}), hdr, parallel));
+    REQUIRE_THROWS(cfg::parser::validate_nodes(make_nodes({4, 2, 2, 3}), hdr, parallel));
+  }
+
+  SECTION("Dense local tags within a sparse tag range")
+  {
+    const cfg::parser::NodeHeader hdr{4, 1, 1, 1000};
+    REQUIRE_NOTHROW(cfg::parser::validate_nodes(make_nodes({503, 500, 502, 501}), hdr, parallel));
+    REQUIRE_THROWS(cfg::parser::validate_nodes(make_nodes({503, 500, 501, 501}), hdr, parallel));
+  }
+
+  SECTION("Sparse tags")
+  {
+    const cfg::parser::NodeHeader hdr{4, 1, 1, 5000};
+    REQUIRE_NOTHROW(cfg::parser::validate_nodes(make_nodes({5000, 1, 1000, 2000}), hdr, parallel));
+    REQUIRE_THROWS(cfg::parser::validate_nodes(make_nodes({5000, 1, 1000, 1000}), hdr, parallel));
+  }
+
+  SECTION("Trusted files only check the number of nodes")
+  {
+    const cfg::parser::NodeHeader hdr{4, 1, 1, 4};
+    const auto trust = cfg::parser::Validation::TRUST;
+    REQUIRE_NOTHROW(cfg::parser::validate_nodes(make_nodes({4, 2, 2, 9}), hdr, parallel, trust));
+    REQUIRE_THROWS(cfg::parser::validate_nodes(make_nodes({4, 2, 1}), hdr, parallel, trust));
+  }
+
+  SECTION("Threaded validation")
+  {
+    // Enough nodes that each thread validates a share
+    const size_t n_nodes = size_t{1} << 17U;
+    std::vector<size_t> tags(n_nodes);
+    for (size_t i = 0; i < n_nodes; i++)
+    {
+      tags[i] = n_nodes - i;
+    }
+    const cfg::parser::NodeHeader hdr{n_nodes, 1, 1, n_nodes};
+
+    for (unsigned int n_threads = 1; n_threads <= 4; n_threads++)
+    {
+      const cfg::utils::Parallel threaded{0, 1, n_threads};
+      auto nodes = make_nodes(tags);
+      REQUIRE_NOTHROW(cfg::parser::validate_nodes(nodes, hdr, threaded));
+      REQUIRE_NOTHROW(cfg::parser::validate_nodes(cfg::parser::to_node_set(nodes), hdr, threaded));
+
+      // The duplicate is found by a different thread than the original
+      nodes.back().natural_idx = nodes.front().natural_idx;
+      REQUIRE_THROWS(cfg::parser::validate_nodes(nodes, hdr, threaded));
+      REQUIRE_THROWS(cfg::parser::validate_nodes(cfg::parser::to_node_set(nodes), hdr, threaded));
+    }
+  }
+}
+
+// These are closer to integration tests
+TEST_CASE("Parse Nodes from mapped mesh", "[internals, mapped]")
+{
+  // Create a serial parallel configuration
+  const auto parallel = []() -> cfg::utils::Parallel
+  {
+    cfg::utils::Parallel parallel{};
+    parallel.size = 1;
+    parallel.rank = 0;
+    return parallel;
+  }();
+
+  // Read the nodes through both backends
+  const auto read_both = [&parallel](const std::string& mesh_file, const cfg::parser::Mode mode)
+  {
+    std::ifstream ifs{mesh_file, std::ios::binary};
+    const cfg::reader::SectionReader stream_reader("Nodes", ifs);
+    const auto stream_nodes = cfg::parser::make_node_reader<std::istream>(parallel)(stream_reader, ifs, mode);
+
+    const cfg::reader::MappedFile mapping{mesh_file};
+    cfg::reader::MappedStream mapped{mapping};
+    const cfg::reader::SectionReader mapped_reader("Nodes", mapped);
+    const auto mapped_nodes =
+        cfg::parser::make_node_reader<cfg::reader::MappedStream>(parallel)(mapped_reader, mapped, mode);
+
+    std::string line;
+    mapped_reader(mapped) >> line;
+    REQUIRE(line == "$EndNodes");
+
+    return std::make_pair(stream_nodes, mapped_nodes);
+  };
+
+  const auto require_equal = [](const std::vector<cfg::parser::Node<3>>& expect,
+                                const std::vector<cfg::parser::Node<3>>& nodes)
+  {
+    REQUIRE(nodes.size() == expect.size());
+    for (size_t i = 0; i < nodes.size(); i++)
+    {
+      REQUIRE(nodes[i].natural_idx == expect[i].natural_idx);
+      REQUIRE(nodes[i].global_idx == expect[i].global_idx);
+      REQUIRE(nodes[i].x == expect[i].x);
+    }
+  };
+
+  SECTION("ASCII mesh")
+  {
+    const auto [stream_nodes, mapped_nodes] = read_both("box-txt.msh", cfg::parser::Mode::ASCII);
+    REQUIRE(stream_nodes.size() == 363);
+    require_equal(stream_nodes, mapped_nodes);
+  }
+
+  SECTION("Binary mesh")
+  {
+    const auto [stream_nodes, mapped_nodes] = read_both("box-bin.msh", cfg::parser::Mode::BINARY);
+    REQUIRE(stream_nodes.size() == 363);
+    require_equal(stream_nodes, mapped_nodes);
+  }
+}
+
+TEST_CASE("Parse Node Blocks (local)", "[internals]")
+{
+  // Fake binary Nodes blocks, the second block is parametric and stores an additional coordinate
+  const std::string node_blocks = []() -> std::string
+  {
+    std::string bytes{"$Nodes\n"};
+    const auto put = [&bytes](const auto val)
+    {
+      bytes.append(reinterpret_cast<const char*>(&val), sizeof(val));  // NOLINT
+    };
+
+    put(0), put(1), put(0), put(size_t{2});
+    put(size_t{1}), put(size_t{2});
+    put(0.0), put(0.0), put(1.0), put(0.0), put(0.0), put(2.0);
+    put(1), put(1), put(1), put(size_t{3});
+    put(size_t{9}), put(size_t{10}), put(size_t{11});
+    put(0.0), put(0.0), put(0.1), put(0.5), put(0.0), put(0.0), put(0.3), put(0.6), put(0.0), put(0.0), put(0.5), put(0.7);
+    bytes += "\n$EndNodes\n";
+    return bytes;
+  }();
+
+  const auto node_header = []() -> cfg::parser::NodeHeader
+  {
+    cfg::parser::NodeHeader node_header{};
+    node_header.n_blocks = 2;
+    node_header.n_nodes  = 5;
+    node_header.min_tag  = 1;
+    node_header.max_tag  = 11;
+    return node_header;
+  }();
+
+  const auto parse = [&](const cfg::utils::Parallel& parallel, const cfg::parser::ReadStrategy strategy)
+  {
+    cfg::reader::MappedStream stream{node_blocks};
+    const cfg::reader::SectionReader node_reader("Nodes", stream);
+    stream.ignore(1);  // Skip newline following the section sygil
+
+    const cfg::parser::NodeEnvironment environment{parallel, strategy};
+    const auto nodes =
+        cfg::parser::DataParser::parse(node_reader, stream, cfg::parser::Mode::BINARY, node_header, environment);
+
+    // The stream should be left at the end of the data
+    std::string line;
+    node_reader(stream) >> line;
+    REQUIRE(line == "$EndNodes");
+
+    return nodes;
+  };
+
+  for (unsigned int size = 1; size <= 6; size++)
+  {
+    for (unsigned int rank = 0; rank < size; rank++)
+    {
+      const cfg::utils::Parallel parallel{rank, size};
+      const auto local = parse(parallel, cfg::parser::ReadStrategy::LOCAL);
+      const auto full  = parse(parallel, cfg::parser::ReadStrategy::FULL);
+
+      REQUIRE(local.size() == cfg::utils::NaivePartition{parallel, node_header.n_nodes}.size());
+      REQUIRE(local.size() == full.size());
+      for (size_t i = 0; i < local.size(); i++)
+      {
+        REQUIRE(local[i].natural_idx == full[i].natural_idx);
+        REQUIRE(local[i].global_idx == full[i].global_idx);
+        REQUIRE(local[i].x == full[i].x);
+      }
+    }
+  }
+
+  SECTION("Parametric coordinates are skipped")
+  {
+    const cfg::utils::Parallel parallel{0, 1};
+    const auto nodes = parse(parallel, cfg::parser::ReadStrategy::LOCAL);
+
+    REQUIRE(nodes[0].x == std::array<double, 3>{0, 0, 1});
+    REQUIRE(nodes[1].x == std::array<double, 3>{0, 0, 2});
+    REQUIRE(nodes[2].x == std::array<double, 3>{0, 0, 0.1});
+    REQUIRE(nodes[3].x == std::array<double, 3>{0, 0, 0.3});
+    REQUIRE(nodes[4].x == std::array<double, 3>{0, 0, 0.5});
+  }
+}
+
+TEST_CASE("Parse Node Blocks (data size 4)", "[internals]")
+{
+  // Fake binary Nodes section of a mesh with a data size of 4, the tags and counts are 4 byte values
+  const std::string node_blocks = []() -> std::string
+  {
+    std::string bytes{"$Nodes\n"};
+    const auto put = [&bytes](const auto val)
+    {
+      bytes.append(reinterpret_cast<const char*>(&val), sizeof(val));  // NOLINT
+    };
+
+    put(uint32_t{2}), put(uint32_t{5}), put(uint32_t{1}), put(uint32_t{11});
+    put(0), put(1), put(0), put(uint32_t{2});
+    put(uint32_t{1}), put(uint32_t{2});
+    put(0.0), put(0.0), put(1.0), put(0.0), put(0.0), put(2.0);
+    put(1), put(1), put(1), put(uint32_t{3});
+    put(uint32_t{9}), put(uint32_t{10}), put(uint32_t{11});
+    put(0.0), put(0.0), put(0.1), put(0.5), put(0.0), put(0.0), put(0.3), put(0.6), put(0.0), put(0.0), put(0.5), put(0.7);
+    bytes += "\n$EndNodes\n";
+    return bytes;
+  }();
+
+  using Encoding = cfg::parser::BinaryEncoding32;
+  const auto parse = [&](const cfg::utils::Parallel& parallel, const cfg::parser::ReadStrategy strategy)
+  {
+    cfg::reader::MappedStream stream{node_blocks};
+    const cfg::reader::SectionReader node_reader("Nodes", stream);
+
+    const auto node_header = cfg::parser::HeaderParser::parse<Encoding>(node_reader, stream);
+    REQUIRE(node_header.n_blocks == 2);
+    REQUIRE(node_header.n_nodes == 5);
+    REQUIRE(node_header.max_tag == 11);
+
+    const cfg::parser::NodeEnvironment environment{parallel, strategy};
+    const auto nodes = cfg::parser::DataParser::parse<Encoding>(node_reader, stream, node_header, environment);
+
+    // The stream should be left at the end of the data
+    std::string line;
+    node_reader(stream) >> line;
+    REQUIRE(line == "$EndNodes");
+
+    return nodes;
+  };
+
+  const auto expected_tags = std::vector<size_t>{1, 2, 9, 10, 11};
+  for (const auto strategy : {cfg::parser::ReadStrategy::LOCAL, cfg::parser::ReadStrategy::FULL})
+  {
+    for (unsigned int size = 1; size <= 6; size++)
+    {
+      std::vector<size_t> tags;
+      for (unsigned int rank = 0; rank < size; rank++)
+      {
+        const auto nodes = parse(cfg::utils::Parallel{rank, size}, strategy);
+        for (const auto& node : nodes)
+        {
+          tags.push_back(node.natural_idx);
+        }
+      }
+      REQUIRE(tags == expected_tags);
+    }
+  }
+
+  const auto nodes = parse(cfg::utils::Parallel{0, 1}, cfg::parser::ReadStrategy::LOCAL);
+  REQUIRE(nodes[1].x == std::array<double, 3>{0, 0, 2});
+  REQUIRE(nodes[4].x == std::array<double, 3>{0, 0, 0.5});
+}
+
+TEST_CASE("Parse Nodes from binary mesh (local)", "[internals]")
+{
+  // Each rank should read exactly the nodes it would have picked from a full read
+  const auto read = [](const cfg::utils::Parallel& parallel, const cfg::parser::ReadStrategy strategy)
+  {
+    const cfg::reader::MappedFile mapping{"box-bin.msh"};
+    cfg::reader::MappedStream stream{mapping};
+    const cfg::reader::SectionReader node_reader("Nodes", stream);
+
+    const auto node_header = cfg::parser::HeaderParser::parse(node_reader, stream, cfg::parser::Mode::BINARY);
+    const cfg::parser::NodeEnvironment environment{parallel, strategy};
+    return cfg::parser::DataParser::parse(node_reader, stream, cfg::parser::Mode::BINARY, node_header, environment);
+  };
+
+  for (const unsigned int size : {1U, 2U, 3U, 7U})
+  {
+    for (unsigned int rank = 0; rank < size; rank++)
+    {
+      const cfg::utils::Parallel parallel{rank, size};
+      const auto local = read(parallel, cfg::parser::ReadStrategy::LOCAL);
+      const auto full  = read(parallel, cfg::parser::ReadStrategy::FULL);
+
+      REQUIRE(local.size() == full.size());
+      for (size_t i = 0; i < local.size(); i++)
+      {
+        REQUIRE(local[i].natural_idx == full[i].natural_idx);
+        REQUIRE(local[i].global_idx == full[i].global_idx);
+        REQUIRE(local[i].x == full[i].x);
+      }
+    }
+  }
+}
+
+TEST_CASE("Index the lines of bytes", "[internals]")
+{
+  for (const std::string bytes : {"", "\n", "a", "a\n", "0 1 0 3\n1\n2\n\n3\n0 0 1\n0 0 2\n0 0 3\n", "ab\ncd\n\nef"})
+  {
+    // The lines found by a serial scan
+    std::vector<size_t> expect;
+    for (size_t i = 0; i < bytes.size(); i++)
+    {
+      if ((i == 0) || (bytes[i - 1] == '\n'))
+      {
+        expect.push_back(i);
+      }
+    }
+
+    for (unsigned int n_threads = 1; n_threads <= 8; n_threads++)
+    {
+      for (const size_t chunk_size : {size_t{1}, size_t{2}, size_t{3}, cfg::parser::LineIndex::default_chunk_size})
+      {
+        const cfg::parser::LineIndex lines{bytes, n_threads, chunk_size};
+        REQUIRE(lines.size() == expect.size());
+        for (size_t line = 0; line < expect.size(); line++)
+        {
+          REQUIRE(lines.line_start(line) == expect[line]);
+        }
+      }
+    }
+  }
+}
+
+TEST_CASE("Parse Node Blocks (threaded)", "[internals]")
+{
+  // Fake ASCII Nodes blocks, the second block is parametric and stores an additional coordinate
+  const std::string node_blocks{
+      "$Nodes\n2 5 1 11\n"
+      "0 1 0 2\n1\n2\n0 0 1\n0 0 2\n"
+      "1 1 1 3\n9\n10\n11\n0 0 0.1 0.5\n0 0 0.3 0.6\n0 0 0.5 0.7\n"
+      "$EndNodes\n"};
+
+  const auto parse = [&node_blocks](const cfg::utils::Parallel& parallel, auto& stream)
+  {
+    const cfg::reader::SectionReader node_reader("Nodes", stream);
+    const auto node_header = cfg::parser::HeaderParser::parse(node_reader, stream, cfg::parser::Mode::ASCII);
+    const cfg::parser::NodeEnvironment environment{parallel};
+    const auto nodes =
+        cfg::parser::DataParser::parse(node_reader, stream, cfg::parser::Mode::ASCII, node_header, environment);
+
+    // The stream should be left at the end of the data
+    std::string line;
+    node_reader(stream) >> line;
+    REQUIRE(line == "$EndNodes");
+
+    return nodes;
+  };
+
+  for (unsigned int size = 1; size <= 6; size++)
+  {
+    for (unsigned int rank = 0; rank < size; rank++)
+    {
+      const cfg::utils::Parallel serial{rank, size};
+      std::istringstream serial_stream{node_blocks};
+      const auto expect = parse(serial, serial_stream);
+
+      for (unsigned int n_threads = 2; n_threads <= 5; n_threads++)
+      {
+        const cfg::utils::Parallel parallel{rank, size, n_threads};
+
+        std::istringstream stream{node_blocks};
+        cfg::reader::MappedStream mapped{node_blocks};
+        for (const auto& nodes : {parse(parallel, stream), parse(parallel, mapped)})
+        {
+          REQUIRE(nodes.size() == expect.size());
+          for (size_t i = 0; i < nodes.size(); i++)
+          {
+            REQUIRE(nodes[i].natural_idx == expect[i].natural_idx);
+            REQUIRE(nodes[i].global_idx == expect[i].global_idx);
+            REQUIRE(nodes[i].x == expect[i].x);
+          }
+        }
+      }
+    }
+  }
+
+  SECTION("Parametric coordinates are skipped")
+  {
+    const cfg::utils::Parallel parallel{0, 1, 3};
+    cfg::reader::MappedStream mapped{node_blocks};
+    const auto nodes = parse(parallel, mapped);
+
+    REQUIRE(nodes.size() == 5);
+    REQUIRE(nodes[1].x == std::array<double, 3>{0, 0, 2});
+    REQUIRE(nodes[2].natural_idx == 9);
+    REQUIRE(nodes[2].x == std::array<double, 3>{0, 0, 0.1});
+    REQUIRE(nodes[4].x == std::array<double, 3>{0, 0, 0.5});
+  }
+
+  SECTION("Truncated blocks raise an error")
+  {
+    const cfg::utils::Parallel parallel{0, 1, 3};
+    const std::string truncated{"$Nodes\n2 5 1 11\n0 1 0 2\n1\n2\n0 0 1\n0 0 2\n1 1 1 3\n9\n$EndNodes\n"};
+    cfg::reader::MappedStream mapped{truncated};
+    REQUIRE_THROWS(parse(parallel, mapped));
+    std::istringstream stream{truncated};
+    REQUIRE_THROWS(parse(parallel, stream));
+  }
+}
+
+TEST_CASE("Parse Nodes from ASCII mesh (threaded)", "[internals]")
+{
+  const auto read = [](const cfg::utils::Parallel& parallel)
+  {
+    std::ifstream stream{"box-txt.msh"};
+    const cfg::reader::SectionReader node_reader("Nodes", stream);
+
+    const auto node_header = cfg::parser::HeaderParser::parse(node_reader, stream, cfg::parser::Mode::ASCII);
+    const cfg::parser::NodeEnvironment environment{parallel};
+    return cfg::parser::NodeSetParser::parse(node_reader, stream, cfg::parser::Mode::ASCII, node_header, environment);
+  };
+
+  for (const unsigned int size : {1U, 2U, 3U, 7U})
+  {
+    for (unsigned int rank = 0; rank < size; rank++)
+    {
+      const auto expect = read({rank, size});
+      const auto nodes  = read({rank, size, 4});
+
+      REQUIRE(nodes.size() == expect.size());
+      REQUIRE(nodes.natural_idx == expect.natural_idx);
+      REQUIRE(nodes.global_idx == expect.global_idx);
+      REQUIRE(nodes.x == expect.x);
+    }
+  }
+}
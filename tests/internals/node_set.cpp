@@ -0,0 +1,148 @@
+/**
+ * node_set.cpp
+ *
+ * Tests the structure-of-arrays node storage.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <_node_parser.h>
+#include <node_set.h>
+
+namespace
+{
+  // Tests whether an array's storage is aligned to a cache line.
+  template <class A>
+  bool is_aligned(const A& array)
+  {
+    return (reinterpret_cast<std::uintptr_t>(array.data()) % 64) == 0;  // NOLINT
+  }
+}  // namespace
+
+TEST_CASE("Node set storage", "[internals]")
+{
+  const std::vector<cfg::parser::Node<3>> nodes{{7, 0, {0.0, 0.5, 1.0}}, {3, 1, {1.0, 1.5, 2.0}}};
+
+  const auto node_set = cfg::parser::to_node_set(nodes);
+  REQUIRE(node_set.size() == 2);
+  REQUIRE(!node_set.empty());
+
+  // Each field is stored in its own array
+  REQUIRE(node_set.natural_idx[0] == 7);
+  REQUIRE(node_set.natural_idx[1] == 3);
+  REQUIRE(node_set.global_idx[1] == 1);
+  REQUIRE(node_set.x[0][1] == 1.0);
+  REQUIRE(node_set.x[1][1] == 1.5);
+  REQUIRE(node_set.x[2][1] == 2.0);
+
+  REQUIRE(is_aligned(node_set.natural_idx));
+  REQUIRE(is_aligned(node_set.global_idx));
+  for (const auto& axis : node_set.x)
+  {
+    REQUIRE(is_aligned(axis));
+  }
+
+  SECTION("Node views")
+  {
+    REQUIRE(node_set[0].natural_idx == 7);
+    REQUIRE(node_set[0].x == std::array<double, 3>{0.0, 0.5, 1.0});
+
+    size_t i = 0;
+    for (const auto node : node_set)
+    {
+      REQUIRE(node.natural_idx == nodes[i].natural_idx);
+      REQUIRE(node.global_idx == nodes[i].global_idx);
+      REQUIRE(node.x == nodes[i].x);
+      i++;
+    }
+    REQUIRE(i == nodes.size());
+
+    const auto round_trip = cfg::parser::to_nodes(node_set);
+    REQUIRE(round_trip.size() == nodes.size());
+    REQUIRE(round_trip[1].x == nodes[1].x);
+  }
+
+  SECTION("Modification")
+  {
+    auto modified = node_set;
+    modified.set(0, {5, 4, {3.0, 2.0, 1.0}});
+    modified.push_back({9, 2, {0.0, 0.0, 0.0}});
+
+    REQUIRE(modified.size() == 3);
+    REQUIRE(modified[0].natural_idx == 5);
+    REQUIRE(modified[0].x == std::array<double, 3>{3.0, 2.0, 1.0});
+    REQUIRE(modified[2].natural_idx == 9);
+
+    modified.resize(1);
+    REQUIRE(modified.size() == 1);
+    REQUIRE(modified.x[2].size() == 1);
+  }
+}
+
+// These are closer to integration tests
+TEST_CASE("Parse Nodes into node set", "[internals]")
+{
+  const auto parse = [](const std::string& mesh_file,
+                        const cfg::parser::Mode mode,
+                        const cfg::utils::Parallel& parallel,
+                        const cfg::parser::ReadStrategy strategy)
+  {
+    const cfg::reader::MappedFile mapping{mesh_file};
+
+    cfg::reader::MappedStream vector_stream{mapping};
+    const cfg::reader::SectionReader vector_reader("Nodes", vector_stream);
+    const auto vector_header = cfg::parser::HeaderParser::parse(vector_reader, vector_stream, mode);
+    const cfg::parser::NodeEnvironment environment{parallel, strategy};
+    const auto nodes = cfg::parser::DataParser::parse(vector_reader, vector_stream, mode, vector_header, environment);
+
+    cfg::reader::MappedStream set_stream{mapping};
+    const cfg::reader::SectionReader set_reader("Nodes", set_stream);
+    const auto set_header = cfg::parser::HeaderParser::parse(set_reader, set_stream, mode);
+    const auto node_set =
+        cfg::parser::NodeSetParser::parse(set_reader, set_stream, mode, set_header, environment);
+
+    REQUIRE_NOTHROW(cfg::parser::validate_nodes(node_set, set_header, parallel));
+    REQUIRE(node_set.size() == nodes.size());
+    for (size_t i = 0; i < nodes.size(); i++)
+    {
+      REQUIRE(node_set[i].natural_idx == nodes[i].natural_idx);
+      REQUIRE(node_set[i].global_idx == nodes[i].global_idx);
+      REQUIRE(node_set[i].x == nodes[i].x);
+    }
+  };
+
+  for (unsigned int size = 1; size <= 3; size++)
+  {
+    for (unsigned int rank = 0; rank < size; rank++)
+    {
+      const cfg::utils::Parallel parallel{rank, size};
+      parse("box-txt.msh", cfg::parser::Mode::ASCII, parallel, cfg::parser::ReadStrategy::FULL);
+      parse("box-bin.msh", cfg::parser::Mode::BINARY, parallel, cfg::parser::ReadStrategy::FULL);
+      parse("box-bin.msh", cfg::parser::Mode::BINARY, parallel, cfg::parser::ReadStrategy::LOCAL);
+    }
+  }
+}
+
+TEST_CASE("Validate Nodes (node set)", "[internals]")
+{
+  const cfg::utils::Parallel parallel{0, 1};
+  const cfg::parser::NodeHeader hdr{2, 1, 3, 4};
+  auto nodes = cfg::parser::to_node_set(std::vector<cfg::parser::Node<3>>{{3, 0, {}}, {4, 1, {}}});
+
+  REQUIRE_NOTHROW(cfg::parser::validate_nodes(nodes, hdr, parallel));
+
+  nodes.natural_idx[0] = 2;
+  REQUIRE_THROWS(cfg::parser::validate_nodes(nodes, hdr, parallel));
+
+  nodes.natural_idx[0] = 5;
+  REQUIRE_THROWS(cfg::parser::validate_nodes(nodes, hdr, parallel));
+
+  nodes.resize(1);
+  REQUIRE_THROWS(cfg::parser::validate_nodes(nodes, hdr, parallel));
+}
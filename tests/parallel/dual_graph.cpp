@@ -0,0 +1,207 @@
+/**
+ * dual_graph.cpp
+ *
+ * Tests the construction of the distributed dual graph of a mesh.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+#include <mpi.h>
+
+#include <dual_graph.h>
+#include <element_parser.h>
+#include <mapped_stream.h>
+#include <mpi_utils.h>
+
+namespace
+{
+  // Reads the elements of a mesh file held by a rank.
+  cfg::parser::ElementSet read_element_set(const std::string& mesh_file, const cfg::utils::Parallel& parallel)
+  {
+    const cfg::reader::MappedFile mapping{mesh_file};
+    cfg::reader::MappedStream stream{mapping};
+    const cfg::reader::SectionIndex index{stream};
+    return cfg::parser::read_elements(stream, cfg::parser::Mode::ASCII, parallel, index);
+  }
+
+  // Gathers the natural index of the cell of each global vertex.
+  std::vector<unsigned long> gather_cells(const cfg::parser::ElementSet& elements, const cfg::utils::DualGraph& graph)
+  {
+    const auto parallel = cfg::utils::make_parallel(MPI_COMM_WORLD);
+
+    std::vector<unsigned long> local;
+    for (const auto cell : graph.cells)
+    {
+      local.push_back(elements.natural_idx[cell]);
+    }
+    std::vector<int> counts(parallel.size);
+    std::vector<int> displs(parallel.size);
+    for (size_t rank = 0; rank < parallel.size; rank++)
+    {
+      counts[rank] = static_cast<int>(graph.vtxdist[rank + 1] - graph.vtxdist[rank]);
+      displs[rank] = static_cast<int>(graph.vtxdist[rank]);
+    }
+
+    std::vector<unsigned long> cells(graph.global_size());
+    MPI_Allgatherv(local.data(),
+                   static_cast<int>(local.size()),
+                   MPI_UNSIGNED_LONG,
+                   cells.data(),
+                   counts.data(),
+                   displs.data(),
+                   MPI_UNSIGNED_LONG,
+                   MPI_COMM_WORLD);
+    return cells;
+  }
+}  // namespace
+
+TEST_CASE("Dual graph of cells on different ranks", "[parallel]")
+{
+  const auto parallel = cfg::utils::make_parallel(MPI_COMM_WORLD);
+
+  // Two tetrahedra sharing the face (2, 3, 4), held by the first two ranks, the last rank holds
+  // only a boundary triangle
+  const std::vector<size_t> first_tet{1, 2, 3, 4};
+  const std::vector<size_t> second_tet{5, 4, 3, 2};
+  const std::vector<size_t> triangle{1, 2, 3};
+  cfg::parser::ElementSet elements;
+  if (parallel.rank == 0)
+  {
+    elements.push_back(1, 0, 4, first_tet.begin(), first_tet.end());
+  }
+  else if (parallel.rank == 1)
+  {
+    elements.push_back(2, 1, 4, second_tet.begin(), second_tet.end());
+  }
+  else
+  {
+    elements.push_back(3, 2, 2, triangle.begin(), triangle.end());
+  }
+
+  const auto graph = cfg::utils::build_dual_graph(elements, MPI_COMM_WORLD);
+  REQUIRE(graph.dim == 3);
+  REQUIRE(graph.global_size() == 2);
+  if (parallel.rank < 2)
+  {
+    REQUIRE(graph.size() == 1);
+    REQUIRE(graph.cells == std::vector<size_t>{0});
+    REQUIRE(graph.vtxdist[parallel.rank] == parallel.rank);
+    REQUIRE(graph.adjacency == std::vector<size_t>{1 - parallel.rank});
+  }
+  else
+  {
+    REQUIRE(graph.size() == 0);
+    REQUIRE(graph.adjacency.empty());
+  }
+}
+
+TEST_CASE("Dual graph of a mesh", "[parallel]")
+{
+  const auto parallel = cfg::utils::make_parallel(MPI_COMM_WORLD);
+  const auto elements = read_element_set("box-txt.msh", parallel);
+  const auto graph    = cfg::utils::build_dual_graph(elements, MPI_COMM_WORLD);
+
+  REQUIRE(graph.dim == 3);
+  REQUIRE(graph.vtxdist.size() == parallel.size + 1);
+  REQUIRE(graph.size() == graph.vtxdist[parallel.rank + 1] - graph.vtxdist[parallel.rank]);
+  REQUIRE(graph.offsets.back() == graph.adjacency.size());
+
+  // The graph matches the graph of the whole mesh built by a single rank
+  const auto serial_elements = read_element_set("box-txt.msh", cfg::utils::Parallel{0, 1});
+  const auto serial_graph    = cfg::utils::build_dual_graph(serial_elements, MPI_COMM_SELF);
+  REQUIRE(graph.global_size() == serial_graph.size());
+
+  std::map<unsigned long, std::vector<unsigned long>> expected;
+  for (size_t v = 0; v < serial_graph.size(); v++)
+  {
+    const auto [first, last] = serial_graph.neighbours(v);
+    auto& neighbours         = expected[serial_elements.natural_idx[serial_graph.cells[v]]];
+    std::for_each(first,
+                  last,
+                  [&](const size_t u)
+                  {
+                    neighbours.push_back(serial_elements.natural_idx[serial_graph.cells[u]]);
+                  });
+    std::sort(neighbours.begin(), neighbours.end());
+  }
+
+  const auto cells = gather_cells(elements, graph);
+  size_t n_edges   = 0;
+  for (size_t v = 0; v < graph.size(); v++)
+  {
+    const auto [first, last] = graph.neighbours(v);
+    REQUIRE(std::is_sorted(first, last));
+    REQUIRE(std::adjacent_find(first, last) == last);
+
+    std::vector<unsigned long> neighbours;
+    std::for_each(first,
+                  last,
+                  [&](const size_t u)
+                  {
+                    REQUIRE(u < graph.global_size());
+                    REQUIRE(u != graph.vtxdist[parallel.rank] + v);
+                    neighbours.push_back(cells[u]);
+                  });
+    std::sort(neighbours.begin(), neighbours.end());
+    REQUIRE(neighbours == expected.at(elements.natural_idx[graph.cells[v]]));
+    n_edges += graph.degree(v);
+  }
+
+  unsigned long total = n_edges;
+  MPI_Allreduce(MPI_IN_PLACE, &total, 1, MPI_UNSIGNED_LONG, MPI_SUM, MPI_COMM_WORLD);
+  REQUIRE(total == serial_graph.adjacency.size());
+  REQUIRE(total > 0);
+
+  // Checking the faces matched within each rank finds no non-manifold face
+  const auto checked = cfg::utils::build_dual_graph(elements, MPI_COMM_WORLD, true);
+  REQUIRE(checked.adjacency == graph.adjacency);
+}
+
+TEST_CASE("Dual graph of a non-manifold mesh", "[parallel]")
+{
+  const auto parallel = cfg::utils::make_parallel(MPI_COMM_WORLD);
+
+  // Each rank holds a tetrahedron on the face (1, 2, 3)
+  const std::vector<size_t> tet{1, 2, 3, 4 + parallel.rank};
+  cfg::parser::ElementSet elements;
+  elements.push_back(parallel.rank + 1, parallel.rank, 4, tet.begin(), tet.end());
+
+  REQUIRE_THROWS_AS(cfg::utils::build_dual_graph(elements, MPI_COMM_WORLD), std::runtime_error);
+}
+
+TEST_CASE("Dual graph of a non-manifold face matched within a rank", "[parallel]")
+{
+  const auto parallel = cfg::utils::make_parallel(MPI_COMM_WORLD);
+
+  // The first rank holds two tetrahedra on the face (1, 2, 3), matched within the rank, and the
+  // second rank a third tetrahedron on the same face
+  const std::vector<size_t> first_tet{1, 2, 3, 4};
+  const std::vector<size_t> second_tet{1, 2, 3, 5};
+  const std::vector<size_t> third_tet{1, 2, 3, 6};
+  cfg::parser::ElementSet elements;
+  if (parallel.rank == 0)
+  {
+    elements.push_back(1, 0, 4, first_tet.begin(), first_tet.end());
+    elements.push_back(2, 1, 4, second_tet.begin(), second_tet.end());
+  }
+  else if (parallel.rank == 1)
+  {
+    elements.push_back(3, 2, 4, third_tet.begin(), third_tet.end());
+  }
+
+  REQUIRE_THROWS_AS(cfg::utils::build_dual_graph(elements, MPI_COMM_WORLD, true), std::runtime_error);
+
+  // The face is matched within each of two ranks
+  if (parallel.rank == 1)
+  {
+    elements.push_back(4, 3, 4, second_tet.begin(), second_tet.end());
+  }
+  REQUIRE_THROWS_AS(cfg::utils::build_dual_graph(elements, MPI_COMM_WORLD, true), std::runtime_error);
+}
@@ -0,0 +1,249 @@
+/**
+ * halo.cpp
+ *
+ * Tests the construction of the halo of a partitioned mesh and its storage in the partitioned mesh
+ * format.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <filesystem>
+#include <map>
+#include <set>
+#include <utility>
+#include <stdexcept>
+#include <vector>
+
+#include <mpi.h>
+
+#include <halo.h>
+#include <hpc_reader.h>
+#include <hpc_writer.h>
+#include <mesh_partition.h>
+#include <mpi_utils.h>
+#include <reader.h>
+
+namespace
+{
+  // The expected halo of a rank, computed from the whole mesh.
+  struct ExpectedHalo
+  {
+    std::vector<size_t> cells;  // The sorted natural indices of the ghost cells
+    std::vector<size_t> nodes;  // The sorted natural indices of the ghost nodes
+  };
+
+  // Computes the halo of a rank's partition by traversing the layers of cells of the whole mesh.
+  ExpectedHalo expected_halo(const cfg::hpc::PartitionedMesh& mesh, const unsigned int depth)
+  {
+    const cfg::reader::GmshReader serial{
+        "box-txt.msh", cfg::utils::Parallel{0, 1}, cfg::reader::Backend::MMAP, MPI_COMM_SELF};
+    const auto& elements = serial.elements();
+
+    int dim = 0;
+    for (const auto type : elements.type)
+    {
+      dim = std::max(dim, cfg::parser::element_type(type).dim);
+    }
+    std::map<size_t, std::vector<size_t>> cells_of_node;
+    std::map<size_t, std::vector<size_t>> nodes_of_cell;
+    for (size_t i = 0; i < elements.size(); i++)
+    {
+      if (cfg::parser::element_type(elements.type[i]).dim == dim)
+      {
+        const auto [first, last] = elements.connectivity(i);
+        nodes_of_cell[elements.natural_idx[i]].assign(first, last);
+        for (auto tag = first; tag != last; ++tag)
+        {
+          cells_of_node[*tag].push_back(elements.natural_idx[i]);
+        }
+      }
+    }
+
+    std::set<size_t> owned;
+    for (size_t i = 0; i < mesh.elements.size(); i++)
+    {
+      if (cfg::parser::element_type(mesh.elements.type[i]).dim == dim)
+      {
+        owned.insert(mesh.elements.natural_idx[i]);
+      }
+    }
+    std::set<size_t> known{owned};
+    std::vector<size_t> layer(owned.begin(), owned.end());
+    std::set<size_t> ghosts;
+    for (unsigned int l = 0; l < depth; l++)
+    {
+      std::vector<size_t> next;
+      for (const auto cell : layer)
+      {
+        for (const auto tag : nodes_of_cell[cell])
+        {
+          for (const auto neighbour : cells_of_node[tag])
+          {
+            if (known.insert(neighbour).second)
+            {
+              next.push_back(neighbour);
+              ghosts.insert(neighbour);
+            }
+          }
+        }
+      }
+      layer = next;
+    }
+
+    std::set<size_t> nodes(mesh.elements.nodes.begin(), mesh.elements.nodes.end());
+    for (const auto cell : ghosts)
+    {
+      nodes.insert(nodes_of_cell[cell].begin(), nodes_of_cell[cell].end());
+    }
+    for (const auto tag : mesh.nodes.natural_idx)
+    {
+      nodes.erase(tag);
+    }
+
+    return {{ghosts.begin(), ghosts.end()}, {nodes.begin(), nodes.end()}};
+  }
+
+  // Returns the sorted values of an array.
+  template <class A>
+  std::vector<size_t> sorted(const A& values)
+  {
+    std::vector<size_t> result(values.begin(), values.end());
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+  // Checks that two halos are equal.
+  void check_equal(const cfg::utils::Halo& a, const cfg::utils::Halo& b)
+  {
+    REQUIRE(a.depth == b.depth);
+    REQUIRE(a.neighbours == b.neighbours);
+    REQUIRE(a.nodes.natural_idx == b.nodes.natural_idx);
+    REQUIRE(a.nodes.global_idx == b.nodes.global_idx);
+    for (size_t axis = 0; axis < 3; axis++)
+    {
+      REQUIRE(a.nodes.x[axis] == b.nodes.x[axis]);
+    }
+    REQUIRE(a.elements.natural_idx == b.elements.natural_idx);
+    REQUIRE(a.elements.global_idx == b.elements.global_idx);
+    REQUIRE(a.elements.type == b.elements.type);
+    REQUIRE(a.elements.offsets == b.elements.offsets);
+    REQUIRE(a.elements.nodes == b.elements.nodes);
+    for (const auto& [pa, pb] : {std::make_pair(&a.node_pattern, &b.node_pattern),
+                                 std::make_pair(&a.element_pattern, &b.element_pattern)})
+    {
+      REQUIRE(pa->send_offsets == pb->send_offsets);
+      REQUIRE(pa->send_idx == pb->send_idx);
+      REQUIRE(pa->recv_offsets == pb->recv_offsets);
+      REQUIRE(pa->recv_idx == pb->recv_idx);
+    }
+  }
+}  // namespace
+
+TEST_CASE("Halo of a partitioned mesh", "[parallel]")
+{
+  const auto parallel = cfg::utils::make_parallel(MPI_COMM_WORLD);
+  const cfg::reader::GmshReader reader{"box-txt.msh", parallel};
+  const auto mesh = cfg::utils::partition_mesh(
+      reader.nodes(), reader.elements(), MPI_COMM_WORLD, cfg::utils::Partitioner::GEOMETRIC);
+
+  for (const unsigned int depth : {0U, 1U, 2U})
+  {
+    const auto halo = cfg::utils::build_halo(mesh.nodes, mesh.elements, depth, MPI_COMM_WORLD);
+
+    // The ghosts are the cells within the layers and the nodes completing the cells
+    const auto expected = expected_halo(mesh, depth);
+    REQUIRE(halo.depth == depth);
+    REQUIRE(sorted(halo.elements.natural_idx) == expected.cells);
+    REQUIRE(sorted(halo.nodes.natural_idx) == expected.nodes);
+    REQUIRE(std::is_sorted(halo.nodes.global_idx.begin(), halo.nodes.global_idx.end()));
+    REQUIRE(std::is_sorted(halo.elements.global_idx.begin(), halo.elements.global_idx.end()));
+    REQUIRE(std::is_sorted(halo.neighbours.begin(), halo.neighbours.end()));
+    if ((depth > 0) && (parallel.size > 1))
+    {
+      REQUIRE(!halo.neighbours.empty());
+    }
+
+    // Each ghost is received once
+    for (const auto& [pattern, n_ghosts] : {std::make_pair(&halo.node_pattern, halo.nodes.size()),
+                                            std::make_pair(&halo.element_pattern, halo.elements.size())})
+    {
+      const auto received = sorted(pattern->recv_idx);
+      REQUIRE(received.size() == n_ghosts);
+      REQUIRE(std::adjacent_find(received.begin(), received.end()) == received.end());
+      REQUIRE(pattern->send_offsets.size() == halo.neighbours.size() + 1);
+      REQUIRE(pattern->recv_offsets.size() == halo.neighbours.size() + 1);
+    }
+
+    // The patterns update the ghosts from their owners over the neighbourhood communicator
+    auto halo_comm = cfg::utils::halo_communicator(halo, MPI_COMM_WORLD);
+    int n_sources      = 0;
+    int n_destinations = 0;
+    int weighted       = 0;
+    MPI_Dist_graph_neighbors_count(halo_comm, &n_sources, &n_destinations, &weighted);
+    REQUIRE(static_cast<size_t>(n_sources) == halo.neighbours.size());
+    REQUIRE(static_cast<size_t>(n_destinations) == halo.neighbours.size());
+
+    for (size_t axis = 0; axis < 3; axis++)
+    {
+      const auto x = cfg::utils::exchange_halo(mesh.nodes.x[axis], halo.node_pattern, halo_comm);
+      REQUIRE(std::equal(x.begin(), x.end(), halo.nodes.x[axis].begin(), halo.nodes.x[axis].end()));
+    }
+    const auto node_idx = cfg::utils::exchange_halo(mesh.nodes.global_idx, halo.node_pattern, halo_comm);
+    REQUIRE(std::equal(
+        node_idx.begin(), node_idx.end(), halo.nodes.global_idx.begin(), halo.nodes.global_idx.end()));
+    const auto cell_idx = cfg::utils::exchange_halo(mesh.elements.global_idx, halo.element_pattern, halo_comm);
+    REQUIRE(cell_idx == halo.elements.global_idx);
+    MPI_Comm_free(&halo_comm);
+  }
+}
+
+TEST_CASE("Halo in the partitioned mesh format", "[parallel]")
+{
+  const auto parallel = cfg::utils::make_parallel(MPI_COMM_WORLD);
+  const auto output   = std::filesystem::temp_directory_path() / "cfgrid-test-halo.cfgm";
+
+  const cfg::reader::GmshReader reader{"box-bin.msh", parallel};
+  const auto mesh = cfg::utils::partition_mesh(
+      reader.nodes(), reader.elements(), MPI_COMM_WORLD, cfg::utils::Partitioner::GEOMETRIC);
+  const auto halo = cfg::utils::build_halo(mesh.nodes, mesh.elements, 2, MPI_COMM_WORLD);
+
+  SECTION("The halo is loaded on the ranks that wrote it")
+  {
+    cfg::hpc::write_mesh(output, mesh.nodes, mesh.elements, halo, MPI_COMM_WORLD);
+    check_equal(cfg::hpc::read_halo(output, MPI_COMM_WORLD), halo);
+
+    // The mesh is unaffected by the halo
+    const auto loaded = cfg::hpc::read_mesh(output, MPI_COMM_WORLD);
+    REQUIRE(loaded.nodes.natural_idx == mesh.nodes.natural_idx);
+    REQUIRE(loaded.elements.nodes == mesh.elements.nodes);
+  }
+
+  SECTION("The halo cannot be loaded on a different number of ranks")
+  {
+    cfg::hpc::write_mesh(output, mesh.nodes, mesh.elements, halo, MPI_COMM_WORLD);
+
+    MPI_Comm comm = MPI_COMM_NULL;
+    MPI_Comm_split(MPI_COMM_WORLD, (parallel.rank < 2) ? 0 : MPI_UNDEFINED, 0, &comm);
+    if (comm != MPI_COMM_NULL)
+    {
+      REQUIRE_THROWS_AS(cfg::hpc::read_halo(output, comm), std::runtime_error);
+      REQUIRE(cfg::hpc::read_mesh(output, comm).nodes.size() > 0);
+      MPI_Comm_free(&comm);
+    }
+  }
+
+  SECTION("A file without a halo is rejected")
+  {
+    cfg::hpc::write_mesh(output, mesh.nodes, mesh.elements, MPI_COMM_WORLD);
+    REQUIRE_THROWS_AS(cfg::hpc::read_halo(output, MPI_COMM_WORLD), std::runtime_error);
+  }
+
+  MPI_Barrier(MPI_COMM_WORLD);
+  if (parallel.rank == 0)
+  {
+    std::filesystem::remove(output);
+  }
+}
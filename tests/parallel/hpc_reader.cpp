@@ -0,0 +1,198 @@
+/**
+ * hpc_reader.cpp
+ *
+ * Tests loading the partitioned mesh format, including on a different number of ranks.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <vector>
+
+#include <mpi.h>
+
+#include <_element_parser.h>
+#include <_node_parser.h>
+#include <hpc_reader.h>
+#include <hpc_writer.h>
+#include <mpi_utils.h>
+
+namespace
+{
+  // Reads a partition of the test mesh from the GMSH file.
+  cfg::hpc::PartitionedMesh read_gmsh(const cfg::utils::Parallel& parallel)
+  {
+    const auto mode = cfg::parser::Mode::BINARY;
+
+    const cfg::reader::MappedFile mapping{"box-bin.msh"};
+    cfg::reader::MappedStream stream{mapping};
+
+    cfg::hpc::PartitionedMesh mesh;
+    const cfg::reader::SectionReader node_reader("Nodes", stream);
+    const auto node_header = cfg::parser::HeaderParser::parse(node_reader, stream, mode);
+    const cfg::parser::NodeEnvironment node_environment{parallel};
+    mesh.nodes = cfg::parser::NodeSetParser::parse(node_reader, stream, mode, node_header, node_environment);
+
+    const cfg::reader::SectionReader element_reader("Elements", stream);
+    const auto element_header = cfg::parser::ElementHeaderParser::parse(element_reader, stream, mode);
+    const cfg::parser::ElementEnvironment element_environment{parallel};
+    mesh.elements =
+        cfg::parser::ElementDataParser::parse(element_reader, stream, mode, element_header, element_environment);
+
+    return mesh;
+  }
+
+  // Writes the test mesh partitioned over the first n_writers ranks.
+  void write_partitioned(const std::filesystem::path& output, const int n_writers)
+  {
+    const auto world = cfg::utils::make_parallel(MPI_COMM_WORLD);
+
+    MPI_Comm comm = MPI_COMM_NULL;
+    MPI_Comm_split(MPI_COMM_WORLD, (static_cast<int>(world.rank) < n_writers) ? 0 : MPI_UNDEFINED, 0, &comm);
+    if (comm != MPI_COMM_NULL)
+    {
+      const auto mesh = read_gmsh(cfg::utils::make_parallel(comm));
+      cfg::hpc::write_mesh(output, mesh.nodes, mesh.elements, comm);
+      MPI_Comm_free(&comm);
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+  }
+
+  // Checks a loaded partition against the full mesh, and that the partitions cover the mesh.
+  void check_mesh(const cfg::hpc::PartitionedMesh& mesh, MPI_Comm comm)
+  {
+    const cfg::utils::Parallel serial{0, 1};
+    const auto full = read_gmsh(serial);
+
+    std::vector<int> node_count(full.nodes.size(), 0);
+    for (size_t i = 0; i < mesh.nodes.size(); i++)
+    {
+      const auto idx = mesh.nodes.global_idx[i];
+      REQUIRE(idx < full.nodes.size());
+      REQUIRE(mesh.nodes.natural_idx[i] == full.nodes.natural_idx[idx]);
+      for (size_t axis = 0; axis < 3; axis++)
+      {
+        REQUIRE(mesh.nodes.x[axis][i] == full.nodes.x[axis][idx]);
+      }
+      node_count[idx]++;
+    }
+
+    std::vector<int> element_count(full.elements.size(), 0);
+    REQUIRE(mesh.elements.offsets.size() == mesh.elements.size() + 1);
+    REQUIRE(mesh.elements.offsets.back() == mesh.elements.nodes.size());
+    for (size_t i = 0; i < mesh.elements.size(); i++)
+    {
+      const auto idx = mesh.elements.global_idx[i];
+      REQUIRE(idx < full.elements.size());
+      REQUIRE(mesh.elements.natural_idx[i] == full.elements.natural_idx[idx]);
+      REQUIRE(mesh.elements.type[i] == full.elements.type[idx]);
+
+      const auto [first, last]           = mesh.elements.connectivity(i);
+      const auto [full_first, full_last] = full.elements.connectivity(idx);
+      REQUIRE(std::vector<size_t>(first, last) == std::vector<size_t>(full_first, full_last));
+      element_count[idx]++;
+    }
+
+    // Every node and element is loaded exactly once
+    MPI_Allreduce(MPI_IN_PLACE, node_count.data(), static_cast<int>(node_count.size()), MPI_INT, MPI_SUM, comm);
+    MPI_Allreduce(
+        MPI_IN_PLACE, element_count.data(), static_cast<int>(element_count.size()), MPI_INT, MPI_SUM, comm);
+    for (const auto count : node_count)
+    {
+      REQUIRE(count == 1);
+    }
+    for (const auto count : element_count)
+    {
+      REQUIRE(count == 1);
+    }
+  }
+}  // namespace
+
+TEST_CASE("Assign partitioned mesh parts", "[parallel]")
+{
+  for (unsigned int n_ranks = 1; n_ranks <= 16; n_ranks++)
+  {
+    for (uint64_t n_parts = 1; n_parts <= 16; n_parts++)
+    {
+      // Every part is assigned, pieces of a part are assigned to consecutive ranks
+      std::vector<uint64_t> pieces(n_parts, 0);
+      std::vector<uint64_t> n_pieces(n_parts, 0);
+      uint64_t next = 0;
+      for (unsigned int rank = 0; rank < n_ranks; rank++)
+      {
+        const auto assignment = cfg::hpc::assign_parts(n_parts, {rank, n_ranks});
+        REQUIRE(assignment.count >= 1);
+        REQUIRE(assignment.piece < assignment.n_pieces);
+        if (n_parts >= n_ranks)
+        {
+          REQUIRE(assignment.first == next);
+          REQUIRE(assignment.n_pieces == 1);
+          next += assignment.count;
+        }
+        else
+        {
+          REQUIRE(assignment.count == 1);
+          REQUIRE(assignment.piece == pieces[assignment.first]);
+          pieces[assignment.first]++;
+          n_pieces[assignment.first] = assignment.n_pieces;
+        }
+      }
+      if (n_parts >= n_ranks)
+      {
+        REQUIRE(next == n_parts);
+      }
+      else
+      {
+        REQUIRE(pieces == n_pieces);
+      }
+    }
+  }
+}
+
+TEST_CASE("Load a partitioned mesh", "[parallel]")
+{
+  const auto parallel = cfg::utils::make_parallel(MPI_COMM_WORLD);
+  const auto output   = std::filesystem::temp_directory_path() / "cfgrid-test-hpc_reader.cfgm";
+
+  SECTION("On the same number of ranks")
+  {
+    write_partitioned(output, static_cast<int>(parallel.size));
+    const auto mesh    = cfg::hpc::read_mesh(output, MPI_COMM_WORLD);
+    const auto written = read_gmsh(parallel);
+    REQUIRE(mesh.nodes.natural_idx == written.nodes.natural_idx);
+    REQUIRE(mesh.elements.natural_idx == written.elements.natural_idx);
+    check_mesh(mesh, MPI_COMM_WORLD);
+  }
+
+  SECTION("On more ranks, splitting parts")
+  {
+    write_partitioned(output, 2);
+    check_mesh(cfg::hpc::read_mesh(output, MPI_COMM_WORLD), MPI_COMM_WORLD);
+  }
+
+  SECTION("On fewer ranks, merging parts")
+  {
+    write_partitioned(output, static_cast<int>(parallel.size));
+
+    MPI_Comm comm = MPI_COMM_NULL;
+    MPI_Comm_split(MPI_COMM_WORLD, (parallel.rank < 2) ? 0 : MPI_UNDEFINED, 0, &comm);
+    if (comm != MPI_COMM_NULL)
+    {
+      check_mesh(cfg::hpc::read_mesh(output, comm), comm);
+      MPI_Comm_free(&comm);
+    }
+  }
+
+  SECTION("Reject a GMSH file")
+  {
+    REQUIRE_THROWS(cfg::hpc::read_mesh("box-bin.msh", MPI_COMM_WORLD));
+  }
+
+  MPI_Barrier(MPI_COMM_WORLD);
+  if (parallel.rank == 0)
+  {
+    std::filesystem::remove(output);
+  }
+}
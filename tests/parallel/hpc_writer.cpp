@@ -0,0 +1,126 @@
+/**
+ * hpc_writer.cpp
+ *
+ * Tests writing the partitioned mesh format.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <mpi.h>
+
+#include <_element_parser.h>
+#include <_node_parser.h>
+#include <hpc_writer.h>
+#include <mpi_utils.h>
+
+namespace
+{
+  // Reads an array of a part from the file.
+  template <class T>
+  std::vector<T> read_array(std::ifstream& file, const uint64_t offset, const size_t count)
+  {
+    std::vector<T> values(count);
+    file.seekg(static_cast<std::streamoff>(offset));
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    file.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(count * sizeof(T)));
+    return values;
+  }
+
+  // Checks that an array read from the file matches the written values.
+  template <class T, class A>
+  void check_array(std::ifstream& file, const uint64_t offset, const A& expected)
+  {
+    const auto values = read_array<T>(file, offset, expected.size());
+    REQUIRE(file.good());
+    for (size_t i = 0; i < expected.size(); i++)
+    {
+      REQUIRE(values[i] == expected[i]);
+    }
+  }
+}  // namespace
+
+TEST_CASE("Write a partitioned mesh", "[parallel]")
+{
+  const auto parallel = cfg::utils::make_parallel(MPI_COMM_WORLD);
+  const auto mode     = cfg::parser::Mode::BINARY;
+
+  const cfg::reader::MappedFile mapping{"box-bin.msh"};
+  cfg::reader::MappedStream stream{mapping};
+
+  const cfg::reader::SectionReader node_reader("Nodes", stream);
+  const auto node_header = cfg::parser::HeaderParser::parse(node_reader, stream, mode);
+  const cfg::parser::NodeEnvironment node_environment{parallel};
+  const auto nodes = cfg::parser::NodeSetParser::parse(node_reader, stream, mode, node_header, node_environment);
+
+  const cfg::reader::SectionReader element_reader("Elements", stream);
+  const auto element_header = cfg::parser::ElementHeaderParser::parse(element_reader, stream, mode);
+  const cfg::parser::ElementEnvironment element_environment{parallel};
+  const auto elements =
+      cfg::parser::ElementDataParser::parse(element_reader, stream, mode, element_header, element_environment);
+
+  const auto output = std::filesystem::temp_directory_path() / "cfgrid-test-hpc_writer.cfgm";
+  cfg::hpc::write_mesh(output, nodes, elements, MPI_COMM_WORLD);
+
+  std::ifstream file{output, std::ios::in | std::ios::binary};
+  REQUIRE(file.good());
+
+  cfg::hpc::FileHeader header{};
+  // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+  file.read(reinterpret_cast<char*>(&header), sizeof(header));
+  REQUIRE(header.magic == cfg::hpc::magic);
+  REQUIRE(header.version == cfg::hpc::format_version);
+  REQUIRE(header.byte_order == cfg::hpc::byte_order);
+  REQUIRE(header.n_parts == parallel.size);
+  REQUIRE(header.n_nodes == 363);
+  REQUIRE(header.n_elements == 1864);
+
+  const auto table = read_array<cfg::hpc::PartEntry>(file, header.table_offset, header.n_parts);
+
+  // The parts are contiguous and cover the data
+  uint64_t offset     = header.data_offset;
+  uint64_t n_nodes    = 0;
+  uint64_t n_elements = 0;
+  for (const auto& entry : table)
+  {
+    REQUIRE(entry.offset == offset);
+    offset += cfg::hpc::PartLayout{entry}.size;
+    n_nodes += entry.n_nodes;
+    n_elements += entry.n_elements;
+  }
+  REQUIRE(n_nodes == header.n_nodes);
+  REQUIRE(n_elements == header.n_elements);
+  REQUIRE(std::filesystem::file_size(output) == offset);
+
+  // Each rank checks its own part
+  const auto& entry = table[parallel.rank];
+  REQUIRE(entry.n_nodes == nodes.size());
+  REQUIRE(entry.n_elements == elements.size());
+  REQUIRE(entry.n_connectivity == elements.nodes.size());
+
+  const cfg::hpc::PartLayout layout{entry};
+  check_array<uint64_t>(file, entry.offset + layout.node_natural_idx, nodes.natural_idx);
+  check_array<uint64_t>(file, entry.offset + layout.node_global_idx, nodes.global_idx);
+  for (size_t axis = 0; axis < 3; axis++)
+  {
+    check_array<double>(file, entry.offset + layout.node_x[axis], nodes.x[axis]);
+  }
+  check_array<uint64_t>(file, entry.offset + layout.element_natural_idx, elements.natural_idx);
+  check_array<uint64_t>(file, entry.offset + layout.element_global_idx, elements.global_idx);
+  check_array<int32_t>(file, entry.offset + layout.element_type, elements.type);
+  check_array<uint64_t>(file, entry.offset + layout.element_offsets, elements.offsets);
+  check_array<uint64_t>(file, entry.offset + layout.element_nodes, elements.nodes);
+
+  file.close();
+  MPI_Barrier(MPI_COMM_WORLD);
+  if (parallel.rank == 0)
+  {
+    std::filesystem::remove(output);
+  }
+}
@@ -0,0 +1,147 @@
+/**
+ * instrument.cpp
+ *
+ * Tests the instrumentation timers and counters, and their reduction over the ranks.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <filesystem>
+#include <sstream>
+#include <string>
+
+#include <mpi.h>
+
+#include <element_parser.h>
+#include <instrument.h>
+#include <mapped_stream.h>
+#include <mpi_utils.h>
+#include <node_parser.h>
+
+TEST_CASE("Instrumentation is disabled by default", "[parallel]")
+{
+  cfg::utils::reset_profile();
+  REQUIRE_FALSE(cfg::utils::profiling());
+
+  {
+    const cfg::utils::ScopedTimer timer{cfg::utils::Phase::DATA_PARSE};
+    cfg::utils::count(cfg::utils::Counter::NODES, 10);
+  }
+
+  const auto local = cfg::utils::profile();
+  REQUIRE(local.calls[static_cast<size_t>(cfg::utils::Phase::DATA_PARSE)] == 0);
+  REQUIRE(local.seconds[static_cast<size_t>(cfg::utils::Phase::DATA_PARSE)] == 0.0);
+  REQUIRE(local.counts[static_cast<size_t>(cfg::utils::Counter::NODES)] == 0);
+}
+
+TEST_CASE("Reduce instrumentation over the ranks", "[parallel]")
+{
+  const auto parallel = cfg::utils::make_parallel(MPI_COMM_WORLD);
+
+  cfg::utils::reset_profile();
+  cfg::utils::set_profiling(true);
+  for (unsigned int i = 0; i <= parallel.rank; i++)
+  {
+    const cfg::utils::ScopedTimer timer{cfg::utils::Phase::VALIDATION};
+    cfg::utils::count(cfg::utils::Counter::BLOCKS, 2);
+  }
+  cfg::utils::set_profiling(false);
+
+  const auto local = cfg::utils::profile();
+  const auto idx   = static_cast<size_t>(cfg::utils::Phase::VALIDATION);
+  REQUIRE(local.calls[idx] == parallel.rank + 1);
+  REQUIRE(local.counts[static_cast<size_t>(cfg::utils::Counter::BLOCKS)] == 2 * (parallel.rank + 1));
+
+  const auto report  = cfg::utils::reduce_profile(local, MPI_COMM_WORLD);
+  const auto& blocks = report.counts[static_cast<size_t>(cfg::utils::Counter::BLOCKS)];
+  REQUIRE(blocks.min == 2.0);
+  REQUIRE(blocks.max == 2.0 * parallel.size);
+  REQUIRE(blocks.mean == static_cast<double>(parallel.size + 1));
+  REQUIRE(report.seconds[idx].min <= report.seconds[idx].mean);
+  REQUIRE(report.seconds[idx].mean <= report.seconds[idx].max);
+
+  // Only the root gathers the profile of each rank
+  if (parallel.rank == 0)
+  {
+    REQUIRE(report.ranks.size() == parallel.size);
+    for (unsigned int rank = 0; rank < parallel.size; rank++)
+    {
+      REQUIRE(report.ranks[rank].calls[idx] == rank + 1);
+    }
+
+    std::ostringstream json;
+    cfg::utils::write_profile_json(json, report);
+    REQUIRE(json.str().find(R"("n_ranks": 3)") != std::string::npos);
+    REQUIRE(json.str().find(R"("validation": {"stats": )") != std::string::npos);
+    REQUIRE(json.str().find(R"(, "calls": [1, 2, 3]})") != std::string::npos);
+    REQUIRE(json.str().find(R"("blocks": {"stats": {"min": 2, "max": 6, "mean": 4}, "ranks": [2, 4, 6]})") !=
+            std::string::npos);
+  }
+  else
+  {
+    REQUIRE(report.ranks.empty());
+  }
+}
+
+TEST_CASE("Profile reading a mesh", "[parallel]")
+{
+  const auto parallel = cfg::utils::make_parallel(MPI_COMM_WORLD);
+
+  cfg::parser::ElementSet elements;
+  size_t section_bytes = 0;  // The size of the Nodes and Elements sections
+  cfg::utils::reset_profile();
+  cfg::utils::set_profiling(true);
+  {
+    const cfg::reader::MappedFile mapping{"box-bin.msh"};
+    cfg::reader::MappedStream stream{mapping};
+    const cfg::reader::SectionIndex index{stream};
+    static_cast<void>(cfg::parser::read_nodes(stream, cfg::parser::Mode::BINARY, parallel, index));
+    elements = cfg::parser::read_elements(stream, cfg::parser::Mode::BINARY, parallel, index);
+    for (const auto* name : {"Nodes", "Elements"})
+    {
+      section_bytes += index.find(name).end - index.find(name).start;
+    }
+  }
+  cfg::utils::set_profiling(false);
+
+  const auto report = cfg::utils::reduce_profile(cfg::utils::profile(), MPI_COMM_WORLD);
+  const auto total  = [&report, &parallel](const cfg::utils::Counter counter) -> double
+  {
+    return report.counts[static_cast<size_t>(counter)].mean * parallel.size;
+  };
+  REQUIRE(total(cfg::utils::Counter::NODES) == 363);
+  REQUIRE(total(cfg::utils::Counter::ELEMENTS) == 1864);
+
+  // The tokens are the tag and coordinates of each node, and the tag and nodes of each element
+  const auto tokens_idx = static_cast<size_t>(cfg::utils::Counter::TOKENS_PARSED);
+  std::array<unsigned long, 2> tokens{cfg::utils::profile().counts[tokens_idx],
+                                      elements.size() + elements.nodes.size()};
+  MPI_Allreduce(MPI_IN_PLACE, tokens.data(), 2, MPI_UNSIGNED_LONG, MPI_SUM, MPI_COMM_WORLD);
+  REQUIRE(tokens[0] == 4 * 363 + tokens[1]);
+
+  // Each rank reads the section and block headers, which are the same on every rank, and the 8 byte
+  // values of its own nodes and elements only
+  const auto local     = cfg::utils::profile();
+  const auto bytes_idx = static_cast<size_t>(cfg::utils::Counter::BYTES_READ);
+  const auto headers   = static_cast<long>(local.counts[bytes_idx] - 8 * local.counts[tokens_idx]);
+  std::array<long, 2> extremes{headers, -headers};
+  MPI_Allreduce(MPI_IN_PLACE, extremes.data(), 2, MPI_LONG, MPI_MAX, MPI_COMM_WORLD);
+  REQUIRE(headers > 0);
+  REQUIRE(extremes[0] == -extremes[1]);
+  if (parallel.size > 1)
+  {
+    REQUIRE(local.counts[bytes_idx] < section_bytes);
+  }
+  REQUIRE(report.counts[static_cast<size_t>(cfg::utils::Counter::BYTES_SCANNED)].min ==
+          static_cast<double>(std::filesystem::file_size("box-bin.msh")));
+  for (const auto phase : {cfg::utils::Phase::SECTION_SEARCH,
+                           cfg::utils::Phase::HEADER_PARSE,
+                           cfg::utils::Phase::DATA_PARSE,
+                           cfg::utils::Phase::VALIDATION})
+  {
+    REQUIRE(cfg::utils::profile().calls[static_cast<size_t>(phase)] > 0);
+  }
+}
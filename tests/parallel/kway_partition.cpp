@@ -0,0 +1,83 @@
+/**
+ * kway_partition.cpp
+ *
+ * Tests the graph partition of the cells of a mesh.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <sstream>
+#include <vector>
+
+#include <mpi.h>
+
+#include <dual_graph.h>
+#include <element_parser.h>
+#include <graph_partition.h>
+#include <mapped_stream.h>
+#include <mpi_utils.h>
+
+TEST_CASE("Graph partition of a mesh", "[parallel]")
+{
+  const auto parallel = cfg::utils::make_parallel(MPI_COMM_WORLD);
+
+  const cfg::reader::MappedFile mapping{"box-bin.msh"};
+  cfg::reader::MappedStream stream{mapping};
+  const cfg::reader::SectionIndex index{stream};
+  const auto elements = cfg::parser::read_elements(stream, cfg::parser::Mode::BINARY, parallel, index);
+  const auto graph    = cfg::utils::build_dual_graph(elements, MPI_COMM_WORLD);
+
+  for (const unsigned int n_threads : {1U, 2U})
+  {
+    const cfg::utils::GraphPartition partition{graph, MPI_COMM_WORLD, n_threads};
+
+    // Every vertex is assigned to exactly one rank
+    REQUIRE(partition.destinations().size() == graph.size());
+    unsigned long n_owned = partition.size();
+    MPI_Allreduce(MPI_IN_PLACE, &n_owned, 1, MPI_UNSIGNED_LONG, MPI_SUM, MPI_COMM_WORLD);
+    REQUIRE(n_owned == graph.global_size());
+    for (size_t i = 0; i < graph.size(); i++)
+    {
+      const auto dst = static_cast<unsigned int>(partition.destinations()[i]);
+      REQUIRE(dst < parallel.size);
+      REQUIRE(partition.pick(graph.vtxdist[parallel.rank] + i) == (dst == parallel.rank));
+    }
+
+    // The partition is balanced and the cut agrees with the destinations
+    REQUIRE(partition.imbalance() <= 1.0 + cfg::utils::default_tolerance);
+    unsigned long cut = 0;
+    std::vector<int> all_destinations(graph.global_size());
+    std::vector<int> counts(parallel.size);
+    std::vector<int> displs(parallel.size);
+    for (size_t rank = 0; rank < parallel.size; rank++)
+    {
+      counts[rank] = static_cast<int>(graph.vtxdist[rank + 1] - graph.vtxdist[rank]);
+      displs[rank] = static_cast<int>(graph.vtxdist[rank]);
+    }
+    MPI_Allgatherv(partition.destinations().data(),
+                   static_cast<int>(graph.size()),
+                   MPI_INT,
+                   all_destinations.data(),
+                   counts.data(),
+                   displs.data(),
+                   MPI_INT,
+                   MPI_COMM_WORLD);
+    for (size_t i = 0; i < graph.size(); i++)
+    {
+      const auto [first, last] = graph.neighbours(i);
+      for (auto it = first; it != last; ++it)
+      {
+        cut += (all_destinations[*it] != partition.destinations()[i]) ? 1 : 0;
+      }
+    }
+    MPI_Allreduce(MPI_IN_PLACE, &cut, 1, MPI_UNSIGNED_LONG, MPI_SUM, MPI_COMM_WORLD);
+    REQUIRE(partition.edge_cut() == cut / 2);
+    REQUIRE(partition.edge_cut() > 0);
+
+    std::ostringstream os;
+    partition.report(os);
+    REQUIRE(os.str().find("edge cut") != std::string::npos);
+  }
+}
@@ -0,0 +1,143 @@
+/**
+ * mesh_partition.cpp
+ *
+ * Tests the partitioning of a mesh and its migration to the partition.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <mpi.h>
+
+#include <dual_graph.h>
+#include <mesh_partition.h>
+#include <mpi_utils.h>
+#include <reader.h>
+
+namespace
+{
+  // Sums a count over the ranks.
+  unsigned long global_sum(unsigned long count)
+  {
+    MPI_Allreduce(MPI_IN_PLACE, &count, 1, MPI_UNSIGNED_LONG, MPI_SUM, MPI_COMM_WORLD);
+    return count;
+  }
+}  // namespace
+
+TEST_CASE("Partitioner selection", "[parallel]")
+{
+  using cfg::utils::Partitioner;
+
+  for (const auto partitioner : {Partitioner::PARMETIS, Partitioner::SCOTCH, Partitioner::GEOMETRIC})
+  {
+    REQUIRE(cfg::utils::partitioner_by_name(cfg::utils::partitioner_name(partitioner)) == partitioner);
+  }
+  REQUIRE_THROWS_AS(cfg::utils::partitioner_by_name("metis"), std::runtime_error);
+
+  REQUIRE(cfg::utils::partitioner_available(Partitioner::GEOMETRIC));
+  REQUIRE(cfg::utils::partitioner_available(cfg::utils::default_partitioner()));
+  if (!cfg::utils::partitioner_available(Partitioner::PARMETIS))
+  {
+    REQUIRE(cfg::utils::default_partitioner() != Partitioner::PARMETIS);
+  }
+}
+
+TEST_CASE("Partition of a mesh", "[parallel]")
+{
+  const auto parallel = cfg::utils::make_parallel(MPI_COMM_WORLD);
+  const cfg::reader::GmshReader reader{"box-txt.msh", parallel};
+  const auto& nodes    = reader.nodes();
+  const auto& elements = reader.elements();
+
+  const auto graph = cfg::utils::build_dual_graph(elements, MPI_COMM_WORLD);
+
+  SECTION("An unavailable partitioner is rejected")
+  {
+    for (const auto partitioner : {cfg::utils::Partitioner::PARMETIS, cfg::utils::Partitioner::SCOTCH})
+    {
+      if (!cfg::utils::partitioner_available(partitioner))
+      {
+        REQUIRE_THROWS_AS(cfg::utils::CellPartition(graph, nodes, elements, MPI_COMM_WORLD, partitioner),
+                          std::runtime_error);
+      }
+    }
+  }
+
+  SECTION("The cells are partitioned")
+  {
+    const cfg::utils::CellPartition partition{graph, nodes, elements, MPI_COMM_WORLD};
+
+    REQUIRE(cfg::utils::partitioner_available(partition.partitioner()));
+    REQUIRE(partition.destinations().size() == graph.size());
+    REQUIRE(global_sum(partition.size()) == graph.global_size());
+    for (size_t i = 0; i < graph.size(); i++)
+    {
+      const auto dst = static_cast<unsigned int>(partition.destinations()[i]);
+      REQUIRE(dst < parallel.size);
+      REQUIRE(partition.pick(graph.vtxdist[parallel.rank] + i) == (dst == parallel.rank));
+    }
+    REQUIRE(partition.imbalance() >= 1.0);
+    REQUIRE(partition.imbalance() < 1.5);
+
+    std::ostringstream os;
+    partition.report(os);
+    REQUIRE(os.str().find(cfg::utils::partitioner_name(partition.partitioner())) != std::string::npos);
+  }
+
+  SECTION("The mesh is migrated to the partition")
+  {
+    const cfg::utils::CellPartition partition{graph, nodes, elements, MPI_COMM_WORLD};
+    const auto mesh = cfg::utils::migrate_mesh(nodes, elements, graph, partition, MPI_COMM_WORLD);
+
+    // Nothing is lost or duplicated
+    REQUIRE(global_sum(mesh.nodes.size()) == global_sum(nodes.size()));
+    REQUIRE(global_sum(mesh.elements.size()) == global_sum(elements.size()));
+    REQUIRE(global_sum(mesh.elements.nodes.size()) == global_sum(elements.nodes.size()));
+
+    // This rank holds the cells of its partition, which keep their global vertex index
+    const auto moved = cfg::utils::build_dual_graph(mesh.elements, MPI_COMM_WORLD);
+    REQUIRE(moved.size() == partition.size());
+    REQUIRE(moved.global_size() == graph.global_size());
+
+    // Each cell's nodes are held by this rank unless a lower ranked partition also contains them
+    std::vector<size_t> tags(mesh.nodes.natural_idx.begin(), mesh.nodes.natural_idx.end());
+    std::sort(tags.begin(), tags.end());
+    size_t n_missing = 0;
+    for (const auto cell : moved.cells)
+    {
+      const auto [first, last] = mesh.elements.connectivity(cell);
+      n_missing += static_cast<size_t>(std::count_if(first,
+                                                     last,
+                                                     [&tags](const size_t tag)
+                                                     {
+                                                       return !std::binary_search(tags.begin(), tags.end(), tag);
+                                                     }));
+    }
+    if (parallel.rank == 0)
+    {
+      REQUIRE(n_missing == 0);
+    }
+
+    // The global indices of the nodes are unchanged
+    std::vector<size_t> global_idx(mesh.nodes.global_idx.begin(), mesh.nodes.global_idx.end());
+    std::sort(global_idx.begin(), global_idx.end());
+    REQUIRE(std::adjacent_find(global_idx.begin(), global_idx.end()) == global_idx.end());
+  }
+
+  SECTION("The mesh is partitioned in one call")
+  {
+    std::ostringstream os;
+    const auto mesh = cfg::utils::partition_mesh(
+        nodes, elements, MPI_COMM_WORLD, cfg::utils::Partitioner::GEOMETRIC, &os);
+
+    REQUIRE(global_sum(mesh.nodes.size()) == global_sum(nodes.size()));
+    REQUIRE(global_sum(mesh.elements.size()) == global_sum(elements.size()));
+    REQUIRE(os.str().empty() == (parallel.rank != 0));
+  }
+}
@@ -0,0 +1,153 @@
+/**
+ * migration.cpp
+ *
+ * Tests the migration of nodes and elements to arbitrary owner ranks.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+#include <mpi.h>
+
+#include <migration.h>
+#include <mpi_utils.h>
+#include <reader.h>
+
+namespace
+{
+  // Sums a count over the ranks.
+  unsigned long global_sum(unsigned long count)
+  {
+    MPI_Allreduce(MPI_IN_PLACE, &count, 1, MPI_UNSIGNED_LONG, MPI_SUM, MPI_COMM_WORLD);
+    return count;
+  }
+
+  // The owner of an item, scattering the items over the ranks by a hash of their global index.
+  int scattered_owner(const size_t global_idx, const unsigned int n_ranks)
+  {
+    return static_cast<int>((global_idx * 7919U + 13U) % n_ranks);
+  }
+
+  // The owners of a set of items.
+  template <class A>
+  std::vector<int> scattered_owners(const A& global_idx, const unsigned int n_ranks)
+  {
+    std::vector<int> owners(global_idx.size());
+    for (size_t i = 0; i < global_idx.size(); i++)
+    {
+      owners[i] = scattered_owner(global_idx[i], n_ranks);
+    }
+    return owners;
+  }
+}  // namespace
+
+TEST_CASE("Route items to their owners", "[parallel]")
+{
+  const auto items = cfg::utils::route({2, 0, 2, 1, 0}, 3);
+
+  REQUIRE(items.counts == std::vector<int>{2, 1, 2});
+  REQUIRE(items.order == std::vector<size_t>{1, 4, 3, 0, 2});
+}
+
+TEST_CASE("Migration of a mesh", "[parallel]")
+{
+  const auto parallel = cfg::utils::make_parallel(MPI_COMM_WORLD);
+  const cfg::reader::GmshReader reader{"box-txt.msh", parallel};
+  const auto& nodes    = reader.nodes();
+  const auto& elements = reader.elements();
+
+  const auto node_owners    = scattered_owners(nodes.global_idx, parallel.size);
+  const auto element_owners = scattered_owners(elements.global_idx, parallel.size);
+
+  SECTION("Nodes move to their owners with their data")
+  {
+    const auto migrated = cfg::utils::migrate_nodes(nodes, node_owners, MPI_COMM_WORLD);
+
+    REQUIRE(global_sum(migrated.size()) == global_sum(nodes.size()));
+    REQUIRE(std::is_sorted(migrated.global_idx.begin(), migrated.global_idx.end()));
+    for (size_t i = 0; i < migrated.size(); i++)
+    {
+      REQUIRE(scattered_owner(migrated.global_idx[i], parallel.size) == static_cast<int>(parallel.rank));
+    }
+
+    // The nodes read by this rank are found on their owners unchanged
+    const auto round_trip = cfg::utils::migrate_nodes(
+        migrated, std::vector<int>(migrated.size(), 0), MPI_COMM_WORLD);
+    if (parallel.rank == 0)
+    {
+      std::map<size_t, size_t> by_global;
+      for (size_t i = 0; i < round_trip.size(); i++)
+      {
+        by_global[round_trip.global_idx[i]] = i;
+      }
+      const cfg::reader::GmshReader serial{"box-txt.msh", cfg::utils::Parallel{0, 1}, cfg::reader::Backend::MMAP,
+                                           MPI_COMM_SELF};
+      REQUIRE(round_trip.size() == serial.nodes().size());
+      for (size_t i = 0; i < serial.nodes().size(); i++)
+      {
+        const auto j = by_global.at(serial.nodes().global_idx[i]);
+        REQUIRE(round_trip.natural_idx[j] == serial.nodes().natural_idx[i]);
+        for (size_t axis = 0; axis < 3; axis++)
+        {
+          REQUIRE(round_trip.x[axis][j] == serial.nodes().x[axis][i]);
+        }
+      }
+    }
+    else
+    {
+      REQUIRE(round_trip.size() == 0);
+    }
+  }
+
+  SECTION("Elements move to their owners with their nodes")
+  {
+    const auto migrated = cfg::utils::migrate_elements(elements, element_owners, MPI_COMM_WORLD);
+
+    REQUIRE(global_sum(migrated.size()) == global_sum(elements.size()));
+    REQUIRE(global_sum(migrated.nodes.size()) == global_sum(elements.nodes.size()));
+    REQUIRE(std::is_sorted(migrated.global_idx.begin(), migrated.global_idx.end()));
+    REQUIRE(migrated.offsets.size() == migrated.size() + 1);
+
+    const auto round_trip = cfg::utils::migrate_elements(
+        migrated, std::vector<int>(migrated.size(), 0), MPI_COMM_WORLD);
+    if (parallel.rank == 0)
+    {
+      const cfg::reader::GmshReader serial{"box-txt.msh", cfg::utils::Parallel{0, 1}, cfg::reader::Backend::MMAP,
+                                           MPI_COMM_SELF};
+      const auto& expected = serial.elements();
+      REQUIRE(round_trip.size() == expected.size());
+      std::map<size_t, size_t> by_global;
+      for (size_t i = 0; i < round_trip.size(); i++)
+      {
+        by_global[round_trip.global_idx[i]] = i;
+      }
+      for (size_t i = 0; i < expected.size(); i++)
+      {
+        const auto j = by_global.at(expected.global_idx[i]);
+        REQUIRE(round_trip.natural_idx[j] == expected.natural_idx[i]);
+        REQUIRE(round_trip.type[j] == expected.type[i]);
+        const auto [first, last] = expected.connectivity(i);
+        const auto [moved_first, moved_last] = round_trip.connectivity(j);
+        REQUIRE(std::equal(first, last, moved_first, moved_last));
+      }
+    }
+  }
+
+  SECTION("Invalid owners are rejected on every rank")
+  {
+    auto owners = node_owners;
+    if ((parallel.rank == 0) && !owners.empty())
+    {
+      owners[0] = static_cast<int>(parallel.size);
+    }
+    REQUIRE_THROWS_AS(cfg::utils::migrate_nodes(nodes, owners, MPI_COMM_WORLD), std::runtime_error);
+    REQUIRE_THROWS_AS(cfg::utils::migrate_elements(elements, std::vector<int>{}, MPI_COMM_WORLD),
+                      std::runtime_error);
+  }
+}
@@ -0,0 +1,27 @@
+/**
+ * mpi_main.cpp
+ *
+ * The main function for the parallel tests, runs the Catch2 session between initialising and
+ * finalising MPI.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <catch2/catch_session.hpp>
+
+#include <mpi.h>
+
+int main(int argc, char* argv[])
+{
+  MPI_Init(&argc, &argv);
+
+  int result = Catch::Session().run(argc, argv);
+
+  // Every rank should report failure if any rank failed
+  int global_result = 0;
+  MPI_Allreduce(&result, &global_result, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+
+  MPI_Finalize();
+
+  return global_result;
+}
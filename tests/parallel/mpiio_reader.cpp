@@ -0,0 +1,57 @@
+/**
+ * mpiio_reader.cpp
+ *
+ * Tests collectively reading nodes through MPI-IO.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <mpi.h>
+
+#include <_node_parser.h>
+#include <mpiio_reader.h>
+
+TEST_CASE("Collective node reading", "[parallel, binary]")
+{
+  int rank = 0;
+  int size = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+  const auto nodes = cfg::parser::read_nodes_collective("box-bin.msh", MPI_COMM_WORLD);
+
+  SECTION("All nodes are read")
+  {
+    unsigned long n_local = nodes.size();
+    unsigned long n_nodes = 0;
+    MPI_Allreduce(&n_local, &n_nodes, 1, MPI_UNSIGNED_LONG, MPI_SUM, MPI_COMM_WORLD);
+    REQUIRE(n_nodes == 363);
+  }
+
+  SECTION("Nodes match the serial reader")
+  {
+    cfg::utils::Parallel parallel{};
+    parallel.rank = rank;
+    parallel.size = size;
+
+    std::ifstream ifs{"box-bin.msh", std::ios::binary};
+    const cfg::reader::SectionReader node_reader("Nodes", ifs);
+    const auto expect =
+        cfg::parser::make_node_reader<std::istream>(parallel)(node_reader, ifs, cfg::parser::Mode::BINARY);
+
+    REQUIRE(nodes.size() == expect.size());
+    for (size_t i = 0; i < nodes.size(); i++)
+    {
+      REQUIRE(nodes[i].natural_idx == expect[i].natural_idx);
+      REQUIRE(nodes[i].global_idx == expect[i].global_idx);
+      REQUIRE(nodes[i].x == expect[i].x);
+    }
+  }
+
+  SECTION("ASCII meshes are rejected on all ranks")
+  {
+    REQUIRE_THROWS(cfg::parser::read_nodes_collective("box-txt.msh", MPI_COMM_WORLD));
+  }
+}
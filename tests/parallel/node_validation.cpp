@@ -0,0 +1,76 @@
+/**
+ * node_validation.cpp
+ *
+ * Tests validating the nodes read by all ranks.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <mpi.h>
+
+#include <_node_parser.h>
+#include <mpi_utils.h>
+
+TEST_CASE("Global node validation", "[parallel]")
+{
+  const auto parallel = cfg::utils::make_parallel(MPI_COMM_WORLD);
+  const auto global   = cfg::parser::Validation::GLOBAL;
+
+  // Each rank holds its share of the nodes in file order, whose tags are 1..n_nodes
+  const size_t n_nodes = 30;
+  const cfg::parser::NodeHeader hdr{n_nodes, 1, 1, n_nodes};
+  const cfg::utils::NaivePartition partition{parallel, n_nodes};
+  const auto nodes = [&partition]() -> cfg::parser::NodeSet<3>
+  {
+    cfg::parser::NodeSet<3> nodes;
+    nodes.resize(partition.size());
+    for (size_t i = 0; i < partition.size(); i++)
+    {
+      nodes.natural_idx[i] = partition.start() + i + 1;
+      nodes.global_idx[i]  = partition.start() + i;
+    }
+    return nodes;
+  }();
+
+  SECTION("Valid nodes don't raise error")
+  {
+    REQUIRE_NOTHROW(cfg::parser::validate_nodes(nodes, hdr, parallel, global, MPI_COMM_WORLD));
+  }
+
+  SECTION("Duplicates across ranks raise error on all ranks")
+  {
+    // The first rank holds the last tag in place of its first, so no rank holds a duplicate
+    auto duplicated = nodes;
+    if (parallel.rank == 0)
+    {
+      duplicated.natural_idx[0] = n_nodes;
+    }
+    REQUIRE_NOTHROW(cfg::parser::validate_nodes(duplicated, hdr, parallel));
+    REQUIRE_THROWS(cfg::parser::validate_nodes(duplicated, hdr, parallel, global, MPI_COMM_WORLD));
+  }
+
+  SECTION("An error on one rank is raised on all ranks")
+  {
+    auto invalid = nodes;
+    if (parallel.rank == (parallel.size - 1))
+    {
+      invalid.natural_idx[0] = n_nodes + 1;
+    }
+    REQUIRE_THROWS(cfg::parser::validate_nodes(invalid, hdr, parallel, global, MPI_COMM_WORLD));
+  }
+
+  SECTION("The tags read by all ranks must span the expected range")
+  {
+    // Each rank's tags lie within the range, but the first tag is never read
+    const cfg::parser::NodeHeader wide{n_nodes, 1, 0, n_nodes};
+    REQUIRE_NOTHROW(cfg::parser::validate_nodes(nodes, wide, parallel));
+    REQUIRE_THROWS(cfg::parser::validate_nodes(nodes, wide, parallel, global, MPI_COMM_WORLD));
+  }
+
+  SECTION("Global validation requires a communicator")
+  {
+    REQUIRE_THROWS(cfg::parser::validate_nodes(nodes, hdr, parallel, global));
+  }
+}
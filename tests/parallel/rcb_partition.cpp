@@ -0,0 +1,147 @@
+/**
+ * rcb_partition.cpp
+ *
+ * Tests the recursive coordinate bisection partitioner.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+#include <mpi.h>
+
+#include <_node_parser.h>
+#include <geometric_partition.h>
+#include <mpi_utils.h>
+
+namespace
+{
+  // Reads this rank's nodes from a mesh file.
+  cfg::parser::NodeSet<3> read_node_set(const std::string& mesh_file,
+                                        const cfg::parser::Mode mode,
+                                        const cfg::utils::Parallel& parallel)
+  {
+    const cfg::reader::MappedFile mapping{mesh_file};
+    cfg::reader::MappedStream stream{mapping};
+    const cfg::reader::SectionReader node_reader("Nodes", stream);
+    const auto node_header = cfg::parser::HeaderParser::parse(node_reader, stream, mode);
+    const cfg::parser::NodeEnvironment environment{parallel};
+    return cfg::parser::NodeSetParser::parse(node_reader, stream, mode, node_header, environment);
+  }
+
+  // Gathers the number of nodes owned by each rank.
+  std::vector<unsigned long> gather_sizes(const cfg::utils::GeometricPartition& partition)
+  {
+    const auto parallel         = cfg::utils::make_parallel(MPI_COMM_WORLD);
+    const unsigned long n_local = partition.size();
+    std::vector<unsigned long> sizes(parallel.size);
+    MPI_Allgather(&n_local, 1, MPI_UNSIGNED_LONG, sizes.data(), 1, MPI_UNSIGNED_LONG, MPI_COMM_WORLD);
+    return sizes;
+  }
+}  // namespace
+
+TEST_CASE("RCB partition of a mesh", "[parallel]")
+{
+  const auto parallel = cfg::utils::make_parallel(MPI_COMM_WORLD);
+  const auto nodes    = read_node_set("box-txt.msh", cfg::parser::Mode::ASCII, parallel);
+
+  const cfg::utils::RCBPartition partition{nodes, MPI_COMM_WORLD};
+
+  SECTION("The partition is balanced")
+  {
+    const auto sizes = gather_sizes(partition);
+    unsigned long n_nodes = 0;
+    for (const auto size : sizes)
+    {
+      n_nodes += size;
+    }
+    REQUIRE(n_nodes == 363);
+
+    const auto [min_size, max_size] = std::minmax_element(sizes.begin(), sizes.end());
+    REQUIRE((*max_size - *min_size) <= 1);
+    REQUIRE(partition.imbalance() >= 1.0);
+    REQUIRE(partition.imbalance() < 1.01);
+  }
+
+  SECTION("Every node is picked by its destination")
+  {
+    // Each rank checks the nodes destined for it
+    REQUIRE(partition.destinations().size() == nodes.size());
+
+    std::vector<unsigned long> picked(parallel.size, 0);
+    for (size_t i = 0; i < nodes.size(); i++)
+    {
+      const auto dst = static_cast<size_t>(partition.destinations()[i]);
+      REQUIRE(dst < parallel.size);
+      if (dst == parallel.rank)
+      {
+        REQUIRE(partition.pick(nodes.global_idx[i]));
+      }
+      picked[dst]++;
+    }
+    MPI_Allreduce(MPI_IN_PLACE, picked.data(), static_cast<int>(parallel.size), MPI_UNSIGNED_LONG, MPI_SUM,
+                  MPI_COMM_WORLD);
+    REQUIRE(picked == gather_sizes(partition));
+  }
+
+  SECTION("Nodes lie within their partition's bounding box")
+  {
+    const auto& boxes = partition.bounding_boxes();
+    REQUIRE(boxes.size() == parallel.size);
+    for (size_t i = 0; i < nodes.size(); i++)
+    {
+      const auto& box = boxes[static_cast<size_t>(partition.destinations()[i])];
+      for (size_t axis = 0; axis < 3; axis++)
+      {
+        REQUIRE(nodes.x[axis][i] >= box.min[axis]);
+        REQUIRE(nodes.x[axis][i] <= box.max[axis]);
+      }
+    }
+
+    // The bisection cuts space, so the boxes should not overlap in volume
+    for (size_t a = 0; a < boxes.size(); a++)
+    {
+      for (size_t b = a + 1; b < boxes.size(); b++)
+      {
+        bool separated = false;
+        for (size_t axis = 0; axis < 3; axis++)
+        {
+          separated = separated || (boxes[a].max[axis] <= boxes[b].min[axis]) ||
+                      (boxes[b].max[axis] <= boxes[a].min[axis]);
+        }
+        REQUIRE(separated);
+      }
+    }
+
+    std::ostringstream report;
+    partition.report(report);
+    REQUIRE(report.str().find("imbalance") != std::string::npos);
+  }
+}
+
+TEST_CASE("RCB partition with coincident nodes", "[parallel]")
+{
+  // Every node has the same coordinates, the partition must still be balanced
+  const auto parallel = cfg::utils::make_parallel(MPI_COMM_WORLD);
+  const size_t n_local = 10 + parallel.rank;
+
+  cfg::parser::NodeSet<3> nodes(n_local);
+  size_t offset = 0;
+  for (unsigned int rank = 0; rank < parallel.rank; rank++)
+  {
+    offset += 10 + rank;
+  }
+  for (size_t i = 0; i < n_local; i++)
+  {
+    nodes.set(i, {offset + i, offset + i, {1.0, 2.0, 3.0}});
+  }
+
+  const cfg::utils::RCBPartition partition{nodes, MPI_COMM_WORLD};
+  const auto sizes                = gather_sizes(partition);
+  const auto [min_size, max_size] = std::minmax_element(sizes.begin(), sizes.end());
+  REQUIRE((*max_size - *min_size) <= 1);
+}
@@ -0,0 +1,139 @@
+/**
+ * sfc_partition.cpp
+ *
+ * Tests the space-filling-curve partitioner and renumbering.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+#include <mpi.h>
+
+#include <_node_parser.h>
+#include <mpi_utils.h>
+#include <sfc_partition.h>
+
+namespace
+{
+  // Reads this rank's nodes from a mesh file.
+  cfg::parser::NodeSet<3> read_node_set(const std::string& mesh_file,
+                                        const cfg::parser::Mode mode,
+                                        const cfg::utils::Parallel& parallel)
+  {
+    const cfg::reader::MappedFile mapping{mesh_file};
+    cfg::reader::MappedStream stream{mapping};
+    const cfg::reader::SectionReader node_reader("Nodes", stream);
+    const auto node_header = cfg::parser::HeaderParser::parse(node_reader, stream, mode);
+    const cfg::parser::NodeEnvironment environment{parallel};
+    return cfg::parser::NodeSetParser::parse(node_reader, stream, mode, node_header, environment);
+  }
+
+  // Gathers the number of nodes owned by each rank.
+  std::vector<unsigned long> gather_sizes(const cfg::utils::GeometricPartition& partition)
+  {
+    const auto parallel         = cfg::utils::make_parallel(MPI_COMM_WORLD);
+    const unsigned long n_local = partition.size();
+    std::vector<unsigned long> sizes(parallel.size);
+    MPI_Allgather(&n_local, 1, MPI_UNSIGNED_LONG, sizes.data(), 1, MPI_UNSIGNED_LONG, MPI_COMM_WORLD);
+    return sizes;
+  }
+}  // namespace
+
+TEST_CASE("SFC partition of a mesh", "[parallel]")
+{
+  const auto parallel = cfg::utils::make_parallel(MPI_COMM_WORLD);
+  const auto nodes    = read_node_set("box-txt.msh", cfg::parser::Mode::ASCII, parallel);
+
+  for (const auto curve : {cfg::utils::Curve::HILBERT, cfg::utils::Curve::MORTON})
+  {
+    const cfg::utils::SFCPartition partition{nodes, MPI_COMM_WORLD, curve};
+
+    const auto sizes      = gather_sizes(partition);
+    unsigned long n_nodes = 0;
+    for (const auto size : sizes)
+    {
+      n_nodes += size;
+    }
+    REQUIRE(n_nodes == 363);
+    const auto [min_size, max_size] = std::minmax_element(sizes.begin(), sizes.end());
+    REQUIRE((*max_size - *min_size) <= 1);
+
+    // Each rank's partition is a contiguous range of the curve
+    const auto keys = cfg::utils::sfc_keys(nodes, cfg::utils::global_bounding_box(nodes, MPI_COMM_WORLD), curve);
+    std::vector<uint64_t> key_min(parallel.size, std::numeric_limits<uint64_t>::max());
+    std::vector<uint64_t> key_max(parallel.size, 0);
+    REQUIRE(partition.destinations().size() == nodes.size());
+    for (size_t i = 0; i < nodes.size(); i++)
+    {
+      const auto dst = static_cast<size_t>(partition.destinations()[i]);
+      REQUIRE(dst < parallel.size);
+      if (dst == parallel.rank)
+      {
+        REQUIRE(partition.pick(nodes.global_idx[i]));
+      }
+      key_min[dst] = std::min(key_min[dst], keys[i]);
+      key_max[dst] = std::max(key_max[dst], keys[i]);
+    }
+    MPI_Allreduce(MPI_IN_PLACE, key_min.data(), static_cast<int>(parallel.size), MPI_UINT64_T, MPI_MIN,
+                  MPI_COMM_WORLD);
+    MPI_Allreduce(MPI_IN_PLACE, key_max.data(), static_cast<int>(parallel.size), MPI_UINT64_T, MPI_MAX,
+                  MPI_COMM_WORLD);
+    for (size_t rank = 1; rank < parallel.size; rank++)
+    {
+      REQUIRE(key_max[rank - 1] <= key_min[rank]);
+    }
+  }
+}
+
+TEST_CASE("SFC partition with coincident nodes", "[parallel]")
+{
+  // Every node has the same key, the partition must still be balanced
+  const auto parallel  = cfg::utils::make_parallel(MPI_COMM_WORLD);
+  const size_t n_local = 10 + 3 * parallel.rank;
+
+  cfg::parser::NodeSet<3> nodes(n_local);
+  for (size_t i = 0; i < n_local; i++)
+  {
+    nodes.set(i, {i, 100 * parallel.rank + i, {1.0, 2.0, 3.0}});
+  }
+
+  const cfg::utils::SFCPartition partition{nodes, MPI_COMM_WORLD};
+  const auto sizes                = gather_sizes(partition);
+  const auto [min_size, max_size] = std::minmax_element(sizes.begin(), sizes.end());
+  REQUIRE((*max_size - *min_size) <= 1);
+}
+
+TEST_CASE("SFC renumbering", "[parallel]")
+{
+  const auto parallel = cfg::utils::make_parallel(MPI_COMM_WORLD);
+  auto nodes          = read_node_set("box-bin.msh", cfg::parser::Mode::BINARY, parallel);
+  const auto n_local  = nodes.size();
+
+  cfg::utils::sfc_renumber(nodes, MPI_COMM_WORLD);
+  REQUIRE(nodes.size() == n_local);
+
+  // The nodes are ordered along the curve
+  const auto keys = cfg::utils::sfc_keys(nodes, cfg::utils::global_bounding_box(nodes, MPI_COMM_WORLD),
+                                         cfg::utils::Curve::HILBERT);
+  REQUIRE(std::is_sorted(keys.begin(), keys.end()));
+
+  // The global indices are a permutation of [0, n_nodes)
+  std::vector<int> counts(363, 0);
+  for (const auto idx : nodes.global_idx)
+  {
+    REQUIRE(idx < counts.size());
+    counts[idx]++;
+  }
+  MPI_Allreduce(MPI_IN_PLACE, counts.data(), static_cast<int>(counts.size()), MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+  REQUIRE(std::all_of(counts.begin(),
+                      counts.end(),
+                      [](const int count) -> bool
+                      {
+                        return count == 1;
+                      }));
+}
@@ -0,0 +1,117 @@
+/**
+ * Tests the pipelined file stream.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+
+#include <async_stream.h>
+#include <element_parser.h>
+#include <mapped_stream.h>
+#include <node_parser.h>
+
+namespace
+{
+  // Reads a whole file into a string.
+  std::string read_file(const std::string& path)
+  {
+    std::ifstream ifs{path, std::ios::in | std::ios::binary};
+    return {std::istreambuf_iterator<char>{ifs}, std::istreambuf_iterator<char>{}};
+  }
+}  // namespace
+
+TEST_CASE("Read a file through an async stream", "[async]")
+{
+  const auto expect = read_file("box-bin.msh");
+
+  for (const size_t chunk_size : {1UL, 7UL, 4096UL, 1UL << 22U})
+  {
+    for (const size_t depth : {2UL, 3UL, 8UL})
+    {
+      cfg::reader::AsyncFileStream stream{"box-bin.msh", chunk_size, depth};
+      const std::string bytes{std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+      REQUIRE(bytes == expect);
+    }
+  }
+}
+
+TEST_CASE("Seek an async stream", "[async]")
+{
+  const auto expect = read_file("box-txt.msh");
+
+  cfg::reader::AsyncFileStream stream{"box-txt.msh", 1000, 2};
+  REQUIRE(stream.tellg() == 0);
+
+  // Read blocks at random positions, within and beyond the current chunk
+  std::mt19937 gen{42};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+  std::uniform_int_distribution<size_t> dist{0, expect.size() - 1};
+  std::string block(100, '\0');
+  for (int i = 0; i < 200; i++)
+  {
+    const auto pos   = dist(gen);
+    const auto count = std::min(block.size(), expect.size() - pos);
+    stream.clear();
+    stream.seekg(static_cast<std::streamoff>(pos));
+    REQUIRE(stream.tellg() == static_cast<std::streamoff>(pos));
+    stream.read(block.data(), static_cast<std::streamsize>(count));
+    REQUIRE(block.substr(0, count) == expect.substr(pos, count));
+    REQUIRE(stream.tellg() == static_cast<std::streamoff>(pos + count));
+  }
+
+  // Relative seeks, and reading to the end of the file
+  stream.seekg(-10, std::ios::end);
+  REQUIRE(stream.tellg() == static_cast<std::streamoff>(expect.size() - 10));
+  stream.seekg(-5, std::ios::cur);
+  std::string tail{std::istreambuf_iterator<char>{stream}, std::istreambuf_iterator<char>{}};
+  REQUIRE(tail == expect.substr(expect.size() - 15));
+  REQUIRE(stream.peek() == std::char_traits<char>::eof());
+
+  // Seeking outside the file fails
+  stream.clear();
+  stream.seekg(static_cast<std::streamoff>(expect.size() + 1));
+  REQUIRE(stream.fail());
+}
+
+TEST_CASE("Async stream errors", "[async]")
+{
+  REQUIRE_THROWS(cfg::reader::AsyncFileStream{"does-not-exist.msh"});
+}
+
+TEST_CASE("Parse a mesh through an async stream", "[async]")
+{
+  for (const auto& [meshfile, mode] : {std::pair{"box-txt.msh", cfg::parser::Mode::ASCII},
+                                       std::pair{"box-bin.msh", cfg::parser::Mode::BINARY}})
+  {
+    const cfg::utils::Parallel parallel{1, 3};
+
+    const cfg::reader::MappedFile mapping{meshfile};
+    cfg::reader::MappedStream mapped{mapping};
+    const cfg::reader::SectionIndex mapped_index{mapped};
+    const auto expect_nodes    = cfg::parser::read_nodes(mapped, mode, parallel, mapped_index);
+    const auto expect_elements = cfg::parser::read_elements(mapped, mode, parallel, mapped_index);
+
+    // Small chunks so that the sections span many chunks
+    cfg::reader::AsyncFileStream stream{meshfile, 512, 3};
+    const cfg::reader::SectionIndex index{stream};
+    REQUIRE(index.sections() == mapped_index.sections());
+
+    const auto nodes = cfg::parser::read_nodes(stream, mode, parallel, index);
+    REQUIRE(nodes.size() == expect_nodes.size());
+    for (size_t i = 0; i < nodes.size(); i++)
+    {
+      REQUIRE(nodes[i].natural_idx == expect_nodes[i].natural_idx);
+      REQUIRE(nodes[i].x == expect_nodes[i].x);
+    }
+
+    const auto elements = cfg::parser::read_elements(stream, mode, parallel, index);
+    REQUIRE(elements.natural_idx == expect_elements.natural_idx);
+    REQUIRE(elements.offsets == expect_elements.offsets);
+    REQUIRE(elements.nodes == expect_elements.nodes);
+  }
+}
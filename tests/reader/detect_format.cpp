@@ -11,6 +11,9 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <filesystem>
+#include <fstream>
+
 #include <detect_format.h>
 
 TEST_CASE("Detect gmsh header", "[format]")
@@ -54,6 +57,21 @@ TEST_CASE("Detect gmsh file", "[format]")
   }
 }
 
+TEST_CASE("Detect partitioned mesh file", "[format]")
+{
+  const auto meshfile = std::filesystem::temp_directory_path() / "cfgrid-test-detect_format.cfgm";
+  {
+    std::ofstream ostream(meshfile, std::ios::out | std::ios::binary);
+    ostream.write(cfg::hpc::magic.data(), cfg::hpc::magic.size());
+  }
+
+  const cfg::reader::FormatDetector detector;
+  REQUIRE(detector.get_format(meshfile) == cfg::reader::MeshFormat::PARTITIONED);
+  REQUIRE_FALSE(cfg::reader::PartitionedDetector::is_partitioned_file("box-bin.msh"));
+
+  std::filesystem::remove(meshfile);
+}
+
 TEST_CASE("Error handling in mesh format detection", "[format]")
 {
   const cfg::reader::FormatDetector detector;
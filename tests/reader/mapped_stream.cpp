@@ -0,0 +1,174 @@
+/**
+ * mapped_stream.cpp
+ *
+ * Tests reading from memory-mapped mesh files through the MappedStream interface.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <fstream>
+#include <string>
+
+#include <mapped_stream.h>
+#include <section_reader.h>
+
+TEST_CASE("Extract from mapped stream", "[mapped]")
+{
+  const std::string data{"$Nodes\n1 -2 +3 0.5 1e-07\nfoo bar\n"};
+
+  SECTION("Formatted extraction")
+  {
+    cfg::reader::MappedStream stream{data};
+
+    std::string word;
+    size_t s      = 0;
+    int i         = 0;
+    int j         = 0;
+    double x      = 0;
+    double y      = 0;
+    REQUIRE(stream >> word);
+    REQUIRE(word == "$Nodes");
+    REQUIRE(stream >> s >> i >> j >> x >> y);
+    REQUIRE(s == 1);
+    REQUIRE(i == -2);
+    REQUIRE(j == 3);
+    REQUIRE(x == 0.5);
+    REQUIRE(y == 1e-07);
+
+    // Reading a word as a number fails
+    REQUIRE_FALSE(stream >> i);
+    stream.clear();
+    REQUIRE(stream >> word);
+    REQUIRE(word == "foo");
+  }
+
+  SECTION("Reading past the end sets EOF")
+  {
+    cfg::reader::MappedStream stream{data};
+
+    std::string word;
+    while (stream >> word) {}
+    REQUIRE(word == "bar");
+    REQUIRE(stream.eof());
+    REQUIRE(stream.fail());
+    REQUIRE(stream.tellg() == -1);
+  }
+
+  SECTION("Seek and tell")
+  {
+    cfg::reader::MappedStream stream{data};
+
+    std::string word;
+    stream >> word;
+    REQUIRE(stream.tellg() == 6);
+    stream.seekg(1);
+    stream >> word;
+    REQUIRE(word == "Nodes");
+
+    stream.seekg(0, std::ios::end);
+    REQUIRE(stream.tellg() == static_cast<std::streamoff>(data.size()));
+    stream.seekg(1, std::ios::cur);
+    REQUIRE(stream.fail());
+  }
+
+  SECTION("Read lines")
+  {
+    cfg::reader::MappedStream stream{data};
+
+    std::string line;
+    REQUIRE(getline(stream, line));
+    REQUIRE(line == "$Nodes");
+    REQUIRE(getline(stream, line));
+    REQUIRE(line == "1 -2 +3 0.5 1e-07");
+  }
+
+  SECTION("Unformatted reads")
+  {
+    const std::string bin{"\x01\x02\x03\x04", 4};
+    cfg::reader::MappedStream stream{bin};
+
+    char c = 0;
+    stream.ignore(1);
+    REQUIRE(stream.read(&c, 1));
+    REQUIRE(c == '\x02');
+
+    std::array<char, 4> buf{};
+    REQUIRE_FALSE(stream.read(buf.data(), buf.size()));
+    REQUIRE(stream.eof());
+    REQUIRE(buf[0] == '\x03');
+    REQUIRE(buf[1] == '\x04');
+  }
+}
+
+TEST_CASE("Locate section in mapped stream", "[mapped, section]")
+{
+  const std::string data{
+      "$MeshFormat\n"
+      "4.1 0 8\n"
+      "$EndMeshFormat\n"
+      "$Nodes\n"
+      "27 363 1 363\n"};
+  cfg::reader::MappedStream stream{data};
+
+  const cfg::reader::SectionReader nodes_reader("Nodes", stream);
+  const cfg::reader::SectionReader format_reader("MeshFormat", stream);
+
+  SECTION("Unordered section search")
+  {
+    std::string line;
+
+    nodes_reader.seekg(stream, 0);
+    nodes_reader(stream) >> line;
+    REQUIRE(line == "$Nodes");
+
+    format_reader.seekg(stream, 0);
+    format_reader(stream) >> line;
+    REQUIRE(line == "$MeshFormat");
+  }
+
+  SECTION("Read until section end")
+  {
+    std::string line;
+
+    format_reader.seekg(stream, 0);
+    while (format_reader(stream) >> line) {}
+    REQUIRE(line == "$EndMeshFormat");
+  }
+
+  SECTION("Read section without end")
+  {
+    nodes_reader.seekg(stream, 0);
+    auto run = [&]()
+    {
+      std::string line;
+      while (nodes_reader(stream) >> line) {}
+    };
+    REQUIRE_THROWS(run());
+  }
+}
+
+// These are closer to integration tests
+TEST_CASE("Map mesh files", "[mapped]")
+{
+  SECTION("Mapping matches file contents")
+  {
+    const cfg::reader::MappedFile mapping{"box-bin.msh"};
+
+    std::ifstream ifs{"box-bin.msh", std::ios::binary};
+    const std::string contents{std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>()};
+    REQUIRE(mapping.bytes() == contents);
+  }
+
+  SECTION("Mapping an empty file")
+  {
+    const cfg::reader::MappedFile mapping{"unknown.msh"};
+    REQUIRE(mapping.bytes().empty());
+  }
+
+  SECTION("Mapping a missing file")
+  {
+    REQUIRE_THROWS_AS(cfg::reader::MappedFile{"non-existent.msh"}, cfg::reader::mapping_error);
+  }
+}
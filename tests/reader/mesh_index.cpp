@@ -0,0 +1,178 @@
+/**
+ * Tests indexing the layout of a mesh file and caching the index in a sidecar file.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include <element_parser.h>
+#include <mapped_stream.h>
+#include <mesh_index.h>
+#include <node_parser.h>
+
+namespace
+{
+  // Checks two indices of the same file agree.
+  void check_index(const cfg::reader::MeshIndex& a, const cfg::reader::MeshIndex& b)
+  {
+    REQUIRE(a.sections.sections() == b.sections.sections());
+
+    REQUIRE(a.node_header.n_nodes == b.node_header.n_nodes);
+    REQUIRE(a.node_header.n_blocks == b.node_header.n_blocks);
+    REQUIRE(a.node_header.min_tag == b.node_header.min_tag);
+    REQUIRE(a.node_header.max_tag == b.node_header.max_tag);
+    REQUIRE(a.nodes.end == b.nodes.end);
+    REQUIRE(a.nodes.blocks.size() == b.nodes.blocks.size());
+    for (size_t i = 0; i < a.nodes.blocks.size(); i++)
+    {
+      REQUIRE(a.nodes.blocks[i].n_nodes == b.nodes.blocks[i].n_nodes);
+      REQUIRE(a.nodes.blocks[i].first == b.nodes.blocks[i].first);
+      REQUIRE(a.nodes.blocks[i].tags_offset == b.nodes.blocks[i].tags_offset);
+      REQUIRE(a.nodes.blocks[i].coords_offset == b.nodes.blocks[i].coords_offset);
+    }
+
+    REQUIRE(a.element_header.n_elements == b.element_header.n_elements);
+    REQUIRE(a.element_header.n_blocks == b.element_header.n_blocks);
+    REQUIRE(a.elements.end == b.elements.end);
+    REQUIRE(a.elements.blocks.size() == b.elements.blocks.size());
+    for (size_t i = 0; i < a.elements.blocks.size(); i++)
+    {
+      REQUIRE(a.elements.blocks[i].type == b.elements.blocks[i].type);
+      REQUIRE(a.elements.blocks[i].n_elements == b.elements.blocks[i].n_elements);
+      REQUIRE(a.elements.blocks[i].first == b.elements.blocks[i].first);
+      REQUIRE(a.elements.blocks[i].offset == b.elements.blocks[i].offset);
+    }
+  }
+}  // namespace
+
+TEST_CASE("Build a mesh index", "[index]")
+{
+  for (const auto& [meshfile, mode] : {std::pair{"box-txt.msh", cfg::parser::Mode::ASCII},
+                                       std::pair{"box-bin.msh", cfg::parser::Mode::BINARY}})
+  {
+    const cfg::reader::MappedFile mapping{meshfile};
+    cfg::reader::MappedStream mapped{mapping};
+    const auto index = cfg::reader::build_mesh_index(mapped, mode);
+
+    REQUIRE(index.node_header.n_nodes == 363);
+    REQUIRE(index.element_header.n_elements == 1864);
+
+    // The blocks cover the nodes and elements, and the data ends at the section end
+    size_t n_nodes = 0;
+    for (const auto& block : index.nodes.blocks)
+    {
+      REQUIRE(block.first == n_nodes);
+      n_nodes += block.n_nodes;
+    }
+    REQUIRE(n_nodes == index.node_header.n_nodes);
+
+    size_t n_elements = 0;
+    for (const auto& block : index.elements.blocks)
+    {
+      REQUIRE(block.first == n_elements);
+      n_elements += block.n_elements;
+    }
+    REQUIRE(n_elements == index.element_header.n_elements);
+
+    const auto bytes = mapping.bytes();
+    REQUIRE(bytes.substr(index.nodes.end).find_first_not_of(" \r\n") ==
+            index.sections.find("Nodes").end - index.nodes.end);
+    REQUIRE(bytes.substr(index.elements.end).find_first_not_of(" \r\n") ==
+            index.sections.find("Elements").end - index.elements.end);
+
+    // The stream backends agree
+    std::ifstream stream{meshfile, std::ios::in | std::ios::binary};
+    check_index(cfg::reader::build_mesh_index(stream, mode), index);
+  }
+}
+
+TEST_CASE("Read using a mesh index", "[index]")
+{
+  for (const auto& [meshfile, mode] : {std::pair{"box-txt.msh", cfg::parser::Mode::ASCII},
+                                       std::pair{"box-bin.msh", cfg::parser::Mode::BINARY}})
+  {
+    const cfg::reader::MappedFile mapping{meshfile};
+    cfg::reader::MappedStream mapped{mapping};
+    const auto index = cfg::reader::build_mesh_index(mapped, mode);
+
+    for (unsigned int rank = 0; rank < 3; rank++)
+    {
+      const cfg::utils::Parallel parallel{rank, 3};
+
+      std::ifstream stream{meshfile, std::ios::in | std::ios::binary};
+      const cfg::reader::SectionIndex sections{stream};
+
+      const auto nodes         = cfg::parser::read_nodes(stream, mode, parallel, sections);
+      const auto indexed_nodes = cfg::parser::read_nodes(mapped, mode, parallel, index);
+      REQUIRE(indexed_nodes.size() == nodes.size());
+      for (size_t i = 0; i < nodes.size(); i++)
+      {
+        REQUIRE(indexed_nodes[i].natural_idx == nodes[i].natural_idx);
+        REQUIRE(indexed_nodes[i].global_idx == nodes[i].global_idx);
+        REQUIRE(indexed_nodes[i].x == nodes[i].x);
+      }
+
+      const auto elements         = cfg::parser::read_elements(stream, mode, parallel, sections);
+      const auto indexed_elements = cfg::parser::read_elements(stream, mode, parallel, index);
+      REQUIRE(indexed_elements.natural_idx == elements.natural_idx);
+      REQUIRE(indexed_elements.global_idx == elements.global_idx);
+      REQUIRE(indexed_elements.type == elements.type);
+      REQUIRE(indexed_elements.offsets == elements.offsets);
+      REQUIRE(indexed_elements.nodes == elements.nodes);
+    }
+  }
+}
+
+TEST_CASE("Cache a mesh index", "[index]")
+{
+  const auto meshfile = std::filesystem::temp_directory_path() / "cfgrid-test-mesh_index.msh";
+  std::filesystem::copy_file("box-bin.msh", meshfile, std::filesystem::copy_options::overwrite_existing);
+  const auto index_file = cfg::reader::index_path(meshfile);
+  std::filesystem::remove(index_file);
+  REQUIRE(index_file.filename() == "cfgrid-test-mesh_index.msh.cfgidx");
+
+  const auto mode = cfg::parser::Mode::BINARY;
+  const auto key  = cfg::reader::file_key(meshfile);
+  REQUIRE(key == cfg::reader::file_key(meshfile));
+  REQUIRE_FALSE(cfg::reader::read_index(index_file, key));
+
+  // The index is built and written on first use, then read from the sidecar
+  {
+    std::ifstream stream{meshfile, std::ios::in | std::ios::binary};
+    const auto index = cfg::reader::load_mesh_index(meshfile, stream, mode, true);
+    REQUIRE(std::filesystem::exists(index_file));
+
+    const auto cached = cfg::reader::read_index(index_file, key);
+    REQUIRE(cached);
+    check_index(*cached, index);
+  }
+
+  // The index is stale once the mesh changes, and is rebuilt
+  {
+    std::ofstream append{meshfile, std::ios::out | std::ios::binary | std::ios::app};
+    append << "\n";
+  }
+  const auto new_key = cfg::reader::file_key(meshfile);
+  REQUIRE_FALSE(new_key == key);
+  REQUIRE_FALSE(cfg::reader::read_index(index_file, new_key));
+  {
+    std::ifstream stream{meshfile, std::ios::in | std::ios::binary};
+    REQUIRE(cfg::reader::load_mesh_index(meshfile, stream, mode, true).node_header.n_nodes == 363);
+    REQUIRE(cfg::reader::read_index(index_file, new_key));
+  }
+
+  // A corrupt index is ignored
+  {
+    std::ofstream corrupt{index_file, std::ios::out | std::ios::binary | std::ios::trunc};
+    corrupt << "CFGINDEX";
+  }
+  REQUIRE_FALSE(cfg::reader::read_index(index_file, new_key));
+
+  std::filesystem::remove(index_file);
+  std::filesystem::remove(meshfile);
+}
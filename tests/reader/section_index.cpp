@@ -0,0 +1,96 @@
+/**
+ * Tests indexing the sections of a mesh file in a single pass.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <mapped_stream.h>
+#include <section_index.h>
+#include <section_reader.h>
+
+TEST_CASE("Index sections", "[section]")
+{
+  // Three sections, the last of which is not closed
+  const std::string mesh{
+      "$MeshFormat\n"
+      "4.1 0 8\n"
+      "$EndMeshFormat\n"
+      "  $Entities\n"
+      "$Spurious\n"
+      "$EndEntities \r\n"
+      "$Nodes\n"
+      "27 363 1 363\n"};
+
+  const cfg::reader::SectionIndex index{std::string_view{mesh}};
+
+  REQUIRE(index.sections().size() == 3);
+  REQUIRE(index.sections()[0].first == "MeshFormat");
+  REQUIRE(index.sections()[1].first == "Entities");
+  REQUIRE(index.sections()[2].first == "Nodes");
+
+  REQUIRE(index.find("MeshFormat").start == 0);
+  REQUIRE(index.find("MeshFormat").end == mesh.find("$EndMeshFormat"));
+  REQUIRE(index.find("Entities").start == mesh.find("$Entities"));
+  REQUIRE(index.find("Entities").end == mesh.find("$EndEntities"));
+  REQUIRE(index.find("Nodes").start == mesh.find("$Nodes"));
+  REQUIRE(index.find("Nodes").end == cfg::reader::SectionIndex::npos);
+
+  // Sygils within a section are not sections
+  REQUIRE_FALSE(index.contains("Spurious"));
+  REQUIRE_THROWS(index.find("Elements"));
+
+  // The same index is built from a stream
+  std::istringstream ss(mesh);
+  const cfg::reader::SectionIndex stream_index{ss};
+  REQUIRE(stream_index.sections() == index.sections());
+  REQUIRE(ss.tellg() == 0);
+}
+
+TEST_CASE("Index sections across chunks", "[section]")
+{
+  // Sections separated by long lines, spanning the chunks a stream is scanned in
+  const std::string filler(3000000, 'x');
+  const std::string mesh = "$First\n" + filler + "\n$EndFirst\n$Second\n" + filler + filler + "\n$EndSecond\n$Third";
+
+  const cfg::reader::SectionIndex index{std::string_view{mesh}};
+  REQUIRE(index.sections().size() == 3);
+  REQUIRE(index.find("Second").start == mesh.find("$Second"));
+  REQUIRE(index.find("Second").end == mesh.find("$EndSecond"));
+  REQUIRE(index.find("Third").start == mesh.find("$Third"));
+
+  std::istringstream ss(mesh);
+  REQUIRE(cfg::reader::SectionIndex{ss}.sections() == index.sections());
+}
+
+TEST_CASE("Index mesh files", "[section]")
+{
+  for (const auto* meshfile : {"box-txt.msh", "box-bin.msh"})
+  {
+    const cfg::reader::MappedFile mapping{meshfile};
+    cfg::reader::MappedStream mapped{mapping};
+    const cfg::reader::SectionIndex index{mapped};
+
+    REQUIRE(index.sections().size() == 4);
+    for (const auto& [name, section] : index.sections())
+    {
+      REQUIRE(section.end != cfg::reader::SectionIndex::npos);
+      REQUIRE(mapping.bytes().substr(section.end, 4 + name.size()) == "$End" + name);
+    }
+
+    std::ifstream stream{meshfile, std::ios::in | std::ios::binary};
+    REQUIRE(cfg::reader::SectionIndex{stream}.sections() == index.sections());
+
+    // Jump straight to the Elements section
+    const cfg::reader::SectionReader element_reader("Elements", mapped, index);
+    std::string word;
+    element_reader.seekg(mapped, 0);
+    element_reader(mapped) >> word;
+    REQUIRE(word == "$Elements");
+  }
+}
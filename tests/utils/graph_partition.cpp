@@ -0,0 +1,196 @@
+/**
+ * graph_partition.cpp
+ *
+ * Tests the multilevel graph partitioner.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <graph_partition.h>
+
+namespace
+{
+  // Builds the graph of an n x n x n grid of cells, each adjacent to the cells sharing a face.
+  cfg::utils::WeightedGraph grid_graph(const size_t n)
+  {
+    cfg::utils::WeightedGraph graph;
+    const auto index = [n](const size_t i, const size_t j, const size_t k) -> size_t
+    {
+      return (k * n + j) * n + i;
+    };
+    for (size_t k = 0; k < n; k++)
+    {
+      for (size_t j = 0; j < n; j++)
+      {
+        for (size_t i = 0; i < n; i++)
+        {
+          const auto add = [&graph](const size_t u)
+          {
+            graph.adjacency.push_back(u);
+            graph.edge_weights.push_back(1);
+          };
+          if (k > 0)
+          {
+            add(index(i, j, k - 1));
+          }
+          if (j > 0)
+          {
+            add(index(i, j - 1, k));
+          }
+          if (i > 0)
+          {
+            add(index(i - 1, j, k));
+          }
+          if (i + 1 < n)
+          {
+            add(index(i + 1, j, k));
+          }
+          if (j + 1 < n)
+          {
+            add(index(i, j + 1, k));
+          }
+          if (k + 1 < n)
+          {
+            add(index(i, j, k + 1));
+          }
+          graph.offsets.push_back(graph.adjacency.size());
+          graph.vertex_weights.push_back(1);
+        }
+      }
+    }
+
+    return graph;
+  }
+
+  // Partitions the cells of an n x n x n grid by recursive coordinate bisection, halving the longest
+  // axis of the block of cells of each part, as the geometric partitioners do.
+  void rcb_grid(const size_t n,
+                const std::array<size_t, 3>& lower,
+                const std::array<size_t, 3>& upper,
+                const int first_part,
+                const size_t n_parts,
+                std::vector<int>& parts)
+  {
+    if (n_parts == 1)
+    {
+      for (auto k = lower[2]; k < upper[2]; k++)
+      {
+        for (auto j = lower[1]; j < upper[1]; j++)
+        {
+          for (auto i = lower[0]; i < upper[0]; i++)
+          {
+            parts[(k * n + j) * n + i] = first_part;
+          }
+        }
+      }
+      return;
+    }
+
+    size_t axis = 0;
+    for (size_t ax = 1; ax < 3; ax++)
+    {
+      if (upper[ax] - lower[ax] > upper[axis] - lower[axis])
+      {
+        axis = ax;
+      }
+    }
+    const auto n_first = n_parts / 2;
+    auto middle        = upper;
+    middle[axis]       = lower[axis] + (upper[axis] - lower[axis]) * n_first / n_parts;
+    auto second        = lower;
+    second[axis]       = middle[axis];
+    rcb_grid(n, lower, middle, first_part, n_first, parts);
+    rcb_grid(n, second, upper, first_part + static_cast<int>(n_first), n_parts - n_first, parts);
+  }
+}  // namespace
+
+TEST_CASE("Partition a grid graph", "[utils]")
+{
+  constexpr size_t n = 16;
+  const auto graph   = grid_graph(n);
+
+  for (const size_t n_parts : {2, 3, 8})
+  {
+    const auto parts = cfg::utils::partition_graph(graph, n_parts);
+    REQUIRE(parts.size() == graph.size());
+    REQUIRE(std::all_of(parts.begin(),
+                        parts.end(),
+                        [n_parts](const int part) -> bool
+                        {
+                          return (part >= 0) && (static_cast<size_t>(part) < n_parts);
+                        }));
+    REQUIRE(cfg::utils::partition_imbalance(graph, parts, n_parts) <= 1.0 + cfg::utils::default_tolerance);
+
+    // The cut is within a small factor of the planar cuts of the grid
+    const auto cut = cfg::utils::partition_cut(graph, parts);
+    REQUIRE(cut > 0);
+    if (n_parts == 2)
+    {
+      REQUIRE(cut <= 2 * n * n);
+    }
+    else if (n_parts == 8)
+    {
+      REQUIRE(cut <= 2 * 3 * n * n);
+    }
+  }
+}
+
+TEST_CASE("The multilevel cut is no worse than coordinate bisection of a grid", "[utils]")
+{
+  constexpr size_t n = 16;
+  const auto graph   = grid_graph(n);
+
+  // The coordinate bisections of the grid are balanced and their cuts planar
+  for (const size_t n_parts : {2, 4, 8, 16})
+  {
+    std::vector<int> rcb(graph.size(), -1);
+    rcb_grid(n, {0, 0, 0}, {n, n, n}, 0, n_parts, rcb);
+    REQUIRE(cfg::utils::partition_imbalance(graph, rcb, n_parts) <= 1.0 + cfg::utils::default_tolerance);
+
+    const auto parts = cfg::utils::partition_graph(graph, n_parts);
+    REQUIRE(cfg::utils::partition_imbalance(graph, parts, n_parts) <= 1.0 + cfg::utils::default_tolerance);
+    REQUIRE(cfg::utils::partition_cut(graph, parts) <= cfg::utils::partition_cut(graph, rcb));
+  }
+}
+
+TEST_CASE("Graph partitions are independent of the number of threads", "[utils]")
+{
+  const auto graph = grid_graph(12);
+  const auto parts = cfg::utils::partition_graph(graph, 4, 1);
+  REQUIRE(cfg::utils::partition_graph(graph, 4, 2) == parts);
+  REQUIRE(cfg::utils::partition_graph(graph, 4, 3) == parts);
+}
+
+TEST_CASE("Partition of small and weighted graphs", "[utils]")
+{
+  // A single part, or an empty graph
+  const auto graph = grid_graph(4);
+  REQUIRE(cfg::utils::partition_graph(graph, 1) == std::vector<int>(graph.size(), 0));
+  REQUIRE(cfg::utils::partition_graph(cfg::utils::WeightedGraph{}, 4).empty());
+  REQUIRE_THROWS_AS(cfg::utils::partition_graph(graph, 0), std::runtime_error);
+
+  // A path of four vertices with a light middle edge is cut there
+  cfg::utils::WeightedGraph path;
+  path.offsets        = {0, 1, 3, 5, 6};
+  path.adjacency      = {1, 0, 2, 1, 3, 2};
+  path.edge_weights   = {5, 5, 1, 1, 5, 5};
+  path.vertex_weights = {1, 1, 1, 1};
+  const auto parts    = cfg::utils::partition_graph(path, 2);
+  REQUIRE(parts[0] == parts[1]);
+  REQUIRE(parts[2] == parts[3]);
+  REQUIRE(parts[0] != parts[2]);
+  REQUIRE(cfg::utils::partition_cut(path, parts) == 1);
+  REQUIRE(cfg::utils::partition_imbalance(path, parts, 2) == 1.0);
+
+  // More parts than vertices leaves parts empty
+  const auto spread = cfg::utils::partition_graph(path, 6);
+  REQUIRE(spread.size() == 4);
+}
@@ -0,0 +1,202 @@
+/**
+ * number_parser.cpp
+ *
+ * Tests the fast ASCII number parser against the standard library.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include <number_parser.h>
+
+namespace
+{
+  // Parses a complete string with the fast parser, failing if the string is not entirely consumed.
+  template <class T>
+  bool parse(const std::string& str, T& val)
+  {
+    const auto* const last = str.data() + str.size();  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const auto [ptr, ec]   = cfg::utils::parse_number(str.data(), last, val);
+    return (ec == std::errc{}) && (ptr == last);
+  }
+
+  // Tests whether two doubles are bit-identical.
+  // NOLINTNEXTLINE(readability-identifier-length)
+  bool identical(const double a, const double b)
+  {
+    return std::memcmp(&a, &b, sizeof(double)) == 0;
+  }
+}  // namespace
+
+TEST_CASE("Parse integers", "[utils]")
+{
+  size_t s = 0;
+  int i    = 0;
+
+  REQUIRE(parse("0", s));
+  REQUIRE(s == 0);
+  REQUIRE(parse("363", s));
+  REQUIRE(s == 363);
+  REQUIRE(parse("18446744073709551615", s));
+  REQUIRE(s == std::numeric_limits<size_t>::max());
+  REQUIRE_FALSE(parse("18446744073709551616", s));
+  REQUIRE_FALSE(parse("-1", s));
+
+  REQUIRE(parse("-2", i));
+  REQUIRE(i == -2);
+  REQUIRE(parse("+3", i));
+  REQUIRE(i == 3);
+  REQUIRE(parse("-2147483648", i));
+  REQUIRE(i == std::numeric_limits<int>::min());
+  REQUIRE_FALSE(parse("2147483648", i));
+  REQUIRE_FALSE(parse("", i));
+  REQUIRE_FALSE(parse("-", i));
+  REQUIRE_FALSE(parse("x", i));
+}
+
+TEST_CASE("Parse doubles", "[utils]")
+{
+  double x = 0;
+
+  SECTION("Simple values")
+  {
+    REQUIRE(parse("0", x));
+    REQUIRE(identical(x, 0.0));
+    REQUIRE(parse("-0", x));
+    REQUIRE(identical(x, -0.0));
+    REQUIRE(parse("0.1", x));
+    REQUIRE(x == 0.1);
+    REQUIRE(parse("+1.5", x));
+    REQUIRE(x == 1.5);
+    REQUIRE(parse("1e-07", x));
+    REQUIRE(x == 1e-07);
+    REQUIRE(parse(".5", x));
+    REQUIRE(x == 0.5);
+    REQUIRE(parse("5.", x));
+    REQUIRE(x == 5.0);
+    REQUIRE(parse("1E+22", x));
+    REQUIRE(x == 1e22);
+  }
+
+  SECTION("Values requiring the fallback")
+  {
+    REQUIRE(parse("0.9999999000000001", x));
+    REQUIRE(x == 0.9999999000000001);
+    REQUIRE(parse("-9.999999994736442e-08", x));
+    REQUIRE(x == -9.999999994736442e-08);
+    REQUIRE(parse("1.7976931348623157e308", x));
+    REQUIRE(x == std::numeric_limits<double>::max());
+    REQUIRE(parse("4.9406564584124654e-324", x));
+    REQUIRE(x == std::numeric_limits<double>::denorm_min());
+  }
+
+  SECTION("Invalid values")
+  {
+    REQUIRE_FALSE(parse("", x));
+    REQUIRE_FALSE(parse("-", x));
+    REQUIRE_FALSE(parse(".", x));
+    REQUIRE_FALSE(parse("$Nodes", x));
+  }
+
+  SECTION("Random values are bit-identical to strtod")
+  {
+    std::mt19937_64 gen{42};  // NOLINT(cert-msc32-c,cert-msc51-cpp)
+    std::uniform_int_distribution<uint64_t> bits;
+    const std::array<const char*, 4> formats{"%.17g", "%.15g", "%.6g", "%.3e"};
+
+    std::array<char, 64> buf{};
+    for (int n = 0; n < 100000; n++)
+    {
+      const auto raw = bits(gen);
+      double value   = 0;
+      std::memcpy(&value, &raw, sizeof(double));
+      if (!std::isfinite(value))
+      {
+        continue;
+      }
+
+      for (const auto* fmt : formats)
+      {
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-vararg,hicpp-vararg)
+        std::snprintf(buf.data(), buf.size(), fmt, value);
+        const std::string str{buf.data()};
+        REQUIRE(parse(str, x));
+        REQUIRE(identical(x, std::strtod(str.c_str(), nullptr)));
+      }
+    }
+  }
+}
+
+TEST_CASE("Extract numbers from a stream", "[utils]")
+{
+  std::istringstream stream{"  1 -2\n0.5\t1e-07 foo"};
+
+  size_t s = 0;
+  int i    = 0;
+  double x = 0;
+  double y = 0;
+  REQUIRE(cfg::utils::extract_number(stream, s));
+  REQUIRE(cfg::utils::extract_number(stream, i));
+  REQUIRE(cfg::utils::extract_number(stream, x));
+  REQUIRE(cfg::utils::extract_number(stream, y));
+  REQUIRE(s == 1);
+  REQUIRE(i == -2);
+  REQUIRE(x == 0.5);
+  REQUIRE(y == 1e-07);
+
+  REQUIRE_FALSE(cfg::utils::extract_number(stream, x));
+  stream.clear();
+  std::string word;
+  REQUIRE(stream >> word);
+  REQUIRE(word == "foo");
+
+  REQUIRE_FALSE(cfg::utils::extract_number(stream, x));
+  REQUIRE(stream.eof());
+}
+
+// These are closer to integration tests
+TEST_CASE("Parse ASCII mesh numbers", "[utils, ASCII]")
+{
+  // Every number in the mesh should parse identically to the formatted stream extraction
+  std::ifstream ifs{"box-txt.msh"};
+  std::string token;
+  size_t n_numbers = 0;
+  while (ifs >> token)
+  {
+    std::istringstream expect_stream{token};
+    double expect = 0;
+    if (!(expect_stream >> expect) || !expect_stream.eof())
+    {
+      continue;  // Not a number, e.g. a section name
+    }
+
+    double x = 0;
+    REQUIRE(parse(token, x));
+    REQUIRE(identical(x, expect));
+
+    size_t s = 0;
+    if (token.find_first_not_of("0123456789") == std::string::npos)
+    {
+      std::istringstream expect_idx_stream{token};
+      size_t expect_idx = 0;
+      expect_idx_stream >> expect_idx;
+      REQUIRE(parse(token, s));
+      REQUIRE(s == expect_idx);
+    }
+
+    n_numbers++;
+  }
+  REQUIRE(n_numbers > 363 * 4);
+}
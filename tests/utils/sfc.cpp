@@ -0,0 +1,70 @@
+/**
+ * sfc.cpp
+ *
+ * Tests the space-filling-curve keys.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <set>
+#include <vector>
+
+#include <sfc_partition.h>
+
+TEST_CASE("Morton keys", "[utils]")
+{
+  REQUIRE(cfg::utils::morton_key({0, 0, 0}) == 0);
+  REQUIRE(cfg::utils::morton_key({1, 0, 0}) == 1);
+  REQUIRE(cfg::utils::morton_key({0, 1, 0}) == 2);
+  REQUIRE(cfg::utils::morton_key({0, 0, 1}) == 4);
+  REQUIRE(cfg::utils::morton_key({2, 0, 0}) == 8);
+  REQUIRE(cfg::utils::morton_key({3, 3, 3}) == 63);
+
+  // The largest grid point uses all key bits
+  constexpr uint32_t max_grid = (uint32_t{1} << cfg::utils::sfc_bits) - 1;
+  REQUIRE(cfg::utils::morton_key({max_grid, max_grid, max_grid}) == (uint64_t{1} << (3 * cfg::utils::sfc_bits)) - 1);
+}
+
+TEST_CASE("Hilbert keys", "[utils]")
+{
+  // Consecutive points along the Hilbert curve are neighbours, test an 8x8x8 grid at the coarsest
+  // level of the curve.
+  constexpr uint32_t n_grid = 8;
+  constexpr unsigned int shift = cfg::utils::sfc_bits - 3;
+
+  std::vector<std::pair<uint64_t, std::array<uint32_t, 3>>> points;
+  std::set<uint64_t> keys;
+  for (uint32_t i = 0; i < n_grid; i++)
+  {
+    for (uint32_t j = 0; j < n_grid; j++)
+    {
+      for (uint32_t k = 0; k < n_grid; k++)
+      {
+        const std::array<uint32_t, 3> x{i, j, k};
+        const auto key = cfg::utils::hilbert_key({i << shift, j << shift, k << shift});
+        points.emplace_back(key, x);
+        keys.insert(key);
+      }
+    }
+  }
+  REQUIRE(keys.size() == points.size());  // Keys are unique
+
+  std::sort(points.begin(), points.end());
+  REQUIRE(points.front().first == 0);
+  for (size_t p = 1; p < points.size(); p++)
+  {
+    unsigned int distance = 0;
+    for (size_t axis = 0; axis < 3; axis++)
+    {
+      distance += static_cast<unsigned int>(
+          std::abs(static_cast<int>(points[p].second[axis]) - static_cast<int>(points[p - 1].second[axis])));
+    }
+    REQUIRE(distance == 1);
+  }
+}
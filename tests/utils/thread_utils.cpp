@@ -0,0 +1,57 @@
+/**
+ * thread_utils.cpp
+ *
+ * Tests processing ranges of items with threads.
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+#include <thread_utils.h>
+
+TEST_CASE("Parallel for", "[utils]")
+{
+  for (const size_t n_items : {0UL, 1UL, 5UL, 1000UL})
+  {
+    for (unsigned int n_threads = 1; n_threads <= 8; n_threads++)
+    {
+      // Every item is processed exactly once, in contiguous chunks in thread order
+      std::vector<int> count(n_items, 0);
+      std::vector<size_t> starts(n_threads, n_items + 1);
+      cfg::utils::parallel_for(n_threads,
+                               n_items,
+                               [&count, &starts](const unsigned int thread, const size_t first, const size_t last)
+                               {
+                                 starts[thread] = first;
+                                 for (auto i = first; i < last; i++)
+                                 {
+                                   count[i]++;
+                                 }
+                               });
+
+      REQUIRE(count == std::vector<int>(n_items, 1));
+      REQUIRE(starts[0] == 0);
+      for (unsigned int thread = 1; thread < n_threads; thread++)
+      {
+        REQUIRE(starts[thread] >= starts[thread - 1]);
+      }
+    }
+  }
+}
+
+TEST_CASE("Parallel for propagates errors", "[utils]")
+{
+  const auto fail_last = [](const unsigned int thread, const size_t /* first */, const size_t /* last */)
+  {
+    if (thread == 3)
+    {
+      throw std::runtime_error("Thread failed");
+    }
+  };
+
+  REQUIRE_THROWS_AS(cfg::utils::parallel_for(4, 100, fail_last), std::runtime_error);
+}